@@ -0,0 +1,260 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "activePixels.h"
+
+#include <eq/fabric/pixelViewport.h>
+#include <lunchbox/debug.h>
+
+#include <cstring>
+
+namespace eq
+{
+namespace
+{
+/** Header of the serialized runs: width, height, number of runs, padding. */
+static const uint64_t _headerSize = 4 * sizeof( uint32_t );
+
+uint64_t _getRowsSize( const uint32_t height )
+{
+    // row run counts, padded to 8 bytes to keep the runs aligned
+    return ( uint64_t( height ) * sizeof( uint32_t ) + 7 ) & ~uint64_t( 7 );
+}
+}
+
+ActivePixels::ActivePixels()
+    : _width( 0 )
+{}
+
+ActivePixels::~ActivePixels()
+{}
+
+void ActivePixels::clear()
+{
+    _width = 0;
+    _rows.clear();
+    _offsets.clear();
+    _runs.clear();
+}
+
+void ActivePixels::computeDepth( const uint32_t* depth,
+                                 const PixelViewport& pvp )
+{
+    _compute( depth, pvp, 0xffffffffu );
+}
+
+void ActivePixels::computeColor( const uint32_t* color,
+                                 const PixelViewport& pvp )
+{
+    _compute( color, pvp, 0u );
+}
+
+template< class T >
+void ActivePixels::_compute( const T* pixels, const PixelViewport& pvp,
+                             const T background )
+{
+    clear();
+    LBASSERT( pvp.hasArea( ));
+    if( !pvp.hasArea( ))
+        return;
+
+    _width = pvp.w;
+    _rows.resize( pvp.h + 1 );
+    _runs.reserve( pvp.h );
+
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        _rows[ y ] = uint32_t( _runs.size( ));
+        const T* row = pixels + size_t( y ) * pvp.w;
+
+        int32_t x = 0;
+        while( x < pvp.w )
+        {
+            while( x < pvp.w && row[ x ] == background )
+                ++x;
+            if( x == pvp.w )
+                break;
+
+            Run run;
+            run.start = x;
+            while( x < pvp.w && row[ x ] != background )
+                ++x;
+            run.length = x - run.start;
+            _runs.push_back( run );
+        }
+    }
+    _rows[ pvp.h ] = uint32_t( _runs.size( ));
+    _computeOffsets();
+}
+
+void ActivePixels::_computeOffsets()
+{
+    const uint32_t height = getHeight();
+    _offsets.resize( height + 1 );
+
+    uint64_t offset = 0;
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        _offsets[ y ] = offset;
+        for( const Run* run = getRunsBegin( y ); run != getRunsEnd( y ); ++run )
+            offset += run->length;
+    }
+    _offsets[ height ] = offset;
+}
+
+float ActivePixels::getActiveRatio() const
+{
+    const uint64_t area = uint64_t( _width ) * getHeight();
+    return area > 0 ? float( getNumPixels( )) / float( area ) : 0.f;
+}
+
+void ActivePixels::pack( const uint8_t* pixels, const size_t pixelSize,
+                         uint8_t* packed ) const
+{
+    const int32_t height = getHeight();
+    const size_t rowSize = _width * pixelSize;
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < height; ++y )
+    {
+        const uint8_t* row = pixels + y * rowSize;
+        uint8_t* out = packed + _offsets[ y ] * pixelSize;
+
+        for( const Run* run = getRunsBegin( y ); run != getRunsEnd( y ); ++run )
+        {
+            const size_t size = run->length * pixelSize;
+            ::memcpy( out, row + run->start * pixelSize, size );
+            out += size;
+        }
+    }
+}
+
+void ActivePixels::unpack( const uint8_t* packed, const size_t pixelSize,
+                           const uint8_t background, uint8_t* pixels ) const
+{
+    const int32_t height = getHeight();
+    const size_t rowSize = _width * pixelSize;
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < height; ++y )
+    {
+        uint8_t* row = pixels + y * rowSize;
+        const uint8_t* in = packed + _offsets[ y ] * pixelSize;
+
+        size_t x = 0; // first pixel not yet written
+        for( const Run* run = getRunsBegin( y ); run != getRunsEnd( y ); ++run )
+        {
+            ::memset( row + x * pixelSize, background,
+                      ( run->start - x ) * pixelSize );
+
+            const size_t size = run->length * pixelSize;
+            ::memcpy( row + run->start * pixelSize, in, size );
+            in += size;
+            x = run->start + run->length;
+        }
+        ::memset( row + x * pixelSize, background, ( _width - x ) * pixelSize );
+    }
+}
+
+uint64_t ActivePixels::getSerializedSize() const
+{
+    return _headerSize + _getRowsSize( getHeight( )) +
+           _runs.size() * sizeof( Run );
+}
+
+void ActivePixels::serialize( uint8_t* data ) const
+{
+    const uint32_t height = getHeight();
+    const uint32_t header[4] = { _width, height, uint32_t( _runs.size( )), 0 };
+    ::memcpy( data, header, _headerSize );
+    data += _headerSize;
+
+    ::memset( data, 0, _getRowsSize( height ));
+    uint32_t* counts = reinterpret_cast< uint32_t* >( data );
+    for( uint32_t y = 0; y < height; ++y )
+        counts[ y ] = _rows[ y + 1 ] - _rows[ y ];
+    data += _getRowsSize( height );
+
+    if( !_runs.empty( ))
+        ::memcpy( data, _runs.data(), _runs.size() * sizeof( Run ));
+}
+
+uint64_t ActivePixels::deserialize( const uint8_t* data, const uint64_t size )
+{
+    clear();
+    if( size < _headerSize )
+        return 0;
+
+    uint32_t header[4];
+    ::memcpy( header, data, _headerSize );
+    const uint32_t height = header[1];
+    const uint32_t nRuns = header[2];
+
+    const uint64_t rowsSize = _getRowsSize( height );
+    const uint64_t total = _headerSize + rowsSize + nRuns * sizeof( Run );
+    if( size < total )
+        return 0;
+
+    std::vector< uint32_t > counts( height );
+    if( height > 0 )
+        ::memcpy( counts.data(), data + _headerSize,
+                  height * sizeof( uint32_t ));
+
+    uint64_t first = 0;
+    for( uint32_t y = 0; y < height; ++y )
+        first += counts[ y ];
+    if( first != nRuns )
+    {
+        LBWARN << "Corrupt active pixel run counts" << std::endl;
+        return 0;
+    }
+
+    _width = header[0];
+    _rows.resize( height + 1 );
+    _runs.resize( nRuns );
+    if( nRuns > 0 )
+        ::memcpy( _runs.data(), data + _headerSize + rowsSize,
+                  nRuns * sizeof( Run ));
+
+    // runs have to be ordered, disjoint and within the row
+    uint32_t run = 0;
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        _rows[ y ] = run;
+        uint64_t end = 0;
+        for( const uint32_t last = run + counts[ y ]; run < last; ++run )
+        {
+            const Run& current = _runs[ run ];
+            if( current.length == 0 || current.start < end ||
+                uint64_t( current.start ) + current.length > _width )
+            {
+                LBWARN << "Corrupt active pixel run " << current.start << ", "
+                       << current.length << " in row " << y << " of width "
+                       << _width << std::endl;
+                clear();
+                return 0;
+            }
+            end = uint64_t( current.start ) + current.length;
+        }
+    }
+    _rows[ height ] = run;
+
+    _computeOffsets();
+    return total;
+}
+
+}
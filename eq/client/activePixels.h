@@ -0,0 +1,160 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_ACTIVEPIXELS_H
+#define EQ_ACTIVEPIXELS_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+
+#include <vector>
+
+namespace eq
+{
+/**
+ * A run-length encoding of the active pixels of an image.
+ *
+ * Each row of the image is described by a list of runs of consecutive active
+ * pixels. Pixel data of active pixels can be packed into a contiguous buffer,
+ * which stores the pixels of all runs in row order. Inactive pixels are
+ * background pixels: depth values on the far plane, or color values of zero.
+ *
+ * Used to transmit and composite sparse sort-last images without touching the
+ * background pixels.
+ */
+class ActivePixels
+{
+public:
+    /** A run of consecutive active pixels within a row. */
+    struct Run
+    {
+        uint32_t start; //!< The first pixel of the run, relative to the row
+        uint32_t length; //!< The number of pixels in the run
+    };
+
+    /** Construct new, empty active pixels. @version 1.8 */
+    EQ_API ActivePixels();
+
+    /** Destruct the active pixels. @version 1.8 */
+    EQ_API ~ActivePixels();
+
+    /** Remove all runs. @version 1.8 */
+    EQ_API void clear();
+
+    /** @return true if no runs have been computed or set. @version 1.8 */
+    bool isEmpty() const { return _rows.empty(); }
+
+    /**
+     * Compute the active pixels of an unsigned int depth buffer.
+     *
+     * Pixels with the maximum depth value (far plane) are inactive.
+     * @version 1.8
+     */
+    EQ_API void computeDepth( const uint32_t* depth, const PixelViewport& pvp );
+
+    /**
+     * Compute the active pixels of a 32 bit color buffer.
+     *
+     * Pixels with a value of zero (black with zero alpha) are inactive.
+     * @version 1.8
+     */
+    EQ_API void computeColor( const uint32_t* color, const PixelViewport& pvp );
+
+    /** @return the width of the encoded image. @version 1.8 */
+    uint32_t getWidth() const { return _width; }
+
+    /** @return the height of the encoded image. @version 1.8 */
+    uint32_t getHeight() const
+        { return _rows.empty() ? 0 : uint32_t( _rows.size() - 1 ); }
+
+    /** @return the total number of active pixels. @version 1.8 */
+    uint64_t getNumPixels() const
+        { return _offsets.empty() ? 0 : _offsets.back(); }
+
+    /** @return the total number of runs. @version 1.8 */
+    size_t getNumRuns() const { return _runs.size(); }
+
+    /** @return the fraction of active pixels, in [0,1]. @version 1.8 */
+    EQ_API float getActiveRatio() const;
+
+    /** @return the first run of the given row. @version 1.8 */
+    const Run* getRunsBegin( const uint32_t y ) const
+        { return _runs.data() + _rows[ y ]; }
+
+    /** @return the end of the runs of the given row. @version 1.8 */
+    const Run* getRunsEnd( const uint32_t y ) const
+        { return _runs.data() + _rows[ y + 1 ]; }
+
+    /** @return the index of the first packed pixel of a row. @version 1.8 */
+    uint64_t getPackedOffset( const uint32_t y ) const { return _offsets[ y ]; }
+
+    /**
+     * Pack the active pixels of a full image into a contiguous buffer.
+     *
+     * @param pixels the full image data.
+     * @param pixelSize the size of one pixel in bytes.
+     * @param packed the output, of at least getNumPixels() * pixelSize bytes.
+     * @version 1.8
+     */
+    EQ_API void pack( const uint8_t* pixels, const size_t pixelSize,
+                      uint8_t* packed ) const;
+
+    /**
+     * Unpack packed pixels into a full image.
+     *
+     * Inactive pixels are set to the given background byte value.
+     * @version 1.8
+     */
+    EQ_API void unpack( const uint8_t* packed, const size_t pixelSize,
+                        const uint8_t background, uint8_t* pixels ) const;
+
+    /** @return the size of the serialized runs in bytes. @version 1.8 */
+    EQ_API uint64_t getSerializedSize() const;
+
+    /**
+     * Serialize the runs.
+     *
+     * @param data the output, of at least getSerializedSize() bytes.
+     * @version 1.8
+     */
+    EQ_API void serialize( uint8_t* data ) const;
+
+    /**
+     * Deserialize the runs from data written by serialize().
+     *
+     * Rejects runs which are empty, unordered, overlapping or outside of the
+     * row.
+     *
+     * @return the number of bytes consumed, or 0 on error.
+     * @version 1.8
+     */
+    EQ_API uint64_t deserialize( const uint8_t* data, const uint64_t size );
+
+private:
+    uint32_t _width;
+    std::vector< uint32_t > _rows; //!< first run per row, height+1 entries
+    std::vector< uint64_t > _offsets; //!< first packed pixel per row
+    std::vector< Run > _runs;
+
+    template< class T > void _compute( const T* pixels,
+                                       const PixelViewport& pvp,
+                                       const T background );
+    void _computeOffsets();
+};
+}
+
+#endif // EQ_ACTIVEPIXELS_H
@@ -79,19 +79,24 @@
  * <img src="http://www.equalizergraphics.com/documents/design/images/clientUML.png">
  */
 
+#include <eq/client/activePixels.h>
 #include <eq/client/canvas.h>
 #include <eq/client/channelStatistics.h>
 #include <eq/client/channel.h>
 #include <eq/client/client.h>
 #include <eq/client/compositor.h>
 #include <eq/client/config.h>
+#include <eq/client/criticalPathAnalyzer.h>
+#include <eq/client/dataStreamer.h>
 #include <eq/client/eventICommand.h>
 #include <eq/client/error.h>
 #include <eq/client/exception.h>
 #include <eq/client/frame.h>
 #include <eq/client/frameData.h>
+#include <eq/client/frameDataTrace.h>
 #include <eq/client/global.h>
 #include <eq/client/glException.h>
+#include <eq/client/hierarchicalBarrier.h>
 #include <eq/client/image.h>
 #include <eq/client/init.h>
 #include <eq/client/layout.h>
@@ -103,6 +108,7 @@
 #include <eq/client/pixelData.h>
 #include <eq/client/server.h>
 #include <eq/client/segment.h>
+#include <eq/client/statisticsAggregator.h>
 #include <eq/client/systemWindow.h>
 #include <eq/client/types.h>
 #include <eq/client/version.h>
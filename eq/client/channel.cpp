@@ -19,6 +19,7 @@
 
 #include "channel.h"
 
+#include "activePixels.h"
 #include "channelStatistics.h"
 #include "client.h"
 #include "compositor.h"
@@ -51,12 +52,14 @@
 #include <eq/fabric/frameData.h>
 #include <eq/fabric/task.h>
 #include <eq/fabric/tile.h>
+#include <eq/fabric/wall.h>
 
 #include <co/connectionDescription.h>
 #include <co/exception.h>
 #include <co/objectICommand.h>
 #include <co/queueSlave.h>
 #include <co/sendToken.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/rng.h>
 #include <lunchbox/scopedMutex.h>
 #include <pression/plugins/compressor.h>
@@ -136,6 +139,8 @@ void Channel::attach( const uint128_t& id, const uint32_t instanceID )
                      CmdFunc( this, &Channel::_cmdStopFrame ), commandQ );
     registerCommand( fabric::CMD_CHANNEL_FRAME_TILES,
                      CmdFunc( this, &Channel::_cmdFrameTiles ), queue );
+    registerCommand( fabric::CMD_CHANNEL_FRAME_REPEAT,
+                     CmdFunc( this, &Channel::_cmdFrameRepeat ), queue );
     registerCommand( fabric::CMD_CHANNEL_FINISH_READBACK,
                      CmdFunc( this, &Channel::_cmdFinishReadback ), transferQ );
     registerCommand( fabric::CMD_CHANNEL_DELETE_TRANSFER_CONTEXT,
@@ -1000,13 +1005,17 @@ namespace detail
 {
 struct RBStat
 {
-    RBStat( eq::Channel* channel )
+    RBStat( eq::Channel* channel, const Frames& frames )
             : event( Statistic::CHANNEL_READBACK, channel )
             , uncompressed( 0 )
             , compressed( 0 )
         {
             event.event.data.statistic.plugins[0] = EQ_COMPRESSOR_NONE;
             event.event.data.statistic.plugins[1] = EQ_COMPRESSOR_NONE;
+            // identifies the output frame for the critical path analysis
+            if( frames.size() == 1 )
+                event.event.data.statistic.frameData =
+                    uint32_t( frames.front()->getFrameData()->getID().low( ));
             LBASSERT( event.event.data.statistic.frameNumber > 0 );
         }
 
@@ -1052,7 +1061,9 @@ void Channel::_frameTiles( RenderContext& context, const bool isLocal,
     if( tasks & fabric::TASK_READBACK )
     {
         frames = _getFrames( frameIDs, true );
-        stat = new detail::RBStat( this );
+        for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+            (*i)->getFrameData()->setDropped( false );
+        stat = new detail::RBStat( this, frames );
     }
 
     int64_t startTime = getConfig()->getTime();
@@ -1060,6 +1071,7 @@ void Channel::_frameTiles( RenderContext& context, const bool isLocal,
     int64_t drawTime = 0;
     int64_t readbackTime = 0;
     bool hasAsyncReadback = false;
+    size_t nTiles = 0;
     const uint32_t timeout = getConfig()->getTimeout();
 
     co::QueueSlave* queue = _getQueue( queueID );
@@ -1072,6 +1084,7 @@ void Channel::_frameTiles( RenderContext& context, const bool isLocal,
 
         const Tile& tile = tileCmd.read< Tile >();
         context.apply( tile );
+        ++nTiles;
 
         const PixelViewport tilePVP = context.pvp;
 
@@ -1143,6 +1156,7 @@ void Channel::_frameTiles( RenderContext& context, const bool isLocal,
         event.event.data.statistic.startTime = startTime;
         startTime += drawTime;
         event.event.data.statistic.endTime = startTime;
+        event.event.data.statistic.ratio = float( nTiles );
     }
 
     if( tasks & fabric::TASK_READBACK )
@@ -1209,19 +1223,136 @@ void Channel::_frameReadback( const uint128_t& frameID,
 {
     LB_TS_THREAD( _pipeThread );
 
-    RBStatPtr stat = new detail::RBStat( this );
     const Frames& frames = _getFrames( frameIDs, true );
+    if( getPipe()->isFrameStale( ))
+    {
+        _dropFrame( frames );
+        return;
+    }
+
+    RBStatPtr stat = new detail::RBStat( this, frames );
+    for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        (*i)->getFrameData()->setDropped( false );
 
     std::vector< size_t > nImages( frames.size(), 0 );
     for( size_t i = 0; i < frames.size(); ++i )
         nImages[i] = frames[i]->getImages().size();
 
+    const std::vector< bool > progressive = _startProgressive( frameID,
+                                                                frames );
     frameReadback( frameID, frames );
+    _finishProgressive( progressive, nImages, frames );
     LBASSERT( stat->event.event.data.statistic.frameNumber > 0 );
     const bool async = _asyncFinishReadback( nImages, frames );
     _setReady( async, stat.get(), frames );
 }
 
+void Channel::_dropFrame( const Frames& frames )
+{
+    LB_TS_THREAD( _pipeThread );
+
+    ChannelStatistics event( Statistic::CHANNEL_FRAME_DROP, this );
+    event.event.data.statistic.ratio = float( ++_impl->droppedFrames );
+
+    // signal the empty output frames, which lets the destinations drop them
+    const uint32_t frameNumber = getCurrentFrame();
+    const Eye eye = getEye();
+    for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+    {
+        const Frame* frame = *i;
+        FrameDataPtr frameData = frame->getFrameData();
+        frameData->setDropped( true );
+        frameData->setReady();
+
+        _refFrame( frameNumber );
+        send( getLocalNode(), fabric::CMD_CHANNEL_FRAME_SET_READY_NODE )
+            << co::ObjectVersion( frameData ) << frame->getInputNodes( eye )
+            << frame->getInputNetNodes( eye ) << frameNumber;
+    }
+}
+
+bool Channel::_hasDroppedInput( const Frames& frames ) const
+{
+    // inputs are only dropped in deadline mode, see Pipe::isFrameStale
+    if( getPipe()->getFrameDeadline() == 0 )
+        return false;
+
+    // Checks the frames which became ready during the assembly. A dropped
+    // frame is ready without images, so its assembly was a no-op.
+    for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+    {
+        const FrameDataPtr frameData = (*i)->getFrameData();
+        if( frameData->isReady() && frameData->isDropped( ))
+            return true;
+    }
+    return false;
+}
+
+namespace
+{
+// Memory frames without depth and configured zoom may be reduced
+bool _isProgressive( const Frame* frame )
+{
+    FrameDataPtr frameData = frame->getFrameData();
+    return frame->getZoom() == Zoom::NONE &&
+           frameData->getZoom() == Zoom::NONE &&
+           frameData->getType() == Frame::TYPE_MEMORY &&
+           frameData->getBuffers() == Frame::BUFFER_COLOR;
+}
+}
+
+std::vector< bool > Channel::_startProgressive( const uint128_t& frameID,
+                                                const Frames& frames )
+{
+    std::vector< bool > progressive( frames.size(), false );
+    if( getIAttribute( IATTR_HINT_PROGRESSIVE ) != ON )
+        return progressive;
+
+    uint64_t nPixels = 0;
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        const Frame* frame = frames[i];
+        progressive[i] = _isProgressive( frame );
+        if( progressive[i] )
+            nPixels += uint64_t( frame->getFrameData()->getPixelViewport().
+                                 getArea( )) *
+                       frame->getInputNodes( getEye( )).size();
+    }
+
+    const float scale = _impl->getProgressiveScale( frameID,
+                                                    getHeadTransform(),
+                                                    nPixels );
+    if( scale >= 1.f )
+        return std::vector< bool >( frames.size(), false );
+
+    // reduce the readback resolution, restored in _finishProgressive
+    for( size_t i = 0; i < frames.size(); ++i )
+        if( progressive[i] )
+            frames[i]->setZoom( Zoom( scale, scale ));
+    return progressive;
+}
+
+void Channel::_finishProgressive( const std::vector< bool >& progressive,
+                                  const std::vector< size_t >& imagePos,
+                                  const Frames& frames )
+{
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        if( !progressive[i] )
+            continue;
+
+        // let the destination channel upscale the reduced images
+        Frame* frame = frames[i];
+        const Zoom& zoom = frame->getZoom();
+        const Zoom upscale( 1.f / zoom.x(), 1.f / zoom.y( ));
+        const Images& images = frame->getImages();
+        for( size_t j = imagePos[i]; j < images.size(); ++j )
+            images[j]->setZoom( upscale );
+
+        frame->setZoom( Zoom::NONE );
+    }
+}
+
 bool Channel::_asyncFinishReadback( const std::vector< size_t >& imagePos,
                                     const Frames& frames )
 {
@@ -1334,6 +1465,9 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
     ChannelStatistics transmitEvent( Statistic::CHANNEL_FRAME_TRANSMIT, this,
                                      frameNumber );
     transmitEvent.event.data.statistic.task = taskID;
+    transmitEvent.event.data.statistic.frameData =
+        uint32_t( frameData->getID().low( ));
+    lunchbox::Clock clock;
 
     const Images& images = frameData->getImages();
     Image* image = images[ imageIndex ];
@@ -1361,6 +1495,20 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
     // use compression on links up to 2 GBit/s
     const bool useCompression = ( description->bandwidth <= 262144 );
 
+    // send only the active pixels of sparse images, uncompressed. AUTO uses
+    // them only on links which are too fast for compression.
+    const int32_t activePixelsHint = getIAttribute( IATTR_HINT_ACTIVE_PIXELS );
+    bool sparse = false;
+    if(( activePixelsHint == ON ||
+         ( activePixelsHint == AUTO && !useCompression )) &&
+       image->computeActivePixels( ))
+    {
+        sparse = ( activePixelsHint == ON ||
+                   image->getActivePixels().getActiveRatio() <= .5f );
+    }
+    const ActivePixels& activePixels = image->getActivePixels();
+    lunchbox::Bufferb packed[2];
+
     std::vector< const PixelData* > pixelDatas;
     std::vector< float > qualities;
 
@@ -1377,6 +1525,10 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
         compressEvent.event.data.statistic.plugins[0] = EQ_COMPRESSOR_NONE;
         compressEvent.event.data.statistic.plugins[1] = EQ_COMPRESSOR_NONE;
 
+        if( sparse ) // runs size, runs
+            imageDataSize += sizeof( uint64_t ) +
+                             activePixels.getSerializedSize();
+
         // Prepare image pixel data
         Frame::Buffer buffers[] = {Frame::BUFFER_COLOR,Frame::BUFFER_DEPTH};
 
@@ -1389,13 +1541,23 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                 // format, type, nChunks, compressor name
                 imageDataSize += sizeof( FrameData::ImageHeader );
 
-                const PixelData& data = useCompression ?
+                const PixelData& data = useCompression && !sparse ?
                     image->compressPixelData( buffer ) :
                     image->getPixelData( buffer );
                 pixelDatas.push_back( &data );
                 qualities.push_back( image->getQuality( buffer ));
 
-                if( data.compressedData.isCompressed( ))
+                if( sparse )
+                {
+                    const uint64_t size = activePixels.getNumPixels() *
+                                          data.pixelSize;
+                    lunchbox::Bufferb& pixels = packed[ pixelDatas.size()-1 ];
+                    pixels.resize( size );
+                    activePixels.pack( data.pixels, data.pixelSize,
+                                       pixels.getData( ));
+                    imageDataSize += sizeof( uint64_t ) + size;
+                }
+                else if( data.compressedData.isCompressed( ))
                 {
                     imageDataSize += data.compressedData.getSize() +
                         data.compressedData.chunks.size() * sizeof( uint64_t );
@@ -1419,6 +1581,7 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
 
     if( pixelDatas.empty( ))
         return;
+    transmitEvent.event.data.statistic.bytes = uint32_t( imageDataSize );
 
     // send image pixel data command
     co::LocalNode::SendToken token;
@@ -1436,20 +1599,36 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
                                 co::COMMANDTYPE_OBJECT, nodeID,
                                 CO_INSTANCE_ALL );
     command << frameDataVersion << image->getPixelViewport() << image->getZoom()
-            << commandBuffers << frameNumber << image->getAlphaUsage();
+            << commandBuffers << frameNumber << image->getAlphaUsage()
+            << sparse;
     command.sendHeader( imageDataSize );
 
 #ifndef NDEBUG
     size_t sentBytes = 0;
 #endif
 
+    if( sparse )
+    {
+        lunchbox::Bufferb runs;
+        runs.resize( activePixels.getSerializedSize( ));
+        activePixels.serialize( runs.getData( ));
+
+        const uint64_t runsSize = runs.getSize();
+        connection->send( &runsSize, sizeof( runsSize ), true );
+        connection->send( runs.getData(), runsSize, true );
+#ifndef NDEBUG
+        sentBytes += sizeof( runsSize ) + runsSize;
+#endif
+    }
+
     for( uint32_t j=0; j < pixelDatas.size(); ++j )
     {
 #ifndef NDEBUG
         sentBytes += sizeof( FrameData::ImageHeader );
 #endif
         const PixelData* data = pixelDatas[j];
-        const bool isCompressed = data->compressedData.isCompressed();
+        const bool isCompressed = !sparse &&
+                                  data->compressedData.isCompressed();
         const uint32_t nChunks = isCompressed ?
             uint32_t( data->compressedData.chunks.size( )) : 1;
 
@@ -1477,6 +1656,16 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
 #endif
             }
         }
+        else if( sparse )
+        {
+            const uint64_t dataSize = packed[j].getSize();
+            connection->send( &dataSize, sizeof( dataSize ), true );
+            if( dataSize > 0 )
+                connection->send( packed[j].getData(), dataSize, true );
+#ifndef NDEBUG
+            sentBytes += sizeof( dataSize ) + dataSize;
+#endif
+        }
         else
         {
             const uint64_t dataSize = data->pvp.getArea() * data->pixelSize;
@@ -1491,6 +1680,10 @@ void Channel::_transmitImage( const co::ObjectVersion& frameDataVersion,
     LBASSERTINFO( sentBytes == imageDataSize,
         sentBytes << " != " << imageDataSize );
 #endif
+
+    if( getIAttribute( IATTR_HINT_PROGRESSIVE ) == ON )
+        _impl->addTransmitTime( clock.getTimef(),
+                                image->getPixelViewport().getArea( ));
 }
 
 void Channel::_setReady( const bool async, detail::RBStat* stat,
@@ -1662,6 +1855,9 @@ bool Channel::_cmdFrameStart( co::ICommand& cmd )
     LBASSERT( statistic.data.empty( ));
     statistic.used = 1;
 
+    _impl->lastTasks.swap( _impl->tasks );
+    _impl->tasks.clear();
+
     resetContext();
     return true;
 }
@@ -1684,39 +1880,112 @@ bool Channel::_cmdFrameFinish( co::ICommand& cmd )
     return true;
 }
 
-bool Channel::_cmdFrameClear( co::ICommand& cmd )
+void Channel::_frameClear( RenderContext& context )
 {
-    LBASSERT( _impl->state == STATE_RUNNING );
-
-    co::ObjectICommand command( cmd );
-    RenderContext context  = command.read< RenderContext >();
-
-    LBLOG( LOG_TASKS ) << "TASK clear " << getName() <<  " " << command
-                       << " " << context << std::endl;
+    _impl->tasks.push_back( detail::Channel::Task(
+                                fabric::CMD_CHANNEL_FRAME_CLEAR, context ));
 
     _overrideContext( context );
     ChannelStatistics event( Statistic::CHANNEL_CLEAR, this );
     frameClear( context.frameID );
     resetContext();
-
-    return true;
 }
 
-bool Channel::_cmdFrameDraw( co::ICommand& cmd )
+void Channel::_lateLatch( RenderContext& context )
 {
-    co::ObjectICommand command( cmd );
-    RenderContext context  = command.read< RenderContext >();
-    const bool finish = command.read< bool >();
+    if( context.latchID == 0 )
+        return;
 
-    LBLOG( LOG_TASKS ) << "TASK draw " << getName() <<  " " << command
-                       << " " << context << std::endl;
+    // Predict for the frame deadline, or for the measured delay from the last
+    // latch to the following buffer swap. The pipe predicts once per frame.
+    const int64_t now = getConfig()->getTime();
+    const int64_t swapEnd = getWindow()->getSwapEndTime();
+    if( _impl->latchTime > 0 && swapEnd > _impl->latchTime )
+    {
+        const float delay = float( swapEnd - _impl->latchTime );
+        _impl->presentDelay = _impl->presentDelay > 0.f ?
+                              .5f * ( _impl->presentDelay + delay ) : delay;
+    }
+    _impl->latchTime = now;
+
+    const int64_t deadline = getPipe()->getFrameDeadline();
+    const int64_t present = deadline > now ? deadline :
+                                now + int64_t( _impl->presentDelay );
+    Matrix4f head;
+    const int64_t sampleTime = getPipe()->predictHead( context.latchID,
+                                                        present, head );
+    if( sampleTime == 0 )
+        return;
 
+    Matrix4f& transform = context.headTransform;
+    if( context.wallType == fabric::Wall::TYPE_FIXED )
+    {
+        // Move the eye in wall space by the displacement of the tracked eye,
+        // using the rotation of the head transform (the wall orientation)
+        const Vector3f delta = ( head * context.eyeHead -
+                                 context.headMatrix * context.eyeHead ) *
+                               context.modelUnit;
+        const Vector3f shift(
+            transform.array[0] * delta[0] + transform.array[4] * delta[1] +
+            transform.array[8] * delta[2],
+            transform.array[1] * delta[0] + transform.array[5] * delta[1] +
+            transform.array[9] * delta[2],
+            transform.array[2] * delta[0] + transform.array[6] * delta[1] +
+            transform.array[10] * delta[2] );
+        const Vector3f& oldEye = context.eyeWall;
+        const Vector3f eye = oldEye + shift;
+        if( oldEye.z() <= 0.f || eye.z() <= 0.f )
+            return; // eye behind the wall, keep the server frustum
+
+        // project the same wall area from the new eye position
+        Frustumf& frustum = context.frustum;
+        const float oldRatio = frustum.near_plane() / oldEye.z();
+        const float ratio = frustum.near_plane() / eye.z();
+        frustum.left() = ( frustum.left() / oldRatio + oldEye.x() - eye.x( )) *
+                         ratio;
+        frustum.right() = ( frustum.right() / oldRatio + oldEye.x() -
+                            eye.x( )) * ratio;
+        frustum.bottom() = ( frustum.bottom() / oldRatio + oldEye.y() -
+                             eye.y( )) * ratio;
+        frustum.top() = ( frustum.top() / oldRatio + oldEye.y() - eye.y( )) *
+                        ratio;
+
+        // headTransform = -trans(eye) * view matrix, see server::Compound
+        for( int i = 0; i < 16; i += 4 )
+        {
+            transform.array[i]   -= shift[0] * transform.array[i+3];
+            transform.array[i+1] -= shift[1] * transform.array[i+3];
+            transform.array[i+2] -= shift[2] * transform.array[i+3];
+        }
+    }
+    else // HMD: replace the inverse head matrix of the head transform
+    {
+        Matrix4f inverse;
+        head.inverse( inverse );
+        transform = transform * context.headMatrix * inverse;
+    }
+
+    ChannelStatistics event( Statistic::CHANNEL_MOTION_TO_PHOTON, this );
+    event.event.data.statistic.startTime = sampleTime;
+    event.event.data.statistic.endTime = present;
+}
+
+void Channel::_frameDraw( RenderContext& context, const bool finish )
+{
+    _impl->tasks.push_back( detail::Channel::Task(
+                                fabric::CMD_CHANNEL_FRAME_DRAW, context,
+                                finish ));
+
+    _lateLatch( context );
     _overrideContext( context );
     const uint32_t frameNumber = getCurrentFrame();
     ChannelStatistics event( Statistic::CHANNEL_DRAW, this, frameNumber,
                              finish ? NICEST : AUTO );
 
+    lunchbox::Clock clock;
     frameDraw( context.frameID );
+    if( getIAttribute( IATTR_HINT_PROGRESSIVE ) == ON )
+        _impl->addDrawTime( clock.getTimef( ));
     // Update ROI for server equalizers
     if( !getRegion().isValid( ))
         declareRegion( getPixelViewport( ));
@@ -1724,7 +1993,70 @@ bool Channel::_cmdFrameDraw( co::ICommand& cmd )
     _impl->statistics.data[ index ].region = getRegion() / getPixelViewport();
 
     resetContext();
+}
+
+void Channel::_frameDrawFinish( const uint128_t& frameID,
+                                const uint32_t frameNumber )
+{
+    RenderContext context;
+    context.frameID = frameID;
+    _impl->tasks.push_back( detail::Channel::Task(
+                                fabric::CMD_CHANNEL_FRAME_DRAW_FINISH,
+                                context ));
+
+    ChannelStatistics event( Statistic::CHANNEL_DRAW_FINISH, this );
+    frameDrawFinish( frameID, frameNumber );
+}
+
+void Channel::_frameViewStart( RenderContext& context )
+{
+    _impl->tasks.push_back( detail::Channel::Task(
+                                fabric::CMD_CHANNEL_FRAME_VIEW_START,
+                                context ));
+
+    _overrideContext( context );
+    frameViewStart( context.frameID );
+    resetContext();
+}
+
+void Channel::_frameViewFinish( RenderContext& context )
+{
+    _impl->tasks.push_back( detail::Channel::Task(
+                                fabric::CMD_CHANNEL_FRAME_VIEW_FINISH,
+                                context ));
+
+    _overrideContext( context );
+    {
+        ChannelStatistics event( Statistic::CHANNEL_VIEW_FINISH, this );
+        frameViewFinish( context.frameID );
+    }
+    resetContext();
+}
+
+bool Channel::_cmdFrameClear( co::ICommand& cmd )
+{
+    LBASSERT( _impl->state == STATE_RUNNING );
+
+    co::ObjectICommand command( cmd );
+    RenderContext context  = command.read< RenderContext >();
+
+    LBLOG( LOG_TASKS ) << "TASK clear " << getName() <<  " " << command
+                       << " " << context << std::endl;
+
+    _frameClear( context );
+    return true;
+}
+
+bool Channel::_cmdFrameDraw( co::ICommand& cmd )
+{
+    co::ObjectICommand command( cmd );
+    RenderContext context  = command.read< RenderContext >();
+    const bool finish = command.read< bool >();
+
+    LBLOG( LOG_TASKS ) << "TASK draw " << getName() <<  " " << command
+                       << " " << context << std::endl;
 
+    _frameDraw( context, finish );
     return true;
 }
 
@@ -1738,9 +2070,7 @@ bool Channel::_cmdFrameDrawFinish( co::ICommand& cmd )
                        << " frame " << frameNumber << " id " << frameID
                        << std::endl;
 
-    ChannelStatistics event( Statistic::CHANNEL_DRAW_FINISH, this );
-    frameDrawFinish( frameID, frameNumber );
-
+    _frameDrawFinish( frameID, frameNumber );
     return true;
 }
 
@@ -1756,9 +2086,19 @@ bool Channel::_cmdFrameAssemble( co::ICommand& cmd )
 
     _overrideContext( context );
 
-    ChannelStatistics event( Statistic::CHANNEL_ASSEMBLE, this );
     const Frames& frames = _getFrames( frameIDs, false );
-    frameAssemble( context.frameID, frames );
+    {
+        ChannelStatistics event( Statistic::CHANNEL_ASSEMBLE, this );
+        frameAssemble( context.frameID, frames );
+    }
+
+    if( _hasDroppedInput( frames ))
+    {
+        // keep presenting the newest complete frame
+        ChannelStatistics event( Statistic::CHANNEL_FRAME_DROP, this );
+        event.event.data.statistic.ratio = float( ++_impl->droppedFrames );
+        getWindow()->dropFrame();
+    }
 
     resetContext();
     return true;
@@ -1886,10 +2226,7 @@ bool Channel::_cmdFrameViewStart( co::ICommand& cmd )
     LBLOG( LOG_TASKS ) << "TASK view start " << getName() <<  " " << command
                        << " " << context << std::endl;
 
-    _overrideContext( context );
-    frameViewStart( context.frameID );
-    resetContext();
-
+    _frameViewStart( context );
     return true;
 }
 
@@ -1901,13 +2238,7 @@ bool Channel::_cmdFrameViewFinish( co::ICommand& cmd )
     LBLOG( LOG_TASKS ) << "TASK view finish " << getName() <<  " " << command
                        << " " << context << std::endl;
 
-    _overrideContext( context );
-    {
-        ChannelStatistics event( Statistic::CHANNEL_VIEW_FINISH, this );
-        frameViewFinish( context.frameID );
-    }
-    resetContext();
-
+    _frameViewFinish( context );
     return true;
 }
 
@@ -1938,6 +2269,58 @@ bool Channel::_cmdFrameTiles( co::ICommand& cmd )
     return true;
 }
 
+bool Channel::_cmdFrameRepeat( co::ICommand& cmd )
+{
+    co::ObjectICommand command( cmd );
+    const uint128_t& frameID = command.read< uint128_t >();
+    const uint32_t frameNumber = command.read< uint32_t >();
+    const uint32_t begin = command.read< uint32_t >();
+    uint32_t end = command.read< uint32_t >();
+
+    LBLOG( LOG_TASKS ) << "TASK repeat " << getName() <<  " " << command
+                       << " frame " << frameNumber << " id " << frameID
+                       << " tasks " << begin << ".." << end << std::endl;
+
+    const detail::Channel::Tasks& tasks = _impl->lastTasks;
+    if( end > tasks.size( ))
+    {
+        LBERROR << "Repeat of tasks " << begin << ".." << end << ", only "
+                << tasks.size() << " tasks recorded in last frame" << std::endl;
+        end = uint32_t( tasks.size( ));
+    }
+
+    // replayed tasks are recorded again for the next repetition
+    for( uint32_t i = begin; i < end; ++i )
+    {
+        const detail::Channel::Task& task = tasks[i];
+        RenderContext context = task.context;
+        context.frameID = frameID;
+
+        switch( task.command )
+        {
+          case fabric::CMD_CHANNEL_FRAME_CLEAR:
+              _frameClear( context );
+              break;
+          case fabric::CMD_CHANNEL_FRAME_DRAW:
+              _frameDraw( context, task.finish );
+              break;
+          case fabric::CMD_CHANNEL_FRAME_DRAW_FINISH:
+              _frameDrawFinish( frameID, frameNumber );
+              break;
+          case fabric::CMD_CHANNEL_FRAME_VIEW_START:
+              _frameViewStart( context );
+              break;
+          case fabric::CMD_CHANNEL_FRAME_VIEW_FINISH:
+              _frameViewFinish( context );
+              break;
+          default:
+              LBERROR << "Can't repeat task " << task.command << std::endl;
+              break;
+        }
+    }
+    return true;
+}
+
 bool Channel::_cmdDeleteTransferContext( co::ICommand& cmd )
 {
     co::ObjectICommand command( cmd );
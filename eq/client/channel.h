@@ -570,12 +570,23 @@ private:
     /** Setup the current rendering context. */
     void _overrideContext( RenderContext& context );
 
+    /** Update the perspective with the newest, predicted head tracking. */
+    void _lateLatch( RenderContext& context );
+
     /** Initialize the FBO */
     bool _configInitFBO();
 
     /** Initialize the channel's drawable config. */
     void _initDrawableConfig();
 
+    /** The tasks of one frame, recorded for CMD_CHANNEL_FRAME_REPEAT. */
+    void _frameClear( RenderContext& context );
+    void _frameDraw( RenderContext& context, const bool finish );
+    void _frameDrawFinish( const uint128_t& frameID,
+                           const uint32_t frameNumber );
+    void _frameViewStart( RenderContext& context );
+    void _frameViewFinish( RenderContext& context );
+
     /** Tile render loop. */
     void _frameTiles( RenderContext& context, const bool isLocal,
                       const uint128_t& queueID, const uint32_t tasks,
@@ -607,6 +618,12 @@ private:
     bool _asyncFinishReadback( const std::vector< size_t >& imagePos,
                                const Frames& frames );
 
+    std::vector< bool > _startProgressive( const uint128_t& frameID,
+                                           const Frames& frames );
+    void _finishProgressive( const std::vector< bool >& progressive,
+                             const std::vector< size_t >& imagePos,
+                             const Frames& frames );
+
     void _asyncTransmit( FrameDataPtr frame, const uint32_t frameNumber,
                          const uint64_t image,
                          const std::vector< uint128_t >& nodes,
@@ -623,6 +640,12 @@ private:
                     const std::vector< uint128_t >& nodes,
                     const co::NodeIDs& netNodes );
 
+    /** Skip the readback of a stale frame and signal the frames dropped. */
+    void _dropFrame( const Frames& frames );
+
+    /** @return true if an assembled input frame was dropped. */
+    bool _hasDroppedInput( const Frames& frames ) const;
+
     /** Get the channel's current input queue. */
     co::QueueSlave* _getQueue( const uint128_t& queueID );
 
@@ -649,6 +672,7 @@ private:
     bool _cmdFrameViewFinish( co::ICommand& command );
     bool _cmdStopFrame( co::ICommand& command );
     bool _cmdFrameTiles( co::ICommand& command );
+    bool _cmdFrameRepeat( co::ICommand& command );
     bool _cmdDeleteTransferContext( co::ICommand& command );
 
     LB_TS_VAR( _pipeThread );
@@ -20,6 +20,7 @@
 
 #include "commandQueue.h"
 #include "config.h"
+#include "hierarchicalBarrier.h"
 #include "node.h"
 #include "global.h"
 #include "init.h"
@@ -60,13 +61,15 @@ namespace detail
 class Client
 {
 public:
-    Client()
+    explicit Client( co::LocalNode& localNode )
         : queue( co::Global::getCommandQueueLimit( ))
+        , barrier( localNode )
         , modelUnit( EQ_UNDEFINED_UNIT )
         , running( false )
     {}
 
     CommandQueue queue; //!< The command->node command queue.
+    HierarchicalBarrier barrier; //!< Handles all hierarchical swap barriers
     Strings activeLayouts;
     ServerSet localServers;
     std::string gpuFilter;
@@ -82,7 +85,7 @@ typedef fabric::Client Super;
 
 Client::Client()
         : Super()
-        , _impl( new detail::Client )
+        , _impl( new detail::Client( *this ))
 {
     registerCommand( fabric::CMD_CLIENT_EXIT,
                      ClientFunc( this, &Client::_cmdExit ), &_impl->queue );
@@ -313,6 +316,11 @@ float Client::getModelUnit() const
     return _impl->modelUnit;
 }
 
+HierarchicalBarrier& Client::getHierarchicalBarrier()
+{
+    return _impl->barrier;
+}
+
 void Client::interruptMainThread()
 {
     send( fabric::CMD_CLIENT_INTERRUPT );
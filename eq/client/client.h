@@ -114,6 +114,9 @@ public:
     /** @internal @return the model unit for all views. */
     float getModelUnit() const;
 
+    /** @internal @return the handler of all hierarchical swap barriers. */
+    HierarchicalBarrier& getHierarchicalBarrier();
+
     /** Experimental: interrupt main thread queue @internal */
     void interruptMainThread();
 
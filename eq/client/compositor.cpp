@@ -19,6 +19,7 @@
 
 #include <lunchbox/perThread.h>
 
+#include "activePixels.h"
 #include "channel.h"
 #include "channelStatistics.h"
 #include "client.h"
@@ -33,17 +34,22 @@
 #include "server.h"
 #include "window.h"
 #include "windowSystem.h"
+#include "detail/tiledMerge.h"
 
 #include <eq/util/accum.h>
 #include <eq/util/frameBufferObject.h>
 #include <eq/util/objectManager.h>
 
 #include <co/global.h>
+#include <lunchbox/buffer.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/debug.h>
 #include <lunchbox/monitor.h>
 #include <lunchbox/os.h>
 #include <pression/plugins/compressor.h>
 
+#include <algorithm>
+
 #ifdef EQ_USE_PARACOMP
 #  include <pcapi.h>
 #endif
@@ -66,7 +72,15 @@ static const char* depthDBKey  = shaderDBKey + 2;
 // Image used for CPU-based assembly
 static lunchbox::PerThread< Image > _resultImage;
 
-static bool _useCPUAssembly( const Frames& frames, Channel* channel,
+// Buffers used for streaming CPU-based assembly
+static lunchbox::PerThread< lunchbox::Bufferb > _streamColor;
+static lunchbox::PerThread< lunchbox::Bufferb > _streamDepth;
+
+// Buffers used for CPU-based sub-pixel compositing
+static lunchbox::PerThread< lunchbox::Bufferb > _subPixelDest;
+static lunchbox::PerThread< lunchbox::Buffer< float > > _subPixelAccum;
+
+static bool _useCPUAssembly( const Frames& frames,
                              const bool blendAlpha = false )
 {
     // It doesn't make sense to use CPU-assembly for only one frame
@@ -76,16 +90,17 @@ static bool _useCPUAssembly( const Frames& frames, Channel* channel,
     // Test that at least two input frames have color and depth buffers or that
     // alpha-blended assembly is used with multiple RGBA buffers. We assume then
     // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly.
-    // Also test early for unsupport decomposition modes
+    // to merge the images on the CPU while waiting for the other frames.
+    // Also test early for unsupport decomposition modes. Sub-pixel steps are
+    // accumulated by the caller, one set of frames at a time.
     const uint32_t desiredBuffers = blendAlpha ? Frame::BUFFER_COLOR :
                                     Frame::BUFFER_COLOR | Frame::BUFFER_DEPTH;
+    const SubPixel& subpixel = frames.front()->getSubPixel();
     size_t nFrames = 0;
     for( Frames::const_iterator i = frames.begin(); i != frames.end(); ++i )
     {
         const Frame* frame = *i;
-        if( frame->getPixel() != Pixel::ALL ||
-            frame->getSubPixel() != SubPixel::ALL ||
+        if( frame->getSubPixel() != subpixel ||
             frame->getZoom() != Zoom::NONE ) // Not supported by CPU compositor
         {
             return false;
@@ -94,109 +109,375 @@ static bool _useCPUAssembly( const Frames& frames, Channel* channel,
         if( frame->getBuffers() == desiredBuffers )
             ++nFrames;
     }
-    if( nFrames < 2 )
+    return nFrames > 1;
+}
+
+struct Formats
+{
+    Formats() : colorInternal( 0 ), colorExternal( 0 )
+              , depthInternal( 0 ), depthExternal( 0 ) {}
+
+    uint32_t colorInternal;
+    uint32_t colorExternal;
+    uint32_t depthInternal;
+    uint32_t depthExternal;
+};
+
+// Test if the image can be merged by the CPU compositor, and that it uses the
+// same formats as the previously tested images.
+static bool _isCPUMergeable( const Image* image, const bool blendAlpha,
+                             Formats& formats )
+{
+    if( image->getStorageType() != Frame::TYPE_MEMORY ||
+        image->getZoom() != Zoom::NONE )
+    {
         return false;
+    }
 
-    // Now wait for all images to be ready and test if our assumption was
-    // correct, that there are enough images to make a CPU-based assembly
-    // worthwhile and all other preconditions for our CPU-based assembly code
-    // are true.
-    size_t   nImages        = 0;
-    uint32_t colorInternalFormat = 0;
-    uint32_t colorExternalFormat = 0;
-    uint32_t depthInternalFormat = 0;
-    uint32_t depthExternalFormat = 0;
-    const uint32_t timeout = channel->getConfig()->getTimeout();
+    const bool hasColor = image->hasPixelData( Frame::BUFFER_COLOR );
+    const bool hasDepth = image->hasPixelData( Frame::BUFFER_DEPTH );
 
+    if( // Not an alpha-blending compositing
+        ( !blendAlpha || !hasColor || !image->hasAlpha( )) &&
+        // and not a depth-sorting compositing
+        ( !hasColor || !hasDepth ))
+    {
+        return false;
+    }
+
+    if( formats.colorInternal == 0 && formats.colorExternal == 0 )
+    {
+        formats.colorInternal = image->getInternalFormat( Frame::BUFFER_COLOR );
+        formats.colorExternal = image->getExternalFormat( Frame::BUFFER_COLOR );
+
+        switch( formats.colorExternal )
+        {
+            case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
+            case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
+                if( !hasDepth )
+                    // blending of RGB10A2 not implemented
+                    return false;
+                break;
+
+            case EQ_COMPRESSOR_DATATYPE_RGBA:
+            case EQ_COMPRESSOR_DATATYPE_BGRA:
+                break;
+
+            default:
+                return false;
+        }
+    }
+    else if( formats.colorInternal !=
+             image->getInternalFormat( Frame::BUFFER_COLOR ) ||
+             formats.colorExternal !=
+             image->getExternalFormat( Frame::BUFFER_COLOR ))
+    {
+        return false;
+    }
+
+    if( !hasDepth )
+        return true;
+
+    if( formats.depthInternal == 0 && formats.depthExternal == 0 )
+    {
+        formats.depthInternal = image->getInternalFormat( Frame::BUFFER_DEPTH );
+        formats.depthExternal = image->getExternalFormat( Frame::BUFFER_DEPTH );
+
+        if( formats.depthExternal != EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+            return false;
+    }
+    else if( formats.depthInternal !=
+             image->getInternalFormat( Frame::BUFFER_DEPTH ) ||
+             formats.depthExternal !=
+             image->getExternalFormat( Frame::BUFFER_DEPTH ))
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool _isWaiting( const Frames& frames )
+{
     for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        if( !(*i)->isReady( ))
+            return true;
+    return false;
+}
+
+/**
+ * Merges input frames into a main memory buffer of the size of the destination
+ * as they become ready.
+ */
+class StreamMerger
+{
+public:
+    /** @param channel the destination channel, 0 to only merge() frames. */
+    StreamMerger( const Frames& frames, const PixelViewport& area,
+                  const bool blendAlpha, Channel* channel )
+        : _channel( channel )
+        , _blendAlpha( blendAlpha )
+        , _hasDepth( false )
+        , _area( 0, 0, area.w, area.h )
+        , _offset( area.x, area.y )
+        , _nMerged( 0 )
+        , _mergeTime( 0.f )
+        , _hiddenTime( 0.f )
     {
-        const Frame* frame = *i;
+        for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+            if( (*i)->getBuffers() & Frame::BUFFER_DEPTH )
+                _hasDepth = true;
+
+        // blending uses the alpha channel as transparency, start opaque
+        const uint8_t clear[4] = { 0, 0, 0, uint8_t( blendAlpha ? 255 : 0 ) };
+        memcpy( &_clearColor, clear, sizeof( _clearColor ));
+
+        if( !_streamColor )
+            _streamColor = new lunchbox::Bufferb;
+        _streamColor->resize( _area.getArea() * sizeof( uint32_t ));
+        if( _hasDepth )
         {
-            ChannelStatistics event( Statistic::CHANNEL_FRAME_WAIT_READY,
-                                     channel );
-            frame->waitReady( timeout );
+            if( !_streamDepth )
+                _streamDepth = new lunchbox::Bufferb;
+            _streamDepth->resize( _area.getArea() * sizeof( uint32_t ));
         }
+        _bounds.invalidate();
+    }
 
-        if( frame->getFrameData()->getZoom() != Zoom::NONE )
+    /**
+     * Merge or assemble one ready frame on the channel.
+     *
+     * @param frame the ready input frame.
+     * @param waiting the input frames not yet ready.
+     * @param last true if no other frame is left after the given one.
+     * @return the number of assembled subpixel steps (0 or 1).
+     */
+    uint32_t add( Frame* frame, const Frames& waiting, const bool last )
+    {
+        LBASSERT( _channel );
+        if( frame->getImages().empty( ))
+            return 0;
+
+        // nothing to overlap with: assemble the only frame directly
+        if( last && _nMerged == 0 )
+        {
+            Compositor::assembleFrame( frame, _channel );
+            return 1;
+        }
+
+        Formats formats = _formats;
+        PixelViewport bounds = _bounds;
+        if( !_isMergeable( frame, formats, bounds ))
+        {
+            // keep the order of alpha-blended frames
+            if( _blendAlpha )
+                flush();
+            Compositor::assembleFrame( frame, _channel );
+            return 1;
+        }
+
+        ChannelStatistics event( Statistic::CHANNEL_FRAME_MERGE, _channel );
+        lunchbox::Clock clock;
+        _merge( frame, formats, bounds );
+
+        // hidden if other frames were still in transit during the merge
+        const float time = clock.getTimef();
+        _mergeTime += time;
+        if( _isWaiting( waiting ))
+            _hiddenTime += time;
+        if( _mergeTime > 0.f )
+            event.event.data.statistic.ratio = _hiddenTime / _mergeTime;
+        return 1;
+    }
+
+    /**
+     * Merge one ready frame.
+     * @return false if the frame can't be merged on the CPU.
+     */
+    bool merge( Frame* frame )
+    {
+        Formats formats = _formats;
+        PixelViewport bounds = _bounds;
+        if( !_isMergeable( frame, formats, bounds ))
             return false;
 
-        const Images& images = frame->getImages();
-        for( Images::const_iterator j = images.begin();
-             j != images.end(); ++j )
+        _merge( frame, formats, bounds );
+        return true;
+    }
+
+    /** Assemble the frames merged so far on the channel. */
+    void flush()
+    {
+        LBASSERT( _channel );
+        const bool hasDepth = _formats.depthInternal != 0;
+        const Image* result = finish();
+        if( !result )
+            return;
+
+        Compositor::ImageOp operation;
+        operation.channel = _channel;
+        operation.buffers = Frame::BUFFER_COLOR;
+        if( hasDepth )
+            operation.buffers |= Frame::BUFFER_DEPTH;
+        Compositor::assembleImage( result, operation );
+    }
+
+    /**
+     * @return the image of the frames merged so far, 0 if nothing was merged.
+     *         Valid until the next use of the compositor in this thread.
+     */
+    const Image* finish()
+    {
+        if( _nMerged == 0 || !_bounds.hasArea( ))
         {
-            const Image* image = *j;
+            _reset();
+            return 0;
+        }
 
-            const bool hasColor = image->hasPixelData( Frame::BUFFER_COLOR );
-            const bool hasDepth = image->hasPixelData( Frame::BUFFER_DEPTH );
+        if( !_resultImage )
+            _resultImage = new Image;
+        Image* result = _resultImage.get();
+
+        PixelViewport pvp = _bounds;
+        pvp.x += _offset.x();
+        pvp.y += _offset.y();
+        result->setPixelViewport( pvp );
+
+        PixelData pixels;
+        pixels.internalFormat = _formats.colorInternal;
+        pixels.externalFormat = _formats.colorExternal;
+        pixels.pixelSize      = sizeof( uint32_t );
+        pixels.pvp            = pvp;
+        result->setPixelData( Frame::BUFFER_COLOR, pixels );
+        _copy( result->getPixelPointer( Frame::BUFFER_COLOR ),
+               _streamColor->getData( ));
+
+        if( _formats.depthInternal != 0 )
+        {
+            pixels.internalFormat = _formats.depthInternal;
+            pixels.externalFormat = _formats.depthExternal;
+            result->setPixelData( Frame::BUFFER_DEPTH, pixels );
+            _copy( result->getPixelPointer( Frame::BUFFER_DEPTH ),
+                   _streamDepth->getData( ));
+        }
 
-            if( // Not an alpha-blending compositing
-                ( !blendAlpha || !hasColor || !image->hasAlpha( )) &&
-                // and not a depth-sorting compositing
-                ( !hasColor || !hasDepth ))
-            {
-                return false;
-            }
+        _reset();
+        return result;
+    }
 
-            if( colorInternalFormat == 0 && colorExternalFormat == 0 )
-            {
-                colorInternalFormat =
-                    image->getInternalFormat( Frame::BUFFER_COLOR );
-                colorExternalFormat =
-                    image->getExternalFormat( Frame::BUFFER_COLOR );
+    float getMergeTime() const { return _mergeTime; }
+    float getHiddenTime() const { return _hiddenTime; }
 
-                switch( colorExternalFormat )
-                {
-                    case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
-                    case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-                        if( !hasDepth )
-                            // blending of RGB10A2 not implemented
-                            return false;
-                        break;
-
-                    case EQ_COMPRESSOR_DATATYPE_RGBA:
-                    case EQ_COMPRESSOR_DATATYPE_BGRA:
-                        break;
-
-                    default:
-                        return false;
-                }
+private:
+    Channel* const _channel;
+    const bool _blendAlpha;
+    bool _hasDepth;
+    uint32_t _clearColor;
 
-            }
-            else if( colorInternalFormat !=
-                     image->getInternalFormat( Frame::BUFFER_COLOR ) ||
-                     colorExternalFormat !=
-                     image->getExternalFormat( Frame::BUFFER_COLOR ))
+    const PixelViewport _area; //!< The size of the merge buffers
+    const Vector2i _offset; //!< The position of the merge buffers
+    PixelViewport _bounds; //!< The initialized area of the merge buffers
+    Formats _formats;
+    size_t _nMerged;
+
+    float _mergeTime;
+    float _hiddenTime;
+
+    void _reset()
+    {
+        _nMerged = 0;
+        _formats = Formats();
+        _bounds.invalidate();
+    }
+
+    /** Check the images of a frame and extend the formats and bounds. */
+    bool _isMergeable( const Frame* frame, Formats& formats,
+                       PixelViewport& bounds ) const
+    {
+        if( frame->getFrameData()->getZoom() != Zoom::NONE )
+            return false;
+
+        const Images& images = frame->getImages();
+        for( ImagesCIter i = images.begin(); i != images.end(); ++i )
+        {
+            const Image* image = *i;
+            if( !_isCPUMergeable( image, _blendAlpha, formats ) ||
+                ( !_hasDepth && image->hasPixelData( Frame::BUFFER_DEPTH )))
             {
                 return false;
             }
-            if( hasDepth )
+
+            PixelViewport pvp = detail::getMergePVP( frame, image );
+            pvp.x -= _offset.x();
+            pvp.y -= _offset.y();
+            pvp.intersect( _area );
+            bounds.merge( pvp );
+        }
+        return true;
+    }
+
+    void _merge( Frame* frame, const Formats& formats,
+                 const PixelViewport& bounds )
+    {
+        _formats = formats;
+        _grow( bounds );
+
+        PixelViewport dest = _area;
+        dest.x = _offset.x();
+        dest.y = _offset.y();
+        detail::mergeFramesTiled( Frames( 1, frame ), _blendAlpha,
+                                  _streamColor->getData(),
+                                  _hasDepth ? _streamDepth->getData() : 0,
+                                  dest );
+        ++_nMerged;
+    }
+
+    /** Initialize the part of the new bounds not covered by the old ones. */
+    void _grow( const PixelViewport& bounds )
+    {
+        for( int32_t y = bounds.y; y < bounds.getYEnd(); ++y )
+        {
+            if( !_bounds.hasArea() || y < _bounds.y || y >= _bounds.getYEnd( ))
+                _clear( bounds.x, y, bounds.w );
+            else
             {
-                if( depthInternalFormat == 0 && depthExternalFormat == 0 )
-                {
-                    depthInternalFormat =
-                        image->getInternalFormat( Frame::BUFFER_DEPTH );
-                    depthExternalFormat =
-                        image->getExternalFormat( Frame::BUFFER_DEPTH );
-
-                    if( depthExternalFormat !=
-                        EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
-                    {
-                        return false;
-                    }
-                }
-                else if( depthInternalFormat !=
-                         image->getInternalFormat(Frame::BUFFER_DEPTH ) ||
-                         depthExternalFormat !=
-                         image->getExternalFormat(  Frame::BUFFER_DEPTH ))
-                {
-                    return false;
-                }
+                _clear( bounds.x, y, _bounds.x - bounds.x );
+                _clear( _bounds.getXEnd(), y,
+                        bounds.getXEnd() - _bounds.getXEnd( ));
             }
-            ++nImages;
         }
+        _bounds = bounds;
     }
-    return (nImages > 1);
-}
+
+    void _clear( const int32_t x, const int32_t y, const int32_t w )
+    {
+        if( w <= 0 )
+            return;
+
+        const size_t skip = size_t( y ) * _area.w + x;
+        uint32_t* color = reinterpret_cast< uint32_t* >(
+            _streamColor->getData( )) + skip;
+        std::fill( color, color + w, _clearColor );
+        if( !_hasDepth )
+            return;
+
+        uint32_t* depth = reinterpret_cast< uint32_t* >(
+            _streamDepth->getData( )) + skip;
+        std::fill( depth, depth + w, 0xffffffffu );
+    }
+
+    /** Copy the bounds of a merge buffer into a result buffer. */
+    void _copy( uint8_t* to, const uint8_t* from ) const
+    {
+        const size_t rowSize = _bounds.w * sizeof( uint32_t );
+        for( int32_t y = _bounds.y; y < _bounds.getYEnd(); ++y )
+        {
+            const size_t skip = ( size_t( y ) * _area.w + _bounds.x ) *
+                                sizeof( uint32_t );
+            memcpy( to, from + skip, rowSize );
+            to += rowSize;
+        }
+    }
+};
 }
 
 uint32_t Compositor::assembleFrames( const Frames& frames,
@@ -205,8 +486,8 @@ uint32_t Compositor::assembleFrames( const Frames& frames,
     if( frames.empty( ))
         return 0;
 
-    if( _useCPUAssembly( frames, channel ))
-        return assembleFramesCPU( frames, channel );
+    if( _useCPUAssembly( frames ))
+        return assembleFramesCPUStreaming( frames, channel );
 
     // else
     return assembleFramesUnsorted( frames, channel, accum );
@@ -279,8 +560,8 @@ uint32_t Compositor::assembleFramesSorted( const Frames& frames,
     }
 
     uint32_t count = 0;
-    if( _useCPUAssembly( frames, channel, blendAlpha ))
-        count |= assembleFramesCPU( frames, channel, blendAlpha );
+    if( _useCPUAssembly( frames, blendAlpha ))
+        count |= assembleFramesCPUStreaming( frames, channel, blendAlpha );
     else
     {
         const uint32_t timeout = channel->getConfig()->getTimeout();
@@ -291,6 +572,8 @@ uint32_t Compositor::assembleFramesSorted( const Frames& frames,
             {
                 ChannelStatistics event( Statistic::CHANNEL_FRAME_WAIT_READY,
                                          channel );
+                event.event.data.statistic.frameData =
+                    uint32_t( frame->getFrameData()->getID().low( ));
                 frame->waitReady( timeout );
             }
 
@@ -490,6 +773,8 @@ Frame* Compositor::waitFrame( WaitHandle* handle )
 
         frame->removeListener( handle->monitor );
         handle->left.erase( i );
+        event.event.data.statistic.frameData =
+            uint32_t( frame->getFrameData()->getID().low( ));
         return frame;
     }
 
@@ -505,8 +790,8 @@ uint32_t Compositor::assembleFramesCPU( const Frames& frames, Channel* channel,
         return 0;
 
     LBVERB << "Sorted CPU assembly" << std::endl;
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not yet support Pixel or Eye
+    // Assembles images from DB, 2D, pixel and sub-pixel compounds using the
+    // CPU and then assembles the result image. Does not yet support Eye
     // compounds.
 
     const Image* result = mergeFramesCPU( frames, blendAlpha,
@@ -530,6 +815,71 @@ uint32_t Compositor::assembleFramesCPU( const Frames& frames, Channel* channel,
     return 1;
 }
 
+uint32_t Compositor::assembleFramesCPUStreaming( const Frames& frames,
+                                                 Channel* channel,
+                                                 const bool blendAlpha )
+{
+    if( frames.empty( ))
+        return 0;
+
+    LBVERB << "Streaming CPU assembly" << std::endl;
+    // Merges the images of each frame on the CPU as soon as the frame is
+    // ready, hiding the merge behind the wait for the remaining frames.
+    // Alpha-blended frames are merged in the given order, the other ones in
+    // the order they become available.
+
+    const PixelViewport& pvp = channel->getPixelViewport();
+    StreamMerger merger( frames, PixelViewport( 0, 0, pvp.w, pvp.h ),
+                         blendAlpha, channel );
+    Frames ready( frames.size(), 0 ); // blended frames ready out of order
+    size_t next = 0; // the next blended frame to merge
+    size_t nLeft = frames.size();
+    uint32_t count = 0;
+
+    WaitHandle* handle = startWaitFrames( frames, channel );
+    for( Frame* frame = waitFrame( handle ); frame; frame = waitFrame( handle ))
+    {
+        if( !blendAlpha )
+        {
+            count |= merger.add( frame, handle->left, --nLeft == 0 );
+            continue;
+        }
+
+        const size_t index = std::find( frames.begin(), frames.end(),
+                                        frame ) - frames.begin();
+        ready[ index ] = frame;
+        for( ; next < ready.size() && ready[ next ]; ++next )
+            count |= merger.add( ready[ next ], handle->left, --nLeft == 0 );
+    }
+    merger.flush();
+
+    LBVERB << "Merged frames in " << merger.getMergeTime() << " ms, "
+           << merger.getHiddenTime() << " ms hidden by frame transmission"
+           << std::endl;
+    return count;
+}
+
+const Image* Compositor::mergeFramesCPUStreaming( const Frames& frames,
+                                                  const PixelViewport& pvp,
+                                                  const bool blendAlpha,
+                                                  const uint32_t timeout )
+{
+    StreamMerger merger( frames, pvp, blendAlpha, 0 );
+    for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+    {
+        Frame* frame = *i;
+        frame->waitReady( timeout );
+        if( !merger.merge( frame ))
+        {
+            LBWARN << "Can't merge frame " << frame->getName()
+                   << " on the CPU" << std::endl;
+            merger.finish();
+            return 0;
+        }
+    }
+    return merger.finish();
+}
+
 const Image* Compositor::mergeFramesCPU( const Frames& frames,
                                          const bool blendAlpha,
                                          const uint32_t timeout )
@@ -586,9 +936,14 @@ const Image* Compositor::mergeFramesCPU( const Frames& frames,
     }
 
     // assembly
-    _mergeFrames( frames, blendAlpha,
-                  result->getPixelPointer( Frame::BUFFER_COLOR ),
-                  destDepth, destPVP );
+    if( _isSubPixelDecomposition( frames ))
+        _mergeSubPixelFrames( frames, blendAlpha,
+                              result->getPixelPointer( Frame::BUFFER_COLOR ),
+                              colorPixelSize, destDepth, destPVP );
+    else
+        _mergeFrames( frames, blendAlpha,
+                      result->getPixelPointer( Frame::BUFFER_COLOR ),
+                      destDepth, destPVP );
     return result;
 }
 
@@ -604,13 +959,9 @@ bool Compositor::_collectOutputData(
         Frame* frame = *i;
         frame->waitReady( timeout );
 
-        LBASSERTINFO( frame->getPixel() == Pixel::ALL &&
-                      frame->getSubPixel() == SubPixel::ALL &&
-                      frame->getFrameData()->getZoom() == Zoom::NONE &&
+        LBASSERTINFO( frame->getFrameData()->getZoom() == Zoom::NONE &&
                       frame->getZoom() == Zoom::NONE,
                       "CPU-based compositing not implemented for given frames");
-        if( frame->getPixel() != Pixel::ALL )
-            return false;
 
         const Images& images = frame->getImages();
         for( Images::const_iterator j = images.begin(); j != images.end(); ++j )
@@ -623,7 +974,7 @@ bool Compositor::_collectOutputData(
             if( !image->hasPixelData( Frame::BUFFER_COLOR ))
                 continue;
 
-            destPVP.merge( image->getPixelViewport() + frame->getOffset( ));
+            destPVP.merge( detail::getMergePVP( frame, image ));
 
             _collectOutputData( image->getPixelData( Frame::BUFFER_COLOR ),
                                 colorInternalFormat, colorPixelSize,
@@ -644,7 +995,21 @@ bool Compositor::_collectOutputData(
         return false;
     }
 
-    return true;
+    if( !_isSubPixelDecomposition( frames ))
+        return true;
+
+    switch( colorExternalFormat )
+    {
+        case EQ_COMPRESSOR_DATATYPE_RGBA:
+        case EQ_COMPRESSOR_DATATYPE_BGRA:
+        case EQ_COMPRESSOR_DATATYPE_RGB:
+        case EQ_COMPRESSOR_DATATYPE_BGR:
+            return true;
+        default:
+            LBWARN << "Sub-pixel CPU compositing not implemented for color "
+                   << "format " << colorExternalFormat << std::endl;
+            return false;
+    }
 }
 
 void Compositor::_collectOutputData( const PixelData& pixelData,
@@ -739,14 +1104,90 @@ bool Compositor::mergeFramesCPU( const Frames& frames,
     }
 
     // assembly
-    _mergeFrames( frames, blendAlpha, colorBuffer, depthBuffer, outPVP );
+    if( _isSubPixelDecomposition( frames ))
+        _mergeSubPixelFrames( frames, blendAlpha, colorBuffer, colorPixelSize,
+                              depthBuffer, outPVP );
+    else
+        _mergeFrames( frames, blendAlpha, colorBuffer, depthBuffer, outPVP );
     return true;
 }
 
+void Compositor::_mergeSubPixelFrames( const Frames& frames,
+                                       const bool blendAlpha,
+                                       void* colorBuffer,
+                                       const uint32_t colorPixelSize,
+                                       void* depthBuffer,
+                                       const PixelViewport& destPVP )
+{
+    const size_t colorSize = destPVP.getArea() * colorPixelSize;
+    const size_t depthSize = depthBuffer ? destPVP.getArea() * 4 : 0;
+
+    // Each step is merged into the initial destination and accumulated
+    if( !_subPixelDest )
+        _subPixelDest = new lunchbox::Bufferb;
+    lunchbox::Bufferb& initial = *_subPixelDest;
+    initial.replace( colorBuffer, colorSize );
+    if( depthBuffer )
+        initial.append( reinterpret_cast< const uint8_t* >( depthBuffer ),
+                        depthSize );
+
+    if( !_subPixelAccum )
+        _subPixelAccum = new lunchbox::Buffer< float >;
+    lunchbox::Buffer< float >& accum = *_subPixelAccum;
+    accum.resize( colorSize );
+    lunchbox::setZero( accum.getData(), colorSize * sizeof( float ));
+
+    size_t nSteps = 0;
+    Frames framesLeft = frames;
+    while( !framesLeft.empty( ))
+    {
+        const Frames current = _extractOneSubPixel( framesLeft );
+        bool hasImages = false;
+        for( FramesCIter i = current.begin(); i != current.end(); ++i )
+            if( !(*i)->getImages().empty( ))
+                hasImages = true;
+        if( !hasImages )
+            continue;
+
+        if( nSteps > 0 )
+        {
+            memcpy( colorBuffer, initial.getData(), colorSize );
+            if( depthBuffer )
+                memcpy( depthBuffer, initial.getData() + colorSize, depthSize );
+        }
+
+        _mergeFrames( current, blendAlpha, colorBuffer, depthBuffer, destPVP );
+        detail::accumulate( colorBuffer, colorSize, accum.getData( ));
+        ++nSteps;
+    }
+
+    if( nSteps > 1 )
+        detail::average( accum.getData(), colorSize, nSteps, colorBuffer );
+}
+
 void Compositor::_mergeFrames( const Frames& frames, const bool blendAlpha,
                                void* colorBuffer, void* depthBuffer,
                                const PixelViewport& destPVP )
 {
+    bool pixelDecomposition = false;
+    for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        if( (*i)->getPixel() != Pixel::ALL )
+            pixelDecomposition = true;
+
+#ifdef EQ_USE_PARACOMP
+    // pixel decompositions are only implemented by the tiled merge
+    if( pixelDecomposition )
+#else
+    // EQ_COMPOSITOR_UNTILED selects the per-image merge, e.g., for benchmarks
+    static const bool untiled = getenv( "EQ_COMPOSITOR_UNTILED" ) != 0;
+    if( pixelDecomposition || !untiled )
+#endif
+    {
+        detail::mergeFramesTiled( frames, blendAlpha, colorBuffer, depthBuffer,
+                                  destPVP );
+        return;
+    }
+
     for( Frames::const_iterator i = frames.begin(); i != frames.end(); ++i)
     {
         const Frame* frame = *i;
@@ -799,6 +1240,12 @@ void Compositor::_mergeDBImage( void* destColor, void* destDepth,
     const int32_t         destX  = offset.x() + pvp.x - destPVP.x;
     const int32_t         destY  = offset.y() + pvp.y - destPVP.y;
 
+    if( image->hasActivePixels( ))
+    {
+        _mergeActiveDBImage( destC, destD, destPVP, image, destX, destY );
+        return;
+    }
+
     const uint32_t* color = reinterpret_cast< const uint32_t* >
         ( image->getPixelPointer( Frame::BUFFER_COLOR ));
     const uint32_t* depth = reinterpret_cast< const uint32_t* >
@@ -829,6 +1276,65 @@ void Compositor::_mergeDBImage( void* destColor, void* destDepth,
     }
 }
 
+void Compositor::_mergeActiveDBImage( uint32_t* destColor,
+                                      uint32_t* destDepth,
+                                      const PixelViewport& destPVP,
+                                      const Image* image,
+                                      const int32_t destX, const int32_t destY )
+{
+    LBVERB << "CPU-DB assembly of active pixels" << std::endl;
+
+    // Only the active pixels are visited, inactive pixels are on the far plane
+    // and never pass the depth test. Packed images are read in place.
+    const ActivePixels& activePixels = image->getActivePixels();
+    const PixelViewport& pvp = image->getPixelViewport();
+    LBASSERT( activePixels.getWidth() == uint32_t( pvp.w ));
+    LBASSERT( activePixels.getHeight() == uint32_t( pvp.h ));
+
+    const bool packedColor = image->hasPackedPixelData( Frame::BUFFER_COLOR );
+    const bool packedDepth = image->hasPackedPixelData( Frame::BUFFER_DEPTH );
+    const uint32_t* color = reinterpret_cast< const uint32_t* >( packedColor ?
+        image->getPackedPixelPointer( Frame::BUFFER_COLOR ) :
+        image->getPixelPointer( Frame::BUFFER_COLOR ));
+    const uint32_t* depth = reinterpret_cast< const uint32_t* >( packedDepth ?
+        image->getPackedPixelPointer( Frame::BUFFER_DEPTH ) :
+        image->getPixelPointer( Frame::BUFFER_DEPTH ));
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        const uint32_t skip =  (destY + y) * destPVP.w + destX;
+        const uint64_t packed = activePixels.getPackedOffset( y );
+        const uint32_t* colorIt = color + ( packedColor ? packed : y * pvp.w );
+        const uint32_t* depthIt = depth + ( packedDepth ? packed : y * pvp.w );
+
+        for( const ActivePixels::Run* run = activePixels.getRunsBegin( y );
+             run != activePixels.getRunsEnd( y ); ++run )
+        {
+            uint32_t* destColorIt = destColor + skip + run->start;
+            uint32_t* destDepthIt = destDepth + skip + run->start;
+            const uint32_t* colorRun = packedColor ? colorIt :
+                                                     colorIt + run->start;
+            const uint32_t* depthRun = packedDepth ? depthIt :
+                                                     depthIt + run->start;
+
+            for( uint32_t x = 0; x < run->length; ++x )
+            {
+                if( destDepthIt[x] > depthRun[x] )
+                {
+                    destColorIt[x] = colorRun[x];
+                    destDepthIt[x] = depthRun[x];
+                }
+            }
+
+            if( packedColor )
+                colorIt += run->length;
+            if( packedDepth )
+                depthIt += run->length;
+        }
+    }
+}
+
 void Compositor::_merge2DImage( void* destColor, void* destDepth,
                                 const eq::PixelViewport& destPVP,
                                 const Image* image,
@@ -1084,7 +1590,7 @@ void Compositor::assembleFrame( const Frame* frame, Channel* channel )
         const Image* image = *i;
         ImageOp op = operation;
         op.zoom.apply( image->getZoom() );
-        op.zoomFilter = (operation.zoom == Zoom::NONE) ?
+        op.zoomFilter = (op.zoom == Zoom::NONE) ?
                                         FILTER_NEAREST : frame->getZoomFilter();
         assembleImage( image, op );
     }
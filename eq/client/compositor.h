@@ -116,6 +116,10 @@ namespace eq
          * glBlendFunc( GL_ONE, GL_SRC_ALPHA )
          * into the current framebuffer.
          *
+         * Pixel-decomposed images are de-interleaved into the intermediate
+         * image. The steps of a sub-pixel decomposition are merged separately
+         * and averaged, which is only implemented for 8 bit color channels.
+         *
          * @param frames the frames to assemble.
          * @param channel the destination channel.
          * @param blendAlpha blend color-only images if they have an alpha
@@ -127,13 +131,61 @@ namespace eq
                                            Channel* channel,
                                            const bool blendAlpha = false );
 
+        /**
+         * Merge the frames using the CPU as they become available before
+         * assembling the result on the given channel.
+         *
+         * Used by assembleFrames() and assembleFramesSorted() for CPU-based
+         * compositing. The images of a frame are merged as soon as the frame
+         * is ready, overlapping the merge with the wait for the remaining
+         * frames. Alpha-blended frames are merged in the given order, see
+         * assembleFramesCPU(). Frames which can't be merged on the CPU are
+         * assembled directly on the channel.
+         *
+         * Each merge is sampled as Statistic::CHANNEL_FRAME_MERGE, with the
+         * ratio of the merge time hidden behind the wait for input frames.
+         *
+         * @param frames the frames to assemble.
+         * @param channel the destination channel.
+         * @param blendAlpha blend color-only images if they have an alpha
+         *                   channel
+         * @return the number of different subpixel steps assembled (0 or 1).
+         * @version 1.8
+         */
+        static uint32_t assembleFramesCPUStreaming( const Frames& frames,
+                                                    Channel* channel,
+                                                 const bool blendAlpha = false );
+
+        /**
+         * Merge the provided frames one after another into one image in main
+         * memory, like assembleFramesCPUStreaming().
+         *
+         * The returned image has the area covered by the input images within
+         * the given pixel viewport. It does not have to be freed and is valid
+         * until the next usage of the compositor in the current thread.
+         *
+         * @param frames the frames to merge, in the order to wait for them.
+         * @param pvp the destination area to merge.
+         * @param blendAlpha blend color-only images if they have an alpha
+         *                   channel
+         * @param timeout the timeout to wait for each frame.
+         * @return the merged image, or 0 if nothing was merged or a frame
+         *         can't be merged on the CPU.
+         * @version 1.8
+         */
+        static const Image* mergeFramesCPUStreaming( const Frames& frames,
+                                                     const PixelViewport& pvp,
+                                                  const bool blendAlpha = false,
+                               const uint32_t timeout = LB_TIMEOUT_INDEFINITE );
+
         /**
          * Merge the provided frames in the given order into one image in main
          * memory.
          *
          * The returned image does not have to be freed. The compositor
          * maintains one image per thread, that is, the returned image is valid
-         * until the next usage of the compositor in the current thread.
+         * until the next usage of the compositor in the current thread. Pixel
+         * and sub-pixel decompositions are handled as in assembleFramesCPU().
          *
          * @version 1.0
          */
@@ -290,6 +342,13 @@ namespace eq
                                         uint32_t& pixelSize,
                                         uint32_t& externalFormat );
 
+        static void _mergeSubPixelFrames( const Frames& frames,
+                                          const bool blendAlpha,
+                                          void* colorBuffer,
+                                          const uint32_t colorPixelSize,
+                                          void* depthBuffer,
+                                          const PixelViewport& destPVP );
+
         static void _mergeFrames( const Frames& frames,
                                   const bool blendAlpha,
                                   void* colorBuffer, void* depthBuffer,
@@ -300,6 +359,13 @@ namespace eq
                                    const Image* image,
                                    const Vector2i& offset );
 
+        static void _mergeActiveDBImage( uint32_t* destColor,
+                                         uint32_t* destDepth,
+                                         const PixelViewport& destPVP,
+                                         const Image* image,
+                                         const int32_t destX,
+                                         const int32_t destY );
+
         static void _merge2DImage( void* destColor, void* destDepth,
                                    const PixelViewport& destPVP,
                                    const Image* input,
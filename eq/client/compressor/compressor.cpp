@@ -126,7 +126,7 @@ void EqCompressorCompress( void* const ptr, const unsigned /*name*/,
 
     eq::plugin::Compressor* compressor =
         reinterpret_cast< eq::plugin::Compressor* >( ptr );
-    compressor->compress( in, nPixels, useAlpha );
+    compressor->compress2D( in, nPixels, inDims[1], useAlpha );
 }
 
 unsigned EqCompressorGetNumResults( void* const ptr,
@@ -73,6 +73,23 @@ namespace plugin
                                const eq_uint64_t nPixels LB_UNUSED,
                                const bool useAlpha LB_UNUSED ) { LBDONTCALL; }
 
+        /**
+         * Compress two-dimensional data.
+         *
+         * The default implementation ignores the row width and calls
+         * compress().
+         *
+         * @param inData data to compress.
+         * @param nPixels number data to compress.
+         * @param width the number of pixels per row.
+         * @param useAlpha use alpha channel in compression.
+         */
+        virtual void compress2D( const void* const inData,
+                                 const eq_uint64_t nPixels,
+                                 const eq_uint64_t width LB_UNUSED,
+                                 const bool useAlpha )
+            { compress( inData, nPixels, useAlpha ); }
+
         typedef lunchbox::Bufferb Result;
         typedef std::vector< Result* > Results;
 
@@ -0,0 +1,345 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorDepth.h"
+
+#include <lunchbox/debug.h>
+#include <lunchbox/log.h>
+#include <lunchbox/omp.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+static const uint32_t _far = 0xffffffffu; //!< Depth value of the far plane
+static const uint8_t _farTag = 0xff; //!< Block tag of a far plane run
+static const unsigned _blockSize = 16; //!< Residuals per bit-packed block
+static const uint64_t _minRun = 16; //!< Minimum length of a far plane run
+static const uint64_t _minBandRows = 16; //!< Minimum rows per parallel band
+
+/** The header of each result, i.e., of one band of rows. */
+struct Header
+{
+    uint64_t firstPixel; //!< The index of the first pixel of the band
+    uint64_t nPixels; //!< The number of pixels in the band
+    uint32_t width; //!< The row width used for prediction
+    uint32_t padding;
+};
+
+static void _getInfo( EqCompressorInfo* const info )
+{
+    info->version      = EQ_COMPRESSOR_VERSION;
+    info->name         = EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT;
+    info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;
+    info->tokenType    = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->quality      = 1.0f;
+    info->ratio        = 0.3f;
+    info->speed        = 0.8f;
+}
+
+static bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions( EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT,
+                               _getInfo, CompressorDepth::getNewCompressor,
+                               CompressorDepth::getNewDecompressor,
+                               CompressorDepth::decompress,
+                               CompressorDepth::isCompatible ));
+    return true;
+}
+
+static bool _initialized LB_UNUSED = _register();
+
+/**
+ * Plane prediction from the already processed neighbors. Band-local, i.e.,
+ * the first row of a band only uses its left neighbor.
+ */
+inline uint32_t _predict( const uint32_t* pixels, const uint64_t i,
+                          const uint64_t x, const uint64_t width )
+{
+    if( i < width )
+        return x == 0 ? 0 : pixels[ i - 1 ];
+    if( x == 0 )
+        return pixels[ i - width ];
+    return pixels[ i - 1 ] + pixels[ i - width ] - pixels[ i - width - 1 ];
+}
+
+inline uint32_t _zigzag( const uint32_t delta )
+{
+    return ( delta << 1 ) ^ uint32_t( int32_t( delta ) >> 31 );
+}
+
+inline uint32_t _unzigzag( const uint32_t value )
+{
+    return ( value >> 1 ) ^ ( 0u - ( value & 1u ));
+}
+
+inline unsigned _getNumBits( uint32_t value )
+{
+    unsigned nBits = 0;
+    while( value )
+    {
+        ++nBits;
+        value >>= 1;
+    }
+    return nBits;
+}
+
+uint8_t* _pack( const uint32_t* values, const unsigned n, const unsigned nBits,
+                uint8_t* out )
+{
+    if( nBits == 0 )
+        return out;
+
+    uint64_t bits = 0;
+    unsigned nFilled = 0;
+    for( unsigned i = 0; i < n; ++i )
+    {
+        bits |= uint64_t( values[i] ) << nFilled;
+        nFilled += nBits;
+        while( nFilled >= 8 )
+        {
+            *out++ = uint8_t( bits );
+            bits >>= 8;
+            nFilled -= 8;
+        }
+    }
+    if( nFilled > 0 )
+        *out++ = uint8_t( bits );
+    return out;
+}
+
+const uint8_t* _unpack( const uint8_t* in, const unsigned n,
+                        const unsigned nBits, uint32_t* values )
+{
+    if( nBits == 0 )
+    {
+        std::fill( values, values + n, 0u );
+        return in;
+    }
+
+    const uint64_t mask = ( uint64_t( 1 ) << nBits ) - 1;
+    uint64_t bits = 0;
+    unsigned nFilled = 0;
+    for( unsigned i = 0; i < n; ++i )
+    {
+        while( nFilled < nBits )
+        {
+            bits |= uint64_t( *in++ ) << nFilled;
+            nFilled += 8;
+        }
+        values[i] = uint32_t( bits & mask );
+        bits >>= nBits;
+        nFilled -= nBits;
+    }
+    return in;
+}
+
+void _compressBand( const uint32_t* in, const uint64_t firstPixel,
+                    const uint64_t nPixels, const uint64_t width,
+                    Compressor::Result& result )
+{
+    // worst case: one tag and full residuals per block
+    const uint64_t nBlocks = nPixels / _blockSize + 2;
+    result.reserve( sizeof( Header ) + nBlocks * ( 1 + _blockSize * 4 ));
+
+    const Header header = { firstPixel, nPixels, uint32_t( width ), 0 };
+    uint8_t* out = result.getData();
+    ::memcpy( out, &header, sizeof( header ));
+    out += sizeof( header );
+
+    uint64_t i = 0;
+    uint64_t x = 0;
+    while( i < nPixels )
+    {
+        if( in[i] == _far )
+        {
+            uint64_t end = i + 1;
+            while( end < nPixels && in[end] == _far )
+                ++end;
+
+            const uint64_t length = end - i;
+            if( length >= _minRun )
+            {
+                const uint32_t run = uint32_t( length );
+                LBASSERT( run == length );
+                *out++ = _farTag;
+                ::memcpy( out, &run, sizeof( run ));
+                out += sizeof( run );
+
+                i = end;
+                x = ( x + length ) % width;
+                continue;
+            }
+        }
+
+        const unsigned n = unsigned( std::min( uint64_t( _blockSize ),
+                                               nPixels - i ));
+        uint32_t residuals[ _blockSize ];
+        uint32_t all = 0;
+        for( unsigned j = 0; j < n; ++j, ++i )
+        {
+            residuals[j] = _zigzag( in[i] - _predict( in, i, x, width ));
+            all |= residuals[j];
+            if( ++x == width )
+                x = 0;
+        }
+
+        const unsigned nBits = _getNumBits( all );
+        *out++ = uint8_t( nBits );
+        out = _pack( residuals, n, nBits, out );
+    }
+
+    result.setSize( out - result.getData( ));
+}
+
+void _decompressBand( const uint8_t* in, const uint64_t size, uint32_t* out,
+                      const uint64_t maxPixels )
+{
+    if( size < sizeof( Header ))
+    {
+        LBWARN << "Depth compressor band too small: " << size << std::endl;
+        return;
+    }
+
+    Header header;
+    ::memcpy( &header, in, sizeof( header ));
+    const uint8_t* const inEnd = in + size;
+    in += sizeof( header );
+
+    if( header.nPixels > maxPixels ||
+        header.firstPixel > maxPixels - header.nPixels || header.width == 0 )
+    {
+        LBWARN << "Corrupt depth compressor band of " << header.nPixels
+               << " pixels at " << header.firstPixel << ", width "
+               << header.width << " for " << maxPixels << " pixels"
+               << std::endl;
+        return;
+    }
+
+    out += header.firstPixel;
+    const uint64_t nPixels = header.nPixels;
+    const uint64_t width = header.width;
+
+    uint64_t i = 0;
+    uint64_t x = 0;
+    while( i < nPixels )
+    {
+        if( in >= inEnd )
+            break;
+
+        const uint8_t tag = *in++;
+        if( tag == _farTag )
+        {
+            uint32_t run;
+            if( uint64_t( inEnd - in ) < sizeof( run ))
+                break;
+            ::memcpy( &run, in, sizeof( run ));
+            in += sizeof( run );
+
+            if( run > nPixels - i )
+                break;
+            std::fill( out + i, out + i + run, _far );
+            i += run;
+            x = ( x + run ) % width;
+            continue;
+        }
+
+        const unsigned n = unsigned( std::min( uint64_t( _blockSize ),
+                                               nPixels - i ));
+        if( tag > 32 || uint64_t( inEnd - in ) < ( n * tag + 7 ) / 8 )
+            break;
+
+        uint32_t residuals[ _blockSize ];
+        in = _unpack( in, n, tag, residuals );
+
+        for( unsigned j = 0; j < n; ++j, ++i )
+        {
+            out[i] = _predict( out, i, x, width ) + _unzigzag( residuals[j] );
+            if( ++x == width )
+                x = 0;
+        }
+    }
+
+    if( i < nPixels )
+        LBWARN << "Corrupt depth compressor data at pixel " << i << " of "
+               << nPixels << std::endl;
+}
+}
+
+CompressorDepth::CompressorDepth()
+    : Compressor()
+{}
+
+CompressorDepth::~CompressorDepth()
+{}
+
+void CompressorDepth::compress( const void* const inData,
+                                const eq_uint64_t nPixels, const bool useAlpha )
+{
+    compress2D( inData, nPixels, nPixels, useAlpha );
+}
+
+void CompressorDepth::compress2D( const void* const inData,
+                                  const eq_uint64_t nPixels,
+                                  const eq_uint64_t width,
+                                  const bool /*useAlpha*/ )
+{
+    LBASSERT( width > 0 );
+    const uint64_t nRows = ( nPixels + width - 1 ) / width;
+    const uint64_t maxBands = std::max( uint64_t( 1 ), nRows / _minBandRows );
+    const uint64_t nBands = std::min( uint64_t( lunchbox::OMP::getNThreads( )),
+                                      maxBands );
+    const uint64_t bandRows = ( nRows + nBands - 1 ) / nBands;
+
+    while( _results.size() < nBands )
+        _results.push_back( new Result );
+    _nResults = unsigned( nBands );
+
+    const uint32_t* in = reinterpret_cast< const uint32_t* >( inData );
+#pragma omp parallel for
+    for( int64_t i = 0; i < int64_t( nBands ); ++i )
+    {
+        const uint64_t first = std::min( uint64_t( i ) * bandRows * width,
+                                         nPixels );
+        const uint64_t end = std::min( first + bandRows * width, nPixels );
+        _compressBand( in + first, first, end - first, width, *_results[i] );
+    }
+}
+
+void CompressorDepth::decompress( const void* const* inData,
+                                  const eq_uint64_t* const inSizes,
+                                  const unsigned numInputs,
+                                  void* const outData,
+                                  const eq_uint64_t nPixels,
+                                  const bool /*useAlpha*/ )
+{
+    uint32_t* out = reinterpret_cast< uint32_t* >( outData );
+
+#pragma omp parallel for
+    for( int i = 0; i < int( numInputs ); ++i )
+        _decompressBand( reinterpret_cast< const uint8_t* >( inData[i] ),
+                         inSizes[i], out, nPixels );
+}
+
+}
+}
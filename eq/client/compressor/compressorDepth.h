@@ -0,0 +1,69 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORDEPTH
+#define EQ_PLUGIN_COMPRESSORDEPTH
+
+#include "compressor.h"
+
+/**
+ * The name of the built-in depth compressor. Taken from the range of private
+ * names, which are not registered with the plugin name registry.
+ */
+#define EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT 0xeffffe01u
+
+namespace eq
+{
+namespace plugin
+{
+/**
+ * Lossless CPU compressor for EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT.
+ *
+ * Each depth value is predicted from its left, upper and upper-left neighbor
+ * (plane prediction), which is exact for planar surfaces since window depth is
+ * affine in screen space. The residuals are zigzag-coded and bit-packed in
+ * blocks of 16 values using the smallest bit width of the block. Runs of
+ * far-plane values are stored as a single run length. The image is split in
+ * row bands, which are compressed and decompressed in parallel.
+ */
+class CompressorDepth : public Compressor
+{
+public:
+    CompressorDepth();
+    virtual ~CompressorDepth();
+
+    static void* getNewCompressor( const unsigned )
+        { return new CompressorDepth; }
+    static void* getNewDecompressor( const unsigned ) { return 0; }
+
+    static void decompress( const void* const* inData,
+                            const eq_uint64_t* const inSizes,
+                            const unsigned numInputs, void* const outData,
+                            const eq_uint64_t nPixels, const bool useAlpha );
+
+    static bool isCompatible( const GLEWContext* ) { return true; }
+
+    void compress( const void* const inData, const eq_uint64_t nPixels,
+                   const bool useAlpha ) override;
+
+    void compress2D( const void* const inData, const eq_uint64_t nPixels,
+                     const eq_uint64_t width, const bool useAlpha ) override;
+};
+}
+}
+
+#endif // EQ_PLUGIN_COMPRESSORDEPTH
@@ -3,12 +3,14 @@
 
 set(EQ_COMPRESSOR_SOURCES
   compressor/compressor.cpp
+  compressor/compressorDepth.cpp
   compressor/compressorReadDrawPixels.cpp
   compressor/compressorYUV.cpp
 )
 
 set(EQ_COMPRESSOR_HEADERS
   compressor/compressor.h
+  compressor/compressorDepth.h
   compressor/compressorReadDrawPixels.h
   compressor/compressorYUV.h
 )
@@ -24,6 +24,7 @@
 #include "client.h"
 #include "configEvent.h"
 #include "configStatistics.h"
+#include "criticalPathAnalyzer.h"
 #include "eventICommand.h"
 #include "global.h"
 #include "layout.h"
@@ -34,6 +35,7 @@
 #include "observer.h"
 #include "pipe.h"
 #include "server.h"
+#include "statisticsAggregator.h"
 #include "view.h"
 #include "window.h"
 
@@ -109,6 +111,7 @@ public:
         , currentFrame( 0 )
         , unlockedFrame( 0 )
         , finishedFrame( 0 )
+        , statisticsItems( true )
         , running( false )
     {
         lunchbox::Log::setClock( &clock );
@@ -147,6 +150,15 @@ public:
     /** The global clock. */
     lunchbox::Clock clock;
 
+    /** Rolling per-entity summaries of all statistics. */
+    StatisticsAggregator aggregator;
+
+    /** Per-frame task dependency analysis of all statistics. */
+    CriticalPathAnalyzer criticalPath;
+
+    /** Generate per-event statistics items for the overlay. */
+    bool statisticsItems;
+
     std::deque< int64_t > frameTimes; //!< Start time of last frames
 
     /** list of the current latency object */
@@ -710,6 +722,15 @@ bool Config::_handleNewEvent( EventICommand& command )
         _impl->errors.push_back( error );
         return false;
     }
+
+    case Event::STATISTIC: // sent by the server
+    {
+        const uint32_t originator = command.read< uint32_t >();
+        const Statistic& statistic = command.read< Statistic >();
+        LBLOG( LOG_STATS ) << statistic << std::endl;
+        addStatistic( originator, statistic );
+        return false;
+    }
     }
     return false;
 }
@@ -759,10 +780,8 @@ bool Config::_handleEvent( const Event& event )
     return false;
 }
 
-void Config::addStatistic( const uint32_t originator LB_UNUSED,
-                           const Statistic& stat LB_UNUSED )
+void Config::addStatistic( const uint32_t originator, const Statistic& stat )
 {
-#ifdef EQUALIZER_USE_GLSTATS
     const uint32_t frame = stat.frameNumber;
     LBASSERT( stat.type != Statistic::NONE );
 
@@ -770,6 +789,13 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
     if( frame == 0 || stat.type == Statistic::NONE )
         return;
 
+    _impl->aggregator.add( originator, stat );
+    _impl->criticalPath.add( originator, stat );
+
+#ifdef EQUALIZER_USE_GLSTATS
+    if( !_impl->statisticsItems )
+        return;
+
     lunchbox::ScopedFastWrite mutex( _impl->statistics );
     GLStats::Item item;
     item.entity = originator;
@@ -797,6 +823,7 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
           item.thread = THREAD_ASYNC2;
           // no break;
       case Statistic::CHANNEL_FRAME_WAIT_READY:
+      case Statistic::CHANNEL_MOTION_TO_PHOTON:
           type.group = "channel";
           item.layer = 1;
           break;
@@ -808,6 +835,14 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
       case Statistic::CHANNEL_VIEW_FINISH:
           type.group = "channel";
           break;
+      case Statistic::CHANNEL_FRAME_MERGE:
+      {
+          std::stringstream text;
+          text << unsigned( 100.f * stat.ratio ) << "% hidden";
+          item.text = text.str();
+          type.group = "channel";
+          break;
+      }
       case Statistic::CHANNEL_ASYNC_READBACK:
           type.group = "channel";
           type.subgroup = "transfer";
@@ -818,6 +853,14 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
           type.subgroup = "transmit";
           item.thread = THREAD_ASYNC2;
           break;
+      case Statistic::CHANNEL_FRAME_DROP:
+      {
+          std::stringstream text;
+          text << unsigned( stat.ratio ) << " dropped";
+          item.text = text.str();
+          type.group = "channel";
+          break;
+      }
 
       case Statistic::WINDOW_FINISH:
       case Statistic::WINDOW_THROTTLE_FRAMERATE:
@@ -825,6 +868,18 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
       case Statistic::WINDOW_SWAP:
           type.group = "window";
           break;
+      case Statistic::WINDOW_FRAME_LATENCY:
+          type.group = "window";
+          item.layer = 1;
+          break;
+      case Statistic::PIPE_STREAM_UPLOAD:
+      {
+          std::stringstream text;
+          text << unsigned( 100.f * stat.ratio ) << '%';
+          item.text = text.str();
+          type.group = "pipe";
+          break;
+      }
       case Statistic::NODE_FRAME_DECOMPRESS:
           type.group = "node";
           break;
@@ -834,9 +889,58 @@ void Config::addStatistic( const uint32_t originator LB_UNUSED,
           // no break;
       case Statistic::CONFIG_START_FRAME:
       case Statistic::CONFIG_FINISH_FRAME:
+      case Statistic::CONFIG_PREPARE_FRAME:
           type.group = "config";
           break;
 
+      case Statistic::CONFIG_LOAD_2D:
+      case Statistic::CONFIG_LOAD_DB:
+      {
+          std::stringstream text;
+          text << ( stat.type == Statistic::CONFIG_LOAD_2D ? "2D " : "DB " )
+               << unsigned( 100.f * stat.ratio ) << '%';
+          item.text = text.str();
+          type.group = "config";
+          break;
+      }
+
+      case Statistic::CONFIG_DPLEX_JITTER:
+      {
+          // relative to the mean frame interval, the duration of the stat
+          std::stringstream text;
+          text << "jitter " << unsigned( 100.f * stat.ratio ) << '%';
+          item.text = text.str();
+          type.group = "config";
+          break;
+      }
+
+      case Statistic::CONFIG_VIEW_STEAL:
+      {
+          std::stringstream text;
+          text << unsigned( stat.ratio ) << " tiles stolen";
+          item.text = text.str();
+          type.group = "config";
+          break;
+      }
+
+      case Statistic::CONFIG_VIEW_IDLE:
+      {
+          std::stringstream text;
+          text << unsigned( 100.f * stat.ratio ) << "% idle";
+          item.text = text.str();
+          type.group = "config";
+          break;
+      }
+
+      case Statistic::CONFIG_HEAD_TRACKING:
+      {
+          std::stringstream text;
+          text << unsigned( stat.ratio ) << " Hz";
+          item.text = text.str();
+          type.group = "config";
+          break;
+      }
+
       case Statistic::PIPE_IDLE:
       {
           const std::string& string = _impl->statistics->getText();
@@ -929,6 +1033,9 @@ bool Config::_needsLocalSync() const
 
 void Config::_updateStatistics()
 {
+    _impl->aggregator.obsolete( _impl->finishedFrame.get( ));
+    _impl->criticalPath.obsolete( _impl->finishedFrame.get( ));
+
 #ifdef EQUALIZER_USE_GLSTATS
     // keep statistics for three frames
     lunchbox::ScopedFastWrite mutex( _impl->statistics );
@@ -946,6 +1053,36 @@ GLStats::Data Config::getStatistics() const
 #endif
 }
 
+StatisticsAggregator& Config::getStatisticsAggregator()
+{
+    return _impl->aggregator;
+}
+
+const StatisticsAggregator& Config::getStatisticsAggregator() const
+{
+    return _impl->aggregator;
+}
+
+CriticalPathAnalyzer& Config::getCriticalPathAnalyzer()
+{
+    return _impl->criticalPath;
+}
+
+const CriticalPathAnalyzer& Config::getCriticalPathAnalyzer() const
+{
+    return _impl->criticalPath;
+}
+
+void Config::setStatisticsItems( const bool enable )
+{
+    _impl->statisticsItems = enable;
+}
+
+bool Config::getStatisticsItems() const
+{
+    return _impl->statisticsItems;
+}
+
 uint32_t Config::getCurrentFrame() const
 {
     return _impl->currentFrame;
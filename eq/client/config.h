@@ -92,6 +92,38 @@ public:
     /** @internal Get all received statistics. */
     EQ_API GLStats::Data getStatistics() const;
 
+    /**
+     * @return the rolling summaries of all received statistics.
+     * @sa StatisticsAggregator::setWindow()
+     * @version 1.8
+     */
+    EQ_API StatisticsAggregator& getStatisticsAggregator();
+
+    /** @return the rolling summaries of all received statistics. @version 1.8 */
+    EQ_API const StatisticsAggregator& getStatisticsAggregator() const;
+
+    /**
+     * @return the critical path analyzer fed with all received statistics.
+     * @version 1.8
+     */
+    EQ_API CriticalPathAnalyzer& getCriticalPathAnalyzer();
+
+    /** @return the critical path analyzer. @version 1.8 */
+    EQ_API const CriticalPathAnalyzer& getCriticalPathAnalyzer() const;
+
+    /**
+     * Enable or disable the per-event statistics used by the overlay.
+     *
+     * Disabling the per-event statistics reduces the processing cost of each
+     * received statistic on the application node to the aggregation in the
+     * StatisticsAggregator, which is always active. Default on.
+     * @version 1.8
+     */
+    EQ_API void setStatisticsItems( const bool enable );
+
+    /** @return true if per-event statistics are generated. @version 1.8 */
+    EQ_API bool getStatisticsItems() const;
+
     /**
      * @return true while the config is initialized and no exit event
      *         has happened.
@@ -0,0 +1,580 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "criticalPathAnalyzer.h"
+
+#include <lunchbox/atomic.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+typedef eq::CriticalPathAnalyzer::Task Task;
+typedef eq::CriticalPathAnalyzer::Tasks Tasks;
+typedef std::map< uint32_t, Tasks > FrameMap;
+typedef FrameMap::const_iterator FrameMapCIter;
+
+/** The precision of the synchronized config clock. */
+static const int64_t _tolerance = 1;
+
+enum Thread
+{
+    THREAD_MAIN,
+    THREAD_ASYNC_READBACK,
+    THREAD_TRANSMIT
+};
+
+Thread _getThread( const Statistic::Type type )
+{
+    switch( type )
+    {
+      case Statistic::CHANNEL_ASYNC_READBACK:
+          return THREAD_ASYNC_READBACK;
+      case Statistic::CHANNEL_FRAME_TRANSMIT:
+      case Statistic::CHANNEL_FRAME_COMPRESS:
+      case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
+          return THREAD_TRANSMIT;
+      default:
+          return THREAD_MAIN;
+    }
+}
+
+/** @return true for tasks contributing to the critical path analysis. */
+bool _isAnalyzed( const Statistic::Type type )
+{
+    switch( type )
+    {
+      case Statistic::NONE:
+      case Statistic::WINDOW_FPS:
+      case Statistic::WINDOW_FRAME_LATENCY: // spans the whole frame
+      case Statistic::CHANNEL_MOTION_TO_PHOTON:
+      case Statistic::PIPE_IDLE:
+      case Statistic::ALL:
+      // config tasks refer to a frame 'latency' frames in the past
+      case Statistic::CONFIG_START_FRAME:
+      case Statistic::CONFIG_FINISH_FRAME:
+      case Statistic::CONFIG_WAIT_FINISH_FRAME:
+      case Statistic::CONFIG_PREPARE_FRAME:
+      case Statistic::CONFIG_LOAD_2D:
+      case Statistic::CONFIG_LOAD_DB:
+      case Statistic::CONFIG_DPLEX_JITTER:
+      case Statistic::CONFIG_VIEW_STEAL:
+      case Statistic::CONFIG_VIEW_IDLE:
+      case Statistic::CONFIG_HEAD_TRACKING:
+          return false;
+      default:
+          return true;
+    }
+}
+
+/** @return true for tasks waiting on another resource. */
+bool _isWait( const Statistic::Type type )
+{
+    return type == Statistic::CHANNEL_FRAME_WAIT_READY ||
+           type == Statistic::WINDOW_SWAP_BARRIER;
+}
+
+bool _isFrameOutput( const Statistic::Type type )
+{
+    return type == Statistic::CHANNEL_FRAME_TRANSMIT ||
+           type == Statistic::CHANNEL_READBACK ||
+           type == Statistic::CHANNEL_ASYNC_READBACK;
+}
+
+/** @return true if the output may be the frame data a wait was blocked on. */
+bool _isSameFrame( const Task& output, const Task& wait )
+{
+    return output.frameData == 0 || wait.frameData == 0 ||
+           output.frameData == wait.frameData;
+}
+
+struct Item
+{
+    Item( const Task& task_ )
+        : task( &task_ ), thread( _getThread( task_.type )), parent( -1 ) {}
+
+    bool isSameResource( const Item& rhs ) const
+        { return task->entity == rhs.task->entity && thread == rhs.thread; }
+
+    int64_t getDuration() const { return task->end - task->start; }
+
+    const Task* task;
+    Thread thread;
+    int parent; //!< index of the enclosing task on the same resource
+};
+typedef std::vector< Item > Items;
+
+bool _lessResource( const Item& a, const Item& b )
+{
+    if( a.task->entity != b.task->entity )
+        return a.task->entity < b.task->entity;
+    if( a.thread != b.thread )
+        return a.thread < b.thread;
+    if( a.task->start != b.task->start )
+        return a.task->start < b.task->start;
+    return a.task->end > b.task->end; // enclosing tasks first
+}
+
+/** Sort the items by resource and set up the nesting of tasks. */
+void _setupItems( Items& items )
+{
+    std::sort( items.begin(), items.end(), _lessResource );
+
+    std::vector< int > open;
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        Item& item = items[i];
+        while( !open.empty( ))
+        {
+            const Item& top = items[ open.back() ];
+            if( top.isSameResource( item ) && item.task->end <= top.task->end )
+                break;
+            open.pop_back();
+        }
+        if( !open.empty( ))
+            item.parent = open.back();
+        open.push_back( int( i ));
+    }
+}
+
+/** @return the latest-ending waiting task within the given item, or -1. */
+int _findWait( const Items& items, const int index )
+{
+    int wait = _isWait( items[ index ].task->type ) ? index : -1;
+    for( size_t i = index + 1; i < items.size(); ++i )
+    {
+        const Item& item = items[i];
+        if( !item.isSameResource( items[ index ] ) ||
+            item.task->start > items[ index ].task->end )
+        {
+            break;
+        }
+        if( item.task->end <= items[ index ].task->end &&
+            _isWait( item.task->type ) &&
+            ( wait < 0 || item.task->end > items[ wait ].task->end ))
+        {
+            wait = int( i );
+        }
+    }
+    return wait;
+}
+
+/** @return the task on another resource which released the wait, or -1. */
+int _findRelease( const Items& items, const int index )
+{
+    const Item& wait = items[ index ];
+    if( wait.getDuration() <= _tolerance ) // did not block
+        return -1;
+
+    int release = -1;
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        const Item& item = items[i];
+        if( item.isSameResource( wait ))
+            continue;
+
+        switch( wait.task->type )
+        {
+          case Statistic::CHANNEL_FRAME_WAIT_READY:
+              // the last matching output finished before the wait returned
+              if( _isFrameOutput( item.task->type ) &&
+                  _isSameFrame( *item.task, *wait.task ) &&
+                  item.task->end <= wait.task->end + _tolerance &&
+                  ( release < 0 || item.task->end > items[release].task->end ))
+              {
+                  release = int( i );
+              }
+              break;
+
+          case Statistic::WINDOW_SWAP_BARRIER:
+              // the last window entering the barrier
+              if( item.task->type == Statistic::WINDOW_SWAP_BARRIER &&
+                  item.task->start > wait.task->start + _tolerance &&
+                  ( release < 0 ||
+                    item.task->start > items[release].task->start ))
+              {
+                  release = int( i );
+              }
+              break;
+
+          default:
+              return -1;
+        }
+    }
+    return release;
+}
+
+/**
+ * @return the top-level task preceding the given one, or -1.
+ *
+ * Prefers the previous task on the same resource, then a task of another
+ * thread of the same entity, then a task of any other entity (e.g., the channel
+ * of a window) which finished when the given task started.
+ */
+int _findPrevious( const Items& items, const int index )
+{
+    const Item& current = items[ index ];
+    int local = -1;
+    int entity = -1;
+    int other = -1;
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        const Item& item = items[i];
+        if( item.parent >= 0 || int( i ) == index ||
+            item.task->end > current.task->start + _tolerance )
+        {
+            continue;
+        }
+
+        if( item.isSameResource( current ))
+        {
+            if( local < 0 || item.task->end > items[ local ].task->end )
+                local = int( i );
+            continue;
+        }
+
+        if( item.task->end < current.task->start - _tolerance )
+            continue;
+
+        int& candidate = item.task->entity == current.task->entity ? entity :
+                                                                     other;
+        if( candidate < 0 || item.task->end > items[ candidate ].task->end )
+            candidate = int( i );
+    }
+
+    if( local >= 0 &&
+        current.task->start - items[ local ].task->end <= _tolerance )
+    {
+        return local;
+    }
+    return entity >= 0 ? entity : other;
+}
+
+int _getRoot( const Items& items, int index )
+{
+    while( items[ index ].parent >= 0 )
+        index = items[ index ].parent;
+    return index;
+}
+
+typedef std::pair< int64_t, int64_t > Interval;
+typedef std::vector< Interval > Intervals;
+
+/** @return the length of the union of the given intervals. */
+int64_t _getUnion( Intervals& intervals )
+{
+    std::sort( intervals.begin(), intervals.end( ));
+    int64_t length = 0;
+    int64_t end = std::numeric_limits< int64_t >::min();
+    for( Intervals::const_iterator i = intervals.begin();
+         i != intervals.end(); ++i )
+    {
+        const int64_t start = std::max( i->first, end );
+        if( i->second > start )
+        {
+            length += i->second - start;
+            end = i->second;
+        }
+    }
+    return length;
+}
+
+void _computeSlacks( const Items& items, eq::CriticalPathAnalyzer::Analysis&
+                     analysis )
+{
+    typedef std::map< uint32_t, Intervals > EntityIntervals;
+    typedef std::map< uint32_t, std::string > EntityNames;
+    EntityIntervals busy;
+    EntityNames names;
+
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        const Item& item = items[i];
+        const Task& task = *item.task;
+        names[ task.entity ] = task.name;
+        if( item.parent >= 0 || _isWait( task.type ))
+        {
+            busy[ task.entity ]; // make sure the entity is listed
+            continue;
+        }
+
+        // split the task at its nested waits
+        int64_t start = task.start;
+        for( size_t j = i + 1; j < items.size() &&
+                 items[j].isSameResource( item ) &&
+                 items[j].task->start <= task.end; ++j )
+        {
+            if( !_isWait( items[j].task->type ))
+                continue;
+            if( items[j].task->start > start )
+                busy[ task.entity ].push_back(
+                    Interval( start, items[j].task->start ));
+            start = std::max( start, items[j].task->end );
+        }
+        if( task.end > start )
+            busy[ task.entity ].push_back( Interval( start, task.end ));
+    }
+
+    const int64_t duration = analysis.end - analysis.start;
+    for( EntityIntervals::iterator i = busy.begin(); i != busy.end(); ++i )
+    {
+        eq::CriticalPathAnalyzer::Slack slack;
+        slack.entity = i->first;
+        slack.name = names[ i->first ];
+        slack.busy = _getUnion( i->second );
+        slack.slack = duration - slack.busy;
+        analysis.slacks.push_back( slack );
+    }
+}
+}
+
+class CriticalPathAnalyzer
+{
+public:
+    explicit CriticalPathAnalyzer( const uint32_t window_ )
+        : window( window_ )
+        , trace( 0 )
+        , active( window_ > 0 )
+    {}
+
+    void updateActive() { active = window > 0 || trace != 0; }
+
+    void obsolete( const uint32_t frame )
+    {
+        if( frame < window )
+            return;
+
+        const uint32_t first = frame - window + 1;
+        frames.erase( frames.begin(), frames.lower_bound( first ));
+    }
+
+    mutable lunchbox::SpinLock lock;
+    uint32_t window;
+    std::ostream* trace;
+    a_int32_t active; //!< window or trace set, checked without the lock
+    FrameMap frames;
+};
+}
+
+CriticalPathAnalyzer::CriticalPathAnalyzer( const uint32_t window )
+    : _impl( new detail::CriticalPathAnalyzer( window ))
+{}
+
+CriticalPathAnalyzer::~CriticalPathAnalyzer()
+{
+    delete _impl;
+}
+
+void CriticalPathAnalyzer::setWindow( const uint32_t frames )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->window = frames;
+    if( frames == 0 )
+        _impl->frames.clear();
+    _impl->updateActive();
+}
+
+uint32_t CriticalPathAnalyzer::getWindow() const
+{
+    lunchbox::ScopedFastRead mutex( _impl->lock );
+    return _impl->window;
+}
+
+void CriticalPathAnalyzer::setTrace( std::ostream* trace )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->trace = trace;
+    _impl->updateActive();
+}
+
+void CriticalPathAnalyzer::add( const uint32_t entity, const Statistic& stat )
+{
+    if( !_impl->active || stat.frameNumber == 0 || stat.type == Statistic::NONE ||
+        stat.type == Statistic::ALL )
+    {
+        return;
+    }
+
+    Task task;
+    task.entity = entity;
+    task.type = stat.type;
+    task.frame = stat.frameNumber;
+    task.start = stat.startTime;
+    task.end = stat.endTime;
+    task.frameData = stat.frameData;
+    task.name = stat.resourceName;
+
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    if( _impl->trace )
+        *_impl->trace << task << std::endl;
+    if( _impl->window > 0 )
+        _impl->frames[ task.frame ].push_back( task );
+}
+
+void CriticalPathAnalyzer::add( const Task& task )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->frames[ task.frame ].push_back( task );
+}
+
+size_t CriticalPathAnalyzer::read( std::istream& trace )
+{
+    size_t nTasks = 0;
+    std::string line;
+    while( std::getline( trace, line ))
+    {
+        std::istringstream stream( line );
+        Task task;
+        uint32_t type = 0;
+        stream >> task.frame >> task.entity >> type >> task.start >> task.end
+               >> task.frameData;
+        if( !stream || type >= Statistic::ALL )
+        {
+            if( !line.empty( ))
+                LBWARN << "Ignoring malformed trace line: " << line
+                       << std::endl;
+            continue;
+        }
+        task.type = Statistic::Type( type );
+        stream >> std::ws;
+        std::getline( stream, task.name );
+        add( task );
+        ++nTasks;
+    }
+    return nTasks;
+}
+
+void CriticalPathAnalyzer::obsolete( const uint32_t frame )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->obsolete( frame );
+}
+
+std::vector< uint32_t > CriticalPathAnalyzer::getFrames() const
+{
+    std::vector< uint32_t > frames;
+    lunchbox::ScopedFastRead mutex( _impl->lock );
+    for( detail::FrameMapCIter i = _impl->frames.begin();
+         i != _impl->frames.end(); ++i )
+    {
+        frames.push_back( i->first );
+    }
+    return frames;
+}
+
+bool CriticalPathAnalyzer::analyze( const uint32_t frame,
+                                    Analysis& analysis ) const
+{
+    Tasks tasks;
+    {
+        lunchbox::ScopedFastRead mutex( _impl->lock );
+        detail::FrameMapCIter i = _impl->frames.find( frame );
+        if( i == _impl->frames.end( ))
+            return false;
+        tasks = i->second;
+    }
+
+    detail::Items items;
+    for( Tasks::const_iterator i = tasks.begin(); i != tasks.end(); ++i )
+        if( detail::_isAnalyzed( i->type ) && i->end >= i->start )
+            items.push_back( detail::Item( *i ));
+    if( items.empty( ))
+        return false;
+
+    detail::_setupItems( items );
+
+    analysis = Analysis();
+    analysis.frame = frame;
+    analysis.start = items.front().task->start;
+    analysis.end = items.front().task->end;
+    int last = 0;
+    for( size_t i = 0; i < items.size(); ++i )
+    {
+        const Task& task = *items[i].task;
+        analysis.start = std::min( analysis.start, task.start );
+        if( items[i].parent < 0 && task.end >= items[ last ].task->end )
+            last = int( i );
+        analysis.end = std::max( analysis.end, task.end );
+    }
+
+    // walk backwards along the latest-finishing dependencies
+    std::set< int > visited;
+    for( int current = last; current >= 0 && visited.insert( current ).second; )
+    {
+        analysis.path.push_back( *items[ current ].task );
+
+        const int wait = detail::_findWait( items, current );
+        const int release = wait < 0 ? -1 :
+                                       detail::_findRelease( items, wait );
+        if( release >= 0 )
+        {
+            if( wait != current )
+                analysis.path.push_back( *items[ wait ].task );
+            current = release;
+            continue;
+        }
+
+        current = detail::_findPrevious( items,
+                                         detail::_getRoot( items, current ));
+    }
+    std::reverse( analysis.path.begin(), analysis.path.end( ));
+
+    detail::_computeSlacks( items, analysis );
+    return true;
+}
+
+std::ostream& operator << ( std::ostream& os,
+                            const CriticalPathAnalyzer::Task& task )
+{
+    return os << task.frame << ' ' << task.entity << ' ' << unsigned( task.type )
+              << ' ' << task.start << ' ' << task.end << ' ' << task.frameData
+              << ' ' << task.name;
+}
+
+std::ostream& operator << ( std::ostream& os,
+                            const CriticalPathAnalyzer::Analysis& analysis )
+{
+    os << "Frame " << analysis.frame << ": " << analysis.end - analysis.start
+       << " ms" << std::endl << "  critical path:" << std::endl;
+    for( CriticalPathAnalyzer::Tasks::const_iterator i = analysis.path.begin();
+         i != analysis.path.end(); ++i )
+    {
+        os << "    " << i->name << " " << Statistic::getName( i->type ) << " "
+           << i->start - analysis.start << ".." << i->end - analysis.start
+           << " ms" << std::endl;
+    }
+    os << "  slack:" << std::endl;
+    for( CriticalPathAnalyzer::Slacks::const_iterator i =
+             analysis.slacks.begin(); i != analysis.slacks.end(); ++i )
+    {
+        os << "    " << i->name << " busy " << i->busy << " ms, slack "
+           << i->slack << " ms" << std::endl;
+    }
+    return os;
+}
+
+}
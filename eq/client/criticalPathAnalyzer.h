@@ -0,0 +1,179 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_CRITICALPATHANALYZER_H
+#define EQ_CRITICALPATHANALYZER_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+#include <eq/fabric/statistic.h> // Statistic::Type
+
+#include <boost/noncopyable.hpp>
+#include <iostream>
+
+namespace eq
+{
+namespace detail { class CriticalPathAnalyzer; }
+
+/**
+ * Reconstructs the chain of tasks which determined the duration of a frame.
+ *
+ * The analyzer collects the statistics of all resources for a number of
+ * frames. For each frame, the tasks of each resource thread form a sequential
+ * chain. Waiting tasks are linked to the task on another resource which
+ * released them: a Statistic::CHANNEL_FRAME_WAIT_READY to the last output frame
+ * transmitted or read back before it returned, and a
+ * Statistic::WINDOW_SWAP_BARRIER to the last window entering the barrier. The
+ * dependencies are inferred from the statistics alone, since the compound
+ * structure is not known on the application node. Dependencies without a
+ * waiting statistic, e.g., between the channels of a tile queue, are not
+ * reconstructed. Config statistics are ignored, since they refer to the frame
+ * finished 'latency' frames earlier.
+ *
+ * The critical path is found by walking backwards from the last finished task
+ * of the frame, following at each step the dependency which finished last.
+ * The slack of a resource is the frame duration minus the time the resource
+ * spent on non-waiting tasks.
+ *
+ * The collected statistics can be written to a trace stream, which can be
+ * read later for offline analysis. The analyzer is disabled by default, and
+ * ignores all statistics until a window or a trace is set. All methods are
+ * thread safe.
+ */
+class CriticalPathAnalyzer : public boost::noncopyable
+{
+public:
+    /** One task of a frame. */
+    struct Task
+    {
+        Task() : entity( 0 ), type( Statistic::NONE ), frame( 0 )
+               , start( 0 ), end( 0 ), frameData( 0 ) {}
+
+        uint32_t entity; //!< The originator serial of the statistic
+        Statistic::Type type; //!< The statistic type
+        uint32_t frame; //!< The frame number
+        int64_t start; //!< The start time in milliseconds
+        int64_t end; //!< The end time in milliseconds
+        /** The output frame read, sent or waited on, 0 if unknown */
+        uint32_t frameData;
+        std::string name; //!< The resource name
+    };
+    typedef std::vector< Task > Tasks;
+
+    /** The time a resource did not contribute to a frame. */
+    struct Slack
+    {
+        Slack() : entity( 0 ), busy( 0 ), slack( 0 ) {}
+
+        uint32_t entity; //!< The originator serial of the resource
+        std::string name; //!< The resource name
+        int64_t busy; //!< The time spent on non-waiting tasks
+        int64_t slack; //!< The frame duration minus the busy time
+    };
+    typedef std::vector< Slack > Slacks;
+
+    /** The result of analyzing one frame. */
+    struct Analysis
+    {
+        Analysis() : frame( 0 ), start( 0 ), end( 0 ) {}
+
+        uint32_t frame; //!< The analyzed frame
+        int64_t start; //!< The start time of the first task
+        int64_t end; //!< The end time of the last task
+        Tasks path; //!< The critical path, in chronological order
+        Slacks slacks; //!< The slack of each resource of the frame
+    };
+
+    /**
+     * Construct a new analyzer.
+     *
+     * @param window the number of frames to keep statistics for, 0 to
+     *               disable collecting statistics.
+     * @version 1.8
+     */
+    EQ_API explicit CriticalPathAnalyzer( const uint32_t window = 0 );
+
+    /** Destruct this analyzer. @version 1.8 */
+    EQ_API ~CriticalPathAnalyzer();
+
+    /**
+     * Set the number of frames to keep statistics for.
+     *
+     * A window of 0 disables the analyzer and clears all statistics.
+     * @version 1.8
+     */
+    EQ_API void setWindow( const uint32_t frames );
+
+    /** @return the number of frames statistics are kept for. @version 1.8 */
+    EQ_API uint32_t getWindow() const;
+
+    /**
+     * Set a stream receiving all added statistics in the trace format.
+     *
+     * The stream has to stay valid until it is reset using 0.
+     * @version 1.8
+     */
+    EQ_API void setTrace( std::ostream* trace );
+
+    /** Add a statistics event of the given originator. @version 1.8 */
+    EQ_API void add( const uint32_t entity, const Statistic& stat );
+
+    /** Add a task, e.g., read from a trace. @version 1.8 */
+    EQ_API void add( const Task& task );
+
+    /**
+     * Read all tasks from a trace written using setTrace().
+     *
+     * The window is not applied to read tasks.
+     * @return the number of read tasks.
+     * @version 1.8
+     */
+    EQ_API size_t read( std::istream& trace );
+
+    /**
+     * Remove all statistics which left the window at the given frame.
+     *
+     * Called by the config for each finished frame.
+     * @version 1.8
+     */
+    EQ_API void obsolete( const uint32_t frame );
+
+    /** @return the frames with statistics, in ascending order. @version 1.8 */
+    EQ_API std::vector< uint32_t > getFrames() const;
+
+    /**
+     * Compute the critical path and slack of the given frame.
+     *
+     * @return true if statistics for the frame exist, false otherwise.
+     * @version 1.8
+     */
+    EQ_API bool analyze( const uint32_t frame, Analysis& analysis ) const;
+
+private:
+    detail::CriticalPathAnalyzer* const _impl;
+};
+
+/** Output a task in the trace format. @version 1.8 */
+EQ_API std::ostream& operator << ( std::ostream& os,
+                                   const CriticalPathAnalyzer::Task& task );
+
+/** Output the analysis in human-readable form. @version 1.8 */
+EQ_API std::ostream& operator << ( std::ostream& os,
+                                   const CriticalPathAnalyzer::Analysis& );
+}
+
+#endif // EQ_CRITICALPATHANALYZER_H
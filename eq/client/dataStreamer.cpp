@@ -0,0 +1,457 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "dataStreamer.h"
+
+#include "channel.h"
+#include "pipeStatistics.h"
+
+#include <lunchbox/clock.h>
+#include <lunchbox/condition.h>
+#include <lunchbox/memoryMap.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace eq
+{
+namespace
+{
+typedef DataStreamer::Request Request;
+
+/** Smoothing factor of the upload throughput. */
+static const float _rateWeight = .1f;
+
+struct Item
+{
+    Request request;
+    lunchbox::Bufferb data;
+};
+
+typedef std::map< uint128_t, Request > RequestMap;
+typedef std::map< uint128_t, Item* > ItemMap;
+typedef std::map< uint128_t, float > PriorityMap;
+
+/** Ordered by descending priority, then ascending identifier. */
+typedef std::set< std::pair< float, uint128_t > > PriorityIndex;
+
+PriorityIndex::value_type _getKey( const Request& request )
+{
+    return std::make_pair( -request.priority, request.id );
+}
+
+/** Locks a condition for the current scope. */
+class ScopedCondition : public boost::noncopyable
+{
+public:
+    explicit ScopedCondition( lunchbox::Condition& condition )
+        : _condition( condition ) { _condition.lock(); }
+    ~ScopedCondition() { _condition.unlock(); }
+
+private:
+    lunchbox::Condition& _condition;
+};
+
+bool _read( const Request& request, lunchbox::Bufferb& data )
+{
+    if( request.filename.empty( ))
+        return true;
+
+    lunchbox::MemoryMap file;
+    const uint8_t* addr = static_cast< const uint8_t* >(
+        file.map( request.filename ));
+    if( !addr )
+    {
+        LBWARN << "Can't open " << request.filename << " for reading"
+               << std::endl;
+        return false;
+    }
+
+    const uint64_t size = file.getSize();
+    if( request.offset > size )
+    {
+        LBWARN << "Offset " << request.offset << " beyond end of "
+               << request.filename << std::endl;
+        return false;
+    }
+
+    const uint64_t available = size - request.offset;
+    data.replace( addr + request.offset,
+                  request.size ? std::min( request.size, available ) :
+                                 available );
+    return true;
+}
+}
+
+namespace detail
+{
+class DataStreamer
+{
+public:
+    class Worker : public lunchbox::Thread
+    {
+    public:
+        explicit Worker( DataStreamer& streamer ) : _streamer( streamer ) {}
+        void run() override { _streamer.work(); }
+
+    private:
+        DataStreamer& _streamer;
+    };
+    typedef std::vector< Worker* > Workers;
+
+    DataStreamer( eq::DataStreamer& parent_, const size_t nThreads_ )
+        : parent( parent_ )
+        , nThreads( std::max( nThreads_, size_t( 1 )))
+        , running( true )
+        , budgetBytes( 0 )
+        , budgetTime( 0.f )
+    {}
+
+    ~DataStreamer()
+    {
+        LBASSERT( workers.empty( ));
+        for( ItemMap::const_iterator i = decoded.begin();
+             i != decoded.end(); ++i )
+        {
+            delete i->second;
+        }
+    }
+
+    void request( const Request& request )
+    {
+        ScopedCondition mutex( condition );
+        if( !running )
+            return;
+
+        PriorityMap::iterator i = active.find( request.id );
+        if( i != active.end( ))
+        {
+            i->second = request.priority;
+            return;
+        }
+
+        ItemMap::iterator j = decoded.find( request.id );
+        if( j != decoded.end( ))
+        {
+            Request& decodedRequest = j->second->request;
+            decodedIndex.erase( _getKey( decodedRequest ));
+            decodedRequest.priority = request.priority;
+            decodedIndex.insert( _getKey( decodedRequest ));
+            return;
+        }
+
+        RequestMap::iterator k = queued.find( request.id );
+        if( k != queued.end( ))
+            queuedIndex.erase( _getKey( k->second ));
+        queued[ request.id ] = request;
+        queuedIndex.insert( _getKey( request ));
+        condition.signal();
+
+        if( workers.empty( ))
+        {
+            // started lazily to not call decode() during construction
+            for( size_t k = 0; k < nThreads; ++k )
+            {
+                workers.push_back( new Worker( *this ));
+                workers.back()->start();
+            }
+        }
+    }
+
+    bool cancel( const uint128_t& id )
+    {
+        ScopedCondition mutex( condition );
+        RequestMap::iterator i = queued.find( id );
+        if( i != queued.end( ))
+        {
+            queuedIndex.erase( _getKey( i->second ));
+            queued.erase( i );
+            return true;
+        }
+
+        ItemMap::iterator j = decoded.find( id );
+        if( j == decoded.end( ))
+            return false;
+
+        decodedIndex.erase( _getKey( j->second->request ));
+        delete j->second;
+        decoded.erase( j );
+        return true;
+    }
+
+    void work()
+    {
+        for( ;; )
+        {
+            condition.lock();
+            while( running && queued.empty( ))
+                condition.wait();
+            if( !running )
+            {
+                condition.unlock();
+                return;
+            }
+
+            RequestMap::iterator i = queued.find( queuedIndex.begin()->second );
+            Item* item = new Item;
+            item->request = i->second;
+            queuedIndex.erase( queuedIndex.begin( ));
+            queued.erase( i );
+            active[ item->request.id ] = item->request.priority;
+            condition.unlock();
+
+            bool ok = _read( item->request, item->data );
+            const uint64_t nRead = item->data.getSize();
+            ok = ok && parent.decode( item->request, item->data );
+
+            condition.lock();
+            PriorityMap::iterator j = active.find( item->request.id );
+            item->request.priority = j->second;
+            active.erase( j );
+            statistics.bytesRead += nRead;
+
+            if( ok && running && addDecoded( item ))
+                item = 0;
+            condition.unlock();
+            delete item;
+        }
+    }
+
+    /** @return false if the item is decoded already. Call locked. */
+    bool addDecoded( Item* item )
+    {
+        if( !decoded.insert( std::make_pair( item->request.id, item )).second )
+            return false;
+        decodedIndex.insert( _getKey( item->request ));
+        return true;
+    }
+
+    Item* popDecoded()
+    {
+        ScopedCondition mutex( condition );
+        if( decoded.empty( ))
+            return 0;
+
+        ItemMap::iterator i = decoded.find( decodedIndex.begin()->second );
+        Item* item = i->second;
+        decodedIndex.erase( decodedIndex.begin( ));
+        decoded.erase( i );
+        return item;
+    }
+
+    bool hasDecoded() const
+    {
+        ScopedCondition mutex( condition );
+        return !decoded.empty();
+    }
+
+    void setBudget( const uint64_t bytes, const float milliseconds )
+    {
+        ScopedCondition mutex( condition );
+        budgetBytes = bytes;
+        budgetTime = milliseconds;
+    }
+
+    uint64_t getBudgetBytes() const
+    {
+        ScopedCondition mutex( condition );
+        return budgetBytes;
+    }
+
+    size_t upload( uint64_t& bytes )
+    {
+        lunchbox::Clock clock;
+        size_t nUploaded = 0;
+        bool overrun = false;
+
+        condition.lock();
+        const uint64_t maxBytes = budgetBytes;
+        const float maxTime = budgetTime;
+        condition.unlock();
+
+        for( ;; )
+        {
+            Item* item = popDecoded();
+            if( !item )
+                break;
+
+            const uint64_t size = item->data.getSize();
+            if( maxBytes > 0 && nUploaded > 0 && bytes + size > maxBytes )
+            {
+                // keep for the next frame unless requested again meanwhile
+                ScopedCondition mutex( condition );
+                if( addDecoded( item ))
+                    item = 0;
+                delete item;
+                break;
+            }
+
+            parent.uploadData( item->request, item->data );
+            delete item;
+            bytes += size;
+            ++nUploaded;
+
+            if( maxTime > 0.f && clock.getTimef() > maxTime )
+            {
+                overrun = true;
+                break;
+            }
+        }
+
+        const float time = rateClock.resetTimef();
+        ScopedCondition mutex( condition );
+        statistics.bytesUploaded += bytes;
+        if( overrun )
+            ++statistics.overruns;
+        if( time > 0.f )
+        {
+            const float rate = float( bytes ) * 1000.f / time;
+            statistics.bytesPerSecond *= 1.f - _rateWeight;
+            statistics.bytesPerSecond += _rateWeight * rate;
+        }
+        return nUploaded;
+    }
+
+    eq::DataStreamer::Statistics getStatistics() const
+    {
+        ScopedCondition mutex( condition );
+        eq::DataStreamer::Statistics result = statistics;
+        result.queueDepth = queued.size() + active.size();
+        result.nDecoded = decoded.size();
+        return result;
+    }
+
+    void stop()
+    {
+        condition.lock();
+        running = false;
+        queued.clear();
+        queuedIndex.clear();
+        condition.broadcast();
+        condition.unlock();
+
+        for( Workers::const_iterator i = workers.begin(); i != workers.end();
+             ++i )
+        {
+            (*i)->join();
+            delete *i;
+        }
+        workers.clear();
+    }
+
+    eq::DataStreamer& parent;
+    const size_t nThreads;
+    Workers workers;
+
+    mutable lunchbox::Condition condition;
+    bool running;
+    RequestMap queued; //!< waiting for an I/O thread
+    PriorityIndex queuedIndex; //!< queued by priority
+    PriorityMap active; //!< processed by an I/O thread
+    ItemMap decoded; //!< waiting for upload
+    PriorityIndex decodedIndex; //!< decoded by priority
+    eq::DataStreamer::Statistics statistics;
+
+    uint64_t budgetBytes; //!< protected by condition
+    float budgetTime; //!< protected by condition
+    lunchbox::Clock rateClock;
+};
+}
+
+DataStreamer::DataStreamer( const size_t nThreads )
+    : _impl( new detail::DataStreamer( *this, nThreads ))
+{}
+
+DataStreamer::~DataStreamer()
+{
+    LBASSERTINFO( _impl->workers.empty(),
+                  "DataStreamer::stop() not called by subclass destructor" );
+    _impl->stop();
+    delete _impl;
+}
+
+void DataStreamer::request( const Request& request )
+{
+    _impl->request( request );
+}
+
+bool DataStreamer::cancel( const uint128_t& id )
+{
+    return _impl->cancel( id );
+}
+
+void DataStreamer::setUploadBudget( const uint64_t bytes,
+                                    const float milliseconds )
+{
+    _impl->setBudget( bytes, milliseconds );
+}
+
+size_t DataStreamer::upload( Pipe* pipe )
+{
+    uint64_t bytes = 0;
+    if( !pipe || !_impl->hasDecoded( ))
+        return _impl->upload( bytes );
+
+    PipeStatistics event( Statistic::PIPE_STREAM_UPLOAD, pipe );
+    const size_t nUploaded = _impl->upload( bytes );
+    const uint64_t budget = _impl->getBudgetBytes();
+    event.event.data.statistic.ratio = budget == 0 ? 0.f :
+                                       float( bytes ) / float( budget );
+    return nUploaded;
+}
+
+DataStreamer::Statistics DataStreamer::getStatistics() const
+{
+    return _impl->getStatistics();
+}
+
+void DataStreamer::stop()
+{
+    _impl->stop();
+}
+
+float DataStreamer::computePriority( const Channel& channel,
+                                     const Matrix4f& modelView,
+                                     const Vector4f& sphere,
+                                     const Range& range )
+{
+    const Range& channelRange = channel.getRange();
+    if( range.end <= channelRange.start || range.start >= channelRange.end )
+        return 0.f;
+
+    const Frustumf& frustum = channel.getFrustum();
+    const Matrix4f projection = channel.useOrtho() ?
+                                    frustum.compute_ortho_matrix() :
+                                    frustum.compute_matrix();
+    const Matrix4f headModelView = channel.getHeadTransform() * modelView;
+
+    FrustumCullerf culler;
+    culler.setup( projection * headModelView );
+    const vmml::Visibility visibility = culler.test_sphere( sphere );
+    if( visibility == vmml::VISIBILITY_NONE )
+        return 0.f;
+
+    const Vector3f center( sphere.x(), sphere.y(), sphere.z( ));
+    const Vector3f eye = headModelView * center;
+    const float distance = std::max( eye.length() - sphere.w(), 0.f );
+    const float visible = visibility == vmml::VISIBILITY_FULL ? 2.f : 1.f;
+    return visible + 1.f / ( 1.f + distance );
+}
+
+}
@@ -0,0 +1,185 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DATASTREAMER_H
+#define EQ_DATASTREAMER_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+#include <eq/fabric/range.h> // default argument
+
+#include <lunchbox/buffer.h>
+
+namespace eq
+{
+namespace detail { class DataStreamer; }
+
+/**
+ * Asynchronous streaming of application data into a pipe.
+ *
+ * Requests are read by a pool of I/O threads using memory-mapped files, in
+ * the order of their priority. The read data is passed to decode() in the I/O
+ * thread, and queued for upload. The pipe thread calls upload() once per
+ * frame, typically from Pipe::frameStart(), which passes the decoded data with
+ * the highest priority to uploadData() until the per-frame upload budget is
+ * used. Rendering therefore never blocks on data, it uses whatever has been
+ * uploaded so far.
+ *
+ * One instance is typically used per pipe. Subclasses implement the decode and
+ * upload stages, and have to call stop() in their destructor.
+ */
+class DataStreamer : public boost::noncopyable
+{
+public:
+    /** A request for one piece of data. @version 1.8 */
+    struct Request
+    {
+        Request() : offset( 0 ), size( 0 ), priority( 0.f ) {}
+
+        uint128_t id; //!< The application identifier of the data
+        std::string filename; //!< The file to read, may be empty
+        uint64_t offset; //!< The offset of the data in the file
+        uint64_t size; //!< The size of the data, 0 to read until the end
+        float priority; //!< Higher priorities are loaded and uploaded first
+    };
+
+    /** Statistics of the streamer. @version 1.8 */
+    struct Statistics
+    {
+        Statistics() : queueDepth( 0 ), nDecoded( 0 ), bytesRead( 0 )
+                     , bytesUploaded( 0 ), bytesPerSecond( 0.f )
+                     , overruns( 0 ) {}
+
+        size_t queueDepth; //!< Requests waiting to be read
+        size_t nDecoded; //!< Decoded requests waiting for upload
+        uint64_t bytesRead; //!< Total bytes read by the I/O threads
+        uint64_t bytesUploaded; //!< Total bytes passed to upload
+        float bytesPerSecond; //!< Averaged recent upload throughput
+        uint32_t overruns; //!< Frames which exceeded the upload time budget
+    };
+
+    /**
+     * Construct a new streamer and start its I/O threads.
+     *
+     * @param nThreads the number of I/O threads.
+     * @version 1.8
+     */
+    EQ_API explicit DataStreamer( const size_t nThreads = 2 );
+
+    /** Destruct the streamer. @version 1.8 */
+    EQ_API virtual ~DataStreamer();
+
+    /**
+     * Queue a request, or update the priority of a queued request.
+     *
+     * Requests with the same identifier which are already read or decoded are
+     * only updated in priority.
+     * @version 1.8
+     */
+    EQ_API void request( const Request& request );
+
+    /**
+     * Cancel a request which has not been uploaded yet.
+     *
+     * @return true if the request was cancelled, false if it is unknown or
+     *         currently processed by an I/O thread.
+     * @version 1.8
+     */
+    EQ_API bool cancel( const uint128_t& id );
+
+    /**
+     * Set the per-frame upload budget.
+     *
+     * upload() stops when the given number of bytes was uploaded or the time
+     * was exceeded. At least one request is uploaded per frame if any is
+     * ready, regardless of its size.
+     *
+     * @param bytes the maximum number of bytes per frame, 0 for unlimited.
+     * @param milliseconds the maximum upload time per frame, 0 for unlimited.
+     * @version 1.8
+     */
+    EQ_API void setUploadBudget( const uint64_t bytes,
+                                 const float milliseconds );
+
+    /**
+     * Upload decoded data within the upload budget.
+     *
+     * Called from the thread owning the upload context, typically the pipe
+     * thread. If a pipe is given, a Statistic::PIPE_STREAM_UPLOAD event is
+     * sampled for it.
+     *
+     * @param pipe the pipe to sample statistics for, may be 0.
+     * @return the number of uploaded requests.
+     * @version 1.8
+     */
+    EQ_API size_t upload( Pipe* pipe = 0 );
+
+    /** @return a snapshot of the current statistics. @version 1.8 */
+    EQ_API Statistics getStatistics() const;
+
+    /**
+     * Stop and join the I/O threads.
+     *
+     * Pending requests are discarded. Has to be called by subclasses in their
+     * destructor, before the decode stage is destroyed.
+     * @version 1.8
+     */
+    EQ_API void stop();
+
+    /**
+     * Compute a request priority for a bounding sphere seen by a channel.
+     *
+     * The priority is 0 if the sphere is outside of the channel's frustum or
+     * if the data range does not overlap the channel's range. Otherwise it
+     * increases with the visibility and decreases with the eye distance.
+     *
+     * @param channel the channel, during a frame task method.
+     * @param modelView the model matrix of the data, relative to the channel's
+     *                  head transform.
+     * @param sphere the bounding sphere (center, radius) in model coordinates.
+     * @param range the database range covered by the data.
+     * @version 1.8
+     */
+    EQ_API static float computePriority( const Channel& channel,
+                                         const Matrix4f& modelView,
+                                         const Vector4f& sphere,
+                                         const Range& range = Range::ALL );
+
+protected:
+    /**
+     * Decode the read data in place. Called from an I/O thread.
+     *
+     * @return false to discard the request.
+     * @version 1.8
+     */
+    virtual bool decode( const Request&, lunchbox::Bufferb& )
+        { return true; }
+
+    /**
+     * Upload decoded data. Called from upload().
+     * @version 1.8
+     */
+    virtual void uploadData( const Request& request,
+                             const lunchbox::Bufferb& data ) = 0;
+
+private:
+    detail::DataStreamer* const _impl;
+    friend class detail::DataStreamer;
+};
+}
+
+#endif // EQ_DATASTREAMER_H
@@ -21,6 +21,8 @@
 
 #include <eq/fabric/drawableConfig.h>
 
+#include <cmath>
+
 #ifdef EQUALIZER_USE_DISPLAYCLUSTER
 #  include "../dc/proxy.h"
 #endif
@@ -45,6 +47,9 @@ public:
             : state( STATE_STOPPED )
             , fbo( 0 )
             , initialSize( Vector2i::ZERO )
+            , droppedFrames( 0 )
+            , latchTime( 0 )
+            , presentDelay( 0.f )
 #ifdef EQUALIZER_USE_DISPLAYCLUSTER
             , _dcProxy( 0 )
 #endif
@@ -117,12 +122,103 @@ public:
     /** The number of the last finished frame. */
     lunchbox::Monitor< uint32_t > finishedFrame;
 
+    /** The number of frames dropped after their deadline. */
+    uint32_t droppedFrames;
+
+    /** The time of the last late latch. */
+    int64_t latchTime;
+
+    /** The smoothed time from a late latch to the next buffer swap. */
+    float presentDelay;
+
 #ifdef EQUALIZER_USE_DISPLAYCLUSTER
     dc::Proxy* _dcProxy;
 #endif
 
     /** Dumps images when the channel is configured to do so */
     FileFrameWriter frameWriter;
+
+    /** A task received from the server, for repeating unchanged frames. */
+    struct Task
+    {
+        Task( const uint32_t command_, const RenderContext& context_,
+              const bool finish_ = false )
+            : command( command_ ), context( context_ ), finish( finish_ ) {}
+
+        uint32_t command;
+        RenderContext context;
+        bool finish;
+    };
+    typedef std::vector< Task > Tasks;
+
+    /** The tasks of the current frame. */
+    Tasks tasks;
+
+    /** The tasks of the last frame, replayed by CMD_CHANNEL_FRAME_REPEAT. */
+    Tasks lastTasks;
+
+    /** Output frame resolution state for IATTR_HINT_PROGRESSIVE. */
+    struct Progressive
+    {
+        Progressive() : drawTime( 0.f ), pixelTime( 0.f ) {}
+
+        uint128_t frameID; //!< of the last readback
+        Matrix4f headTransform; //!< of the last readback
+        float drawTime; //!< smoothed frameDraw time in ms
+        float pixelTime; //!< smoothed transmit time per pixel in ms
+    };
+
+    /** Updated by the pipe and the transmit thread. */
+    lunchbox::Lockable< Progressive, lunchbox::SpinLock > progressive;
+
+    void addDrawTime( const float time )
+    {
+        lunchbox::ScopedFastWrite mutex( progressive );
+        progressive->drawTime = _smooth( progressive->drawTime, time );
+    }
+
+    void addTransmitTime( const float time, const uint32_t nPixels )
+    {
+        if( nPixels == 0 )
+            return;
+        lunchbox::ScopedFastWrite mutex( progressive );
+        progressive->pixelTime = _smooth( progressive->pixelTime,
+                                          time / float( nPixels ));
+    }
+
+    /**
+     * @return the readback scale factor for the output frames of the current
+     *         frame, 1 for full resolution.
+     */
+    float getProgressiveScale( const uint128_t& frameID,
+                               const Matrix4f& headTransform,
+                               const uint64_t nPixels )
+    {
+        lunchbox::ScopedFastWrite mutex( progressive );
+        const bool still = frameID == progressive->frameID &&
+                           headTransform == progressive->headTransform;
+        progressive->frameID = frameID;
+        progressive->headTransform = headTransform;
+
+        // refine to full resolution once the application data and the head
+        // position are unchanged
+        if( still || progressive->drawTime <= 0.f )
+            return 1.f;
+
+        // transmission is asynchronous: keep up with the draw rate
+        const float transmitTime = progressive->pixelTime * float( nPixels );
+        if( transmitTime <= progressive->drawTime )
+            return 1.f;
+
+        // the transmit time is proportional to the area: scale both sides,
+        // and quantize to limit reallocations of the readback buffers
+        const float scale = std::sqrt( progressive->drawTime / transmitTime );
+        return std::max( std::floor( scale * 8.f ) / 8.f, .25f );
+    }
+
+private:
+    static float _smooth( const float average, const float value )
+        { return average <= 0.f ? value : average * .8f + value * .2f; }
 };
 
 }
@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *               2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -18,9 +19,13 @@
 #include "cvTracker.h"
 
 #include "../config.h"
+#include "../configStatistics.h"
 #include "../observer.h"
 
 #include <eq/fabric/event.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/sleep.h>
 
 #define FACE_CONFIG std::string( OPENCV_INSTALL_PATH ) +            \
     "/share/OpenCV/haarcascades/haarcascade_frontalface_alt.xml"
@@ -33,58 +38,204 @@ namespace eq
 {
 namespace detail
 {
-CVTracker::CVTracker( eq::Observer* observer, const uint32_t camera )
-    : observer_( observer )
-    , camera_( camera )
-    , capture_( cvCaptureFromCAM( camera_ ))
-    , running_( false )
+namespace
+{
+static const size_t _nDetectors = 3; // detection takes longer than a frame
+static const int _downscale = 2; // of the frame for face detection
+
+bool _load( cv::CascadeClassifier& classifier, const std::string& file )
+{
+    if( classifier.load( file ))
+        return true;
+
+    std::string config = file;
+    config.replace( config.find( "OpenCV" ), 6, "opencv" );
+    if( classifier.load( config ))
+        return true;
+
+    LBWARN << "Cannot set up detector using " << file << " or " << config
+           << std::endl;
+    return false;
+}
+}
+
+/** Detects the face and eyes in the captured frames. */
+class CVTracker::Detector : public lunchbox::Thread
 {
-	if( !capture_ )
+public:
+    explicit Detector( CVTracker& tracker ) : tracker_( tracker ) {}
+
+    bool load()
     {
-        LBWARN << "Did not find OpenCV camera " << camera_ << std::endl;
-        return;
+        return _load( faceDetector_, FACE_CONFIG ) &&
+               _load( eyeDetector_, EYE_CONFIG );
     }
 
-    if( !faceDetector_.load( FACE_CONFIG ))
+protected:
+    virtual void run()
     {
-        std::string config = FACE_CONFIG;
-        config.replace( config.find( "OpenCV" ), 6, "opencv" );
-        if( !faceDetector_.load( config ))
+        for( ;; )
         {
-            LBWARN << "Cannot set up face detector using " << FACE_CONFIG
-                   << " or " << config << std::endl;
-
-            cvReleaseCapture( &capture_ );
-            capture_ = 0;
-            return;
+            const Frame frame = tracker_.frames_.pop();
+            if( frame.image.empty( ))
+                return;
+            tracker_._update( _detect( frame ));
         }
     }
 
-    if( !eyeDetector_.load( EYE_CONFIG ))
-    {
-        std::string config = FACE_CONFIG;
-        config.replace( config.find( "OpenCV" ), 6, "opencv" );
-        if( !eyeDetector_.load( config ))
-        {
-            LBWARN << "Can't set up eye detector using " << EYE_CONFIG << " or "
-                   << config << std::endl;
+private:
+    CVTracker& tracker_;
+    cv::CascadeClassifier faceDetector_;
+    cv::CascadeClassifier eyeDetector_;
 
-            cvReleaseCapture( &capture_ );
-            capture_ = 0;
-            return;
-        }
+    Detection _detect( const Frame& frame );
+    cv::Rect _detectFace( const cv::Mat& image, const cv::Rect& roi );
+};
+
+CVTracker::Detection CVTracker::Detector::_detect( const Frame& frame )
+{
+    Detection detection;
+    detection.time = frame.time;
+    detection.sequence = frame.sequence;
+
+    cv::Mat bwFrame;
+    cvtColor( frame.image, bwFrame, CV_BGR2GRAY );
+    equalizeHist( bwFrame, bwFrame );
+
+    cv::Mat small;
+    cv::resize( bwFrame, small, cv::Size( bwFrame.cols / _downscale,
+                                          bwFrame.rows / _downscale ));
+
+    // detect face around the predicted position, in the full frame on loss
+    const cv::Rect roi = tracker_._getFaceROI( bwFrame.size( ));
+    cv::Rect face;
+    if( roi.area() > 0 )
+        face = _detectFace( small, cv::Rect( roi.x / _downscale,
+                                             roi.y / _downscale,
+                                             roi.width / _downscale,
+                                             roi.height / _downscale ));
+    if( face.area() == 0 )
+        face = _detectFace( small, cv::Rect( 0, 0, small.cols, small.rows ));
+    if( face.area() == 0 )
+        return detection;
+
+    face = cv::Rect( face.x * _downscale, face.y * _downscale,
+                     face.width * _downscale, face.height * _downscale ) &
+           cv::Rect( 0, 0, bwFrame.cols, bwFrame.rows );
+    detection.face = face;
+
+    // detect eyes in the full resolution face
+    const cv::Mat faceROI = bwFrame( face );
+    eyeDetector_.detectMultiScale( faceROI, detection.eyes, 1.1f, 2,
+                                   CV_HAAR_SCALE_IMAGE, cv::Size( 15, 15 ));
+    for( size_t i = 0; i < detection.eyes.size(); ++i )
+        detection.eyes[i] += face.tl();
+    return detection;
+}
+
+cv::Rect CVTracker::Detector::_detectFace( const cv::Mat& image,
+                                           const cv::Rect& roi )
+{
+    const cv::Rect region = roi & cv::Rect( 0, 0, image.cols, image.rows );
+    if( region.area() == 0 )
+        return cv::Rect();
+
+    std::vector< cv::Rect > faces;
+    faceDetector_.detectMultiScale( image( region ), faces, 1.1f, 2,
+                                    CV_HAAR_SCALE_IMAGE |
+                                    CV_HAAR_FIND_BIGGEST_OBJECT,
+                                    cv::Size( 30 / _downscale,
+                                              30 / _downscale ));
+    if( faces.empty( ))
+        return cv::Rect();
+    return faces.front() + region.tl();
+}
+
+CVTracker::CVTracker( eq::Observer* observer, const uint32_t camera )
+    : observer_( observer )
+    , capture_( cvCaptureFromCAM( camera ))
+    , period_( 0.f )
+    , running_( false )
+    , sequence_( 0 )
+    , updateTime_( 0 )
+    , rate_( 0.f )
+    , position_( .3f )
+    , roll_( .3f )
+    , headEyeRatio_( .3f )
+    , head_( Matrix4f::IDENTITY )
+    , width_( 0.f )
+    , isEyeWidth_( false )
+    , sentSequence_( 0 )
+{
+    if( !capture_ )
+    {
+        LBWARN << "Did not find OpenCV camera " << camera << std::endl;
+        return;
     }
 
     cvSetCaptureProperty( capture_, CV_CAP_PROP_FRAME_WIDTH, CAPTURE_WIDTH );
     cvSetCaptureProperty( capture_, CV_CAP_PROP_FRAME_HEIGHT, CAPTURE_HEIGHT );
-    LBINFO << "Activated tracking camera " << camera_ << std::endl;
+    _init();
+    if( capture_ )
+        LBINFO << "Activated tracking camera " << camera << std::endl;
+}
+
+CVTracker::CVTracker( eq::Observer* observer, const std::string& filename )
+    : observer_( observer )
+    , capture_( cvCaptureFromFile( filename.c_str( )))
+    , period_( 0.f )
+    , running_( false )
+    , sequence_( 0 )
+    , updateTime_( 0 )
+    , rate_( 0.f )
+    , position_( .3f )
+    , roll_( .3f )
+    , headEyeRatio_( .3f )
+    , head_( Matrix4f::IDENTITY )
+    , width_( 0.f )
+    , isEyeWidth_( false )
+    , sentSequence_( 0 )
+{
+    if( !capture_ )
+    {
+        LBWARN << "Cannot open tracking video " << filename << std::endl;
+        return;
+    }
+
+    const double fps = cvGetCaptureProperty( capture_, CV_CAP_PROP_FPS );
+    if( fps > 0. )
+        period_ = float( 1000. / fps );
+    _init();
+    if( capture_ )
+        LBINFO << "Activated tracking video " << filename << std::endl;
+}
+
+void CVTracker::_init()
+{
+    headEyeRatio_.add( .4f ); // initial guess
+
+    for( size_t i = 0; i < _nDetectors; ++i )
+    {
+        Detector* detector = new Detector( *this );
+        detectors_.push_back( detector );
+        if( detector->load( ))
+            continue;
+
+        cvReleaseCapture( &capture_ );
+        capture_ = 0;
+        return;
+    }
 }
 
 CVTracker::~CVTracker()
 {
     running_ = false;
     join();
-    cvReleaseCapture( &capture_ );
+    for( DetectorsCIter i = detectors_.begin(); i != detectors_.end(); ++i )
+        delete *i;
+    detectors_.clear();
+    if( capture_ )
+        cvReleaseCapture( &capture_ );
     capture_ = 0;
 }
 
@@ -92,110 +243,174 @@ void CVTracker::run()
 {
     running_ = true;
     eq::Config* config = observer_->getConfig();
-    const uint128_t originator = observer_->getID();
 
-    vmml::lowpass_filter< 5, Vector3f > position( .3f );
-    vmml::lowpass_filter< 5, float > roll( .3f );
-    vmml::lowpass_filter< 5, float > headEyeRatio( .3f );
-    Matrix4f head( Matrix4f::IDENTITY );
-
-    headEyeRatio.add( .4f ); // initial guesses
-    float width = 0.f;
-    bool isEyeWidth = false;
+    for( DetectorsCIter i = detectors_.begin(); i != detectors_.end(); ++i )
+        (*i)->start();
 
+    uint64_t sequence = 0;
+    lunchbox::Clock clock;
     while( running_ )
     {
-        const cv::Mat frame = cvQueryFrame( capture_ );
-        if( frame.empty( ))
+        if( period_ > 0.f )
+        {
+            // replay at the recorded rate, a camera blocks for the next frame
+            const float wait = float( sequence ) * period_ - clock.getTimef();
+            if( wait > 0.f )
+                lunchbox::sleep( uint32_t( wait ));
+        }
+
+        const IplImage* image = cvQueryFrame( capture_ );
+        if( !image )
         {
-            LBWARN << "Failure to grab a video frame, bailing" << std::endl;
+            if( period_ > 0.f )
+                LBINFO << "End of tracking video" << std::endl;
+            else
+                LBWARN << "Failure to grab a video frame, bailing" << std::endl;
             break;
         }
 
-        cv::Mat bwFrame;
-        cvtColor( frame, bwFrame, CV_BGR2GRAY );
-        equalizeHist( bwFrame, bwFrame );
-
-        // detect face
-        std::vector< cv::Rect > faces;
-        faceDetector_.detectMultiScale( bwFrame, faces, 1.1f, 2,
-                                        CV_HAAR_SCALE_IMAGE |
-                                        CV_HAAR_FIND_BIGGEST_OBJECT,
-                                        cv::Size( 30, 30 ));
-        if( faces.empty( ))
-            continue;
+        Frame frame;
+        frame.time = config->getTime();
+        frame.image = cv::Mat( image ).clone(); // capture reuses the image
+        frame.sequence = ++sequence;
+
+        // Drop pending frames, the newest frame is detected next
+        Frame pending;
+        while( frames_.tryPop( pending ))
+            /* nop */ ;
+        frames_.push( frame );
+    }
+
+    for( size_t i = 0; i < detectors_.size(); ++i )
+        frames_.push( Frame( )); // stop
+    for( DetectorsCIter i = detectors_.begin(); i != detectors_.end(); ++i )
+        (*i)->join();
+    running_ = false;
+}
+
+cv::Rect CVTracker::_getFaceROI( const cv::Size& frameSize )
+{
+    lock_.set();
+    const cv::Rect face = face_ + motion_;
+    lock_.unset();
 
-        // detect eyes
-        const cv::Rect& face = faces.front();
-        const cv::Mat faceROI = bwFrame( face );
-        std::vector< cv::Rect > eyes;
-        eyeDetector_.detectMultiScale( faceROI, eyes, 1.1f, 2,
-                                       CV_HAAR_SCALE_IMAGE, cv::Size( 15, 15 ));
-        Vector3f center( 0.f, 0.f, 0.f );
-        Matrix3f rotation( Matrix3f::IDENTITY );
+    if( face.area() == 0 )
+        return cv::Rect();
 
-        if( eyes.size() == 2 )
+    // the predicted face with a margin of half its size
+    const cv::Rect roi( face.x - face.width / 2, face.y - face.height / 2,
+                        face.width * 2, face.height * 2 );
+    return roi & cv::Rect( cv::Point( 0, 0 ), frameSize );
+}
+
+void CVTracker::_update( const Detection& detection )
+{
+    lock_.set();
+    if( detection.sequence <= sequence_ ) // a newer frame was faster
+    {
+        lock_.unset();
+        return;
+    }
+
+    sequence_ = detection.sequence;
+    const cv::Rect& face = detection.face;
+    motion_ = face.area() > 0 && face_.area() > 0 ?
+                  face.tl() - face_.tl() : cv::Point();
+    face_ = face;
+    if( face.area() == 0 )
+    {
+        lock_.unset();
+        return;
+    }
+
+    const std::vector< cv::Rect >& eyes = detection.eyes;
+    Vector3f center( 0.f, 0.f, 0.f );
+    Matrix3f rotation( Matrix3f::IDENTITY );
+
+    if( eyes.size() == 2 )
+    {
+        const Vector2f left( eyes[0].x + eyes[0].width * .5f,
+                             eyes[0].y + eyes[0].height * .5f );
+        const Vector2f right( eyes[1].x + eyes[1].width * .5f,
+                              eyes[1].y + eyes[1].height * .5f );
+        center = (left + right) * .5f;
+        center.z() = (right-left).length() / float(CAPTURE_WIDTH);
+
+        // low pass smooth filter of roll angle
+        roll_.add( atanf( fabs( left.y() - right.y( )) /
+                          fabs( left.x() - right.x( ))));
+        rotation.array[ 0 ] = cosf( *roll_ );
+        rotation.array[ 1 ] = sinf( *roll_ );
+        rotation.array[ 4 ] = -rotation.array[ 1 ];
+        rotation.array[ 5 ] =  rotation.array[ 0 ];
+        head_.set_sub_matrix( rotation );
+
+        if( !isEyeWidth_ && width_ > 0.f )
         {
-            const Vector2f left( face.x + eyes[0].x + eyes[0].width * .5f,
-                                 face.y + eyes[0].y + eyes[0].height * .5f );
-            const Vector2f right( face.x + eyes[1].x + eyes[1].width * .5f,
-                                  face.y + eyes[1].y + eyes[1].height * .5f );
-            center = (left + right) * .5f;
-            center.z() = (right-left).length() / float(CAPTURE_WIDTH);
-
-            // low pass smooth filter of roll angle
-            roll.add( atanf( fabs( left.y() - right.y( )) /
-                             fabs( left.x() - right.x( ))));
-            rotation.array[ 0 ] = cosf( *roll );
-            rotation.array[ 1 ] = sinf( *roll );
-            rotation.array[ 4 ] = -rotation.array[ 1 ];
-            rotation.array[ 5 ] =  rotation.array[ 0 ];
-            head.set_sub_matrix( rotation );
-
-            if( !isEyeWidth && width > 0.f )
-            {
-                headEyeRatio.add( center.z() / width );
-                isEyeWidth = true;
-            }
-            width = center.z();
+            headEyeRatio_.add( center.z() / width_ );
+            isEyeWidth_ = true;
         }
-        else
+        width_ = center.z();
+    }
+    else
+    {
+        center.x() = face.x + face.width * .5f;
+        center.y() = face.y + face.height * .33f; // eyes are in upper third
+        center.z() = face.width / float(CAPTURE_WIDTH);
+
+        if( isEyeWidth_ && width_ > 0.f )
         {
-            center.x() = face.x + face.width * .5f;
-            center.y() = face.y + face.height * .33f; // eyes are in upper third
-            center.z() = face.width / float(CAPTURE_WIDTH);
-
-            if( isEyeWidth && width > 0.f )
-            {
-                headEyeRatio.add( width / center.z() );
-                isEyeWidth = false;
-            }
-            width = center.z();
-            center.z() *= *headEyeRatio;
+            headEyeRatio_.add( width_ / center.z() );
+            isEyeWidth_ = false;
         }
-        center.x() = 2.f * ( -center.x() / float( CAPTURE_WIDTH ) + .5f );
-        center.y() = 2.f * ( -center.y() / float( CAPTURE_HEIGHT ) + .5f );
-
-        // 20 cm macro distance, 2 m tele, inverted scale
-        center.z() *= 4.f;
-        if( center.z() < 0.f )
-            center.z() = 0.f;
-        if( center.z() > 1.f )
-            center.z() = 1.f;
-        center.z() = .2f + (1.f - center.z()) * 2.f;
-        position.add( center ); // low pass smooth filter
-
-        // emit
-        head.x() = position->x();
-        head.y() = position->y();
-        head.z() = position->z();
-
-        LBVERB << "head " << *position << " roll " << *roll << " eyes "
-               << (eyes.size() == 2) <<  " h->e " << *headEyeRatio << std::endl;
-        config->sendEvent( Event::OBSERVER_MOTION ) << originator << head;
+        width_ = center.z();
+        center.z() *= *headEyeRatio_;
     }
+    center.x() = 2.f * ( -center.x() / float( CAPTURE_WIDTH ) + .5f );
+    center.y() = 2.f * ( -center.y() / float( CAPTURE_HEIGHT ) + .5f );
 
-    running_ = false;
+    // 20 cm macro distance, 2 m tele, inverted scale
+    center.z() *= 4.f;
+    if( center.z() < 0.f )
+        center.z() = 0.f;
+    if( center.z() > 1.f )
+        center.z() = 1.f;
+    center.z() = .2f + (1.f - center.z()) * 2.f;
+    position_.add( center ); // low pass smooth filter
+
+    // emit
+    head_.x() = position_->x();
+    head_.y() = position_->y();
+    head_.z() = position_->z();
+
+    LBVERB << "head " << *position_ << " roll " << *roll_ << " eyes "
+           << (eyes.size() == 2) <<  " h->e " << *headEyeRatio_ << std::endl;
+
+    eq::Config* config = observer_->getConfig();
+    const int64_t time = config->getTime();
+    if( updateTime_ > 0 && time > updateTime_ )
+    {
+        const float rate = 1000.f / float( time - updateTime_ );
+        rate_ = rate_ > 0.f ? .5f * ( rate_ + rate ) : rate;
+    }
+    updateTime_ = time;
+
+    // send without blocking the detectors, which need the face position
+    const Matrix4f head = head_;
+    const float rate = rate_;
+    lock_.unset();
+
+    lunchbox::ScopedWrite mutex( sendLock_ );
+    if( detection.sequence < sentSequence_ ) // a newer update was sent
+        return;
+    sentSequence_ = detection.sequence;
+
+    observer_->latchHeadMatrix( head );
+    config->sendEvent( Event::OBSERVER_MOTION ) << observer_->getID()
+                                                << head;
+    ConfigStatistics stat( Statistic::CONFIG_HEAD_TRACKING, config );
+    stat.event.data.statistic.startTime = detection.time;
+    stat.event.data.statistic.ratio = rate;
 }
 
 }
@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *               2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -19,6 +20,8 @@
 #define EQ_CVTRACKER_H
 
 #include <eq/client/types.h>
+#include <lunchbox/lock.h>
+#include <lunchbox/mtQueue.h>
 #include <opencv2/opencv.hpp>
 
 namespace eq
@@ -27,14 +30,22 @@ namespace detail
 {
 /**
  * @internal
- * An OpenCV head tracker running in a separate thread for performance.
+ * An OpenCV head tracker running in separate threads for performance.
+ *
+ * The tracker thread captures the frames, which are processed by a pool of
+ * detector threads. Each detector searches the face in a downscaled frame
+ * around the position predicted from the last update, and in the full frame
+ * only if the face was lost. The newest detection updates the observer.
  */
 class CVTracker : public lunchbox::Thread
 {
 public:
-    /** Construct a new tracker. */
+    /** Construct a new tracker using the given camera. */
     CVTracker( eq::Observer* observer, const uint32_t camera );
 
+    /** Construct a new tracker replaying the given video file in real time. */
+    CVTracker( eq::Observer* observer, const std::string& filename );
+
     /** Destruct this tracker. */
     virtual ~CVTracker();
 
@@ -45,13 +56,62 @@ protected:
     virtual void run();
 
 private:
+    class Detector;
+    friend class Detector;
+    typedef std::vector< Detector* > Detectors;
+    typedef Detectors::const_iterator DetectorsCIter;
+
+    struct Frame
+    {
+        Frame() : time( 0 ), sequence( 0 ) {}
+
+        cv::Mat image; //!< empty to stop the detectors
+        int64_t time; //!< capture time
+        uint64_t sequence;
+    };
+
+    struct Detection
+    {
+        Detection() : time( 0 ), sequence( 0 ) {}
+
+        int64_t time; //!< capture time
+        uint64_t sequence;
+        cv::Rect face; //!< empty if no face was found
+        std::vector< cv::Rect > eyes; //!< in frame coordinates
+    };
+
     eq::Observer* observer_;
-    const uint32_t camera_;
     CvCapture* capture_;
-    cv::CascadeClassifier faceDetector_;
-    cv::CascadeClassifier eyeDetector_;
-
+    float period_; //!< ms between two replayed frames, 0 for a camera
+    Detectors detectors_;
+    lunchbox::MTQueue< Frame > frames_;
     bool running_;
+
+    // update state, protected by lock_
+    lunchbox::Lock lock_;
+    uint64_t sequence_; //!< newest frame used for an update
+    cv::Rect face_; //!< last face position, empty if lost
+    cv::Point motion_; //!< face motion of the last update
+    int64_t updateTime_; //!< time of the last update
+    float rate_; //!< smoothed updates per second
+    vmml::lowpass_filter< 5, Vector3f > position_;
+    vmml::lowpass_filter< 5, float > roll_;
+    vmml::lowpass_filter< 5, float > headEyeRatio_;
+    Matrix4f head_;
+    float width_;
+    bool isEyeWidth_;
+
+    // observer updates, in detection order
+    lunchbox::Lock sendLock_;
+    uint64_t sentSequence_; //!< newest frame sent to the observer
+
+    void _init();
+
+    /** @return the region to search for the face, empty if lost. */
+    cv::Rect _getFaceROI( const cv::Size& frameSize );
+
+    /** Update the observer with the given detection, unless outdated. */
+    void _update( const Detection& detection );
 };
 }
 }
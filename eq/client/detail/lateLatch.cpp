@@ -0,0 +1,135 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "lateLatch.h"
+
+#include <co/dataIStream.h>
+#include <co/dataOStream.h>
+
+#include <cmath>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+static const int64_t _maxHorizon = 100; // ms, don't predict further
+static const float _minAngle = 1e-4f; // radians, below: no rotation
+
+// The matrices are column-major, array[ column * 4 + row ].
+float _get( const Matrix4f& matrix, const int row, const int column )
+{
+    return matrix.array[ column * 4 + row ];
+}
+
+/** Extrapolate the rotation of 'from' to 'to' by the given factor. */
+void _extrapolateRotation( Matrix4f& result, const Matrix4f& from,
+                           const Matrix4f& to, const float factor )
+{
+    // delta = to * transpose( from )
+    float delta[3][3];
+    for( int i = 0; i < 3; ++i )
+        for( int j = 0; j < 3; ++j )
+            delta[i][j] = _get( to, i, 0 ) * _get( from, j, 0 ) +
+                          _get( to, i, 1 ) * _get( from, j, 1 ) +
+                          _get( to, i, 2 ) * _get( from, j, 2 );
+
+    const float cosAngle = ( delta[0][0] + delta[1][1] + delta[2][2] - 1.f ) *
+                           .5f;
+    const float angle = std::acos( LB_MAX( -1.f, LB_MIN( 1.f, cosAngle )));
+    if( angle < _minAngle || angle > float( M_PI ) - _minAngle )
+        return; // no rotation or axis ill-defined
+
+    Vector3f axis( delta[2][1] - delta[1][2], delta[0][2] - delta[2][0],
+                   delta[1][0] - delta[0][1] );
+    axis /= 2.f * std::sin( angle );
+
+    // Rodrigues' formula for the extrapolated angle around the same axis
+    const float a = angle * factor;
+    const float c = std::cos( a );
+    const float s = std::sin( a );
+    const float t = 1.f - c;
+    const float x = axis.x(), y = axis.y(), z = axis.z();
+    const float rotation[3][3] = {{ t*x*x + c,   t*x*y - s*z, t*x*z + s*y },
+                                  { t*x*y + s*z, t*y*y + c,   t*y*z - s*x },
+                                  { t*x*z - s*y, t*y*z + s*x, t*z*z + c   }};
+
+    for( int i = 0; i < 3; ++i )
+        for( int j = 0; j < 3; ++j )
+            result.array[ j * 4 + i ] = rotation[i][0] * _get( to, 0, j ) +
+                                        rotation[i][1] * _get( to, 1, j ) +
+                                        rotation[i][2] * _get( to, 2, j );
+}
+}
+
+LateLatch::LateLatch()
+{}
+
+LateLatch::~LateLatch()
+{}
+
+void LateLatch::push( const Matrix4f& head, const int64_t time )
+{
+    add( head, time );
+    commit();
+}
+
+void LateLatch::add( const Matrix4f& head, const int64_t time )
+{
+    _lock.set();
+    _previous = _current;
+    _current.head = head;
+    _current.time = time;
+    _lock.unset();
+}
+
+void LateLatch::getInstanceData( co::DataOStream& os )
+{
+    _lock.set();
+    os << _previous.head << _previous.time << _current.head << _current.time;
+    _lock.unset();
+}
+
+void LateLatch::applyInstanceData( co::DataIStream& is )
+{
+    is >> _previous.head >> _previous.time >> _current.head >> _current.time;
+}
+
+int64_t LateLatch::predict( Matrix4f& head, const int64_t time ) const
+{
+    if( _current.time == 0 )
+        return 0;
+
+    head = _current.head;
+    const int64_t interval = _current.time - _previous.time;
+    if( _previous.time == 0 || interval <= 0 || time <= _current.time )
+        return _current.time;
+
+    // constant linear and angular velocity of the last two samples
+    const int64_t horizon = LB_MIN( time - _current.time, _maxHorizon );
+    const float factor = float( horizon ) / float( interval );
+    const Vector3f& position = _current.head.get_translation();
+    const Vector3f velocity = position - _previous.head.get_translation();
+
+    _extrapolateRotation( head, _previous.head, _current.head, factor );
+    head.set_translation( position + velocity * factor );
+    return _current.time;
+}
+
+}
+}
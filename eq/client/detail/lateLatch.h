@@ -0,0 +1,78 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_LATELATCH_H
+#define EQ_DETAIL_LATELATCH_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+#include <co/object.h>          // base class
+#include <lunchbox/lock.h>      // member
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * @internal
+ * The two newest head tracker samples of an observer.
+ *
+ * The master instance on the application node commits each new sample, the
+ * render clients map a slave instance and sync it right before drawing.
+ */
+class LateLatch : public co::Object
+{
+public:
+    EQ_API LateLatch();
+    EQ_API virtual ~LateLatch();
+
+    /** Add a new sample and distribute it. Thread-safe on the master. */
+    void push( const Matrix4f& head, const int64_t time );
+
+    /** Add a new sample without distributing it. Thread-safe. */
+    EQ_API void add( const Matrix4f& head, const int64_t time );
+
+    /**
+     * Extrapolate the head matrix to the given time.
+     *
+     * @param head the predicted head matrix, unchanged if no sample is known.
+     * @param time the time to predict for.
+     * @return the time of the newest sample, or 0 if no sample is known.
+     */
+    EQ_API int64_t predict( Matrix4f& head, const int64_t time ) const;
+
+protected:
+    virtual ChangeType getChangeType() const { return INSTANCE; }
+    virtual void getInstanceData( co::DataOStream& os );
+    virtual void applyInstanceData( co::DataIStream& is );
+
+private:
+    struct Sample
+    {
+        Sample() : head( Matrix4f::IDENTITY ), time( 0 ) {}
+
+        Matrix4f head;
+        int64_t time;
+    };
+
+    Sample _previous;
+    Sample _current;
+    lunchbox::Lock _lock; // push vs. getInstanceData on the master
+};
+}
+}
+#endif // EQ_DETAIL_LATELATCH_H
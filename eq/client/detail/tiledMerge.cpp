@@ -0,0 +1,430 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "tiledMerge.h"
+
+#include <eq/client/activePixels.h>
+#include <eq/client/frame.h>
+#include <eq/client/image.h>
+
+#include <lunchbox/os.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+// 128x64 pixels of 32 bit color and depth use 64 KB of the destination
+static const int32_t _tileWidth = 128;
+static const int32_t _tileHeight = 64;
+
+enum Mode
+{
+    MODE_DB,
+    MODE_ACTIVE_DB,
+    MODE_BLEND,
+    MODE_2D
+};
+
+struct Input
+{
+    const Image* image;
+    PixelViewport pvp; //!< The image area relative to the destination
+    Pixel pixel; //!< The pixel decomposition of the image's frame
+    Mode mode;
+};
+typedef std::vector< Input > Inputs;
+
+struct Dest
+{
+    uint8_t* color;
+    uint32_t* depth;
+    int32_t width;
+    size_t pixelSize; //!< of the color buffer
+};
+
+inline const uint32_t* _getPixels( const Image* image,
+                                   const Frame::Buffer buffer )
+{
+    return reinterpret_cast< const uint32_t* >(
+        image->getPixelPointer( buffer ));
+}
+
+void _mergeDB( const Dest& dest, const Input& input, const PixelViewport& area )
+{
+    const uint32_t* color = _getPixels( input.image, Frame::BUFFER_COLOR );
+    const uint32_t* depth = _getPixels( input.image, Frame::BUFFER_DEPTH );
+    uint32_t* destColor = reinterpret_cast< uint32_t* >( dest.color );
+
+    for( int32_t y = area.y; y < area.getYEnd(); ++y )
+    {
+        const size_t skip = size_t( y ) * dest.width + area.x;
+        const size_t src = size_t( y - input.pvp.y ) * input.pvp.w +
+                           area.x - input.pvp.x;
+        uint32_t* destColorIt = destColor + skip;
+        uint32_t* destDepthIt = dest.depth + skip;
+        const uint32_t* colorIt = color + src;
+        const uint32_t* depthIt = depth + src;
+
+        for( int32_t x = 0; x < area.w; ++x )
+        {
+            if( destDepthIt[x] > depthIt[x] )
+            {
+                destColorIt[x] = colorIt[x];
+                destDepthIt[x] = depthIt[x];
+            }
+        }
+    }
+}
+
+void _mergeActiveDB( const Dest& dest, const Input& input,
+                     const PixelViewport& area )
+{
+    const Image* image = input.image;
+    const ActivePixels& activePixels = image->getActivePixels();
+    const bool packedColor = image->hasPackedPixelData( Frame::BUFFER_COLOR );
+    const bool packedDepth = image->hasPackedPixelData( Frame::BUFFER_DEPTH );
+    const uint32_t* color = reinterpret_cast< const uint32_t* >( packedColor ?
+        image->getPackedPixelPointer( Frame::BUFFER_COLOR ) :
+        image->getPixelPointer( Frame::BUFFER_COLOR ));
+    const uint32_t* depth = reinterpret_cast< const uint32_t* >( packedDepth ?
+        image->getPackedPixelPointer( Frame::BUFFER_DEPTH ) :
+        image->getPixelPointer( Frame::BUFFER_DEPTH ));
+    uint32_t* destColor = reinterpret_cast< uint32_t* >( dest.color );
+
+    // the area in image coordinates
+    const uint32_t begin = area.x - input.pvp.x;
+    const uint32_t end = begin + area.w;
+
+    for( int32_t y = area.y; y < area.getYEnd(); ++y )
+    {
+        const uint32_t row = y - input.pvp.y;
+        const size_t skip = size_t( y ) * dest.width + input.pvp.x;
+        uint64_t packed = activePixels.getPackedOffset( row );
+
+        for( const ActivePixels::Run* run = activePixels.getRunsBegin( row );
+             run != activePixels.getRunsEnd( row ) && run->start < end; ++run )
+        {
+            const uint32_t first = std::max( run->start, begin );
+            const uint32_t last = std::min( run->start + run->length, end );
+
+            // packed pixels start at the run, unpacked ones at the row
+            const size_t unpacked = size_t( row ) * input.pvp.w;
+            const size_t colorIt = packedColor ? packed - run->start : unpacked;
+            const size_t depthIt = packedDepth ? packed - run->start : unpacked;
+
+            for( uint32_t x = first; x < last; ++x )
+            {
+                if( dest.depth[ skip + x ] > depth[ depthIt + x ] )
+                {
+                    destColor[ skip + x ] = color[ colorIt + x ];
+                    dest.depth[ skip + x ] = depth[ depthIt + x ];
+                }
+            }
+            packed += run->length;
+        }
+    }
+}
+
+void _merge2D( const Dest& dest, const Input& input, const PixelViewport& area )
+{
+    const uint8_t* color = input.image->getPixelPointer( Frame::BUFFER_COLOR );
+    const size_t rowLength = area.w * dest.pixelSize;
+
+    for( int32_t y = area.y; y < area.getYEnd(); ++y )
+    {
+        const size_t skip = size_t( y ) * dest.width + area.x;
+        const size_t src = size_t( y - input.pvp.y ) * input.pvp.w +
+                           area.x - input.pvp.x;
+        memcpy( dest.color + skip * dest.pixelSize,
+                color + src * dest.pixelSize, rowLength );
+        // clear depth, for depth-assembly into existing FB
+        if( dest.depth )
+            lunchbox::setZero( dest.depth + skip, area.w * sizeof( uint32_t ));
+    }
+}
+
+void _mergeBlend( const Dest& dest, const Input& input,
+                  const PixelViewport& area )
+{
+    const uint8_t* color = input.image->getPixelPointer( Frame::BUFFER_COLOR );
+
+    // premultiplied colors, see Compositor::_mergeBlendImage
+    for( int32_t y = area.y; y < area.getYEnd(); ++y )
+    {
+        const size_t skip = size_t( y ) * dest.width + area.x;
+        const size_t src = size_t( y - input.pvp.y ) * input.pvp.w +
+                           area.x - input.pvp.x;
+        const uint8_t* srcIt = color + src * 4;
+        uint8_t* dst = dest.color + skip * 4;
+
+        for( int32_t x = 0; x < area.w; ++x )
+        {
+            dst[0] = LB_MIN( srcIt[0] + (srcIt[3]*dst[0] >> 8), 255 );
+            dst[1] = LB_MIN( srcIt[1] + (srcIt[3]*dst[1] >> 8), 255 );
+            dst[2] = LB_MIN( srcIt[2] + (srcIt[3]*dst[2] >> 8), 255 );
+            dst[3] =                     srcIt[3]*dst[3] >> 8;
+
+            srcIt += 4;
+            dst += 4;
+        }
+    }
+}
+
+// @return the first sample at origin + i * step which is not before position
+inline int32_t _firstSample( const int32_t position, const int32_t origin,
+                             const uint32_t step )
+{
+    if( position <= origin )
+        return 0;
+    return ( position - origin + step - 1 ) / step;
+}
+
+inline void _mergeSample( const Dest& dest, const Input& input,
+                          const uint8_t* color, const uint32_t* depth,
+                          const size_t to, const size_t from )
+{
+    switch( input.mode )
+    {
+      case MODE_DB:
+      case MODE_ACTIVE_DB:
+          if( dest.depth[ to ] > depth[ from ] )
+          {
+              reinterpret_cast< uint32_t* >( dest.color )[ to ] =
+                  reinterpret_cast< const uint32_t* >( color )[ from ];
+              dest.depth[ to ] = depth[ from ];
+          }
+          break;
+
+      case MODE_BLEND:
+      {
+          const uint8_t* src = color + from * 4;
+          uint8_t* dst = dest.color + to * 4;
+          dst[0] = LB_MIN( src[0] + (src[3]*dst[0] >> 8), 255 );
+          dst[1] = LB_MIN( src[1] + (src[3]*dst[1] >> 8), 255 );
+          dst[2] = LB_MIN( src[2] + (src[3]*dst[2] >> 8), 255 );
+          dst[3] =                   src[3]*dst[3] >> 8;
+          break;
+      }
+
+      case MODE_2D:
+          memcpy( dest.color + to * dest.pixelSize,
+                  color + from * dest.pixelSize, dest.pixelSize );
+          if( dest.depth )
+              dest.depth[ to ] = 0;
+          break;
+    }
+}
+
+// Spread the samples of a pixel-decomposed image with a stride of pixel.w and
+// pixel.h over the destination, starting at pixel.x and pixel.y.
+void _mergePixel( const Dest& dest, const Input& input,
+                  const PixelViewport& area )
+{
+    const Image* image = input.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const Pixel& pixel = input.pixel;
+    const bool hasDepth = input.mode == MODE_DB || input.mode == MODE_ACTIVE_DB;
+    const bool packedColor = input.mode == MODE_ACTIVE_DB &&
+                             image->hasPackedPixelData( Frame::BUFFER_COLOR );
+    const bool packedDepth = input.mode == MODE_ACTIVE_DB &&
+                             image->hasPackedPixelData( Frame::BUFFER_DEPTH );
+    const uint8_t* color = packedColor ?
+        image->getPackedPixelPointer( Frame::BUFFER_COLOR ) :
+        image->getPixelPointer( Frame::BUFFER_COLOR );
+    const uint32_t* depth = !hasDepth ? 0 :
+        reinterpret_cast< const uint32_t* >( packedDepth ?
+            image->getPackedPixelPointer( Frame::BUFFER_DEPTH ) :
+            image->getPixelPointer( Frame::BUFFER_DEPTH ));
+
+    const int32_t originX = input.pvp.x + pixel.x;
+    const int32_t originY = input.pvp.y + pixel.y;
+    const int32_t beginX = _firstSample( area.x, originX, pixel.w );
+    const int32_t endX = std::min( pvp.w, _firstSample( area.getXEnd(),
+                                                        originX, pixel.w ));
+    const int32_t beginY = _firstSample( area.y, originY, pixel.h );
+    const int32_t endY = std::min( pvp.h, _firstSample( area.getYEnd(),
+                                                        originY, pixel.h ));
+
+    for( int32_t y = beginY; y < endY; ++y )
+    {
+        const size_t destRow = size_t( originY + y * pixel.h ) * dest.width +
+                               originX;
+        const size_t row = size_t( y ) * pvp.w;
+
+        if( input.mode != MODE_ACTIVE_DB )
+        {
+            for( int32_t x = beginX; x < endX; ++x )
+                _mergeSample( dest, input, color, depth,
+                              destRow + x * pixel.w, row + x );
+            continue;
+        }
+
+        const ActivePixels& activePixels = image->getActivePixels();
+        uint64_t packed = activePixels.getPackedOffset( y );
+        for( const ActivePixels::Run* run = activePixels.getRunsBegin( y );
+             run != activePixels.getRunsEnd( y ) &&
+                 int32_t( run->start ) < endX; ++run )
+        {
+            const int32_t first = std::max( int32_t( run->start ), beginX );
+            const int32_t last = std::min( int32_t( run->start + run->length ),
+                                           endX );
+            for( int32_t x = first; x < last; ++x )
+            {
+                // packed pixels are consecutive within the run
+                const size_t from = packed + x - run->start;
+                const size_t to = destRow + x * pixel.w;
+                if( dest.depth[ to ] > depth[ packedDepth ? from : row + x ])
+                {
+                    reinterpret_cast< uint32_t* >( dest.color )[ to ] =
+                        reinterpret_cast< const uint32_t* >( color )
+                            [ packedColor ? from : row + x ];
+                    dest.depth[ to ] = depth[ packedDepth ? from : row + x ];
+                }
+            }
+            packed += run->length;
+        }
+    }
+}
+}
+
+PixelViewport getMergePVP( const Frame* frame, const Image* image )
+{
+    const PixelViewport& pvp = image->getPixelViewport();
+    const Pixel& pixel = frame->getPixel();
+    const Vector2i& offset = frame->getOffset();
+
+    return PixelViewport( pvp.x * int32_t( pixel.w ) + offset.x(),
+                          pvp.y * int32_t( pixel.h ) + offset.y(),
+                          pvp.w * pixel.w, pvp.h * pixel.h );
+}
+
+void mergeFramesTiled( const Frames& frames, const bool blendAlpha,
+                       void* destColor, void* destDepth,
+                       const PixelViewport& destPVP )
+{
+    Dest dest = { reinterpret_cast< uint8_t* >( destColor ),
+                  reinterpret_cast< uint32_t* >( destDepth ), destPVP.w, 0 };
+    Inputs inputs;
+
+    for( Frames::const_iterator i = frames.begin(); i != frames.end(); ++i )
+    {
+        const Frame* frame = *i;
+        const Images& images = frame->getImages();
+        for( Images::const_iterator j = images.begin(); j != images.end(); ++j )
+        {
+            const Image* image = *j;
+            if( !image->hasPixelData( Frame::BUFFER_COLOR ))
+                continue;
+
+            Input input;
+            input.image = image;
+            input.pixel = frame->getPixel();
+            input.pvp = getMergePVP( frame, image );
+            input.pvp.x -= destPVP.x;
+            input.pvp.y -= destPVP.y;
+
+            if( image->hasPixelData( Frame::BUFFER_DEPTH ))
+            {
+                LBASSERT( destDepth );
+                input.mode = image->hasActivePixels() ? MODE_ACTIVE_DB :
+                                                        MODE_DB;
+            }
+            else if( blendAlpha && image->hasAlpha( ))
+                input.mode = MODE_BLEND;
+            else
+                input.mode = MODE_2D;
+
+            dest.pixelSize = image->getPixelSize( Frame::BUFFER_COLOR );
+            inputs.push_back( input );
+        }
+    }
+
+    if( inputs.empty( ))
+        return;
+
+    const PixelViewport destArea( 0, 0, destPVP.w, destPVP.h );
+    const int32_t nTilesX = ( destPVP.w + _tileWidth - 1 ) / _tileWidth;
+    const int32_t nTilesY = ( destPVP.h + _tileHeight - 1 ) / _tileHeight;
+
+#pragma omp parallel for schedule( dynamic )
+    for( int32_t i = 0; i < nTilesX * nTilesY; ++i )
+    {
+        PixelViewport tile( ( i % nTilesX ) * _tileWidth,
+                            ( i / nTilesX ) * _tileHeight,
+                            _tileWidth, _tileHeight );
+        tile.intersect( destArea );
+
+        for( Inputs::const_iterator j = inputs.begin(); j != inputs.end(); ++j)
+        {
+            const Input& input = *j;
+            PixelViewport area = tile;
+            area.intersect( input.pvp );
+            if( !area.hasArea( ))
+                continue;
+
+            if( input.pixel != Pixel::ALL )
+            {
+                _mergePixel( dest, input, area );
+                continue;
+            }
+
+            switch( input.mode )
+            {
+              case MODE_DB:
+                  _mergeDB( dest, input, area );
+                  break;
+              case MODE_ACTIVE_DB:
+                  _mergeActiveDB( dest, input, area );
+                  break;
+              case MODE_BLEND:
+                  _mergeBlend( dest, input, area );
+                  break;
+              case MODE_2D:
+                  _merge2D( dest, input, area );
+                  break;
+            }
+        }
+    }
+}
+
+void accumulate( const void* color, const size_t size, float* accum )
+{
+    const uint8_t* input = reinterpret_cast< const uint8_t* >( color );
+
+#pragma omp parallel for
+    for( int64_t i = 0; i < int64_t( size ); ++i )
+        accum[i] += input[i];
+}
+
+void average( const float* accum, const size_t size, const size_t nSteps,
+              void* color )
+{
+    uint8_t* output = reinterpret_cast< uint8_t* >( color );
+    const float scale = 1.f / float( nSteps );
+
+#pragma omp parallel for
+    for( int64_t i = 0; i < int64_t( size ); ++i )
+        output[i] = uint8_t( accum[i] * scale + .5f );
+}
+
+}
+}
@@ -0,0 +1,74 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_TILEDMERGE_H
+#define EQ_DETAIL_TILEDMERGE_H
+
+#include <eq/client/types.h>
+#include <eq/fabric/pixelViewport.h> // return value
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * @return the area covered by an image on the destination, including the frame
+ *         offset and the frame's pixel decomposition.
+ */
+PixelViewport getMergePVP( const Frame* frame, const Image* image );
+
+/**
+ * Merge all images of the given frames into a main memory buffer.
+ *
+ * The destination is split into blocks which fit into the cache. Each block is
+ * processed by one thread, which merges all overlapping input images in frame
+ * order. The result is the same as merging the images one after another.
+ * Images of pixel-decomposed frames are de-interleaved into the destination.
+ *
+ * @param frames the input frames, all images in main memory.
+ * @param blendAlpha blend color-only images with an alpha channel.
+ * @param destColor the destination color buffer.
+ * @param destDepth the destination depth buffer, may be 0 without depth.
+ * @param destPVP the pixel viewport of the destination buffers.
+ */
+void mergeFramesTiled( const Frames& frames, const bool blendAlpha,
+                       void* destColor, void* destDepth,
+                       const PixelViewport& destPVP );
+
+/**
+ * Add the color channels of a main memory buffer to a float accumulator.
+ *
+ * @param color the input color buffer, using one byte per channel.
+ * @param size the number of channels, i.e., bytes, of the color buffer.
+ * @param accum the accumulator of size elements.
+ */
+void accumulate( const void* color, const size_t size, float* accum );
+
+/**
+ * Write the average of the accumulated steps into a color buffer.
+ *
+ * @param accum the accumulator of size elements.
+ * @param size the number of channels, i.e., bytes, of the color buffer.
+ * @param nSteps the number of accumulated steps.
+ * @param color the output color buffer, using one byte per channel.
+ */
+void average( const float* accum, const size_t size, const size_t nSteps,
+              void* color );
+}
+}
+
+#endif // EQ_DETAIL_TILEDMERGE_H
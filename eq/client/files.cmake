@@ -92,6 +92,7 @@ set(WGL_SOURCES
 
 set(CLIENT_PUBLIC_HEADERS
   ${AGL_HEADERS} ${GLX_HEADERS} ${QT_HEADERS} ${WGL_HEADERS}
+  activePixels.h
   api.h
   base.h
   canvas.h
@@ -104,7 +105,9 @@ set(CLIENT_PUBLIC_HEADERS
   config.h
   configEvent.h
   configStatistics.h
+  criticalPathAnalyzer.h
   cudaContext.h
+  dataStreamer.h
   error.h
   eventICommand.h
   eventHandler.h
@@ -112,10 +115,12 @@ set(CLIENT_PUBLIC_HEADERS
   eye.h
   frame.h
   frameData.h
+  frameDataTrace.h
   gl.h
   glException.h
   glWindow.h
   global.h
+  hierarchicalBarrier.h
   image.h
   init.h
   layout.h
@@ -131,6 +136,7 @@ set(CLIENT_PUBLIC_HEADERS
   segment.h
   server.h
   statisticSampler.h
+  statisticsAggregator.h
   system.h
   systemPipe.h
   systemWindow.h
@@ -146,6 +152,8 @@ set(CLIENT_PUBLIC_HEADERS
 
 set(CLIENT_HEADERS
   detail/fileFrameWriter.h
+  detail/lateLatch.h
+  detail/tiledMerge.h
   detail/statsRenderer.h
   exitVisitor.h
   half.h
@@ -155,6 +163,7 @@ set(CLIENT_HEADERS
 
 set(CLIENT_SOURCES
   ${DISPLAYCLUSTER_SOURCES}
+  activePixels.cpp
   canvas.cpp
   channel.cpp
   channelStatistics.cpp
@@ -164,18 +173,24 @@ set(CLIENT_SOURCES
   computeContext.cpp
   config.cpp
   configStatistics.cpp
+  criticalPathAnalyzer.cpp
   cudaContext.cpp
+  dataStreamer.cpp
   detail/channel.ipp
   detail/fileFrameWriter.cpp
+  detail/lateLatch.cpp
+  detail/tiledMerge.cpp
   eventHandler.cpp
   eventICommand.cpp
   frame.cpp
   frameData.cpp
+  frameDataTrace.cpp
   gl.cpp
   glException.cpp
   glWindow.cpp
   global.cpp
   half.cpp
+  hierarchicalBarrier.cpp
   image.cpp
   init.cpp
   jitter.cpp
@@ -192,6 +207,7 @@ set(CLIENT_SOURCES
   roiTracker.cpp
   segment.cpp
   server.cpp
+  statisticsAggregator.cpp
   systemPipe.cpp
   systemWindow.cpp
   version.cpp
@@ -19,6 +19,7 @@
 
 #include "frameData.h"
 
+#include "activePixels.h"
 #include "nodeStatistics.h"
 #include "channelStatistics.h"
 #include "exception.h"
@@ -145,11 +146,21 @@ const Pixel& FrameData::getPixel() const
     return _impl->data.pixel;
 }
 
+void FrameData::setPixel( const Pixel& pixel )
+{
+    _impl->data.pixel = pixel;
+}
+
 const SubPixel& FrameData::getSubPixel() const
 {
     return _impl->data.subpixel;
 }
 
+void FrameData::setSubPixel( const SubPixel& subpixel )
+{
+    _impl->data.subpixel = subpixel;
+}
+
 uint32_t FrameData::getPeriod() const
 {
     return _impl->data.period;
@@ -195,6 +206,16 @@ bool FrameData::isReady() const
     return _impl->readyVersion.get() >= _impl->version;
 }
 
+void FrameData::setDropped( const bool dropped )
+{
+    _impl->data.dropped = dropped;
+}
+
+bool FrameData::isDropped() const
+{
+    return _impl->data.dropped;
+}
+
 void FrameData::disableBuffer( const Frame::Buffer buffer )
 {
     _impl->data.buffers &= ~buffer;
@@ -502,17 +523,36 @@ void FrameData::removeListener( Listener& listener )
 bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
                           const PixelViewport& pvp, const Zoom& zoom,
                           const uint32_t buffers_, const bool useAlpha,
-                          uint8_t* data )
+                          const bool sparse, uint8_t* data )
 {
     LBASSERT( _impl->readyVersion < frameDataVersion.version.low( ));
     if( _impl->readyVersion >= frameDataVersion.version.low( ))
         return false;
 
+    ActivePixels activePixels;
+    if( sparse )
+    {
+        const uint64_t size = *reinterpret_cast< uint64_t* >( data );
+        data += sizeof( uint64_t );
+
+        if( activePixels.deserialize( data, size ) != size ||
+            activePixels.getWidth() != uint32_t( pvp.w ) ||
+            activePixels.getHeight() != uint32_t( pvp.h ))
+        {
+            LBERROR << "Dropping image with corrupt active pixels for " << pvp
+                    << std::endl;
+            return true;
+        }
+        data += size;
+    }
+
     Image* image = _allocImage( Frame::TYPE_MEMORY, DrawableConfig(),
                                 false /* set quality */ );
 
     image->setPixelViewport( pvp );
     image->setAlphaUsage( useAlpha );
+    if( sparse )
+        image->setActivePixels( activePixels );
 
     Frame::Buffer buffers[] = { Frame::BUFFER_COLOR, Frame::BUFFER_DEPTH };
     for( unsigned i = 0; i < 2; ++i )
@@ -532,6 +572,7 @@ bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
             pixelData.compressorFlags = header->compressorFlags;
 
             const uint32_t compressor = header->compressorName;
+            uint64_t dataSize = 0;
             if( compressor > EQ_COMPRESSOR_NONE )
             {
                 pression::CompressorChunks chunks;
@@ -556,12 +597,32 @@ bool FrameData::addImage( const co::ObjectVersion& frameDataVersion,
 
                 pixelData.pixels = data;
                 data += size;
-                LBASSERT( size == pixelData.pvp.getArea()*pixelData.pixelSize );
+                dataSize = size;
+                LBASSERT( sparse ||
+                          size == pixelData.pvp.getArea()*pixelData.pixelSize );
+            }
+
+            // packed data is uncompressed and covers all active pixels
+            if( sparse &&
+                ( compressor > EQ_COMPRESSOR_NONE ||
+                  pixelData.pvp.w != pvp.w || pixelData.pvp.h != pvp.h ||
+                  dataSize != activePixels.getNumPixels() *
+                                pixelData.pixelSize ))
+            {
+                LBERROR << "Dropping image with corrupt active pixel data for "
+                        << pvp << std::endl;
+                _impl->imageCacheLock.set();
+                _impl->imageCache.push_back( image );
+                _impl->imageCacheLock.unset();
+                return true;
             }
 
             image->setZoom( zoom );
             image->setQuality( buffer, header->quality );
-            image->setPixelData( buffer, pixelData );
+            if( sparse )
+                image->setPackedPixelData( buffer, pixelData );
+            else
+                image->setPixelData( buffer, pixelData );
         }
     }
 
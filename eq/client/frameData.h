@@ -112,12 +112,22 @@ public:
      */
     EQ_API const Pixel& getPixel() const;
 
+    /**
+     * Set the pixel decomposition, e.g., for CPU-based compositing of
+     * application-created frames.
+     * @version 1.8
+     */
+    EQ_API void setPixel( const Pixel& pixel );
+
     /**
      * @return the subpixel decomposition wrt the destination channel.
      * @version 1.0
      */
     EQ_API const SubPixel& getSubPixel() const;
 
+    /** Set the subpixel decomposition. @version 1.8 */
+    EQ_API void setSubPixel( const SubPixel& subpixel );
+
     /**
      * @return the DPlex period relative to the destination channel.
      * @version 1.0
@@ -259,6 +269,16 @@ public:
     /** @return true if the frame data is ready. @version 1.0 */
     EQ_API bool isReady() const;
 
+    /**
+     * Mark the frame data as dropped, i.e., its readback was skipped since
+     * the frame missed its deadline.
+     * @internal
+     */
+    void setDropped( const bool dropped );
+
+    /** @return true if the readback of the frame was skipped. @version 1.8 */
+    EQ_API bool isDropped() const;
+
     /** Wait for the frame data to become available. @version 1.0 */
     EQ_API void waitReady( const uint32_t timeout = LB_TIMEOUT_INDEFINITE )
         const;
@@ -302,7 +322,7 @@ public:
     bool addImage( const co::ObjectVersion& frameDataVersion,
                    const PixelViewport& pvp, const Zoom& zoom,
                    const uint32_t buffers, const bool useAlpha,
-                   uint8_t* data );
+                   const bool sparse, uint8_t* data );
     void setReady( const co::ObjectVersion& frameData,
                    const fabric::FrameData& data ); //!< @internal
 
@@ -0,0 +1,469 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "frameDataTrace.h"
+
+#include "frame.h"
+#include "frameData.h"
+
+#include <eq/fabric/frameData.h>
+#include <eq/fabric/zoom.h>
+
+#include <co/objectVersion.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/scopedMutex.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+static const uint32_t _magic = 0x45514654; // 'EQFT'
+static const uint32_t _version = 2; //!< 2: explicit field layout
+
+enum RecordType
+{
+    RECORD_IMAGE,
+    RECORD_READY
+};
+
+/** One received image, referencing its data in the trace buffer. */
+struct ImageRecord
+{
+    co::ObjectVersion frameData;
+    uint32_t frameNumber;
+    float time;
+    PixelViewport pvp;
+    Zoom zoom;
+    uint32_t buffers;
+    uint8_t useAlpha;
+    uint8_t sparse;
+    uint64_t offset;
+    uint64_t size;
+};
+typedef std::vector< ImageRecord > ImageRecords;
+typedef ImageRecords::const_iterator ImageRecordsCIter;
+
+/** All data captured for one frame number. */
+struct Captured
+{
+    Captured() : size( 0 ) {}
+
+    ImageRecords images;
+    std::map< uint128_t, fabric::FrameData > ready;
+    std::vector< uint128_t > order; //!< frame datas in order of arrival
+    uint64_t size;
+};
+typedef std::map< uint32_t, Captured > CapturedMap;
+typedef CapturedMap::const_iterator CapturedMapCIter;
+
+// Scalars are stored in host byte order, the magic detects foreign traces.
+template< class T > void _put( std::ofstream& file, const T value )
+{
+    file.write( reinterpret_cast< const char* >( &value ), sizeof( T ));
+}
+
+template< class T > bool _get( const std::vector< uint8_t >& data,
+                               uint64_t& offset, T& value )
+{
+    if( offset + sizeof( T ) > data.size( ))
+        return false;
+    memcpy( &value, &data[ offset ], sizeof( T ));
+    offset += sizeof( T );
+    return true;
+}
+
+// Structures are written field by field, independent of their memory layout.
+void _write( std::ofstream& file, const uint128_t& value )
+{
+    _put( file, value.high( ));
+    _put( file, value.low( ));
+}
+
+void _write( std::ofstream& file, const co::ObjectVersion& value )
+{
+    _write( file, value.identifier );
+    _write( file, value.version );
+}
+
+void _write( std::ofstream& file, const PixelViewport& value )
+{
+    _put( file, value.x );
+    _put( file, value.y );
+    _put( file, value.w );
+    _put( file, value.h );
+}
+
+void _write( std::ofstream& file, const Zoom& value )
+{
+    _put( file, value.x( ));
+    _put( file, value.y( ));
+}
+
+void _write( std::ofstream& file, const fabric::FrameData& value )
+{
+    _write( file, value.pvp );
+    _put( file, uint32_t( value.frameType ));
+    _put( file, value.buffers );
+    _put( file, value.period );
+    _put( file, value.phase );
+    _put( file, value.range.start );
+    _put( file, value.range.end );
+    _put( file, value.pixel.x );
+    _put( file, value.pixel.y );
+    _put( file, value.pixel.w );
+    _put( file, value.pixel.h );
+    _put( file, value.subpixel.index );
+    _put( file, value.subpixel.size );
+    _write( file, value.zoom );
+    _put( file, uint8_t( value.dropped ));
+}
+
+bool _read( const std::vector< uint8_t >& data, uint64_t& offset,
+            uint128_t& value )
+{
+    uint64_t high = 0;
+    uint64_t low = 0;
+    if( !_get( data, offset, high ) || !_get( data, offset, low ))
+        return false;
+    value = uint128_t( high, low );
+    return true;
+}
+
+bool _read( const std::vector< uint8_t >& data, uint64_t& offset,
+            co::ObjectVersion& value )
+{
+    return _read( data, offset, value.identifier ) &&
+           _read( data, offset, value.version );
+}
+
+bool _read( const std::vector< uint8_t >& data, uint64_t& offset,
+            PixelViewport& value )
+{
+    return _get( data, offset, value.x ) && _get( data, offset, value.y ) &&
+           _get( data, offset, value.w ) && _get( data, offset, value.h );
+}
+
+bool _read( const std::vector< uint8_t >& data, uint64_t& offset,
+            Zoom& value )
+{
+    float x = 0.f;
+    float y = 0.f;
+    if( !_get( data, offset, x ) || !_get( data, offset, y ))
+        return false;
+    value = Zoom( x, y );
+    return true;
+}
+
+bool _read( const std::vector< uint8_t >& data, uint64_t& offset,
+            fabric::FrameData& value )
+{
+    uint32_t frameType = 0;
+    uint8_t dropped = 0;
+    if( !_read( data, offset, value.pvp ) ||
+        !_get( data, offset, frameType ) ||
+        !_get( data, offset, value.buffers ) ||
+        !_get( data, offset, value.period ) ||
+        !_get( data, offset, value.phase ) ||
+        !_get( data, offset, value.range.start ) ||
+        !_get( data, offset, value.range.end ) ||
+        !_get( data, offset, value.pixel.x ) ||
+        !_get( data, offset, value.pixel.y ) ||
+        !_get( data, offset, value.pixel.w ) ||
+        !_get( data, offset, value.pixel.h ) ||
+        !_get( data, offset, value.subpixel.index ) ||
+        !_get( data, offset, value.subpixel.size ) ||
+        !_read( data, offset, value.zoom ) ||
+        !_get( data, offset, dropped ))
+    {
+        return false;
+    }
+    value.frameType = fabric::Frame::Type( frameType );
+    value.dropped = dropped != 0;
+    return true;
+}
+}
+
+class FrameDataTrace
+{
+public:
+    FrameDataTrace() : nImages( 0 ) {}
+    ~FrameDataTrace() { clearFrames(); }
+
+    void clearFrames()
+    {
+        for( FramesCIter i = frames.begin(); i != frames.end(); ++i )
+            delete *i;
+        frames.clear();
+    }
+
+    bool parse()
+    {
+        uint64_t offset = 0;
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if( !_get( data, offset, magic ) || magic != _magic ||
+            !_get( data, offset, version ) || version != _version )
+        {
+            LBWARN << "Not a frame data trace or unsupported version"
+                   << std::endl;
+            return false;
+        }
+
+        while( offset < data.size( ))
+        {
+            uint32_t type = 0;
+            if( !_get( data, offset, type ))
+                return false;
+
+            if( type == RECORD_READY )
+            {
+                co::ObjectVersion frameData;
+                uint32_t frameNumber = 0;
+                fabric::FrameData ready;
+                if( !_read( data, offset, frameData ) ||
+                    !_get( data, offset, frameNumber ) ||
+                    !_read( data, offset, ready ))
+                {
+                    return false;
+                }
+                captured[ frameNumber ].ready[ frameData.identifier ] = ready;
+                continue;
+            }
+
+            ImageRecord image;
+            if( type != RECORD_IMAGE ||
+                !_read( data, offset, image.frameData ) ||
+                !_get( data, offset, image.frameNumber ) ||
+                !_get( data, offset, image.time ) ||
+                !_read( data, offset, image.pvp ) ||
+                !_read( data, offset, image.zoom ) ||
+                !_get( data, offset, image.buffers ) ||
+                !_get( data, offset, image.useAlpha ) ||
+                !_get( data, offset, image.sparse ) ||
+                !_get( data, offset, image.size ) ||
+                offset + image.size > data.size( ))
+            {
+                LBWARN << "Truncated frame data trace at byte " << offset
+                       << std::endl;
+                return false;
+            }
+            image.offset = offset;
+            offset += image.size;
+
+            Captured& frame = captured[ image.frameNumber ];
+            const uint128_t& id = image.frameData.identifier;
+            if( std::find( frame.order.begin(), frame.order.end(), id ) ==
+                frame.order.end( ))
+            {
+                frame.order.push_back( id );
+            }
+            frame.images.push_back( image );
+            frame.size += image.size;
+            ++nImages;
+        }
+        return true;
+    }
+
+    // capture
+    std::ofstream file;
+    lunchbox::Clock clock;
+    std::map< uint128_t, uint32_t > frameNumbers; //!< of pending frame datas
+    lunchbox::Lock lock;
+
+    // replay
+    std::vector< uint8_t > data;
+    CapturedMap captured;
+    size_t nImages;
+    std::map< uint128_t, FrameDataPtr > frameDatas;
+    std::map< uint128_t, uint64_t > versions;
+    Frames frames;
+};
+}
+
+FrameDataTrace::FrameDataTrace()
+    : _impl( new detail::FrameDataTrace )
+{}
+
+FrameDataTrace::~FrameDataTrace()
+{
+    delete _impl;
+}
+
+bool FrameDataTrace::open( const std::string& filename )
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    _impl->file.open( filename.c_str(), std::ios::out | std::ios::binary |
+                                        std::ios::trunc );
+    if( !_impl->file )
+    {
+        LBWARN << "Can't open frame data trace " << filename << std::endl;
+        return false;
+    }
+
+    detail::_put( _impl->file, detail::_magic );
+    detail::_put( _impl->file, detail::_version );
+    _impl->clock.reset();
+    return true;
+}
+
+void FrameDataTrace::writeImage( const co::ObjectVersion& frameData,
+                                 const uint32_t frameNumber,
+                                 const PixelViewport& pvp, const Zoom& zoom,
+                                 const uint32_t buffers, const bool useAlpha,
+                                 const bool sparse, const void* data,
+                                 const uint64_t size )
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    if( !_impl->file.is_open( ))
+        return;
+
+    std::ofstream& file = _impl->file;
+    detail::_put( file, uint32_t( detail::RECORD_IMAGE ));
+    detail::_write( file, frameData );
+    detail::_put( file, frameNumber );
+    detail::_put( file, _impl->clock.getTimef( ));
+    detail::_write( file, pvp );
+    detail::_write( file, zoom );
+    detail::_put( file, buffers );
+    detail::_put( file, uint8_t( useAlpha ));
+    detail::_put( file, uint8_t( sparse ));
+    detail::_put( file, size );
+    file.write( reinterpret_cast< const char* >( data ), size );
+
+    _impl->frameNumbers[ frameData.identifier ] = frameNumber;
+}
+
+void FrameDataTrace::writeReady( const co::ObjectVersion& frameData,
+                                 const fabric::FrameData& data )
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    std::map< uint128_t, uint32_t >::iterator i =
+        _impl->frameNumbers.find( frameData.identifier );
+    if( !_impl->file.is_open() || i == _impl->frameNumbers.end( ))
+        return;
+
+    std::ofstream& file = _impl->file;
+    detail::_put( file, uint32_t( detail::RECORD_READY ));
+    detail::_write( file, frameData );
+    detail::_put( file, i->second );
+    detail::_write( file, data );
+    _impl->frameNumbers.erase( i );
+}
+
+size_t FrameDataTrace::read( const std::string& filename )
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file )
+    {
+        LBWARN << "Can't open frame data trace " << filename << std::endl;
+        return 0;
+    }
+
+    file.seekg( 0, std::ios::end );
+    const std::streamoff size = file.tellg();
+    file.seekg( 0, std::ios::beg );
+
+    std::vector< uint8_t >& data = _impl->data;
+    data.resize( size );
+    if( size > 0 )
+        file.read( reinterpret_cast< char* >( &data[0] ), size );
+
+    _impl->captured.clear();
+    _impl->nImages = 0;
+    _impl->parse();
+    return _impl->nImages;
+}
+
+std::vector< uint32_t > FrameDataTrace::getFrames() const
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    std::vector< uint32_t > frames;
+    for( detail::CapturedMapCIter i = _impl->captured.begin();
+         i != _impl->captured.end(); ++i )
+    {
+        frames.push_back( i->first );
+    }
+    return frames;
+}
+
+uint64_t FrameDataTrace::getSize( const uint32_t frameNumber ) const
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    detail::CapturedMapCIter i = _impl->captured.find( frameNumber );
+    return i == _impl->captured.end() ? 0 : i->second.size;
+}
+
+const Frames& FrameDataTrace::receive( const uint32_t frameNumber )
+{
+    lunchbox::ScopedWrite mutex( _impl->lock );
+    _impl->clearFrames();
+
+    detail::CapturedMapCIter i = _impl->captured.find( frameNumber );
+    if( i == _impl->captured.end( ))
+        return _impl->frames;
+
+    const detail::Captured& captured = i->second;
+    for( std::vector< uint128_t >::const_iterator j = captured.order.begin();
+         j != captured.order.end(); ++j )
+    {
+        const uint128_t& id = *j;
+        FrameDataPtr& frameData = _impl->frameDatas[ id ];
+        if( !frameData )
+            frameData = new FrameData;
+
+        // new version for each replay, as for each received frame
+        const uint64_t version = ++_impl->versions[ id ];
+        const co::ObjectVersion objectVersion( id, version );
+        frameData->setVersion( version );
+
+        fabric::FrameData data;
+        for( detail::ImageRecordsCIter k = captured.images.begin();
+             k != captured.images.end(); ++k )
+        {
+            const detail::ImageRecord& image = *k;
+            if( image.frameData.identifier != id )
+                continue;
+
+            data.buffers |= image.buffers;
+            LBCHECK( frameData->addImage( objectVersion, image.pvp,
+                                          image.zoom, image.buffers,
+                                          image.useAlpha, image.sparse,
+                                          &_impl->data[ image.offset ] ));
+        }
+
+        std::map< uint128_t, fabric::FrameData >::const_iterator ready =
+            captured.ready.find( id );
+        if( ready != captured.ready.end( ))
+            data = ready->second;
+        frameData->setReady( objectVersion, data );
+
+        Frame* frame = new Frame;
+        frame->setFrameData( frameData );
+        _impl->frames.push_back( frame );
+    }
+    return _impl->frames;
+}
+
+}
@@ -0,0 +1,130 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_FRAMEDATATRACE_H
+#define EQ_FRAMEDATATRACE_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace eq
+{
+namespace detail { class FrameDataTrace; }
+
+/**
+ * Captures and replays the output frame data received by a node.
+ *
+ * During capture, every image received for an input frame is written with its
+ * header and compressed pixel data as sent by the source channel, together
+ * with the frame number, the arrival time and the frame data parameters set
+ * when the frame data becomes ready. Capture is enabled on all render client
+ * nodes by setting the environment variable EQ_FRAMEDATA_TRACE to a file name
+ * prefix; each node writes to <prefix>.<node identifier>.
+ *
+ * During replay, the images of one captured frame are decompressed into
+ * application-owned frame datas, which then can be composited using the
+ * Compositor, e.g., with mergeFramesCPU(). This allows benchmarking the
+ * receive, decompress and merge path without a cluster, GPUs or the
+ * application.
+ */
+class FrameDataTrace : public boost::noncopyable
+{
+public:
+    /** Construct a new, empty trace. @version 1.8 */
+    EQ_API FrameDataTrace();
+
+    /** Destruct this trace and all replay frames. @version 1.8 */
+    EQ_API ~FrameDataTrace();
+
+    /** @name Capture */
+    //@{
+    /**
+     * Open a file for capturing received frame data.
+     *
+     * @return true if the file was opened, false otherwise.
+     * @version 1.8
+     */
+    EQ_API bool open( const std::string& filename );
+
+    /**
+     * Record one received image.
+     *
+     * @param frameData the frame data version the image belongs to.
+     * @param frameNumber the frame number of the image.
+     * @param pvp the pixel viewport of the image.
+     * @param zoom the zoom of the image.
+     * @param buffers the transmitted frame buffer attachments.
+     * @param useAlpha the alpha usage of the image.
+     * @param sparse true if the image has active pixel runs.
+     * @param data the image headers and pixel data.
+     * @param size the size of the data.
+     * @version 1.8
+     */
+    EQ_API void writeImage( const co::ObjectVersion& frameData,
+                            const uint32_t frameNumber,
+                            const PixelViewport& pvp, const Zoom& zoom,
+                            const uint32_t buffers, const bool useAlpha,
+                            const bool sparse, const void* data,
+                            const uint64_t size );
+
+    /**
+     * Record the parameters of a ready frame data.
+     *
+     * Frame data without any received images are not recorded.
+     * @version 1.8
+     */
+    EQ_API void writeReady( const co::ObjectVersion& frameData,
+                            const fabric::FrameData& data );
+    //@}
+
+    /** @name Replay */
+    //@{
+    /**
+     * Read a captured trace.
+     *
+     * @return the number of read images.
+     * @version 1.8
+     */
+    EQ_API size_t read( const std::string& filename );
+
+    /** @return the captured frame numbers, in ascending order. @version 1.8 */
+    EQ_API std::vector< uint32_t > getFrames() const;
+
+    /** @return the number of captured bytes of a frame. @version 1.8 */
+    EQ_API uint64_t getSize( const uint32_t frameNumber ) const;
+
+    /**
+     * Receive all images of a captured frame.
+     *
+     * The images are decompressed into one ready frame data for each
+     * captured frame data, in the captured order. The returned frames stay
+     * valid until the next call or the destruction of this trace.
+     *
+     * @return the input frames of the captured frame.
+     * @version 1.8
+     */
+    EQ_API const Frames& receive( const uint32_t frameNumber );
+    //@}
+
+private:
+    detail::FrameDataTrace* const _impl;
+};
+}
+
+#endif // EQ_FRAMEDATATRACE_H
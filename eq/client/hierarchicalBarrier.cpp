@@ -0,0 +1,214 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "hierarchicalBarrier.h"
+
+#include <co/customICommand.h>
+#include <co/customOCommand.h>
+#include <co/exception.h>
+#include <co/localNode.h>
+#include <lunchbox/condition.h>
+
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <deque>
+#include <map>
+
+namespace eq
+{
+namespace
+{
+/** The custom command notifying a node of a finished round. */
+static const uint128_t _cmdRound( 0xb9c2a5f31e0d4c67ull,
+                                  0x8f4a1d2e6b3c5970ull );
+
+struct State
+{
+    State() : entered( 0 ), left( 0 ), rounds( 0 ), released( false )
+            , success( false ) {}
+
+    uint32_t entered; //!< The number of local threads which entered
+    uint32_t left; //!< The number of local threads which left
+    uint64_t rounds; //!< The received round notifications, one bit per round
+    bool released; //!< The last local thread finished all rounds
+    bool success; //!< All rounds were finished in time
+};
+typedef std::map< uint128_t, State > StateMap;
+typedef std::map< co::NodeID, co::NodePtr > NodeMap;
+
+static const size_t _maxFinished = 64; //!< Remembered left barriers
+}
+
+namespace detail
+{
+class HierarchicalBarrier
+{
+public:
+    explicit HierarchicalBarrier( co::LocalNode& localNode_ )
+        : localNode( localNode_ )
+    {
+        localNode.registerCommandHandler( _cmdRound,
+            boost::bind( &HierarchicalBarrier::cmdRound, this, _1 ), 0 );
+    }
+
+    bool enter( const uint128_t& id, const uint32_t height,
+                const co::NodeIDs& nodes, const uint32_t timeout )
+    {
+        LBASSERT( height > 0 );
+        condition.lock();
+        State& state = states[ id ];
+
+        if( ++state.entered < height )
+        {
+            // wait for the last local thread
+            bool inTime = true;
+            while( inTime && !state.released )
+                inTime = condition.timedWait( timeout );
+
+            const bool success = inTime && state.success;
+            leave( id, state, height );
+            condition.unlock();
+            return success;
+        }
+
+        const co::NodeIDs::const_iterator self =
+            std::find( nodes.begin(), nodes.end(), localNode.getNodeID( ));
+        LBASSERTINFO( self != nodes.end(), "Local node not in barrier" );
+
+        const size_t nNodes = nodes.size();
+        const size_t index = self - nodes.begin();
+        bool success = ( self != nodes.end( ));
+
+        for( uint32_t round = 0, distance = 1; success && distance < nNodes;
+             ++round, distance <<= 1 )
+        {
+            condition.unlock();
+            const co::NodeID& nodeID = nodes[ ( index + distance ) % nNodes ];
+            const bool sent = send( nodeID, id, round );
+            condition.lock();
+
+            const uint64_t bit = uint64_t( 1 ) << round;
+            success = sent;
+            while( success && !( state.rounds & bit ))
+                success = condition.timedWait( timeout );
+        }
+
+        if( !success )
+            LBWARN << "Timeout in hierarchical barrier " << id << std::endl;
+
+        state.released = true;
+        state.success = success;
+        condition.broadcast();
+        leave( id, state, height );
+        condition.unlock();
+        return success;
+    }
+
+    /** Notify the given node of a finished round. Unlocked. */
+    bool send( const co::NodeID& nodeID, const uint128_t& id,
+               const uint32_t round )
+    {
+        try
+        {
+            co::NodePtr node = getPeer( nodeID );
+            if( !node )
+            {
+                LBWARN << "Can't connect node " << nodeID
+                       << " for swap barrier" << std::endl;
+                return false;
+            }
+            node->send( _cmdRound ) << id << round;
+            return true;
+        }
+        catch( const co::Exception& e )
+        {
+            LBWARN << e.what() << " for swap barrier " << id << std::endl;
+            return false;
+        }
+    }
+
+    /** @return the connected peer node, connecting it only once. Unlocked. */
+    co::NodePtr getPeer( const co::NodeID& nodeID )
+    {
+        condition.lock();
+        co::NodePtr node = peers[ nodeID ];
+        condition.unlock();
+        if( node && node->isConnected( ))
+            return node;
+
+        node = localNode.connect( nodeID );
+        condition.lock();
+        peers[ nodeID ] = node;
+        condition.unlock();
+        return node;
+    }
+
+    /** Remove the state after the last local thread left. Locked. */
+    void leave( const uint128_t& id, State& state, const uint32_t height )
+    {
+        if( ++state.left < height )
+            return;
+
+        states.erase( id );
+        finished.push_back( id );
+        if( finished.size() > _maxFinished )
+            finished.pop_front();
+    }
+
+    bool cmdRound( co::CustomICommand& command )
+    {
+        const uint128_t& id = command.read< uint128_t >();
+        const uint32_t round = command.read< uint32_t >();
+
+        condition.lock();
+        // Drop late notifications of left barriers, e.g., after a timeout.
+        // Unknown barriers are kept, since the local threads may enter later.
+        if( std::find( finished.begin(), finished.end(), id ) ==
+            finished.end( ))
+        {
+            states[ id ].rounds |= uint64_t( 1 ) << round;
+            condition.broadcast();
+        }
+        condition.unlock();
+        return true;
+    }
+
+    co::LocalNode& localNode;
+    lunchbox::Condition condition;
+    StateMap states;
+    std::deque< uint128_t > finished; //!< The last left barriers
+    NodeMap peers; //!< The connected barrier peers
+};
+}
+
+HierarchicalBarrier::HierarchicalBarrier( co::LocalNode& localNode )
+    : _impl( new detail::HierarchicalBarrier( localNode ))
+{}
+
+HierarchicalBarrier::~HierarchicalBarrier()
+{
+    delete _impl;
+}
+
+bool HierarchicalBarrier::enter( const uint128_t& id, const uint32_t height,
+                                 const co::NodeIDs& nodes,
+                                 const uint32_t timeout )
+{
+    return _impl->enter( id, height, nodes, timeout );
+}
+
+}
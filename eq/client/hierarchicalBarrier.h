@@ -0,0 +1,80 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_HIERARCHICALBARRIER_H
+#define EQ_HIERARCHICALBARRIER_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+
+#include <co/types.h>
+#include <lunchbox/types.h>
+
+namespace eq
+{
+namespace detail { class HierarchicalBarrier; }
+
+/**
+ * A barrier for multiple threads in multiple processes, without a master.
+ *
+ * The entering threads of one process synchronize locally first. The last
+ * local thread then synchronizes with the other processes using a
+ * dissemination barrier: in round k, each process notifies the process 2^k
+ * positions after itself and waits for the notification of the process 2^k
+ * positions before itself. After ceil(log2(n)) rounds all processes have
+ * entered, and the local threads are released.
+ *
+ * Each use of the barrier is identified by a unique identifier, which is used
+ * by all participants. Notifications may arrive before the local threads
+ * entered. One instance handles all barriers of a local node, since it
+ * registers a custom command handler with the node.
+ */
+class HierarchicalBarrier : public boost::noncopyable
+{
+public:
+    /**
+     * Construct a new barrier handler for the given local node.
+     *
+     * The local node has to outlive the barrier.
+     * @version 1.8
+     */
+    EQ_API explicit HierarchicalBarrier( co::LocalNode& localNode );
+
+    /** Destruct the barrier handler. @version 1.8 */
+    EQ_API ~HierarchicalBarrier();
+
+    /**
+     * Enter the barrier with the given identifier.
+     *
+     * @param id the unique identifier of this barrier instance.
+     * @param height the number of local threads entering this instance.
+     * @param nodes the participating nodes, in the same order on all nodes.
+     *              Has to contain the local node.
+     * @param timeout the timeout in milliseconds for each wait.
+     * @return true if all participants entered, false on timeout.
+     * @version 1.8
+     */
+    EQ_API bool enter( const uint128_t& id, const uint32_t height,
+                       const co::NodeIDs& nodes,
+                       const uint32_t timeout = LB_TIMEOUT_INDEFINITE );
+
+private:
+    detail::HierarchicalBarrier* const _impl;
+};
+}
+
+#endif // EQ_HIERARCHICALBARRIER_H
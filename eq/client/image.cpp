@@ -19,6 +19,7 @@
 
 #include "image.h"
 
+#include "activePixels.h"
 #include "gl.h"
 #include "half.h"
 #include "log.h"
@@ -32,6 +33,7 @@
 #include <co/global.h>
 
 #include <lunchbox/buffer.h>
+#include <lunchbox/lock.h>
 #include <lunchbox/memoryMap.h>
 #include <lunchbox/omp.h>
 #include <pression/compressor.h>
@@ -62,6 +64,7 @@ public:
     Memory()
         : state( INVALID )
         , hasAlpha( true )
+        , packed( false )
     {}
 
     void flush()
@@ -69,7 +72,9 @@ public:
         PixelData::reset();
         state = INVALID;
         localBuffer.clear();
+        packedBuffer.clear();
         hasAlpha = true;
+        packed = false;
     }
 
     void useLocalBuffer()
@@ -98,6 +103,10 @@ public:
     lunchbox::Bufferb localBuffer;
 
     bool hasAlpha; //!< The uncompressed pixels contain alpha
+
+    /** The pixels contain only the active pixels, stored in packedBuffer. */
+    bool packed;
+    lunchbox::Bufferb packedBuffer;
 };
 
 enum ActivePlugin
@@ -182,6 +191,12 @@ public:
     /** Alpha channel significance. */
     bool ignoreAlpha;
 
+    /** The run-length encoded active pixels, if computed or received. */
+    ActivePixels activePixels;
+
+    /** Serializes unpacking from concurrent const pixel accesses. */
+    lunchbox::Lock unpackLock;
+
     Attachment& getAttachment( const eq::Frame::Buffer buffer )
     {
         switch( buffer )
@@ -215,6 +230,41 @@ public:
     const Memory& getMemory( const eq::Frame::Buffer buffer ) const
         { return getAttachment( buffer ).memory; }
 
+    /** Expand packed pixel data to the full pixel viewport. */
+    void unpack( const eq::Frame::Buffer buffer )
+    {
+        Memory& memory = getMemory( buffer );
+        unpackLock.set();
+        if( memory.packed )
+        {
+            memory.useLocalBuffer();
+
+            const uint8_t background = memory.externalFormat ==
+                EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT ? 0xff : 0;
+            activePixels.unpack( memory.packedBuffer.getData(),
+                                 memory.pixelSize, background,
+                                 reinterpret_cast< uint8_t* >( memory.pixels ));
+            memory.packed = false;
+        }
+        unpackLock.unset();
+    }
+
+    /** Invalidate the active pixels, unpacking all packed data. */
+    void invalidateActivePixels()
+    {
+        unpack( eq::Frame::BUFFER_COLOR );
+        unpack( eq::Frame::BUFFER_DEPTH );
+        activePixels.clear();
+    }
+
+    /** Drop the active pixels, e.g., for new pixel data. */
+    void clearActivePixels()
+    {
+        color.memory.packed = false;
+        depth.memory.packed = false;
+        activePixels.clear();
+    }
+
     EqCompressorInfos findTransferers( const eq::Frame::Buffer buffer,
                                        const GLEWContext* gl ) const
     {
@@ -242,6 +292,7 @@ Image::~Image()
 void Image::reset()
 {
     _impl->ignoreAlpha = false;
+    _impl->zoom = Zoom::NONE;
     setPixelViewport( PixelViewport( ));
 }
 
@@ -249,6 +300,7 @@ void Image::flush()
 {
     _impl->color.flush();
     _impl->depth.flush();
+    _impl->activePixels.clear();
 }
 
 void Image::resetPlugins()
@@ -444,18 +496,21 @@ const util::Texture& Image::getTexture( const Frame::Buffer buffer ) const
 const uint8_t* Image::getPixelPointer( const Frame::Buffer buffer ) const
 {
     LBASSERT( hasPixelData( buffer ));
+    _impl->unpack( buffer );
     return reinterpret_cast< const uint8_t* >( _impl->getMemory( buffer ).pixels );
 }
 
 uint8_t* Image::getPixelPointer( const Frame::Buffer buffer )
 {
     LBASSERT( hasPixelData( buffer ));
+    _impl->unpack( buffer );
     return  reinterpret_cast< uint8_t* >( _impl->getMemory( buffer ).pixels );
 }
 
 const PixelData& Image::getPixelData( const Frame::Buffer buffer ) const
 {
     LBASSERT( hasPixelData( buffer ));
+    _impl->unpack( buffer );
     return _impl->getMemory( buffer );
 }
 
@@ -526,6 +581,7 @@ bool Image::startReadback( const uint32_t buffers, const PixelViewport& pvp,
     _impl->pvp = pvp;
     _impl->color.memory.state = Memory::INVALID;
     _impl->depth.memory.state = Memory::INVALID;
+    _impl->clearActivePixels();
 
     bool needFinish = (buffers & Frame::BUFFER_COLOR) &&
                          _startReadback( Frame::BUFFER_COLOR, zoom, glObjects );
@@ -792,6 +848,7 @@ void Image::setPixelViewport( const PixelViewport& pvp )
     _impl->depth.memory.state = Memory::INVALID;
     _impl->color.memory.compressedData = pression::CompressorResult();
     _impl->depth.memory.compressedData = pression::CompressorResult();
+    _impl->clearActivePixels();
 }
 
 void Image::clearPixelData( const Frame::Buffer buffer )
@@ -835,6 +892,7 @@ void Image::clearPixelData( const Frame::Buffer buffer )
 
 void Image::validatePixelData( const Frame::Buffer buffer )
 {
+    _impl->invalidateActivePixels();
     Memory& memory = _impl->getAttachment( buffer ).memory;
     memory.useLocalBuffer();
     memory.state = Memory::VALID;
@@ -843,6 +901,7 @@ void Image::validatePixelData( const Frame::Buffer buffer )
 
 void Image::setPixelData( const Frame::Buffer buffer, const PixelData& pixels )
 {
+    _impl->invalidateActivePixels();
     Memory& memory = _impl->getMemory( buffer );
     memory.externalFormat = pixels.externalFormat;
     memory.internalFormat = pixels.internalFormat;
@@ -996,6 +1055,7 @@ void Image::useCompressor( const Frame::Buffer buffer, const uint32_t name )
 const PixelData& Image::compressPixelData( const Frame::Buffer buffer )
 {
     LBASSERT( getPixelDataSize( buffer ) > 0 );
+    _impl->unpack( buffer );
 
     Attachment& attachment = _impl->getAttachment( buffer );
     Memory& memory = attachment.memory;
@@ -1142,6 +1202,7 @@ void put16f( std::ostream& os, const char* ptr )
 bool Image::writeImage( const std::string& filename,
                         const Frame::Buffer buffer ) const
 {
+    _impl->unpack( buffer );
     const Memory& memory = _impl->getMemory( buffer );
 
     const PixelViewport& pvp = memory.pvp;
@@ -1636,4 +1697,86 @@ void Image::setOffset( int32_t x, int32_t y )
     _impl->pvp.y = y;
 }
 
+//---------------------------------------------------------------------------
+// Active pixels
+//---------------------------------------------------------------------------
+bool Image::computeActivePixels()
+{
+    if( _impl->activePixels.isEmpty( ))
+    {
+        if( hasPixelData( Frame::BUFFER_DEPTH ) &&
+            getExternalFormat( Frame::BUFFER_DEPTH ) ==
+                EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT )
+        {
+            const Memory& memory = _impl->getMemory( Frame::BUFFER_DEPTH );
+            _impl->activePixels.computeDepth(
+                reinterpret_cast< const uint32_t* >( memory.pixels ),
+                memory.pvp );
+        }
+        else if( hasPixelData( Frame::BUFFER_COLOR ) &&
+                 getPixelSize( Frame::BUFFER_COLOR ) == 4 )
+        {
+            const Memory& memory = _impl->getMemory( Frame::BUFFER_COLOR );
+            _impl->activePixels.computeColor(
+                reinterpret_cast< const uint32_t* >( memory.pixels ),
+                memory.pvp );
+        }
+    }
+    return !_impl->activePixels.isEmpty();
+}
+
+bool Image::hasActivePixels() const
+{
+    return !_impl->activePixels.isEmpty();
+}
+
+const ActivePixels& Image::getActivePixels() const
+{
+    return _impl->activePixels;
+}
+
+void Image::setActivePixels( const ActivePixels& activePixels )
+{
+    _impl->clearActivePixels();
+    _impl->activePixels = activePixels;
+}
+
+void Image::setPackedPixelData( const Frame::Buffer buffer,
+                                const PixelData& data )
+{
+    LBASSERT( hasActivePixels( ));
+    LBASSERT( data.compressedData.compressor <= EQ_COMPRESSOR_NONE );
+    LBASSERT( data.pvp.w == int32_t( _impl->activePixels.getWidth( )));
+    LBASSERT( data.pvp.h == int32_t( _impl->activePixels.getHeight( )));
+
+    Memory& memory = _impl->getMemory( buffer );
+    memory.externalFormat = data.externalFormat;
+    memory.internalFormat = data.internalFormat;
+    memory.pixelSize = data.pixelSize;
+    memory.pvp = data.pvp;
+    memory.compressedData = pression::CompressorResult();
+
+    const EqCompressorInfos& transferrers = _impl->findTransferers( buffer,
+                                                           0 /*GLEW context*/ );
+    memory.hasAlpha = !transferrers.empty() &&
+        ( transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA );
+
+    const uint64_t size = _impl->activePixels.getNumPixels() * data.pixelSize;
+    memory.packedBuffer.replace( data.pixels, size );
+    memory.pixels = memory.packedBuffer.getData();
+    memory.packed = true;
+    memory.state = Memory::VALID;
+}
+
+bool Image::hasPackedPixelData( const Frame::Buffer buffer ) const
+{
+    return hasPixelData( buffer ) && _impl->getMemory( buffer ).packed;
+}
+
+const uint8_t* Image::getPackedPixelPointer( const Frame::Buffer buffer ) const
+{
+    LBASSERT( hasPackedPixelData( buffer ));
+    return _impl->getMemory( buffer ).packedBuffer.getData();
+}
+
 }
@@ -357,6 +357,51 @@ public:
     void setOffset( int32_t x, int32_t y );
     //@}
 
+    /** @name Active Pixels */
+    //@{
+    /**
+     * Compute the run-length encoded active pixels of the pixel data.
+     *
+     * The runs are derived from the depth buffer if present, otherwise from
+     * a 32 bit color buffer. They stay valid until the pixel data changes.
+     *
+     * @return true if the active pixels were computed, false if the image
+     *         has no suitable pixel data.
+     * @version 1.8
+     */
+    EQ_API bool computeActivePixels();
+
+    /** @return true if the image has active pixel runs. @version 1.8 */
+    EQ_API bool hasActivePixels() const;
+
+    /** @return the active pixel runs of the image. @version 1.8 */
+    EQ_API const ActivePixels& getActivePixels() const;
+
+    /**
+     * @internal Set the active pixel runs, e.g., after receiving an image.
+     *
+     * Has to be called before setPackedPixelData().
+     */
+    EQ_API void setActivePixels( const ActivePixels& activePixels );
+
+    /**
+     * @internal Set pixel data containing only the active pixels.
+     *
+     * The data is copied and unpacked on the first access through
+     * getPixelPointer() or getPixelData(), which may happen concurrently. The
+     * compositor merges packed data directly using getPackedPixelPointer().
+     */
+    EQ_API void setPackedPixelData( const Frame::Buffer buffer,
+                                    const PixelData& data );
+
+    /** @return true if the pixel data is stored packed. @version 1.8 */
+    EQ_API bool hasPackedPixelData( const Frame::Buffer buffer ) const;
+
+    /** @return the packed pixel data, in active pixel order. @version 1.8 */
+    EQ_API const uint8_t* getPackedPixelPointer( const Frame::Buffer buffer )
+        const;
+    //@}
+
     /** @name Internal */
     //@{
     /**
@@ -24,6 +24,7 @@
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
+#include "frameDataTrace.h"
 #include "global.h"
 #include "log.h"
 #include "nodeFactory.h"
@@ -42,6 +43,8 @@
 #include <co/objectICommand.h>
 #include <lunchbox/scopedMutex.h>
 
+#include <set>
+
 namespace eq
 {
 namespace
@@ -50,6 +53,7 @@ typedef stde::hash_map< uint128_t, co::Barrier* > BarrierHash;
 typedef stde::hash_map< uint128_t, FrameDataPtr > FrameDataHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
+typedef std::set< uint32_t > FrameNumbers;
 
 enum State
 {
@@ -108,7 +112,13 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable< FrameDataHash > frameDatas;
 
+    /** The unfinished frames dropped by a window of this node. */
+    lunchbox::Lockable< FrameNumbers > droppedFrames;
+
     TransmitThread transmitter;
+
+    /** Captures received frame data if EQ_FRAMEDATA_TRACE is set. */
+    FrameDataTrace trace;
 };
 
 }
@@ -250,6 +260,18 @@ FrameDataPtr Node::getFrameData( const co::ObjectVersion& frameDataVersion )
     return data;
 }
 
+void Node::dropFrame( const uint32_t frameNumber )
+{
+    lunchbox::ScopedWrite mutex( _impl->droppedFrames );
+    _impl->droppedFrames->insert( frameNumber );
+}
+
+bool Node::isFrameDropped( const uint32_t frameNumber ) const
+{
+    lunchbox::ScopedWrite mutex( _impl->droppedFrames );
+    return _impl->droppedFrames->count( frameNumber ) > 0;
+}
+
 void Node::releaseFrameData( FrameDataPtr data )
 {
     lunchbox::ScopedWrite mutex( _impl->frameDatas );
@@ -345,6 +367,11 @@ void Node::_frameFinish( const uint128_t& frameID,
     frameFinish( frameID, frameNumber );
     LBLOG( LOG_TASKS ) << "---- Finished Frame --- " << frameNumber
                        << std::endl;
+    {
+        lunchbox::ScopedWrite mutex( _impl->droppedFrames );
+        FrameNumbers& dropped = _impl->droppedFrames.data;
+        dropped.erase( dropped.begin(), dropped.upper_bound( frameNumber ));
+    }
 
     if( _impl->unlockedFrame < frameNumber )
     {
@@ -589,6 +616,11 @@ bool Node::_cmdConfigInit( co::ICommand& cmd )
     _impl->finishedFrame = frameNumber;
     _setAffinity();
 
+    const char* trace = getenv( "EQ_FRAMEDATA_TRACE" );
+    if( trace )
+        _impl->trace.open( std::string( trace ) + "." +
+                           getID().getShortString( ));
+
     _impl->transmitter.start();
     const uint64_t result = configInit( initID );
 
@@ -718,8 +750,10 @@ bool Node::_cmdFrameDataTransmit( co::ICommand& cmd )
     const uint32_t buffers = command.read< uint32_t >();
     const uint32_t frameNumber = command.read< uint32_t >();
     const bool useAlpha = command.read< bool >();
+    const bool sparse = command.read< bool >();
+    const uint64_t size = command.getRemainingBufferSize();
     const uint8_t* data = reinterpret_cast< const uint8_t* >(
-                command.getRemainingBuffer( command.getRemainingBufferSize( )));
+                                          command.getRemainingBuffer( size ));
 
     LBLOG( LOG_ASSEMBLY )
         << "received image data for " << frameDataVersion << ", buffers "
@@ -730,6 +764,9 @@ bool Node::_cmdFrameDataTransmit( co::ICommand& cmd )
     FrameDataPtr frameData = getFrameData( frameDataVersion );
     LBASSERT( !frameData->isReady() );
 
+    _impl->trace.writeImage( frameDataVersion, frameNumber, pvp, zoom, buffers,
+                             useAlpha, sparse, data, size );
+
     NodeStatistics event( Statistic::NODE_FRAME_DECOMPRESS, this,
                           frameNumber );
 
@@ -737,7 +774,8 @@ bool Node::_cmdFrameDataTransmit( co::ICommand& cmd )
     // pointers, we have to go non-const at some point, even though we do not
     // modify the data.
     LBCHECK( frameData->addImage( frameDataVersion, pvp, zoom, buffers,
-                                  useAlpha, const_cast< uint8_t* >( data )));
+                                  useAlpha, sparse,
+                                  const_cast< uint8_t* >( data )));
     return true;
 }
 
@@ -751,6 +789,8 @@ bool Node::_cmdFrameDataReady( co::ICommand& cmd )
 
     LBLOG( LOG_ASSEMBLY ) << "received ready for " << frameDataVersion
                           << std::endl;
+    _impl->trace.writeReady( frameDataVersion, data );
+
     FrameDataPtr frameData = getFrameData( frameDataVersion );
     LBASSERT( frameData );
     LBASSERT( !frameData->isReady() );
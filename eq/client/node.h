@@ -88,6 +88,16 @@ public:
     /** @internal Release the frame data instance. */
     void releaseFrameData( FrameDataPtr data );
 
+    /**
+     * @internal
+     * Skip the swap of an incomplete deadline frame on all windows of this
+     * node, which keeps the windows of a swap group consistent.
+     */
+    void dropFrame( const uint32_t frameNumber );
+
+    /** @internal @return true if the frame was dropped by a window. */
+    bool isFrameDropped( const uint32_t frameNumber ) const;
+
     /** @internal Wait for the node to be initialized. */
     EQ_API void waitInitialized() const;
 
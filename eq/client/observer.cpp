@@ -21,6 +21,7 @@
 #include "client.h"
 #include "eventICommand.h"
 #include "server.h"
+#include "detail/lateLatch.h"
 
 #include <eq/fabric/event.h>
 #include <eq/fabric/paths.h>
@@ -50,10 +51,12 @@ public:
     Observer()
         : vrpnTracker( 0 )
         , cvTracker( 0 )
+        , lateLatch( 0 )
     {}
 
     vrpn_Tracker_Remote *vrpnTracker;
     CVTracker* cvTracker;
+    LateLatch* lateLatch;
 };
 }
 
@@ -108,6 +111,7 @@ void VRPN_CALLBACK trackerCB( void* userdata, const vrpn_TRACKERCB data )
 
     Observer *observer = static_cast< Observer* >( userdata );
     Config* config = observer->getConfig();
+    observer->latchHeadMatrix( head );
 
     // Directly dispatch the event: We're called from Config::startFrame and
     // need to process now without sending the event so that the change is
@@ -129,6 +133,13 @@ void VRPN_CALLBACK trackerCB( void* userdata, const vrpn_TRACKERCB data )
 
 bool Observer::configInit()
 {
+    if( getLateLatch( ))
+    {
+        _impl->lateLatch = new detail::LateLatch;
+        LBCHECK( getConfig()->registerObject( _impl->lateLatch ));
+        setLatchID( _impl->lateLatch->getID( ));
+    }
+
 #ifdef EQUALIZER_USE_VRPN
     const std::string& vrpnName = getVRPNTracker();
     if( !vrpnName.empty( ))
@@ -153,7 +164,11 @@ bool Observer::configInit()
     else
         --camera; // .eqc counts from 1, OpenCV from 0
 
-    _impl->cvTracker = new detail::CVTracker( this, camera );
+    const char* video = getenv( "EQ_OPENCV_VIDEO" );
+    if( video )
+        _impl->cvTracker = new detail::CVTracker( this, std::string( video ));
+    else
+        _impl->cvTracker = new detail::CVTracker( this, camera );
     if( _impl->cvTracker->isGood( ))
         return _impl->cvTracker->start();
 
@@ -174,6 +189,12 @@ bool Observer::handleEvent( EventICommand& command )
     return false;
 }
 
+void Observer::latchHeadMatrix( const Matrix4f& head )
+{
+    if( _impl->lateLatch )
+        _impl->lateLatch->push( head, getConfig()->getTime( ));
+}
+
 bool Observer::configExit()
 {
 #ifdef EQUALIZER_USE_VRPN
@@ -188,6 +209,13 @@ bool Observer::configExit()
     delete _impl->cvTracker;
     _impl->cvTracker = 0;
 #endif
+    if( _impl->lateLatch )
+    {
+        setLatchID( uint128_t( ));
+        getConfig()->deregisterObject( _impl->lateLatch );
+        delete _impl->lateLatch;
+        _impl->lateLatch = 0;
+    }
     return true;
 }
 
@@ -55,6 +55,19 @@ namespace detail { class Observer; }
          * @return true if the event requires a redraw, false otherwise.
          */
         EQ_API virtual bool handleEvent( EventICommand& command );
+
+        /**
+         * Provide a new tracker sample for late latching.
+         *
+         * The sample is sent immediately to the render clients, which
+         * extrapolate the newest two samples to the expected display time.
+         * Does nothing if late latching is disabled. Thread-safe.
+         *
+         * @param head the tracked head matrix.
+         * @sa setLateLatch()
+         * @version 1.8
+         */
+        EQ_API void latchHeadMatrix( const Matrix4f& head );
         //@}
 
         /** @name Data Access */
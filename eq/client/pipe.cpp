@@ -38,6 +38,7 @@
 #include "systemPipe.h"
 
 #include "computeContext.h"
+#include "detail/lateLatch.h"
 #ifdef EQUALIZER_USE_CUDA
 #  include "cudaContext.h"
 #endif
@@ -82,11 +83,24 @@ typedef stde::hash_map< uint128_t, Frame* > FrameHash;
 typedef stde::hash_map< uint128_t, FrameDataPtr > FrameDataHash;
 typedef stde::hash_map< uint128_t, View* > ViewHash;
 typedef stde::hash_map< uint128_t, co::QueueSlave* > QueueHash;
+
+/** The tracker samples of one observer and their prediction. */
+struct Latch
+{
+    Latch() : latch( 0 ), frame( 0 ), head( Matrix4f::IDENTITY ), time( 0 ) {}
+
+    detail::LateLatch* latch;
+    uint32_t frame; //!< the frame of the prediction
+    Matrix4f head;  //!< the predicted head matrix
+    int64_t time;   //!< the time of the newest sample, or 0
+};
+typedef stde::hash_map< uint128_t, Latch > LateLatchHash;
 typedef FrameHash::const_iterator FrameHashCIter;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef ViewHash::const_iterator ViewHashCIter;
 typedef ViewHash::iterator ViewHashIter;
 typedef QueueHash::const_iterator QueueHashCIter;
+typedef LateLatchHash::const_iterator LateLatchHashCIter;
 }
 
 namespace detail
@@ -159,6 +173,7 @@ public:
         , state( STATE_STOPPED )
         , currentFrame( 0 )
         , frameTime( 0 )
+        , deadline( 0 )
         , thread( 0 )
         , transferThread( index )
         , computeContext( 0 )
@@ -195,6 +210,9 @@ public:
     /** The base time for the currently active frame. */
     int64_t frameTime;
 
+    /** The target present time of the currently active frame, or 0. */
+    int64_t deadline;
+
     /** All assembly frames used by the pipe during rendering. */
     FrameHash frames;
 
@@ -210,6 +228,9 @@ public:
     /** All queues used by the pipe's channels during rendering. */
     QueueHash queues;
 
+    /** All tracker samples latched by the pipe's channels. */
+    LateLatchHash lateLatches;
+
     /** The pipe thread. */
     RenderThread* thread;
 
@@ -612,6 +633,48 @@ void Pipe::_flushQueues()
     _impl->queues.clear();
 }
 
+int64_t Pipe::predictHead( const uint128_t& id, const int64_t time,
+                           Matrix4f& head )
+{
+    LB_TS_THREAD( _pipeThread );
+    if( id == 0 )
+        return 0;
+
+    Latch& latch = _impl->lateLatches[ id ];
+    if( !latch.latch )
+    {
+        latch.latch = new detail::LateLatch;
+        ClientPtr client = getClient();
+        LBCHECK( client->mapObject( latch.latch, id ));
+    }
+
+    // all channels of the frame render the same prediction
+    if( latch.frame != _impl->currentFrame )
+    {
+        latch.latch->sync();
+        latch.time = latch.latch->predict( latch.head, time );
+        latch.frame = _impl->currentFrame;
+    }
+
+    head = latch.head;
+    return latch.time;
+}
+
+void Pipe::_flushLateLatches()
+{
+    LB_TS_THREAD( _pipeThread );
+    ClientPtr client = getClient();
+
+    for( LateLatchHashCIter i = _impl->lateLatches.begin();
+         i != _impl->lateLatches.end(); ++i )
+    {
+        detail::LateLatch* lateLatch = i->second.latch;
+        client->unmapObject( lateLatch );
+        delete lateLatch;
+    }
+    _impl->lateLatches.clear();
+}
+
 const View* Pipe::getView( const co::ObjectVersion& viewVersion ) const
 {
     // Yie-ha: we want to have a const-interface to get a view on the render
@@ -782,6 +845,31 @@ uint32_t Pipe::getFinishedFrame() const
     return _impl->finishedFrame.get();
 }
 
+int64_t Pipe::getFrameDeadline() const
+{
+    LB_TS_THREAD( _pipeThread );
+    return _impl->deadline;
+}
+
+int64_t Pipe::getFrameTime() const
+{
+    LB_TS_THREAD( _pipeThread );
+    return _impl->frameTime;
+}
+
+bool Pipe::isFrameStale() const
+{
+    LB_TS_THREAD( _pipeThread );
+    if( _impl->deadline == 0 || getConfig()->getTime() <= _impl->deadline )
+        return false;
+
+    // never drop the newest frame, it would not be replaced
+    _impl->frameTimeMutex.set();
+    const bool hasNewerFrame = !_impl->frameTimes.empty();
+    _impl->frameTimeMutex.unset();
+    return hasNewerFrame;
+}
+
 WindowSystem Pipe::getWindowSystem() const
 {
     return _impl->windowSystem;
@@ -1142,6 +1230,7 @@ bool Pipe::_cmdConfigExit( co::ICommand& cmd )
     // - configExit can't access views since all channels are gone already
     _flushViews();
     _flushQueues();
+    _flushLateLatches();
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
     return true;
 }
@@ -1176,6 +1265,7 @@ bool Pipe::_cmdFrameStart( co::ICommand& cmd )
     const uint128_t& version = command.read< uint128_t >();
     const uint128_t& frameID = command.read< uint128_t >();
     const uint32_t frameNumber = command.read< uint32_t >();
+    const int64_t deadline = command.read< int64_t >();
 
     LBVERB << "handle pipe frame start " << command << " frame " << frameNumber
            << " id " << frameID << std::endl;
@@ -1191,6 +1281,7 @@ bool Pipe::_cmdFrameStart( co::ICommand& cmd )
     _impl->frameTime = _impl->frameTimes.front();
     _impl->frameTimes.pop_front();
     _impl->frameTimeMutex.unset();
+    _impl->deadline = deadline;
 
     if( lastFrameTime > 0 )
     {
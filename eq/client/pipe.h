@@ -96,6 +96,26 @@ public:
     EQ_API uint32_t getCurrentFrame() const;
     EQ_API uint32_t getFinishedFrame() const; //!< @internal
 
+    /**
+     * Return the target present time of the current frame.
+     *
+     * To be called only from the pipe thread. Set when the config has a
+     * deadline attribute.
+     * @return the target present time in config time, or 0.
+     * @version 1.8
+     */
+    EQ_API int64_t getFrameDeadline() const;
+
+    /** @internal @return the config time the current frame was started. */
+    int64_t getFrameTime() const;
+
+    /**
+     * @internal
+     * @return true if the current frame missed its deadline and a newer frame
+     *         has already been started on this pipe.
+     */
+    bool isFrameStale() const;
+
     /**
      * Return the window system used by this pipe.
      *
@@ -127,6 +147,18 @@ public:
     /** @internal @return the queue for the given identifier and version. */
     co::QueueSlave* getQueue( const uint128_t& queueID );
 
+    /**
+     * @internal
+     * Predict the head matrix of an observer's late latch.
+     *
+     * The newest samples are synced and extrapolated to the given time once
+     * per frame, later calls during the same frame reuse the prediction.
+     *
+     * @return the time of the newest sample, or 0 if no sample is known.
+     */
+    int64_t predictHead( const uint128_t& id, const int64_t time,
+                         Matrix4f& head );
+
     /** @internal Clear the frame cache and delete all frames. */
     void flushFrames( util::ObjectManager& om );
 
@@ -398,6 +430,9 @@ private:
     /** @internal Clear the queue cache and release all queues. */
     void _flushQueues();
 
+    /** @internal Release all latched tracker samples. */
+    void _flushLateLatches();
+
     /* The command functions. */
     bool _cmdCreateWindow( co::ICommand& command );
     bool _cmdDestroyWindow( co::ICommand& command );
@@ -53,6 +53,8 @@ namespace eq
             event.data.originator            = owner->getID();
             event.data.statistic.type        = type;
             event.data.statistic.frameNumber = frameNumber;
+            event.data.statistic.frameData   = 0;
+            event.data.statistic.bytes       = 0;
             event.data.statistic.resourceName[0] = '\0';
             event.data.statistic.startTime   = 0;
             event.data.statistic.endTime     = 0;
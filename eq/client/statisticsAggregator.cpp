@@ -0,0 +1,431 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "statisticsAggregator.h"
+
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+#ifdef _MSC_VER
+#  define snprintf _snprintf
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+// Histogram buckets: one for values below 2^_minExponent, then _nSubBuckets
+// linear buckets per power of two up to 2^(_minExponent + _nOctaves)
+static const int _minExponent = -6;
+static const int _nOctaves = 23;
+static const int _nSubBuckets = 8;
+static const int _nBuckets = 1 + _nOctaves * _nSubBuckets;
+
+// The window is covered by up to _nSlots - 1 full slots and the current one
+static const uint32_t _nSlots = 9;
+
+/** The histogram of the samples of a range of frames. */
+struct Slot
+{
+    Slot() : first( 0 ) {}
+
+    void reset( const uint32_t first_ )
+    {
+        first = first_;
+        count = 0;
+        sum = 0.;
+        min = 0.f;
+        max = 0.f;
+        std::fill( buckets, buckets + _nBuckets, 0u );
+    }
+
+    uint32_t first; //!< the first frame of the slot, 0 if unused
+    uint32_t count;
+    double sum;
+    float min;
+    float max;
+    uint32_t buckets[ _nBuckets ];
+};
+
+struct Series
+{
+    std::string name;
+    Slot slots[ _nSlots ];
+};
+
+typedef std::pair< uint32_t, Statistic::Type > Key;
+typedef std::map< Key, Series > SeriesMap;
+typedef SeriesMap::const_iterator SeriesMapCIter;
+
+float _getValue( const Statistic& stat )
+{
+    switch( stat.type )
+    {
+      case Statistic::PIPE_IDLE:
+          return stat.totalTime > 0 ?
+                     float( stat.idleTime ) * 100.f / float( stat.totalTime ) :
+                     0.f;
+      case Statistic::WINDOW_FPS:
+          return stat.currentFPS;
+      default:
+          return float( stat.endTime - stat.startTime );
+    }
+}
+
+int _getBucket( const float value )
+{
+    int exponent = 0;
+    const float mantissa = std::frexp( value, &exponent ); // [.5, 1)
+    if( value <= 0.f || exponent <= _minExponent )
+        return 0;
+
+    const int octave = exponent - 1 - _minExponent;
+    const int sub = int(( mantissa * 2.f - 1.f ) * float( _nSubBuckets ));
+    return std::min( 1 + octave * _nSubBuckets + sub, _nBuckets - 1 );
+}
+
+/** @return the smallest value of the given bucket. */
+float _getBucketStart( const int bucket )
+{
+    if( bucket == 0 )
+        return 0.f;
+
+    const int octave = ( bucket - 1 ) / _nSubBuckets;
+    const int sub = ( bucket - 1 ) % _nSubBuckets;
+    return std::ldexp( 1.f + float( sub ) / float( _nSubBuckets ),
+                       _minExponent + octave );
+}
+
+/** @return the value at the given percentile, interpolated in its bucket. */
+float _getPercentile( const uint32_t* buckets,
+                      const eq::StatisticsAggregator::Summary& summary,
+                      const float p )
+{
+    LBASSERT( summary.count > 0 );
+    const float rank = p * float( summary.count - 1 ) + .5f;
+    uint32_t count = 0;
+    for( int i = 0; i < _nBuckets; ++i )
+    {
+        if( float( count + buckets[i] ) < rank )
+        {
+            count += buckets[i];
+            continue;
+        }
+
+        const float start = std::max( _getBucketStart( i ), summary.min );
+        const float end = i + 1 < _nBuckets ?
+                          std::min( _getBucketStart( i + 1 ), summary.max ) :
+                          summary.max;
+        const float fraction = ( rank - float( count )) / float( buckets[i] );
+        return std::max( start + fraction * ( end - start ), start );
+    }
+    return summary.max;
+}
+
+void _summarize( const Key& key, const Series& series,
+                 eq::StatisticsAggregator::Summary& summary )
+{
+    summary.entity = key.first;
+    summary.type = key.second;
+    summary.name = series.name;
+    summary.count = 0;
+
+    uint32_t buckets[ _nBuckets ] = { 0 };
+    double sum = 0.;
+    for( uint32_t i = 0; i < _nSlots; ++i )
+    {
+        const Slot& slot = series.slots[i];
+        if( slot.first == 0 || slot.count == 0 )
+            continue;
+
+        summary.min = summary.count ? std::min( summary.min, slot.min ) :
+                                      slot.min;
+        summary.max = summary.count ? std::max( summary.max, slot.max ) :
+                                      slot.max;
+        summary.count += slot.count;
+        sum += slot.sum;
+        for( int j = 0; j < _nBuckets; ++j )
+            buckets[j] += slot.buckets[j];
+    }
+    if( summary.count == 0 )
+        return;
+
+    summary.mean = float( sum / double( summary.count ));
+    summary.p50 = _getPercentile( buckets, summary, .50f );
+    summary.p95 = _getPercentile( buckets, summary, .95f );
+    summary.p99 = _getPercentile( buckets, summary, .99f );
+}
+
+/** @return the CSV field, quoted if needed. */
+std::string _escapeCSV( const std::string& field )
+{
+    if( field.find_first_of( ",\"\r\n" ) == std::string::npos )
+        return field;
+
+    std::string escaped = "\"";
+    for( size_t i = 0; i < field.size(); ++i )
+    {
+        if( field[i] == '"' )
+            escaped += '"';
+        escaped += field[i];
+    }
+    return escaped + '"';
+}
+
+/** @return the string with JSON escape sequences, without quotes. */
+std::string _escapeJSON( const std::string& string )
+{
+    std::string escaped;
+    for( size_t i = 0; i < string.size(); ++i )
+    {
+        const char c = string[i];
+        switch( c )
+        {
+          case '"':  escaped += "\\\""; break;
+          case '\\': escaped += "\\\\"; break;
+          case '\n': escaped += "\\n"; break;
+          case '\r': escaped += "\\r"; break;
+          case '\t': escaped += "\\t"; break;
+          default:
+              if( (unsigned char)( c ) < 0x20 )
+              {
+                  char code[8];
+                  snprintf( code, sizeof( code ), "\\u%04x", unsigned( c ));
+                  escaped += code;
+              }
+              else
+                  escaped += c;
+        }
+    }
+    return escaped;
+}
+}
+
+class StatisticsAggregator
+{
+public:
+    explicit StatisticsAggregator( const uint32_t window_ )
+        : window( 0 )
+        , slotFrames( 1 )
+        , lastFrame( 0 )
+    {
+        setWindow( window_ );
+    }
+
+    void setWindow( const uint32_t window_ )
+    {
+        window = window_;
+        slotFrames = std::max( ( window + _nSlots - 2 ) / ( _nSlots - 1 ),
+                               1u );
+        series.clear();
+    }
+
+    void add( Series& entry, const uint32_t frame, const float value )
+    {
+        if( frame + window <= lastFrame ) // before the window
+            return;
+
+        const uint32_t index = ( frame - 1 ) / slotFrames;
+        const uint32_t first = index * slotFrames + 1;
+        Slot& slot = entry.slots[ index % _nSlots ];
+        if( slot.first > first ) // reused by newer frames
+            return;
+        if( slot.first < first )
+            slot.reset( first );
+
+        slot.min = slot.count ? std::min( slot.min, value ) : value;
+        slot.max = slot.count ? std::max( slot.max, value ) : value;
+        ++slot.count;
+        slot.sum += value;
+        ++slot.buckets[ _getBucket( value ) ];
+    }
+
+    void obsolete()
+    {
+        if( lastFrame < window )
+            return;
+
+        const uint32_t first = lastFrame - window + 1;
+        SeriesMap::iterator i = series.begin();
+        while( i != series.end( ))
+        {
+            bool empty = true;
+            for( uint32_t j = 0; j < _nSlots; ++j )
+            {
+                Slot& slot = i->second.slots[j];
+                if( slot.first > 0 && slot.first + slotFrames <= first )
+                    slot.first = 0;
+                if( slot.first > 0 )
+                    empty = false;
+            }
+
+            if( empty )
+                series.erase( i++ );
+            else
+                ++i;
+        }
+    }
+
+    mutable lunchbox::SpinLock lock;
+    uint32_t window;
+    uint32_t slotFrames; //!< the number of frames per slot
+    uint32_t lastFrame;
+    SeriesMap series;
+};
+}
+
+StatisticsAggregator::StatisticsAggregator( const uint32_t window )
+    : _impl( new detail::StatisticsAggregator( window ))
+{}
+
+StatisticsAggregator::~StatisticsAggregator()
+{
+    delete _impl;
+}
+
+void StatisticsAggregator::setWindow( const uint32_t frames )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->setWindow( frames );
+}
+
+uint32_t StatisticsAggregator::getWindow() const
+{
+    lunchbox::ScopedFastRead mutex( _impl->lock );
+    return _impl->window;
+}
+
+void StatisticsAggregator::add( const uint32_t entity, const Statistic& stat )
+{
+    if( stat.frameNumber == 0 || stat.type == Statistic::NONE ||
+        stat.type == Statistic::ALL )
+    {
+        return;
+    }
+
+    const float value = detail::_getValue( stat );
+    const detail::Key key( entity, stat.type );
+
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    if( _impl->window == 0 )
+        return;
+
+    detail::Series& series = _impl->series[ key ];
+    if( series.name.empty( ))
+        series.name = stat.resourceName;
+    _impl->add( series, stat.frameNumber, value );
+}
+
+void StatisticsAggregator::obsolete( const uint32_t frame )
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->lastFrame = frame;
+    _impl->obsolete();
+}
+
+void StatisticsAggregator::clear()
+{
+    lunchbox::ScopedFastWrite mutex( _impl->lock );
+    _impl->series.clear();
+}
+
+StatisticsAggregator::Summaries StatisticsAggregator::getSummaries() const
+{
+    Summaries summaries;
+    lunchbox::ScopedFastRead mutex( _impl->lock );
+    summaries.resize( _impl->series.size( ));
+
+    size_t index = 0;
+    for( detail::SeriesMapCIter i = _impl->series.begin();
+         i != _impl->series.end(); ++i, ++index )
+    {
+        detail::_summarize( i->first, i->second, summaries[ index ] );
+    }
+    return summaries;
+}
+
+bool StatisticsAggregator::getSummary( const uint32_t entity,
+                                       const Statistic::Type type,
+                                       Summary& summary ) const
+{
+    const detail::Key key( entity, type );
+    lunchbox::ScopedFastRead mutex( _impl->lock );
+    detail::SeriesMapCIter i = _impl->series.find( key );
+    if( i == _impl->series.end( ))
+        return false;
+
+    detail::_summarize( i->first, i->second, summary );
+    return true;
+}
+
+void StatisticsAggregator::writeCSV( std::ostream& os,
+                                     const Summaries& summaries )
+{
+    os << "entity,name,type,count,min,max,mean,p50,p95,p99" << std::endl;
+    for( Summaries::const_iterator i = summaries.begin();
+         i != summaries.end(); ++i )
+    {
+        const Summary& summary = *i;
+        os << summary.entity << ',' << detail::_escapeCSV( summary.name )
+           << ',' << Statistic::getName( summary.type ) << ','
+           << summary.count << ','
+           << summary.min << ',' << summary.max << ',' << summary.mean << ','
+           << summary.p50 << ',' << summary.p95 << ',' << summary.p99
+           << std::endl;
+    }
+}
+
+void StatisticsAggregator::writeJSON( std::ostream& os,
+                                      const Summaries& summaries )
+{
+    os << "[";
+    for( Summaries::const_iterator i = summaries.begin();
+         i != summaries.end(); ++i )
+    {
+        const Summary& summary = *i;
+        if( i != summaries.begin( ))
+            os << ",";
+        os << std::endl << "  { \"entity\": " << summary.entity
+           << ", \"name\": \"" << detail::_escapeJSON( summary.name )
+           << "\", \"type\": \""
+           << Statistic::getName( summary.type ) << "\", \"count\": "
+           << summary.count << ", \"min\": " << summary.min
+           << ", \"max\": " << summary.max << ", \"mean\": " << summary.mean
+           << ", \"p50\": " << summary.p50 << ", \"p95\": " << summary.p95
+           << ", \"p99\": " << summary.p99 << " }";
+    }
+    os << std::endl << "]" << std::endl;
+}
+
+std::ostream& operator << ( std::ostream& os,
+                            const StatisticsAggregator::Summary& summary )
+{
+    return os << summary.name << " " << Statistic::getName( summary.type )
+              << ": n " << summary.count << " min " << summary.min << " max "
+              << summary.max << " mean " << summary.mean << " p50 "
+              << summary.p50 << " p95 " << summary.p95 << " p99 "
+              << summary.p99;
+}
+
+}
@@ -0,0 +1,141 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_STATISTICSAGGREGATOR_H
+#define EQ_STATISTICSAGGREGATOR_H
+
+#include <eq/client/api.h>
+#include <eq/client/types.h>
+#include <eq/fabric/statistic.h> // Statistic::Type
+
+#include <boost/noncopyable.hpp>
+#include <iostream>
+
+namespace eq
+{
+namespace detail { class StatisticsAggregator; }
+
+/**
+ * Aggregates statistics events into rolling per-entity, per-type summaries.
+ *
+ * Each added Statistic is reduced to one sample value. The sample value is
+ * the duration in milliseconds for timing events, the idle percentage for
+ * Statistic::PIPE_IDLE and the current frame rate for Statistic::WINDOW_FPS.
+ *
+ * The samples of each entity and type are counted in fixed histograms with
+ * eight linear buckets per power of two, each covering an eighth of the
+ * window. Adding a sample is constant time and does not allocate memory,
+ * except for the first sample of a series. The summaries provide the exact
+ * count, minimum, maximum and mean, and the p50, p95 and p99 percentiles
+ * interpolated within their bucket. Samples are dropped in steps of an
+ * eighth of the window, and samples of frames before the window are ignored.
+ *
+ * All methods are thread safe.
+ */
+class StatisticsAggregator : public boost::noncopyable
+{
+public:
+    /** The aggregated values of one entity and statistic type. */
+    struct Summary
+    {
+        Summary() : entity( 0 ), type( Statistic::NONE ), count( 0 ), min( 0 )
+                  , max( 0 ), mean( 0 ), p50( 0 ), p95( 0 ), p99( 0 ) {}
+
+        uint32_t entity; //!< The originator serial of the statistics
+        Statistic::Type type; //!< The statistic type
+        std::string name; //!< The (non-unique) resource name of the entity
+        size_t count; //!< The number of samples in the window
+        float min; //!< The smallest sample value
+        float max; //!< The largest sample value
+        float mean; //!< The arithmetic mean of all samples
+        float p50; //!< The median sample value
+        float p95; //!< The 95th percentile sample value
+        float p99; //!< The 99th percentile sample value
+    };
+    typedef std::vector< Summary > Summaries;
+
+    /**
+     * Construct a new aggregator.
+     *
+     * @param window the number of frames to keep samples for.
+     * @version 1.8
+     */
+    EQ_API explicit StatisticsAggregator( const uint32_t window = 100 );
+
+    /** Destruct this aggregator. @version 1.8 */
+    EQ_API ~StatisticsAggregator();
+
+    /**
+     * Set the number of frames to aggregate samples over.
+     *
+     * Clears all samples. A window of 0 disables aggregation.
+     * @version 1.8
+     */
+    EQ_API void setWindow( const uint32_t frames );
+
+    /** @return the number of frames samples are kept for. @version 1.8 */
+    EQ_API uint32_t getWindow() const;
+
+    /**
+     * Add a statistics event.
+     *
+     * @param entity the originator serial of the statistics event.
+     * @param stat the statistics event.
+     * @version 1.8
+     */
+    EQ_API void add( const uint32_t entity, const Statistic& stat );
+
+    /**
+     * Remove all samples which left the window at the given frame.
+     *
+     * Called by the config for each finished frame.
+     * @param frame the last finished frame.
+     * @version 1.8
+     */
+    EQ_API void obsolete( const uint32_t frame );
+
+    /** Remove all samples. @version 1.8 */
+    EQ_API void clear();
+
+    /** @return the summaries of all entities and types. @version 1.8 */
+    EQ_API Summaries getSummaries() const;
+
+    /**
+     * Get the summary of one entity and type.
+     *
+     * @return true if samples for the entity and type exist, false otherwise.
+     * @version 1.8
+     */
+    EQ_API bool getSummary( const uint32_t entity, const Statistic::Type type,
+                            Summary& summary ) const;
+
+    /** Write the given summaries as comma-separated values. @version 1.8 */
+    EQ_API static void writeCSV( std::ostream& os, const Summaries& summaries );
+
+    /** Write the given summaries as a JSON array. @version 1.8 */
+    EQ_API static void writeJSON( std::ostream& os, const Summaries& summaries );
+
+private:
+    detail::StatisticsAggregator* const _impl;
+};
+
+/** Output the summary in human-readable form. @version 1.8 */
+EQ_API std::ostream& operator << ( std::ostream& os,
+                                   const StatisticsAggregator::Summary& );
+}
+
+#endif // EQ_STATISTICSAGGREGATOR_H
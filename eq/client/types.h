@@ -35,15 +35,20 @@
 
 namespace eq
 {
+class ActivePixels;
 class Canvas;
 class Channel;
 class Client;
 class CommandQueue;
 class ComputeContext;
 class Config;
+class CriticalPathAnalyzer;
+class DataStreamer;
 class EventICommand;
 class Frame;
 class FrameData;
+class FrameDataTrace;
+class HierarchicalBarrier;
 class Image;
 class Layout;
 class MessagePump;
@@ -54,6 +59,7 @@ class Observer;
 class Pipe;
 class Segment;
 class Server;
+class StatisticsAggregator;
 class SystemPipe;
 class SystemWindow;
 class View;
@@ -25,6 +25,7 @@
 #include "error.h"
 #include "gl.h"
 #include "global.h"
+#include "hierarchicalBarrier.h"
 #include "log.h"
 #include "node.h"
 #include "nodeFactory.h"
@@ -70,6 +71,7 @@ Window::Window( Pipe* parent )
         , _lastTime ( 0.0f )
         , _avgFPS ( 0.0f )
         , _lastSwapTime( 0 )
+        , _swapEndTime( 0 )
 {
     const Windows& windows = parent->getWindows();
     if( windows.empty( ))
@@ -112,6 +114,9 @@ void Window::attach( const uint128_t& id, const uint32_t instanceID )
                      WindowFunc( this, &Window::_cmdBarrier ), queue );
     registerCommand( fabric::CMD_WINDOW_NV_BARRIER,
                      WindowFunc( this, &Window::_cmdNVBarrier ), queue );
+    registerCommand( fabric::CMD_WINDOW_HIERARCHICAL_BARRIER,
+                     WindowFunc( this, &Window::_cmdHierarchicalBarrier ),
+                     queue );
     registerCommand( fabric::CMD_WINDOW_SWAP,
                      WindowFunc( this, &Window::_cmdSwap), queue );
     registerCommand( fabric::CMD_WINDOW_FRAME_DRAW_FINISH,
@@ -539,6 +544,11 @@ void Window::deleteTransferSystemWindow()
     _transferWindow = 0;
 }
 
+void Window::dropFrame()
+{
+    getNode()->dropFrame( getPipe()->getCurrentFrame( ));
+}
+
 //----------------------------------------------------------------------
 // configExit
 //----------------------------------------------------------------------
@@ -979,6 +989,30 @@ bool Window::_cmdNVBarrier( co::ICommand& cmd )
     return true;
 }
 
+bool Window::_cmdHierarchicalBarrier( co::ICommand& cmd )
+{
+    co::ObjectICommand command( cmd );
+    const uint128_t& id = command.read< uint128_t >();
+    const uint32_t height = command.read< uint32_t >();
+    const co::NodeIDs& nodes = command.read< co::NodeIDs >();
+
+    LBLOG( LOG_TASKS ) << "TASK hierarchical swap barrier  " << getName()
+                       << std::endl;
+
+    WindowStatistics stat( Statistic::WINDOW_SWAP_BARRIER, this );
+    const uint32_t timeout = getConfig()->getTimeout() / 2;
+    try
+    {
+        getClient()->getHierarchicalBarrier().enter( id, height, nodes,
+                                                     timeout );
+    }
+    catch( const co::Exception& e )
+    {
+        LBWARN << e.what() << " for hierarchical barrier " << id << std::endl;
+    }
+    return true;
+}
+
 bool Window::_cmdSwap( co::ICommand& cmd )
 {
     co::ObjectICommand command( cmd );
@@ -986,13 +1020,34 @@ bool Window::_cmdSwap( co::ICommand& cmd )
     LBLOG( LOG_TASKS ) << "TASK swap buffers " << getName() << " " << command
                        << std::endl;
 
-    if( getDrawableConfig().doublebuffered )
+    if( !getDrawableConfig().doublebuffered )
+        return true;
+
+    // The swap barrier precedes the swap, so all local windows of the swap
+    // group have assembled the frame and decided on dropping it.
+    const Pipe* pipe = getPipe();
+    const uint32_t frameNumber = pipe->getCurrentFrame();
+    if( getNode()->isFrameDropped( frameNumber ))
+    {
+        // the front buffer keeps the newest complete frame
+        LBLOG( LOG_TASKS ) << "Skip swap of dropped frame " << frameNumber
+                           << std::endl;
+        return true;
+    }
+
     {
         // swap
         WindowStatistics stat( Statistic::WINDOW_SWAP, this );
         makeCurrent();
         swapBuffers();
     }
+    _swapEndTime = getConfig()->getTime();
+
+    if( pipe->getFrameDeadline() > 0 )
+    {
+        WindowStatistics stat( Statistic::WINDOW_FRAME_LATENCY, this );
+        stat.event.data.statistic.startTime = pipe->getFrameTime();
+    }
     return true;
 }
 
@@ -275,6 +275,16 @@ public:
 
     /** @internal delete the shared context window. */
     void deleteTransferSystemWindow();
+
+    /**
+     * @internal
+     * Skip the swap of the current, incomplete deadline frame on all windows
+     * of the node.
+     */
+    void dropFrame();
+
+    /** @internal @return the time the last buffer swap finished. */
+    int64_t getSwapEndTime() const { return _swapEndTime; }
     //@}
 
     /** @name Events */
@@ -460,6 +470,9 @@ private:
     /** The time of the last swap command. */
     int64_t _lastSwapTime;
 
+    /** The end time of the last buffer swap. */
+    int64_t _swapEndTime;
+
     /** List of channels that have grabbed the mouse. */
     Channels _grabbedChannels;
 
@@ -498,6 +511,7 @@ private:
     bool _cmdFinish( co::ICommand& command );
     bool _cmdBarrier( co::ICommand& command );
     bool _cmdNVBarrier( co::ICommand& command );
+    bool _cmdHierarchicalBarrier( co::ICommand& command );
     bool _cmdSwap( co::ICommand& command );
     bool _cmdFrameDrawFinish( co::ICommand& command );
 
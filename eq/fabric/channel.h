@@ -310,6 +310,10 @@ public:
         IATTR_HINT_STATISTICS,
         /** Use a send token for output frames (OFF, ON) */
         IATTR_HINT_SENDTOKEN,
+        /** Send output frames as active pixel runs (OFF, ON, AUTO) */
+        IATTR_HINT_ACTIVE_PIXELS,
+        /** Reduce output frame resolution during interaction (OFF, ON) */
+        IATTR_HINT_PROGRESSIVE,
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
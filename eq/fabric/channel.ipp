@@ -35,7 +35,9 @@ namespace
 #define MAKE_ATTR_STRING( attr ) ( std::string("EQ_CHANNEL_") + #attr )
 static std::string _iAttributeStrings[] = {
     MAKE_ATTR_STRING( IATTR_HINT_STATISTICS ),
-    MAKE_ATTR_STRING( IATTR_HINT_SENDTOKEN )
+    MAKE_ATTR_STRING( IATTR_HINT_SENDTOKEN ),
+    MAKE_ATTR_STRING( IATTR_HINT_ACTIVE_PIXELS ),
+    MAKE_ATTR_STRING( IATTR_HINT_PROGRESSIVE )
 };
 
 static std::string _sAttributeStrings[] = {
@@ -152,6 +152,7 @@ namespace fabric
         CMD_WINDOW_FRAME_DRAW_FINISH,
         CMD_WINDOW_CREATE_QGL_WIDGET,
         CMD_WINDOW_DESTROY_QGL_WIDGET,
+        CMD_WINDOW_HIERARCHICAL_BARRIER,
         CMD_WINDOW_CUSTOM = CMD_OBJECT_CUSTOM + 20
     };
 
@@ -178,6 +179,7 @@ namespace fabric
         CMD_CHANNEL_FRAME_TILES,
         CMD_CHANNEL_FINISH_READBACK,
         CMD_CHANNEL_DELETE_TRANSFER_CONTEXT,
+        CMD_CHANNEL_FRAME_REPEAT,
         CMD_CHANNEL_CUSTOM = CMD_OBJECT_CUSTOM + 30
     };
 
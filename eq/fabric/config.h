@@ -129,6 +129,7 @@ namespace fabric
         {
             FATTR_EYE_BASE, //!< The default interocular distance in meters
             FATTR_VERSION,  //!< The version of the file loaded
+            FATTR_DEADLINE, //!< The frame period in ms of the deadline mode
             FATTR_LAST,
             FATTR_ALL = FATTR_LAST + 5
         };
@@ -137,6 +138,7 @@ namespace fabric
         enum IAttribute
         {
             IATTR_ROBUSTNESS, //!< Tolerate resource failures
+            IATTR_TASK_CACHE, //!< Repeat unchanged channel tasks
             IATTR_LAST,
             IATTR_ALL = IATTR_LAST + 5
         };
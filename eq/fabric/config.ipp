@@ -41,10 +41,12 @@ std::string _fAttributeStrings[] =
 {
     MAKE_ATTR_STRING( FATTR_EYE_BASE ),
     MAKE_ATTR_STRING( FATTR_VERSION ),
+    MAKE_ATTR_STRING( FATTR_DEADLINE ),
 };
 std::string _iAttributeStrings[] =
 {
     MAKE_ATTR_STRING( IATTR_ROBUSTNESS ),
+    MAKE_ATTR_STRING( IATTR_TASK_CACHE ),
 };
 }
 
@@ -912,8 +914,13 @@ std::ostream& operator << ( std::ostream& os,
        << "robustness "
        << IAttribute( config.getIAttribute( C::IATTR_ROBUSTNESS )) << std::endl
        << "eye_base   " << config.getFAttribute( C::FATTR_EYE_BASE )
-       << std::endl
-       << lunchbox::exdent << "}" << std::endl;
+       << std::endl;
+    if( config.getIAttribute( C::IATTR_TASK_CACHE ) == ON )
+        os << "task_cache " << IAttribute( ON ) << std::endl;
+    if( config.getFAttribute( C::FATTR_DEADLINE ) > 0.f )
+        os << "deadline   " << config.getFAttribute( C::FATTR_DEADLINE )
+           << std::endl;
+    os << lunchbox::exdent << "}" << std::endl;
 
     const typename C::Nodes& nodes = config.getNodes();
     for( typename C::Nodes::const_iterator i = nodes.begin();
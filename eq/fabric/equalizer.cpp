@@ -264,7 +264,8 @@ std::ostream& operator << ( std::ostream& os, const Equalizer::Mode mode )
     os << ( mode == Equalizer::MODE_2D         ? "2D" :
             mode == Equalizer::MODE_VERTICAL   ? "VERTICAL" :
             mode == Equalizer::MODE_HORIZONTAL ? "HORIZONTAL" :
-            mode == Equalizer::MODE_DB         ? "DB" : "ERROR" );
+            mode == Equalizer::MODE_DB         ? "DB" :
+            mode == Equalizer::MODE_HYBRID     ? "HYBRID" : "ERROR" );
     return os;
 }
 
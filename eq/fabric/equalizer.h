@@ -55,7 +55,9 @@ public:
         MODE_DB = 0,     //!< Adapt for a sort-last decomposition
         MODE_HORIZONTAL, //!< Adapt for sort-first using horizontal stripes
         MODE_VERTICAL,   //!< Adapt for sort-first using vertical stripes
-        MODE_2D          //!< Adapt for a sort-first decomposition
+        MODE_2D,         //!< Adapt for a sort-first decomposition
+        /** Use 2D or DB, whichever is predicted to be faster. @version 1.8 */
+        MODE_HYBRID
     };
 
     /** @name Data Access. */
@@ -30,13 +30,13 @@ namespace fabric
 void FrameData::serialize( co::DataOStream& os ) const
 {
     os << pvp << frameType << buffers << period << phase << range
-       << pixel << subpixel << zoom;
+       << pixel << subpixel << zoom << dropped;
 }
 
 void FrameData::deserialize( co::DataIStream& is )
 {
     is >> pvp >> frameType >> buffers >> period >> phase >> range
-       >> pixel >> subpixel >> zoom;
+       >> pixel >> subpixel >> zoom >> dropped;
 }
 
 }
@@ -36,7 +36,7 @@ namespace fabric
 struct FrameData
 {
     FrameData() : frameType( Frame::TYPE_MEMORY ), buffers( 0 ), period( 1 )
-                , phase( 0 ) {}
+                , phase( 0 ), dropped( false ) {}
 
     PixelViewport pvp;
     Frame::Type   frameType;
@@ -47,6 +47,7 @@ struct FrameData
     Pixel         pixel;     //<! pixel decomposition of source
     SubPixel      subpixel;  //<! subpixel decomposition of source
     Zoom          zoom;
+    bool          dropped;   //<! readback skipped after the frame deadline
 
     EQFABRIC_API void serialize( co::DataOStream& os ) const;
     EQFABRIC_API void deserialize( co::DataIStream& is );
@@ -102,6 +102,25 @@ namespace fabric
         /** @return the current VRPN tracker device name. @version 1.5.2 */
         const std::string& getVRPNTracker() const { return _data.vrpnTracker; }
 
+        /**
+         * Enable late latching of the tracked head matrix.
+         *
+         * When enabled, the render nodes update the frustum and head transform
+         * with the newest tracker sample, extrapolated to the expected display
+         * time, immediately before Channel::frameDraw().
+         * @version 1.8
+         */
+        EQFABRIC_INL void setLateLatch( const bool enable );
+
+        /** @return true if late latching is enabled. @version 1.8 */
+        bool getLateLatch() const { return _data.lateLatch; }
+
+        /** @internal Set the identifier of the latched tracker samples. */
+        EQFABRIC_INL void setLatchID( const uint128_t& id );
+
+        /** @internal @return the identifier of the latched samples. */
+        const uint128_t& getLatchID() const { return _data.latchID; }
+
         /** @return the parent config of this observer. @version 1.0 */
         const C* getConfig() const { return _config; }
 
@@ -175,6 +194,8 @@ namespace fabric
             FocusMode focusMode; //!< The current focal distance mode
             int32_t camera; //!< The OpenCV camera used for head tracking
             std::string vrpnTracker; //!< VRPN tracking device
+            bool lateLatch; //!< Latch tracker samples on the render nodes
+            uint128_t latchID; //!< Distributed tracker samples
         }
             _data, _backup;
 
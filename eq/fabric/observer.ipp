@@ -57,6 +57,7 @@ Observer< C, O >::BackupData::BackupData()
     , focusDistance( 1.f )
     , focusMode( FOCUSMODE_FIXED )
     , camera( OFF )
+    , lateLatch( false )
 {
     for( size_t i = 0; i < NUM_EYES; ++i )
         eyePosition[ i ] = Vector3f::ZERO;
@@ -93,7 +94,8 @@ void Observer< C, O >::serialize( co::DataOStream& os,
     if( dirtyBits & DIRTY_FOCUS )
         os << _data.focusDistance << _data.focusMode;
     if( dirtyBits & DIRTY_TRACKER )
-        os << _data.camera << _data.vrpnTracker;
+        os << _data.camera << _data.vrpnTracker << _data.lateLatch
+           << _data.latchID;
 }
 
 template< typename C, typename O >
@@ -110,7 +112,8 @@ void Observer< C, O >::deserialize( co::DataIStream& is,
     if( dirtyBits & DIRTY_FOCUS )
         is >> _data.focusDistance >> _data.focusMode;
     if( dirtyBits & DIRTY_TRACKER )
-        is >> _data.camera >> _data.vrpnTracker;
+        is >> _data.camera >> _data.vrpnTracker >> _data.lateLatch
+           >> _data.latchID;
 }
 
 template< typename C, typename O >
@@ -222,6 +225,26 @@ void Observer< C, O >::setVRPNTracker( const std::string& tracker )
     setDirty( DIRTY_TRACKER );
 }
 
+template< typename C, typename O >
+void Observer< C, O >::setLateLatch( const bool enable )
+{
+    if( _data.lateLatch == enable )
+        return;
+
+    _data.lateLatch = enable;
+    setDirty( DIRTY_TRACKER );
+}
+
+template< typename C, typename O >
+void Observer< C, O >::setLatchID( const uint128_t& id )
+{
+    if( _data.latchID == id )
+        return;
+
+    _data.latchID = id;
+    setDirty( DIRTY_TRACKER );
+}
+
 template< typename C, typename O >
 bool Observer< C, O >::setHeadMatrix( const Matrix4f& matrix )
 {
@@ -254,6 +277,8 @@ std::ostream& operator << ( std::ostream& os, const Observer< C, O >& observer )
     if( !observer.getVRPNTracker().empty( ))
         os << "vrpn_tracker   \"" << observer.getVRPNTracker() << "\""
            << std::endl;
+    if( observer.getLateLatch( ))
+        os << "late_latch     ON" << std::endl;
     os << lunchbox::exdent << "}" << std::endl << lunchbox::enableHeader
        << lunchbox::enableFlush;
     return os;
@@ -22,6 +22,15 @@ namespace eq
 {
 namespace fabric
 {
+namespace
+{
+bool _equals( const Frustumf& a, const Frustumf& b )
+{
+    return a.left() == b.left() && a.right() == b.right() &&
+           a.bottom() == b.bottom() && a.top() == b.top() &&
+           a.near_plane() == b.near_plane() && a.far_plane() == b.far_plane();
+}
+}
 
 // cppcheck-suppress uninitMemberVar
 RenderContext::RenderContext()
@@ -29,6 +38,12 @@ RenderContext::RenderContext()
         , ortho( Frustumf::DEFAULT )
         , headTransform( Matrix4f::IDENTITY )
         , orthoTransform( Matrix4f::IDENTITY )
+        , latchID( 0 )
+        , headMatrix( Matrix4f::IDENTITY )
+        , eyeHead( Vector3f::ZERO )
+        , modelUnit( 1.f )
+        , eyeWall( Vector3f::ZERO )
+        , wallType( 0 )
         , frameID( 0 )
         , overdraw( Vector4i::ZERO )
         , offset( Vector2i::ZERO )
@@ -48,6 +63,28 @@ void RenderContext::apply( const Tile& tile )
     vp = tile.vp;
 }
 
+// Keep in sync with the members and the byteswap in the header, checked by
+// tests/fabric/renderContext.cpp
+bool RenderContext::operator == ( const RenderContext& rhs ) const
+{
+    return _equals( frustum, rhs.frustum ) && _equals( ortho, rhs.ortho ) &&
+           headTransform == rhs.headTransform &&
+           orthoTransform == rhs.orthoTransform &&
+           latchID == rhs.latchID && headMatrix == rhs.headMatrix &&
+           eyeHead == rhs.eyeHead && modelUnit == rhs.modelUnit &&
+           eyeWall == rhs.eyeWall && wallType == rhs.wallType &&
+           view == rhs.view && frameID == rhs.frameID && pvp == rhs.pvp &&
+           pixel == rhs.pixel && overdraw == rhs.overdraw && vp == rhs.vp &&
+           offset == rhs.offset && range == rhs.range &&
+           subpixel == rhs.subpixel && zoom == rhs.zoom &&
+           buffer == rhs.buffer && taskID == rhs.taskID &&
+           period == rhs.period && phase == rhs.phase && eye == rhs.eye &&
+           bufferMask.red == rhs.bufferMask.red &&
+           bufferMask.green == rhs.bufferMask.green &&
+           bufferMask.blue == rhs.bufferMask.blue &&
+           bufferMask.alpha == rhs.bufferMask.alpha;
+}
+
 std::ostream& operator << ( std::ostream& os, const RenderContext& ctx )
 {
     return os << "ID " << ctx.frameID << " pvp " << ctx.pvp << " vp " << ctx.vp
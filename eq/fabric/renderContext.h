@@ -41,12 +41,29 @@ namespace fabric
         EQFABRIC_API RenderContext();
         EQFABRIC_API void apply( const Tile& tile ); //!< @internal
 
+        /**
+         * @return true if all members, except for the padding, are equal.
+         * @version 1.8
+         */
+        EQFABRIC_API bool operator == ( const RenderContext& rhs ) const;
+
+        /** @return true if any member differs. @version 1.8 */
+        bool operator != ( const RenderContext& rhs ) const
+            { return !( *this == rhs ); }
+
         Frustumf       frustum;        //!< frustum for projection matrix
         Frustumf       ortho;          //!< ortho frustum for projection matrix
 
         Matrix4f       headTransform;  //!< frustum transform for modelview
         Matrix4f       orthoTransform; //!< orthographic frustum transform
 
+        uint128_t      latchID;        //!< @internal late-latched samples
+        Matrix4f       headMatrix;     //!< @internal head matrix of frustum
+        Vector3f       eyeHead;        //!< @internal eye wrt observer head
+        float          modelUnit;      //!< @internal view model unit
+        Vector3f       eyeWall;        //!< @internal eye wrt frustum
+        uint32_t       wallType;       //!< @internal Wall::Type of frustum
+
         co::ObjectVersion view;        //!< destination view id and version
         uint128_t      frameID;        //!< identifier from Config::beginFrame
         PixelViewport  pvp;            //!< pixel viewport of channel wrt window
@@ -85,6 +102,13 @@ template<> inline void byteswap( eq::fabric::RenderContext& value )
     byteswap( value.headTransform );
     byteswap( value.orthoTransform );
 
+    byteswap( value.latchID );
+    byteswap( value.headMatrix );
+    byteswap( value.eyeHead );
+    byteswap( value.modelUnit );
+    byteswap( value.eyeWall );
+    byteswap( value.wallType );
+
     byteswap( value.view );
     byteswap( value.frameID );
     byteswap( value.pvp );
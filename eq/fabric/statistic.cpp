@@ -83,6 +83,30 @@ static StatisticData _statisticData[] =
    "finish frame", Vector3f( .5f, .5f, .5f ) },
  { Statistic::CONFIG_WAIT_FINISH_FRAME,
    "wait finish",  Vector3f( 1.0f, 0.f, 0.f ) },
+ { Statistic::CONFIG_PREPARE_FRAME,
+   "prepare frame", Vector3f( .5f, .5f, 1.f ) },
+ { Statistic::PIPE_STREAM_UPLOAD,
+   "stream upload", Vector3f( 0.f, 1.f, .5f ) },
+ { Statistic::CHANNEL_FRAME_MERGE,
+   "merge",        Vector3f( .8f, .8f, 0.f ) },
+ { Statistic::CONFIG_LOAD_2D,
+   "load 2D",      Vector3f( 0.f, 1.f, 1.f ) },
+ { Statistic::CONFIG_LOAD_DB,
+   "load DB",      Vector3f( 1.f, .5f, 0.f ) },
+ { Statistic::CONFIG_DPLEX_JITTER,
+   "DPlex jitter", Vector3f( 1.f, 1.f, 0.f ) },
+ { Statistic::CONFIG_VIEW_STEAL,
+   "view steal",   Vector3f( 0.f, .5f, 1.f ) },
+ { Statistic::CONFIG_VIEW_IDLE,
+   "view idle",    Vector3f( .5f, .5f, .5f ) },
+ { Statistic::CHANNEL_FRAME_DROP,
+   "drop frame",   Vector3f( 1.f, .3f, 0.f ) },
+ { Statistic::WINDOW_FRAME_LATENCY,
+   "latency",      Vector3f( .7f, .7f, 1.f ) },
+ { Statistic::CHANNEL_MOTION_TO_PHOTON,
+   "motion to photon", Vector3f( .5f, 1.f, .5f ) },
+ { Statistic::CONFIG_HEAD_TRACKING,
+   "head tracking", Vector3f( .5f, 1.f, .5f ) },
  { Statistic::ALL,
    "ALL EVENTS",   Vector3f( 0.0f, 0.f, 0.f ) }} ;
 }
@@ -66,6 +66,29 @@ struct Statistic
         CONFIG_FINISH_FRAME, //!< Sampling of Config::finishFrame
         /** Sampling of synchronization time during Config::finishFrame */
         CONFIG_WAIT_FINISH_FRAME,
+        // new types are appended to keep the values of the existing ones
+        /** Sampling of the server-side compound update and task generation */
+        CONFIG_PREPARE_FRAME,
+        PIPE_STREAM_UPLOAD, //!< Sampling of DataStreamer::upload
+        CHANNEL_FRAME_MERGE, //!< Sampling of streaming CPU compositing
+        /** Hybrid load_equalizer decision for sort-first, predicted time */
+        CONFIG_LOAD_2D,
+        /** Hybrid load_equalizer decision for sort-last, predicted time */
+        CONFIG_LOAD_DB,
+        /** Output frame jitter of the dplex_equalizer, mean frame interval */
+        CONFIG_DPLEX_JITTER,
+        /** Tiles stolen from a view of the view_equalizer, stolen time */
+        CONFIG_VIEW_STEAL,
+        /** Idle pipe time during a view_equalizer frame, idle time */
+        CONFIG_VIEW_IDLE,
+        /** Frame dropped after its deadline, number of dropped frames */
+        CHANNEL_FRAME_DROP,
+        /** End-to-end latency from the frame start to a deadline swap */
+        WINDOW_FRAME_LATENCY,
+        /** Latched tracker sample to the predicted display of the frame */
+        CHANNEL_MOTION_TO_PHOTON,
+        /** Head tracker capture to observer update, tracking rate in Hz */
+        CONFIG_HEAD_TRACKING,
         ALL          // must be last
     };
 
@@ -73,16 +96,24 @@ struct Statistic
     uint32_t frameNumber; //!< The frame during when the sampling happened
     uint32_t task; //!< @internal
     uint32_t plugins[2]; //!< color,depth plugins (readback, compression)
+    uint32_t frameData; //!< @internal output frame read, sent or waited on
 
     int64_t  startTime; //!< Absolute start time of the operation
     int64_t  endTime;    //!< Absolute end time of the operation
     int64_t  idleTime;  //!< Absolute idle time of PIPE_IDLE
     int64_t  totalTime;  //!< Total time of a pipe frame (PIPE_IDLE)
 
-    float    ratio; //!< compression ratio (transfer, compression)
+    /**
+     * compression, upload budget, hidden merge, load mode cost, jitter or
+     * idle ratio, the number of tiles drawn by a CHANNEL_DRAW of a tile
+     * task or stolen from a view (CONFIG_VIEW_STEAL), or the number of
+     * frames dropped by a channel (CHANNEL_FRAME_DROP), or the head
+     * tracking updates per second (CONFIG_HEAD_TRACKING)
+     */
+    float    ratio;
     float    currentFPS; //!< FPS of last frame (WINDOW_FPS)
     float    averageFPS; //!< Weighted sum averaging of FPS (WINDOW_FPS)
-    float    pad; //!< @internal
+    uint32_t bytes; //!< Bytes sent by CHANNEL_FRAME_TRANSMIT @version 1.8
 
     char resourceName[32]; //!< A non-unique name of the originator
 
@@ -113,6 +144,7 @@ template<> inline void byteswap( eq::fabric::Statistic& value )
     byteswap( value.task );
     byteswap( value.plugins[0] );
     byteswap( value.plugins[1] );
+    byteswap( value.frameData );
 
     byteswap( value.startTime );
     byteswap( value.endTime );
@@ -122,6 +154,7 @@ template<> inline void byteswap( eq::fabric::Statistic& value )
     byteswap( value.ratio );
     byteswap( value.currentFPS );
     byteswap( value.averageFPS );
+    byteswap( value.bytes );
 }
 }
 
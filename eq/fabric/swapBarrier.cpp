@@ -31,11 +31,14 @@ std::ostream& operator << ( std::ostream& os, const SwapBarrier& swapBarrier )
                   << "    NV_group " << swapBarrier.getNVSwapGroup() <<std::endl
                   << "    NV_barrier " << swapBarrier.getNVSwapBarrier()
                   << std::endl
+                  << ( swapBarrier.isHierarchical() ? "    hierarchical ON\n" :
+                                                      "" )
                   << "}"  << lunchbox::enableFlush << std::endl; 
 
-    return os << lunchbox::disableFlush << "swapbarrier { name \"" 
-              << swapBarrier.getName() << "\" }" << lunchbox::enableFlush
-              << std::endl;
+    return os << lunchbox::disableFlush << "swapbarrier { name \""
+              << swapBarrier.getName() << "\" "
+              << ( swapBarrier.isHierarchical() ? "hierarchical ON " : "" )
+              << "}" << lunchbox::enableFlush << std::endl;
 }
 
 }
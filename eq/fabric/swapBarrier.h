@@ -40,7 +40,8 @@ namespace fabric
         /** 
          * Constructs a new SwapBarrier.
          */
-        SwapBarrier() : _nvSwapGroup( 0 ), _nvSwapBarrier( 0 ) {}
+        SwapBarrier() : _nvSwapGroup( 0 ), _nvSwapBarrier( 0 )
+                      , _hierarchical( false ) {}
 
         /** @name Data Access. */
         //@{
@@ -56,6 +57,14 @@ namespace fabric
 
         bool isNvSwapBarrier() const
             { return ( _nvSwapBarrier || _nvSwapGroup ); }
+
+        /**
+         * Synchronize the windows of each node locally first, and then the
+         * nodes without a central master.
+         */
+        void setHierarchical( const bool hierarchical )
+            { _hierarchical = hierarchical; }
+        bool isHierarchical() const { return _hierarchical; }
         //@}
 
     private:
@@ -63,6 +72,7 @@ namespace fabric
 
         uint32_t _nvSwapGroup;
         uint32_t _nvSwapBarrier;
+        bool _hierarchical;
     };
 
     EQFABRIC_API std::ostream& operator << ( std::ostream&, const SwapBarrier& );
@@ -20,6 +20,7 @@
 
 #include "channel.h"
 
+#include "canvas.h"
 #include "channelListener.h"
 #include "channelUpdateVisitor.h"
 #include "compound.h"
@@ -29,6 +30,8 @@
 #include "global.h"
 #include "log.h"
 #include "node.h"
+#include "observer.h"
+#include "pipe.h"
 #include "segment.h"
 #include "view.h"
 #include "window.h"
@@ -41,6 +44,7 @@
 
 #include <lunchbox/debug.h>
 
+#include <limits>
 #include <set>
 
 namespace eq
@@ -78,6 +82,115 @@ namespace
         const Channel*     _channel;
         ViewSet  _viewSet;
     };
+
+    /**
+     * Finds tasks of a channel which can't be repeated from the cache, and
+     * collects the state the tasks of repeatable channels are derived from.
+     */
+    class RepeatableFinder : public CompoundVisitor
+    {
+    public:
+        RepeatableFinder( const Channel* channel, Channel::TaskKey& key )
+            : _channel( channel ), _key( key ), _repeatable( true )
+            , _static( true )
+            , _maxFPS( std::numeric_limits< float >::max( ))
+        {}
+        virtual ~RepeatableFinder(){}
+
+        virtual VisitorResult visit( const Compound* compound )
+        {
+            if( compound->getChannel() != _channel )
+                return TRAVERSE_CONTINUE;
+
+            // frame and tile tasks reference per-frame object versions
+            if( compound->hasTiles() ||
+                compound->testInheritTask( fabric::TASK_ASSEMBLE ) ||
+                compound->testInheritTask( fabric::TASK_READBACK ))
+            {
+                _repeatable = false;
+                return TRAVERSE_TERMINATE;
+            }
+
+            // equalizers and periods change the tasks without a new version
+            if( compound->getInheritPeriod() > 1 || _hasEqualizers( compound ))
+                _static = false;
+            if( !_static )
+                return TRAVERSE_CONTINUE;
+
+            uint32_t active = 0;
+            for( uint32_t i = 0; i < fabric::NUM_EYES; ++i )
+                if( compound->isInheritActive( Eye( 1 << i )))
+                    active |= 1 << i;
+            _key.push_back( uint128_t( uint64_t( compound ),
+                                       uint64_t( active ) << 32 |
+                                       compound->getInheritTasks( )));
+            if( active && compound->getInheritTasks() != fabric::TASK_NONE )
+                _maxFPS = LB_MIN( _maxFPS, compound->getInheritMaxFPS( ));
+
+            const Channel* channel = compound->getInheritChannel();
+            const View* view = channel->getView();
+            _add( channel );
+            _add( view );
+            _add( view ? view->getObserver() : 0 );
+            _add( channel->getSegment( ));
+            _add( channel->getCanvas( ));
+            return TRAVERSE_CONTINUE;
+        }
+
+        bool isRepeatable() const { return _repeatable; }
+
+        /** @return true if the tasks only change with the collected key. */
+        bool isStatic() const { return _repeatable && _static; }
+
+        /** @return the minimum frame rate of the static compounds. */
+        float getMaxFPS() const { return _maxFPS; }
+
+    private:
+        const Channel* const _channel;
+        Channel::TaskKey& _key;
+        bool _repeatable;
+        bool _static;
+        float _maxFPS;
+
+        static bool _hasEqualizers( const Compound* compound )
+        {
+            for( ; compound; compound = compound->getParent( ))
+                if( !compound->getEqualizers().empty( ))
+                    return true;
+            return false;
+        }
+
+        void _add( const fabric::Object* object )
+        {
+            if( !object )
+                return;
+            if( object->isDirty( ))
+                _static = false; // changed, but not committed yet
+            _key.push_back( object->getID( ));
+            _key.push_back( object->getVersion( ));
+        }
+    };
+
+    bool _equals( const Channel::Tasks& a, const Channel::Tasks& b )
+    {
+        if( a.size() != b.size( ))
+            return false;
+
+        for( size_t i = 0; i < a.size(); ++i )
+        {
+            // contexts are compared without their frame identifier
+            RenderContext context = a[i].context;
+            context.frameID = b[i].context.frameID;
+
+            if( a[i].command != b[i].command ||
+                a[i].objectID != b[i].objectID ||
+                a[i].finish != b[i].finish || context != b[i].context )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 Channel::Channel( Window* parent )
@@ -87,6 +200,7 @@ Channel::Channel( Window* parent )
         , _segment( 0 )
         , _state( STATE_STOPPED )
         , _lastDrawCompound( 0 )
+        , _lastUpdated( false )
         , _private( 0 )
 {
     const Global* global = Global::instance();
@@ -109,6 +223,7 @@ Channel::Channel( const Channel& from )
         , _segment( 0 )
         , _state( STATE_STOPPED )
         , _lastDrawCompound( 0 )
+        , _lastUpdated( false )
         , _private( 0 )
 {
     // Don't copy view and segment. Will be re-set by segment copy ctor
@@ -383,32 +498,178 @@ bool Channel::update( const uint128_t& frameID, const uint32_t frameNumber )
     LBLOG( LOG_TASKS ) << "TASK channel " << getName() << " start frame  "
                        << frameNumber << std::endl;
 
+    TaskKey key;
+    float maxFPS = 0.f;
+    const bool useTaskCache = _useTaskCache( key, maxFPS );
+    if( !key.empty() && key == _lastTaskKey )
+    {
+        // Nothing the tasks are derived from changed: skip the update and
+        // repeat the recorded tasks, including the frame rate limit.
+        Window* window = getWindow();
+        if( maxFPS < window->getMaxFPS( ))
+            window->setMaxFPS( maxFPS );
+
+        _sendTasks( _lastTasks, true, frameID, frameNumber );
+        _finishUpdate( context, frameNumber );
+        return _lastUpdated;
+    }
+
     bool updated = false;
+    Tasks tasks;
     const Compounds& compounds = getCompounds();
-    for( Compounds::const_iterator i = compounds.begin();
-         i != compounds.end(); ++i )
+
+    // Deferred compounds steal work from other views, and are issued after
+    // the channel's own tasks of this frame.
+    for( size_t deferred = 0; deferred < 2; ++deferred )
     {
-        const Compound* compound = *i;
-        ChannelUpdateVisitor visitor( this, frameID, frameNumber );
+        for( Compounds::const_iterator i = compounds.begin();
+             i != compounds.end(); ++i )
+        {
+            const Compound* compound = *i;
+            ChannelUpdateVisitor visitor( this, frameID, frameNumber );
+            if( useTaskCache )
+                visitor.setTasks( &tasks );
+            visitor.setDeferred( deferred != 0 );
 
-        visitor.setEye( EYE_CYCLOP );
-        compound->accept( visitor );
+            visitor.setEye( EYE_CYCLOP );
+            compound->accept( visitor );
 
-        visitor.setEye( EYE_LEFT );
-        compound->accept( visitor );
+            visitor.setEye( EYE_LEFT );
+            compound->accept( visitor );
 
-        visitor.setEye( EYE_RIGHT );
-        compound->accept( visitor );
+            visitor.setEye( EYE_RIGHT );
+            compound->accept( visitor );
 
-        updated |= visitor.isUpdated();
+            updated |= visitor.isUpdated();
+        }
+    }
+
+    if( useTaskCache )
+    {
+        const bool repeat = !tasks.empty() && _equals( tasks, _lastTasks );
+        _sendTasks( tasks, repeat, frameID, frameNumber );
+        _lastTasks.swap( tasks );
+        _lastTaskKey.swap( key );
+    }
+    else
+    {
+        _lastTasks.clear();
+        _lastTaskKey.clear();
     }
+    _lastUpdated = updated;
 
+    _finishUpdate( context, frameNumber );
+    return updated;
+}
+
+void Channel::_finishUpdate( const RenderContext& context,
+                             const uint32_t frameNumber )
+{
     send( fabric::CMD_CHANNEL_FRAME_FINISH ) << context << frameNumber;
     LBLOG( LOG_TASKS ) << "TASK channel " << getName() << " finish frame  "
                            << frameNumber << std::endl;
     _lastDrawCompound = 0;
+}
 
-    return updated;
+bool Channel::_useTaskCache( TaskKey& key, float& maxFPS ) const
+{
+    if( getConfig()->getIAttribute( Config::IATTR_TASK_CACHE ) != fabric::ON )
+        return false;
+
+    RepeatableFinder finder( this, key );
+    const Compounds& compounds = getCompounds();
+    for( Compounds::const_iterator i = compounds.begin();
+         i != compounds.end() && finder.isRepeatable(); ++i )
+    {
+        (*i)->accept( finder );
+    }
+    if( !finder.isRepeatable( ))
+        return false;
+
+    if( !finder.isStatic( ))
+    {
+        key.clear();
+        return true;
+    }
+
+    // the placement of the draw finish tasks, the draw finish flag and the
+    // window's drawable
+    const Window* window = getWindow();
+    const Pipe* pipe = getPipe();
+    const uint32_t flags = ( window->getLastDrawChannel() == this ) |
+                           ( pipe->getLastDrawWindow() == window ) << 1 |
+                           ( getNode()->getLastDrawPipe() == pipe ) << 2 |
+                           hasListeners() << 3;
+    key.push_back( uint128_t( uint64_t( _lastDrawCompound ), flags ));
+    key.push_back( window->getID( ));
+    key.push_back( window->getVersion( ));
+    if( window->isDirty( ))
+        key.clear();
+    maxFPS = finder.getMaxFPS();
+    return true;
+}
+
+void Channel::_sendTasks( const Tasks& tasks, const bool repeat,
+                          const uint128_t& frameID, const uint32_t frameNumber )
+{
+    // The client channel replays its tasks of the last frame with the new
+    // frame identifier. Draw finish tasks of the window, pipe and node are not
+    // cached, and are sent in between the repeats of the channel task ranges
+    // to keep the original task order.
+    uint32_t begin = 0; // first channel task to repeat
+    uint32_t end = 0;   // end of the channel tasks to repeat
+
+    Node* node = getNode();
+    for( Tasks::const_iterator i = tasks.begin(); i != tasks.end(); ++i )
+    {
+        const Task& task = *i;
+        if( repeat && task.objectID == getID( ))
+        {
+            ++end;
+            continue;
+        }
+
+        if( begin < end )
+        {
+            _sendRepeat( frameID, frameNumber, begin, end );
+            begin = end;
+        }
+
+        RenderContext context = task.context;
+        context.frameID = frameID;
+
+        switch( task.command )
+        {
+          case fabric::CMD_CHANNEL_FRAME_CLEAR:
+          case fabric::CMD_CHANNEL_FRAME_VIEW_START:
+          case fabric::CMD_CHANNEL_FRAME_VIEW_FINISH:
+              node->send( task.command, task.objectID ) << context;
+              break;
+
+          case fabric::CMD_CHANNEL_FRAME_DRAW:
+              node->send( task.command, task.objectID )
+                  << context << task.finish;
+              break;
+
+          default: // draw finish of channel, window, pipe or node
+              node->send( task.command, task.objectID )
+                  << frameID << frameNumber;
+              break;
+        }
+    }
+
+    if( begin < end )
+        _sendRepeat( frameID, frameNumber, begin, end );
+}
+
+void Channel::_sendRepeat( const uint128_t& frameID, const uint32_t frameNumber,
+                           const uint32_t begin, const uint32_t end )
+{
+    send( fabric::CMD_CHANNEL_FRAME_REPEAT ) << frameID << frameNumber
+                                             << begin << end;
+    LBLOG( LOG_TASKS ) << "TASK repeat " << getName() << " frame "
+                       << frameNumber << " tasks " << begin << ".." << end
+                       << std::endl;
 }
 
 co::ObjectOCommand Channel::send( const uint32_t cmd )
@@ -512,6 +773,8 @@ void Channel::output( std::ostream& os ) const
 
         os << ( i==IATTR_HINT_STATISTICS ? "hint_statistics   " :
                 i==IATTR_HINT_SENDTOKEN ?  "hint_sendtoken    " :
+                i==IATTR_HINT_ACTIVE_PIXELS ? "hint_active_pixels " :
+                i==IATTR_HINT_PROGRESSIVE ? "hint_progressive  " :
                                            "ERROR " )
            << static_cast< fabric::IAttribute >( value ) << std::endl;
     }
@@ -25,6 +25,7 @@
 
 #include <eq/fabric/channel.h>       // base class
 #include <eq/fabric/pixelViewport.h> // member
+#include <eq/fabric/renderContext.h> // member
 #include <eq/fabric/viewport.h>      // member
 #include <lunchbox/monitor.h> // member
 
@@ -132,6 +133,24 @@ public:
         { _lastDrawCompound = compound; }
     const Compound* getLastDrawCompound() const { return _lastDrawCompound;}
 
+    /** @internal A task recorded for repeating unchanged frames. */
+    struct Task
+    {
+        Task( const uint32_t command_, const uint128_t& objectID_,
+              const RenderContext& context_, const bool finish_ = false )
+            : command( command_ ), objectID( objectID_ ), context( context_ )
+            , finish( finish_ ) {}
+
+        uint32_t command; //!< The task command
+        uint128_t objectID; //!< The receiving channel, window, pipe or node
+        RenderContext context; //!< The render context of channel tasks
+        bool finish; //!< The finish flag of draw tasks
+    };
+    typedef std::vector< Task > Tasks;
+
+    /** The versions and state the tasks of a channel are derived from. */
+    typedef std::vector< uint128_t > TaskKey;
+
     void setIAttribute( const IAttribute attr, const int32_t value )
         { fabric::Channel< Window, Channel >::setIAttribute( attr, value );}
     void setSAttribute( const SAttribute attr, const std::string& value )
@@ -208,6 +227,15 @@ private:
     typedef std::vector< ChannelListener* > ChannelListeners;
     ChannelListeners _listeners;
 
+    /** The tasks of the last frame, if recorded for the task cache. */
+    Tasks _lastTasks;
+
+    /** The key of _lastTasks, empty if they may change without a new key. */
+    TaskKey _lastTaskKey;
+
+    /** The return value of update() for _lastTasks. */
+    bool _lastUpdated;
+
     LB_TS_VAR( _serverThread );
 
     struct Private;
@@ -219,6 +247,25 @@ private:
     void _setupRenderContext( const uint128_t& frameID,
                               RenderContext& context );
 
+    /**
+     * @return true if the tasks of this frame can be recorded, with the key
+     *         of the tasks and the frame rate limit of the compounds if they
+     *         only change with the key.
+     */
+    bool _useTaskCache( TaskKey& key, float& maxFPS ) const;
+
+    /** Send the recorded tasks, using repeats for unchanged channel tasks. */
+    void _sendTasks( const Tasks& tasks, const bool repeat,
+                     const uint128_t& frameID, const uint32_t frameNumber );
+
+    /** Send the channel frame finish and reset the per-frame state. */
+    void _finishUpdate( const RenderContext& context,
+                        const uint32_t frameNumber );
+
+    /** Repeat the given range of the client's recorded channel tasks. */
+    void _sendRepeat( const uint128_t& frameID, const uint32_t frameNumber,
+                      const uint32_t begin, const uint32_t end );
+
     void _fireLoadData( const uint32_t frameNumber,
                         const Statistics& statistics,
                         const Viewport& region );
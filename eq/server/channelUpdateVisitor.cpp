@@ -92,15 +92,36 @@ ChannelUpdateVisitor::ChannelUpdateVisitor( Channel* channel,
         , _frameID( frameID )
         , _frameNumber( frameNumber )
         , _updated( false )
+        , _deferred( false )
+        , _tasks( 0 )
 {}
 
 bool ChannelUpdateVisitor::_skipCompound( const Compound* compound )
 {
     return ( compound->getChannel() != _channel ||
+             compound->isDeferred() != _deferred ||
              !compound->isInheritActive( _eye ) ||
              compound->getInheritTasks() == fabric::TASK_NONE );
 }
 
+bool ChannelUpdateVisitor::_record( const uint32_t command,
+                                    const uint128_t& objectID,
+                                    const RenderContext& context,
+                                    const bool finish ) const
+{
+    if( !_tasks )
+        return false;
+
+    _tasks->push_back( Channel::Task( command, objectID, context, finish ));
+    return true;
+}
+
+bool ChannelUpdateVisitor::_record( const uint32_t command,
+                                    const uint128_t& objectID ) const
+{
+    return _record( command, objectID, RenderContext( ));
+}
+
 VisitorResult ChannelUpdateVisitor::visitPre( const Compound* compound )
 {
     if( !compound->isInheritActive( _eye ))
@@ -221,7 +242,12 @@ void ChannelUpdateVisitor::_updateDraw( const Compound* compound,
     if( compound->testInheritTask( fabric::TASK_DRAW ))
     {
         const bool finish = _channel->hasListeners(); // finish for eq stats
-        _channel->send( fabric::CMD_CHANNEL_FRAME_DRAW ) << context << finish;
+        if( !_record( fabric::CMD_CHANNEL_FRAME_DRAW, _channel->getID(),
+                      context, finish ))
+        {
+            _channel->send( fabric::CMD_CHANNEL_FRAME_DRAW )
+                << context << finish;
+        }
         _updated = true;
         LBLOG( LOG_TASKS ) << "TASK draw " << _channel->getName() <<  " "
                            << finish << std::endl;
@@ -259,6 +285,7 @@ void ChannelUpdateVisitor::_updateDrawTiles( const Compound* compound,
                             ( eq::fabric::TASK_CLEAR | eq::fabric::TASK_DRAW |
                               eq::fabric::TASK_READBACK );
 
+        LBASSERT( !_tasks ); // not repeatable, see Channel::update
         _channel->send( fabric::CMD_CHANNEL_FRAME_TILES )
                 << context << isLocal << id << tasks << frameIDs;
         _updated = true;
@@ -269,6 +296,9 @@ void ChannelUpdateVisitor::_updateDrawTiles( const Compound* compound,
 
 void ChannelUpdateVisitor::_updateDrawFinish( const Compound* compound ) const
 {
+    if( compound->isDeferred() != _deferred )
+        return;
+
     const Compound* lastDrawCompound = _channel->getLastDrawCompound();
     if( lastDrawCompound && lastDrawCompound != compound )
         return;
@@ -283,8 +313,9 @@ void ChannelUpdateVisitor::_updateDrawFinish( const Compound* compound ) const
     // Channel::frameDrawFinish
     Node* node = _channel->getNode();
 
-    node->send( fabric::CMD_CHANNEL_FRAME_DRAW_FINISH, _channel->getID( ))
-            << _frameID << _frameNumber;
+    if( !_record( fabric::CMD_CHANNEL_FRAME_DRAW_FINISH, _channel->getID( )))
+        node->send( fabric::CMD_CHANNEL_FRAME_DRAW_FINISH, _channel->getID( ))
+                << _frameID << _frameNumber;
     LBLOG( LOG_TASKS ) << "TASK channel draw finish " << _channel->getName()
                        << " frame " << _frameNumber
                        << " id " << _frameID << std::endl;
@@ -298,8 +329,9 @@ void ChannelUpdateVisitor::_updateDrawFinish( const Compound* compound ) const
 
     window->setLastDrawChannel( _channel ); // in case not set
 
-    node->send( fabric::CMD_WINDOW_FRAME_DRAW_FINISH, window->getID( ))
-            << _frameID << _frameNumber;
+    if( !_record( fabric::CMD_WINDOW_FRAME_DRAW_FINISH, window->getID( )))
+        node->send( fabric::CMD_WINDOW_FRAME_DRAW_FINISH, window->getID( ))
+                << _frameID << _frameNumber;
     LBLOG( LOG_TASKS ) << "TASK window draw finish "  << window->getName()
                            <<  " frame " << _frameNumber
                            << " id " << _frameID << std::endl;
@@ -312,8 +344,9 @@ void ChannelUpdateVisitor::_updateDrawFinish( const Compound* compound ) const
 
     pipe->setLastDrawWindow( window ); // in case not set
 
-    node->send( fabric::CMD_PIPE_FRAME_DRAW_FINISH, pipe->getID( ))
-            << _frameID << _frameNumber;
+    if( !_record( fabric::CMD_PIPE_FRAME_DRAW_FINISH, pipe->getID( )))
+        node->send( fabric::CMD_PIPE_FRAME_DRAW_FINISH, pipe->getID( ))
+                << _frameID << _frameNumber;
     LBLOG( LOG_TASKS ) << "TASK pipe draw finish " << pipe->getName()
                        << " frame " << _frameNumber
                        << " id " << _frameID << std::endl;
@@ -325,15 +358,20 @@ void ChannelUpdateVisitor::_updateDrawFinish( const Compound* compound ) const
 
     node->setLastDrawPipe( pipe ); // in case not set
 
-    node->send( fabric::CMD_NODE_FRAME_DRAW_FINISH, node->getID( ))
-            << _frameID << _frameNumber;
+    if( !_record( fabric::CMD_NODE_FRAME_DRAW_FINISH, node->getID( )))
+        node->send( fabric::CMD_NODE_FRAME_DRAW_FINISH, node->getID( ))
+                << _frameID << _frameNumber;
     LBLOG( LOG_TASKS ) << "TASK node draw finish " << node->getName() <<  " "
                        << std::endl;
 }
 
 void ChannelUpdateVisitor::_sendClear( const RenderContext& context )
 {
-    _channel->send( fabric::CMD_CHANNEL_FRAME_CLEAR ) << context;
+    if( !_record( fabric::CMD_CHANNEL_FRAME_CLEAR, _channel->getID(),
+                  context ))
+    {
+        _channel->send( fabric::CMD_CHANNEL_FRAME_CLEAR ) << context;
+    }
     _updated = true;
     LBLOG( LOG_TASKS ) << "TASK clear " << _channel->getName() <<  " "
                        << std::endl;
@@ -419,6 +457,7 @@ void ChannelUpdateVisitor::_updateAssemble( const Compound* compound,
     LBLOG( LOG_ASSEMBLY | LOG_TASKS )
         << "TASK assemble " << _channel->getName()
         << " nFrames " << frames.size() << std::endl;
+    LBASSERT( !_tasks ); // not repeatable, see Channel::update
     _channel->send( fabric::CMD_CHANNEL_FRAME_ASSEMBLE )
             << context << frames;
     _updated = true;
@@ -452,6 +491,7 @@ void ChannelUpdateVisitor::_updateReadback( const Compound* compound,
         return;
 
     // readback task
+    LBASSERT( !_tasks ); // not repeatable, see Channel::update
     _channel->send( fabric::CMD_CHANNEL_FRAME_READBACK )
             << context << frames;
     _updated = true;
@@ -470,7 +510,11 @@ void ChannelUpdateVisitor::_updateViewStart( const Compound* compound,
     // view start task
     LBLOG( LOG_TASKS ) << "TASK view start " << _channel->getName()
                        << std::endl;
-    _channel->send( fabric::CMD_CHANNEL_FRAME_VIEW_START ) << context;
+    if( !_record( fabric::CMD_CHANNEL_FRAME_VIEW_START, _channel->getID(),
+                  context ))
+    {
+        _channel->send( fabric::CMD_CHANNEL_FRAME_VIEW_START ) << context;
+    }
 }
 
 void ChannelUpdateVisitor::_updateViewFinish( const Compound* compound,
@@ -483,7 +527,11 @@ void ChannelUpdateVisitor::_updateViewFinish( const Compound* compound,
     // view finish task
     LBLOG( LOG_TASKS ) << "TASK view finish " << _channel->getName() <<  " "
                        << std::endl;
-    _channel->send( fabric::CMD_CHANNEL_FRAME_VIEW_FINISH ) << context;
+    if( !_record( fabric::CMD_CHANNEL_FRAME_VIEW_FINISH, _channel->getID(),
+                  context ))
+    {
+        _channel->send( fabric::CMD_CHANNEL_FRAME_VIEW_FINISH ) << context;
+    }
 }
 
 }
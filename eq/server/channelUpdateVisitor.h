@@ -18,6 +18,7 @@
 #ifndef EQSERVER_CHANNELUPDATEVISITOR_H
 #define EQSERVER_CHANNELUPDATEVISITOR_H
 
+#include "channel.h"         // Channel::Tasks
 #include "compoundVisitor.h" // base class
 #include "types.h"
 
@@ -46,6 +47,9 @@ namespace server
 
         void setEye( const fabric::Eye eye ) { _eye = eye; }
 
+        /** Only update deferred or only non-deferred compounds. */
+        void setDeferred( const bool deferred ) { _deferred = deferred; }
+
         /** Visit a non-leaf compound on the down traversal. */
         virtual VisitorResult visitPre( const Compound* compound );
         /** Visit a leaf compound. */
@@ -55,14 +59,23 @@ namespace server
 
         bool isUpdated() const { return _updated; }
 
+        /** Record the tasks into the given list instead of sending them. */
+        void setTasks( Channel::Tasks* tasks ) { _tasks = tasks; }
+
     private:
         Channel*        _channel;
         fabric::Eye     _eye;
         const uint128_t _frameID;
         const uint32_t  _frameNumber;
         bool            _updated;
+        bool            _deferred;
+        Channel::Tasks* _tasks;
 
         bool _skipCompound( const Compound* compound );
+        bool _record( const uint32_t command, const uint128_t& objectID,
+                      const RenderContext& context,
+                      const bool finish = false ) const;
+        bool _record( const uint32_t command, const uint128_t& objectID ) const;
         void _sendClear( const RenderContext& context );
 
         void _updateDraw( const Compound* compound,
@@ -62,6 +62,7 @@ Compound::Compound( Config* parent )
         : _config( parent )
         , _parent( 0 )
         , _usage( 1.0f )
+        , _deferred( false )
         , _taskID( 0 )
         , _frustum( _data.frustumData )
 {
@@ -74,6 +75,7 @@ Compound::Compound( Compound* parent )
         : _config( 0 )
         , _parent( parent )
         , _usage( 1.0f )
+        , _deferred( false )
         , _taskID( 0 )
         , _frustum( _data.frustumData )
 {
@@ -635,6 +637,7 @@ void Compound::computeFrustum( RenderContext& context, const Eye eye ) const
         << std::endl;
     _computePerspective( context, eyeWall );
     _computeOrtho( context, eyeWall );
+    _setupLateLatch( context, eye, eyeWall );
 }
 
 void Compound::computeTileFrustum( Frustumf& frustum, const Eye eye,
@@ -698,6 +701,26 @@ void Compound::_computeOrtho( RenderContext& context, const Vector3f& eye) const
         context.orthoTransform *= _getInverseHeadMatrix();
 }
 
+void Compound::_setupLateLatch( RenderContext& context, const Eye eye,
+                                const Vector3f& eyeWall ) const
+{
+    const Channel* destChannel = getInheritChannel();
+    const View* view = destChannel->getView();
+    const Observer* observer = view ? view->getObserver() : 0;
+    if( !observer || !observer->getLateLatch( ))
+        return;
+
+    // data needed by the render client to redo the frustum computation with a
+    // newer head matrix, see eq::Channel::_lateLatch()
+    const FrustumData& frustumData = getInheritFrustumData();
+    context.latchID = observer->getLatchID();
+    context.headMatrix = observer->getHeadMatrix();
+    context.eyeHead = observer->getEyePosition( eye );
+    context.modelUnit = view->getModelUnit();
+    context.eyeWall = eyeWall;
+    context.wallType = frustumData.getType();
+}
+
 Vector3f Compound::_getEyePosition( const Eye eye ) const
 {
     const FrustumData& frustumData = getInheritFrustumData();
@@ -1204,6 +1227,14 @@ void Compound::update( const uint32_t frameNumber )
         if( barrier->getHeight() > 1 )
             barrier->commit();
     }
+
+    const HierarchicalBarrierMap& hierarchicalBarriers =
+        updateOutputVisitor.getHierarchicalBarriers();
+    for( HierarchicalBarrierMapCIter i = hierarchicalBarriers.begin();
+         i != hierarchicalBarriers.end(); ++i )
+    {
+        i->second->commit();
+    }
 }
 
 void Compound::updateInheritData( const uint32_t frameNumber )
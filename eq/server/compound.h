@@ -231,6 +231,15 @@ public:
         { LBASSERT( usage >= 0.f ); _usage = usage; }
     float getUsage() const                     { return _usage; }
 
+    /**
+     * Issue the tasks of this leaf after all other tasks of its channel.
+     *
+     * Used by the view equalizer to let a channel steal tiles from other
+     * views once it has finished its own work.
+     */
+    void setDeferred( const bool deferred )    { _deferred = deferred; }
+    bool isDeferred() const                    { return _deferred; }
+
     void setTaskID( const uint32_t id )        { _taskID = id; }
     uint32_t getTaskID() const                 { return _taskID; }
     //@}
@@ -513,6 +522,10 @@ public:
     typedef stde::hash_map<std::string, co::Barrier*> BarrierMap;
     typedef BarrierMap::const_iterator BarrierMapCIter;
 
+    typedef stde::hash_map< std::string, HierarchicalBarrierPtr >
+        HierarchicalBarrierMap;
+    typedef HierarchicalBarrierMap::const_iterator HierarchicalBarrierMapCIter;
+
     typedef stde::hash_map<std::string, Frame*> FrameMap;
     typedef FrameMap::const_iterator FrameMapCIter;
 
@@ -535,6 +548,9 @@ private:
     /** Percentage the resource should be used. */
     float _usage;
 
+    /** Tasks are issued after the other tasks of the channel. */
+    bool _deferred;
+
     /** Unique identifier for channel tasks. */
     uint32_t _taskID;
 
@@ -614,6 +630,8 @@ private:
     void _computePerspective( RenderContext& context,
                               const Vector3f& eye ) const;
     void _computeOrtho( RenderContext& context, const Vector3f& eye ) const;
+    void _setupLateLatch( RenderContext& context, const fabric::Eye eye,
+                          const Vector3f& eyeWall ) const;
     Vector3f _getEyePosition( const fabric::Eye eye ) const;
     const Matrix4f& _getInverseHeadMatrix() const;
     void _computeFrustumCorners( Frustumf& frustum,
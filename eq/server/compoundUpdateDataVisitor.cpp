@@ -44,8 +44,11 @@ void CompoundUpdateDataVisitor::_updateDrawFinish( Compound* compound )
 {
     if( compound->testInheritTask( TASK_DRAW ) && compound->isActive( ))
     {
+        // deferred compounds draw after all others, see Channel::update
         Channel* channel = compound->getChannel();
-        channel->setLastDrawCompound( compound );
+        const Compound* last = channel->getLastDrawCompound();
+        if( !last || !last->isDeferred() || compound->isDeferred( ))
+            channel->setLastDrawCompound( compound );
     }
 }
 
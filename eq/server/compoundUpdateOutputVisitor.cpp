@@ -309,6 +309,14 @@ void CompoundUpdateOutputVisitor::_updateSwapBarriers( Compound* compound )
                 window->joinNVSwapBarrier( swapBarrier, _swapBarriers[name] );
         }
     }
+    else if( swapBarrier->isHierarchical( ))
+    {
+        HierarchicalBarrierPtr& barrier =
+            _hierarchicalBarriers[ swapBarrier->getName() ];
+        if( !barrier )
+            barrier = new HierarchicalBarrier;
+        window->joinHierarchicalSwapBarrier( barrier );
+    }
     else
     {
         const std::string& name = swapBarrier->getName();
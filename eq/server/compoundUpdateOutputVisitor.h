@@ -21,6 +21,7 @@
 
 #include "compoundVisitor.h" // base class
 #include "compound.h"        // nested type
+#include "hierarchicalBarrier.h" // member
 
 namespace eq
 {
@@ -41,6 +42,8 @@ namespace server
 
         const Compound::BarrierMap& getSwapBarriers() const
             { return _swapBarriers; }
+        const Compound::HierarchicalBarrierMap& getHierarchicalBarriers() const
+            { return _hierarchicalBarriers; }
         const Compound::FrameMap& getOutputFrames() const
             { return _outputFrames; }
         const Compound::TileQueueMap& getOutputQueues() const
@@ -50,6 +53,7 @@ namespace server
         const uint32_t _frameNumber;
  
         Compound::BarrierMap   _swapBarriers;
+        Compound::HierarchicalBarrierMap _hierarchicalBarriers;
         Compound::FrameMap     _outputFrames;
         Compound::TileQueueMap _outputTileQueues;
 
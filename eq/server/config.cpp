@@ -39,10 +39,12 @@
 #include <eq/fabric/event.h>
 #include <eq/fabric/iAttribute.h>
 #include <eq/fabric/paths.h>
+#include <eq/fabric/statistic.h>
 
 #include <co/objectICommand.h>
 
-#include <lunchbox/sleep.h>
+#include <iomanip>
+#include <sstream>
 
 #include "channelStopFrameVisitor.h"
 #include "configDeregistrator.h"
@@ -67,6 +69,7 @@ Config::Config( ServerPtr parent )
         , _state( STATE_UNUSED )
         , _needsFinish( false )
         , _lastCheck( 0 )
+        , _deadline( 0 )
         , _private( 0 )
 {
     const Global* global = Global::instance();
@@ -553,12 +556,18 @@ bool Config::_updateRunning( const bool canFail )
     LBASSERT( _state == STATE_RUNNING || _state == STATE_INITIALIZING ||
               _state == STATE_EXITING );
 
+    const int64_t startTime = getServer()->getTime();
     if( !_connectNodes() && !canFail )
+    {
+        // finish the initialization already started on the connected nodes
+        ConfigUpdateSyncVisitor syncUpdate;
+        accept( syncUpdate );
         return false;
+    }
 
-    _startNodes();
     _updateCanvases();
     const bool result = _updateNodes( canFail );
+    _printStartupTimeline( startTime );
     _stopNodes();
 
     // Don't use visitor, it would get confused with modified child vectors
@@ -581,50 +590,55 @@ bool Config::_updateRunning( const bool canFail )
 
 bool Config::_connectNodes()
 {
-    bool success = true;
-    lunchbox::Clock clock;
-    const Nodes& nodes = getNodes();
-    for( Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i )
+    Nodes nodes;
+    BOOST_FOREACH( Node* node, getNodes( ))
     {
-        Node* node = *i;
-        if( !node->isActive( ))
-            continue;
-
-        if( !node->connect( ))
-            success = false;
+        if( node->isActive( ))
+            nodes.push_back( node );
     }
 
-    for( Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i )
+    // Each node is connected or launched, synchronized and initialized on its
+    // own thread, overlapping connection timeouts and slow launches with the
+    // initialization of the already connected nodes.
+    const lunchbox::Clock clock;
+    const int nNodes = int( nodes.size( ));
+    int nFailures = 0;
+
+#pragma omp parallel for schedule( dynamic ) reduction( +: nFailures ) \
+    num_threads( std::max( nNodes, 1 )) if( nNodes > 1 )
+    for( int i = 0; i < nNodes; ++i )
     {
-        Node* node = *i;
-        if( node->isActive() && !node->syncLaunch( clock ))
-            success = false;
+        if( !_startNode( nodes[i], clock ))
+            ++nFailures;
     }
 
-    return success;
+    return nFailures == 0;
 }
 
-void Config::_startNodes()
+bool Config::_startNode( Node* node, const lunchbox::Clock& clock )
 {
-    // start up newly running nodes
-    std::vector< lunchbox::Request< void > > requests;
-    const Nodes& nodes = getNodes();
-    requests.reserve( nodes.size( ));
+    const bool stopped = node->isStopped();
+    if( !node->connect() || !node->syncLaunch( clock ))
+        return false;
 
-    BOOST_FOREACH( Node* node, nodes )
+    if( !stopped || node->getState() != STATE_STOPPED )
     {
-        if( node->isActive() && node->isStopped( ))
-        {
-            if( !node->isApplicationNode( ))
-                requests.push_back( _createConfig( node ));
-        }
-        else
-        {
-            LBASSERT( !node->isActive() || node->getState() == STATE_FAILED ||
-                      node->getState() == STATE_RUNNING );
-        }
+        LBASSERT( node->getState() == STATE_FAILED ||
+                  node->getState() == STATE_RUNNING );
+        return true;
     }
-    // Request dtor waits for finish
+
+    // start up newly running node
+    //   app-node already has config from chooseConfig
+    if( !node->isApplicationNode( ))
+    {
+        _createConfig( node ).wait();
+        node->setStartupTime( Node::STARTUP_CONFIG );
+    }
+
+    ConfigUpdateVisitor update( _initID, _currentFrame );
+    node->accept( update );
+    return true;
 }
 
 void Config::_updateCanvases()
@@ -672,7 +686,8 @@ void Config::_stopNodes()
     }
 
     // now wait that the render clients disconnect
-    uint32_t nSleeps = 50; // max 5 seconds for all clients
+    ServerPtr server = getServer();
+    const int64_t timeout = server->getTime() + 5000; // max 5s for all clients
     for( Nodes::const_iterator i = stoppingNodes.begin();
          i != stoppingNodes.end(); ++i )
     {
@@ -680,9 +695,16 @@ void Config::_stopNodes()
         co::NodePtr netNode = node->getNode();
         node->setNode( 0 );
 
-        if( nSleeps )
-            while( netNode->isConnected() && --nSleeps )
-                lunchbox::sleep( 100 ); // ms
+        for( uint32_t changes = server->getConnectionChanges();
+             netNode->isConnected(); changes = server->getConnectionChanges( ))
+        {
+            const int64_t wait = timeout - server->getTime();
+            if( wait <= 0 ||
+                !server->waitConnectionChange( changes, uint32_t( wait )))
+            {
+                break;
+            }
+        }
 
         if( netNode->isConnected( ))
         {
@@ -698,6 +720,34 @@ void Config::_stopNodes()
     }
 }
 
+void Config::_printStartupTimeline( const int64_t startTime ) const
+{
+    std::ostringstream os;
+    BOOST_FOREACH( const Node* node, getNodes( ))
+    {
+        if( node->getStartupTime( Node::STARTUP_INIT ) < startTime )
+            continue;
+
+        os << std::endl << std::setw( 16 ) << node->getName().substr( 0, 16 );
+        for( int i = 0; i < Node::STARTUP_ALL; ++i )
+        {
+            const int64_t time =
+                node->getStartupTime( Node::StartupPhase( i ));
+            if( time < startTime )
+                os << std::setw( 10 ) << "-";
+            else
+                os << std::setw( 10 ) << time - startTime;
+        }
+    }
+
+    if( os.str().empty( ))
+        return;
+
+    LBINFO << "Node startup timeline [ms]" << std::endl
+           << "            node   connect    launch connected    config"
+           << "      init   running" << os.str() << std::endl;
+}
+
 bool Config::_updateNodes( const bool canFail )
 {
     ConfigUpdateVisitor update( _initID, _currentFrame );
@@ -865,22 +915,24 @@ void Config::_startFrame( const uint128_t& frameID )
     LBLOG( LOG_TASKS ) << "----- Start Frame ----- " << _currentFrame
                        << std::endl;
 
+    const int64_t prepareStart = getServer()->getTime();
+    _updateDeadline( prepareStart );
+
+    // The equalizers, frame and barrier commits and sendStatistic() are not
+    // thread-safe: update the compounds on the main thread.
     for( Compounds::const_iterator i = _compounds.begin();
          i != _compounds.end(); ++i )
     {
         Compound* compound = *i;
         compound->update( _currentFrame );
     }
+    _updateFrameNodes( frameID );
 
-    ConfigUpdateDataVisitor configDataVisitor;
-    accept( configDataVisitor );
-
-    const Nodes& nodes = getNodes();
     co::NodePtr appNode = findApplicationNetNode();
+    const Nodes& nodes = getNodes();
     for( Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i )
     {
-        Node* node = *i;
-        node->update( frameID, _currentFrame );
+        const Node* node = *i;
         if( node->isRunning() && node->isApplicationNode( ))
             appNode = 0; // release sent (see below)
     }
@@ -889,10 +941,77 @@ void Config::_startFrame( const uint128_t& frameID )
         send( appNode,
               fabric::CMD_CONFIG_RELEASE_FRAME_LOCAL ) << _currentFrame;
 
+    sendStatistic( Statistic::CONFIG_PREPARE_FRAME, prepareStart );
+
     // Fix 2976899: Config::finishFrame deadlocks when no nodes are active
     notifyNodeFrameFinished( _currentFrame );
 }
 
+void Config::_updateDeadline( const int64_t startTime )
+{
+    const float period = getFAttribute( FATTR_DEADLINE );
+    if( period <= 0.f )
+    {
+        _deadline = 0;
+        return;
+    }
+
+    // The frame is presented after the frames in flight, one period each.
+    const float budget = period * float( getLatency() + 1 );
+    _deadline = startTime + int64_t( budget + .5f );
+    LBLOG( LOG_TASKS ) << "Frame " << _currentFrame << " deadline "
+                       << _deadline << std::endl;
+}
+
+void Config::_updateFrameNodes( const uint128_t& frameID )
+{
+    // Each node serializes its tasks into its own buffered connection, and the
+    // ConfigUpdateDataVisitor only touches the entities of one node. Node
+    // updates only read the compounds, and must not register or commit
+    // objects nor send statistics.
+    const Nodes& nodes = getNodes();
+    const int nNodes = int( nodes.size( ));
+    const uint32_t frameNumber = _currentFrame;
+
+#pragma omp parallel for schedule( dynamic ) if( nNodes > 1 )
+    for( int i = 0; i < nNodes; ++i )
+    {
+        Node* node = nodes[i];
+        ConfigUpdateDataVisitor configDataVisitor;
+        node->accept( configDataVisitor );
+        node->update( frameID, frameNumber );
+    }
+}
+
+void Config::sendStatistic( const Statistic::Type type,
+                            const int64_t startTime, const float ratio,
+                            const std::string& resourceName )
+{
+    co::NodePtr appNode = findApplicationNetNode();
+    if( !appNode )
+        return;
+
+    Statistic statistic;
+    statistic.type = type;
+    statistic.frameNumber = _currentFrame;
+    statistic.task = 0;
+    statistic.plugins[0] = 0;
+    statistic.plugins[1] = 0;
+    statistic.frameData = 0;
+    statistic.startTime = startTime;
+    statistic.endTime = LB_MAX( getServer()->getTime(), startTime + 1 );
+    statistic.idleTime = 0;
+    statistic.totalTime = 0;
+    statistic.ratio = ratio;
+    statistic.currentFPS = 0.f;
+    statistic.averageFPS = 0.f;
+    statistic.bytes = 0;
+    snprintf( statistic.resourceName, 32, "%s", resourceName.c_str( ));
+
+    send( appNode, fabric::CMD_CONFIG_EVENT ) << Event::STATISTIC
+                                              << getSerial() << statistic;
+}
+
 void Config::_verifyFrameFinished( const uint32_t frameNumber )
 {
     const Nodes& nodes = getNodes();
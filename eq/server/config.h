@@ -168,6 +168,16 @@ public:
 
     EventOCommand sendError( const uint32_t type, const Error& error );
 
+    /**
+     * Send a server-side statistic for the current frame to the application.
+     *
+     * The statistic ends now and starts at the given time. Not thread-safe,
+     * call only from the main thread, e.g., during the compound update.
+     */
+    void sendStatistic( const Statistic::Type type, const int64_t startTime,
+                        const float ratio = 1.f,
+                        const std::string& resourceName = "server" );
+
     /** Return the initID, used for late initialization  */
     uint128_t getInitID(){ return _initID; }
 
@@ -183,6 +193,13 @@ public:
     /** @internal @return the last finished frame */
     uint32_t getFinishedFrame() const { return _finishedFrame.get(); }
 
+    /**
+     * @internal
+     * @return the target present time of the current frame, or 0 if the
+     *         config has no deadline.
+     */
+    int64_t getFrameDeadline() const { return _deadline; }
+
     /** @internal */
     virtual VisitorResult _acceptCompounds( ConfigVisitor& visitor );
     /** @internal */
@@ -232,6 +249,9 @@ private:
 
     int64_t _lastCheck;
 
+    /** The target present time of the current frame, or 0. */
+    int64_t _deadline;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -244,11 +264,10 @@ private:
 
     void _updateCanvases();
     bool _connectNodes();
-    bool _connectNode( Node* node );
-    bool _syncConnectNode( Node* node, const lunchbox::Clock& clock );
-    void _startNodes();
+    bool _startNode( Node* node, const lunchbox::Clock& clock );
     lunchbox::Request< void > _createConfig( Node* node );
     bool _updateNodes( const bool canFail );
+    void _printStartupTimeline( const int64_t startTime ) const;
     void _stopNodes();
     template< class T >
     void _deleteEntities( const std::vector< T* >& entities );
@@ -257,6 +276,8 @@ private:
     bool _init( const uint128_t& initID );
 
     void _startFrame( const uint128_t& frameID );
+    void _updateDeadline( const int64_t startTime );
+    void _updateFrameNodes( const uint128_t& frameID );
     void _flushAllFrames();
     //@}
 
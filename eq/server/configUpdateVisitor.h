@@ -79,6 +79,9 @@ private:
                     }
                     return TRAVERSE_PRUNE;
 
+                case STATE_INITIALIZING: // already started during connect
+                case STATE_INIT_FAILED:
+                case STATE_INIT_SUCCESS:
                 case STATE_RUNNING:
                     return TRAVERSE_CONTINUE;
                 case STATE_FAILED:
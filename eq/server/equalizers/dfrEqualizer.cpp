@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -26,14 +27,25 @@
 #include <eq/fabric/zoom.h>
 #include <lunchbox/debug.h>
 
+#include <limits>
+
 namespace eq
 {
 namespace server
 {
+namespace
+{
+static const size_t _nPixels = 32; // frames awaiting their load data
+static const size_t _minSamples = 4; // frames needed for a prediction
+static const float _tolerance = .05f; // converged relative error
+}
 
 DFREqualizer::DFREqualizer()
         : _current ( getFrameRate( ))
         , _lastTime( 0 )
+        , _predictive( false )
+        , _percentile( 0.f )
+        , _initialError( 0.f )
 {
     LBINFO << "New DFREqualizer @" << (void*)this << std::endl;
 }
@@ -69,7 +81,16 @@ void DFREqualizer::attach( Compound* compound )
     }
 }
 
-void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
+void DFREqualizer::setPercentile( const float percentile )
+{
+    LBASSERT( percentile >= 0.f && percentile < 100.f );
+    _percentile = LB_MIN( LB_MAX( percentile, 0.f ), 99.f );
+    if( _percentile > 0.f )
+        _predictive = true;
+}
+
+void DFREqualizer::notifyUpdatePre( Compound* compound,
+                                    const uint32_t frameNumber )
 {
     LBASSERT( compound == getCompound( ));
 
@@ -82,17 +103,28 @@ void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
     LBASSERT( getDamping() >= 0.f );
     LBASSERT( getDamping() <= 1.f );
 
-    const float factor = ( sqrtf( _current / getFrameRate( )) - 1.f ) *
-                         getDamping() + 1.f;
+    const Compound*      parent = compound->getParent();
+    const PixelViewport& pvp    = parent->getInheritPixelViewport();
 
     Zoom newZoom( compound->getZoom( ));
-    newZoom *= factor;
+    if( _predictive && _model.getSize() >= _minSamples )
+    {
+        const float area = static_cast< float >( pvp.getArea( ));
+        const float pixels = _model.predictPixels( 1000.f / getFrameRate(),
+                                                   _percentile );
+        const float zoom = sqrtf( pixels / area );
+        newZoom.x() += ( zoom - newZoom.x( )) * getDamping();
+    }
+    else
+    {
+        const float factor = ( sqrtf( _current / getFrameRate( )) - 1.f ) *
+                             getDamping() + 1.f;
+        newZoom *= factor;
+    }
 
-    //LBINFO << _current << ": " << factor << " = " << newZoom << std::endl;
+    //LBINFO << _current << ": " << newZoom << std::endl;
 
     // clip zoom factor to min( 128px ), max( channel pvp )
-    const Compound*      parent = compound->getParent();
-    const PixelViewport& pvp    = parent->getInheritPixelViewport();
 
     const Channel*       channel    = compound->getChannel();
     const PixelViewport& channelPVP = channel->getPixelViewport();
@@ -109,6 +141,10 @@ void DFREqualizer::notifyUpdatePre( Compound* compound, const uint32_t/*frame*/)
     newZoom.y() = newZoom.x();
 
     compound->setZoom( newZoom );
+    if( _pixels.size() > _nPixels ) // no load data for old frames
+        _pixels.erase( _pixels.begin( ));
+    _pixels[ frameNumber ] = static_cast< float >( pvp.getArea( )) *
+                             newZoom.x() * newZoom.y();
 }
 
 void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
@@ -116,6 +152,7 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
                                    const Viewport& /*region*/ )
 {
     // gather and notify load data
+    int64_t startTime = std::numeric_limits< int64_t >::max();
     int64_t endTime = 0;
     for( size_t i = 0; i < statistics.size(); ++i )
     {
@@ -126,6 +163,7 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
             case Statistic::CHANNEL_DRAW:
             case Statistic::CHANNEL_ASSEMBLE:
             case Statistic::CHANNEL_READBACK:
+                startTime = LB_MIN( startTime, data.startTime );
                 endTime = LB_MAX( endTime, data.endTime );
                 break;
 
@@ -137,6 +175,15 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
     if( endTime == 0 )
         return;
 
+    // sample the rendered pixels and time of the frame for the model
+    std::map< uint32_t, float >::iterator i = _pixels.find( frameNumber );
+    if( i != _pixels.end( ))
+    {
+        _model.add( i->second, float( LB_MAX( endTime - startTime, 1 )));
+        _pixels.erase( _pixels.begin(), ++i );
+        _updateMetrics();
+    }
+
     const int64_t time = endTime - _lastTime;
     _lastTime = endTime;
 
@@ -148,6 +195,39 @@ void DFREqualizer::notifyLoadData( Channel* channel, const uint32_t frameNumber,
                      << channel->getName() << " time " << time << std::endl;
 }
 
+void DFREqualizer::_updateMetrics()
+{
+    const float target = 1000.f / getFrameRate();
+    const float error = _model.getTime( _percentile ) / target - 1.f;
+    _metrics.error = error;
+
+    if( _metrics.converged )
+    {
+        if( fabsf( error ) <= _tolerance )
+            return;
+
+        // disturbance, e.g., a scene change: measure a new convergence
+        _metrics.converged = false;
+        _metrics.settleFrames = 0;
+    }
+
+    if( _metrics.settleFrames == 0 )
+    {
+        _initialError = error;
+        _metrics.overshoot = 0.f;
+    }
+
+    ++_metrics.settleFrames;
+    if( error * _initialError < 0.f ) // crossed the target
+        _metrics.overshoot = LB_MAX( _metrics.overshoot, fabsf( error ));
+    _metrics.converged = fabsf( error ) <= _tolerance;
+
+    LBLOG( LOG_LB1 ) << "Frame time error " << error << ", "
+                     << ( _metrics.converged ? "converged after " : "for " )
+                     << _metrics.settleFrames << " frames, overshoot "
+                     << _metrics.overshoot << std::endl;
+}
+
 std::ostream& operator << ( std::ostream& os, const DFREqualizer* lb )
 {
     if( !lb )
@@ -160,6 +240,10 @@ std::ostream& operator << ( std::ostream& os, const DFREqualizer* lb )
 
     if( lb->getDamping() != 0.5f )
         os << "    damping " << lb->getDamping() << std::endl;
+    if( lb->getPercentile() > 0.f )
+        os << "    percentile " << lb->getPercentile() << std::endl;
+    else if( lb->isPredictive( ))
+        os << "    predictive ON" << std::endl;
 
     os << '}' << std::endl << lunchbox::enableFlush;
     return os;
@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -20,6 +21,7 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"       // base class
+#include "frameTimeModel.h"  // member
 
 #include <deque>
 #include <map>
@@ -30,10 +32,33 @@ namespace server
 {
     std::ostream& operator << ( std::ostream& os, const DFREqualizer* );
 
-    /** Tries to maintain a constant frame rate by adapting the compound zoom.*/
+    /**
+     * Tries to maintain a constant frame rate by adapting the compound zoom.
+     *
+     * By default, the zoom is corrected by the square root of the ratio of
+     * the last frame rate to the target frame rate. The predictive controller
+     * instead fits the channel's frame time as a linear function of the
+     * rendered pixels over the recent frames, and sets the zoom predicted to
+     * render at the target frame rate. It keeps either the last frame time or
+     * the given percentile of the frame times at the target.
+     */
     class DFREqualizer : public Equalizer, protected ChannelListener
     {
     public:
+        /** Convergence of the frame time towards the target. */
+        struct Metrics
+        {
+            Metrics() : error( 0.f ), overshoot( 0.f ), settleFrames( 0 )
+                      , converged( false ) {}
+
+            float error; //!< relative error of the frame time to the target
+            /** Largest relative error after crossing the target. */
+            float overshoot;
+            /** Frames needed to converge, or since the last disturbance. */
+            uint32_t settleFrames;
+            bool converged; //!< the error is within the tolerance
+        };
+
         DFREqualizer();
         virtual ~DFREqualizer();
         virtual void toStream( std::ostream& os ) const { os << this; }
@@ -53,6 +78,25 @@ namespace server
 
         virtual uint32_t getType() const { return fabric::DFR_EQUALIZER; }
 
+        /** Enable the predictive controller. */
+        void setPredictive( const bool onOff ) { _predictive = onOff; }
+
+        /** @return true if the predictive controller is used. */
+        bool isPredictive() const { return _predictive; }
+
+        /**
+         * Set the percentile [0..100) of the frame times to keep at the target
+         * frame rate, or 0 to use the last frame time. Implies predictive.
+         * Values outside of the range are clamped.
+         */
+        void setPercentile( const float percentile );
+
+        /** @return the targeted percentile of the frame times. */
+        float getPercentile() const { return _percentile; }
+
+        /** @return the convergence of the frame time towards the target. */
+        const Metrics& getMetrics() const { return _metrics; }
+
     protected:
         void notifyChildAdded( Compound*, Compound* ) override {}
         void notifyChildRemove( Compound*, Compound* ) override {}
@@ -60,6 +104,17 @@ namespace server
     private:
         float _current; //!< Framerate of the last finished frame
         int64_t _lastTime; //!< Last frames' timestamp
+
+        bool _predictive;
+        float _percentile;
+
+        FrameTimeModel _model; //!< frame time over rendered pixels
+        std::map< uint32_t, float > _pixels; //!< rendered pixels per frame
+
+        Metrics _metrics;
+        float _initialError; //!< error at the last disturbance
+
+        void _updateMetrics();
     };
 
 }
@@ -0,0 +1,192 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "dplexEqualizer.h"
+
+#include "../compound.h"
+#include "../config.h"
+#include "../log.h"
+#include "../server.h"
+
+#include <eq/fabric/statistic.h>
+#include <lunchbox/debug.h>
+
+#include <limits>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+static const float _slowdown = 1.05f; // throttle below the combined rate
+static const float _vsyncCap = 60.f; // don't throttle above this rate
+}
+
+DPlexEqualizer::DPlexEqualizer()
+{
+    LBINFO << "New DPlexEqualizer @" << (void*)this << std::endl;
+}
+
+DPlexEqualizer::DPlexEqualizer( const DPlexEqualizer& from )
+        : Equalizer( from )
+{}
+
+DPlexEqualizer::~DPlexEqualizer()
+{
+    attach( 0 );
+}
+
+void DPlexEqualizer::attach( Compound* compound )
+{
+    _exit();
+    Equalizer::attach( compound );
+}
+
+void DPlexEqualizer::_init()
+{
+    Compound* compound = getCompound();
+    if( !_children.empty() || !compound )
+        return;
+
+    // Subscribe to the source channels and the destination channel
+    Channel* destination = compound->getChannel();
+    LBASSERT( destination );
+    destination->addListener( this );
+
+    const Compounds& children = compound->getChildren();
+    for( CompoundsCIter i = children.begin(); i != children.end(); ++i )
+    {
+        Compound* child = *i;
+        const Child entry = { child, child->getPeriod(), child->getPhase() };
+        _children.push_back( entry );
+
+        Channel* channel = child->getChannel();
+        if( channel != destination )
+            channel->addListener( this );
+    }
+    _model.reset( _children.size( ));
+}
+
+void DPlexEqualizer::_exit()
+{
+    Compound* compound = getCompound();
+    if( !compound || _children.empty( ))
+        return;
+
+    Channel* destination = compound->getChannel();
+    destination->removeListener( this );
+
+    // Restore the configured time-multiplex
+    for( ChildrenCIter i = _children.begin(); i != _children.end(); ++i )
+    {
+        const Child& child = *i;
+        child.compound->setPeriod( child.period );
+        child.compound->setPhase( child.phase );
+
+        Channel* channel = child.compound->getChannel();
+        if( channel != destination )
+            channel->removeListener( this );
+    }
+
+    _children.clear();
+    _model.reset( 0 );
+}
+
+void DPlexEqualizer::notifyUpdatePre( Compound* compound,
+                                      const uint32_t frameNumber )
+{
+    _init();
+    if( _children.empty( ))
+        return;
+
+    Config* config = compound->getConfig();
+    const int64_t now = config->getServer()->getTime();
+
+    size_t source = 0;
+    if( isFrozen() || !compound->isActive() || !isActive( ))
+    {
+        source = frameNumber % _children.size();
+        compound->setMaxFPS( std::numeric_limits< float >::max( ));
+    }
+    else
+    {
+        source = _model.select( frameNumber, now );
+        const float interval = _model.getFrameInterval();
+        const float fps = interval > 0.f ?
+                              1000.f / ( interval * _slowdown ) :
+                              std::numeric_limits< float >::max();
+        compound->setMaxFPS( fps > _vsyncCap ?
+                             std::numeric_limits< float >::max() : fps );
+    }
+    _activate( source, frameNumber );
+    _model.assign( source, frameNumber, now );
+
+    const float measured = _model.getMeasuredInterval();
+    if( measured > 0.f )
+        config->sendStatistic( Statistic::CONFIG_DPLEX_JITTER,
+                               now - int64_t( measured ),
+                               _model.getJitter() / measured );
+
+    LBLOG( LOG_LB2 ) << "Frame " << frameNumber << " source " << source
+                     << " interval " << _model.getFrameInterval()
+                     << "ms jitter " << _model.getJitter() << "ms" << std::endl;
+}
+
+void DPlexEqualizer::_activate( const size_t source,
+                                const uint32_t frameNumber )
+{
+    // give each source a distinct phase, the selected one the current phase
+    const uint32_t period = uint32_t( _children.size( ));
+    const uint32_t phase = frameNumber % period;
+
+    for( size_t i = 0; i < _children.size(); ++i )
+    {
+        Compound* child = _children[i].compound;
+        child->setPeriod( period );
+        child->setPhase( uint32_t( phase + period + i - source ) % period );
+    }
+}
+
+void DPlexEqualizer::notifyLoadData( Channel* channel,
+                                     const uint32_t frameNumber,
+                                     const Statistics& statistics,
+                                     const Viewport& /*region*/ )
+{
+    const Compound* compound = getCompound();
+    if( channel == compound->getChannel( ))
+        _model.updateDelivery( frameNumber, compound->getTaskID(),
+                               statistics );
+
+    for( size_t i = 0; i < _children.size(); ++i )
+    {
+        const Compound* child = _children[i].compound;
+        if( child->getChannel() == channel )
+            _model.updateSource( i, frameNumber, child->getTaskID(),
+                                 statistics );
+    }
+}
+
+std::ostream& operator << ( std::ostream& os, const DPlexEqualizer* lb )
+{
+    if( lb )
+        os << "dplex_equalizer {}" << std::endl;
+    return os;
+}
+
+}
+}
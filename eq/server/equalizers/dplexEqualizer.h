@@ -0,0 +1,104 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_DPLEXEQUALIZER_H
+#define EQS_DPLEXEQUALIZER_H
+
+#include "../channelListener.h" // base class
+#include "dplexModel.h"         // member
+#include "equalizer.h"          // base class
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+    std::ostream& operator << ( std::ostream& os, const DPlexEqualizer* );
+
+    /**
+     * Assigns the frames of a time-multiplex (DPlex) compound to its children.
+     *
+     * Each child is a source rendering complete frames on its channel. For
+     * each frame, the period and phase of the children are set to activate
+     * the source predicted to finish closest before the next evenly spaced
+     * delivery time, or the earliest source if none is in time. The
+     * destination is throttled to the combined frame rate of all sources,
+     * and the jitter of the delivered frames is reported to the application
+     * as a CONFIG_DPLEX_JITTER statistic.
+     *
+     * Replaces the framerate_equalizer and the static period and phase
+     * settings of the children, which are restored when detached.
+     */
+    class DPlexEqualizer : public Equalizer, protected ChannelListener
+    {
+    public:
+        EQSERVER_API DPlexEqualizer();
+        DPlexEqualizer( const DPlexEqualizer& from );
+        virtual ~DPlexEqualizer();
+        virtual void toStream( std::ostream& os ) const { os << this; }
+
+        /** @sa Equalizer::attach */
+        virtual void attach( Compound* compound );
+
+        /** @sa CompoundListener::notifyUpdatePre */
+        virtual void notifyUpdatePre( Compound* compound,
+                                      const uint32_t frameNumber );
+
+        /** @sa ChannelListener::notifyLoadData */
+        virtual void notifyLoadData( Channel* channel,
+                                     const uint32_t frameNumber,
+                                     const Statistics& statistics,
+                                     const Viewport& region );
+
+        virtual uint32_t getType() const { return fabric::DPLEX_EQUALIZER; }
+
+        /** @return the targeted time between two output frames in ms. */
+        float getFrameInterval() const { return _model.getFrameInterval(); }
+
+        /** @return the deviation of the recent output frame intervals in ms.*/
+        float getJitter() const { return _model.getJitter(); }
+
+    protected:
+        void notifyChildAdded( Compound*, Compound* ) override
+            { LBASSERT( _children.empty( )); }
+        void notifyChildRemove( Compound*, Compound* ) override
+            { LBASSERT( _children.empty( )); }
+
+    private:
+        struct Child
+        {
+            Compound* compound;
+            uint32_t period; //!< configured period
+            uint32_t phase; //!< configured phase
+        };
+        typedef std::vector< Child > Children;
+        typedef Children::const_iterator ChildrenCIter;
+        Children _children; //!< the sources, in the order of the model
+
+        DPlexModel _model;
+
+        void _init();
+        void _exit();
+
+        /** Activate the given source for the given frame. */
+        void _activate( const size_t source, const uint32_t frameNumber );
+    };
+}
+}
+
+#endif // EQS_DPLEXEQUALIZER_H
@@ -0,0 +1,230 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "dplexModel.h"
+
+#include "../log.h"
+
+#include <eq/fabric/statistic.h>
+#include <lunchbox/debug.h>
+
+#include <cmath>
+#include <limits>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+static const size_t _nAssignments = 64; // frames tracked for load data
+static const size_t _nDeliveries = 32; // frames used for the jitter
+}
+
+DPlexModel::DPlexModel()
+        : _delivery( 0 )
+        , _interval( 0.f )
+        , _measured( 0.f )
+        , _jitter( 0.f )
+{}
+
+void DPlexModel::reset( const size_t nSources )
+{
+    _sources.clear();
+    _sources.resize( nSources );
+    _assignments.clear();
+    _deliveries.clear();
+    _delivery = 0;
+    _interval = 0.f;
+    _measured = 0.f;
+    _jitter = 0.f;
+}
+
+size_t DPlexModel::select( const uint32_t frameNumber, const int64_t now )
+{
+    LBASSERT( !_sources.empty( ));
+
+    // use the static time-multiplex until all sources have been measured
+    float rate = 0.f;
+    for( SourcesCIter i = _sources.begin(); i != _sources.end(); ++i )
+    {
+        if( i->time <= 0.f )
+            return frameNumber % _sources.size();
+        rate += 1.f / i->time;
+    }
+    _interval = 1.f / rate;
+
+    // Take the source finishing closest before the next delivery time, which
+    // keeps faster sources available for the following frames. If none is in
+    // time, take the one finishing first.
+    const int64_t target = _delivery + int64_t( _interval );
+    const size_t nSources = _sources.size();
+    size_t best = nSources;
+    int64_t bestEnd = 0;
+    size_t first = 0;
+    int64_t firstEnd = std::numeric_limits< int64_t >::max();
+
+    for( size_t i = 0; i < nSources; ++i )
+    {
+        const Source& source = _sources[i];
+        const int64_t end = LB_MAX( now, source.ready ) +
+                            int64_t( source.time );
+        if( end <= target && ( best == nSources || end > bestEnd ))
+        {
+            best = i;
+            bestEnd = end;
+        }
+        if( end < firstEnd )
+        {
+            first = i;
+            firstEnd = end;
+        }
+    }
+
+    if( best == nSources )
+    {
+        _delivery = firstEnd;
+        return first;
+    }
+    _delivery = target;
+    return best;
+}
+
+void DPlexModel::assign( const size_t index, const uint32_t frameNumber,
+                         const int64_t now )
+{
+    LBASSERT( index < _sources.size( ));
+    Source& source = _sources[ index ];
+    source.ready = LB_MAX( now, source.ready ) + int64_t( source.time );
+
+    const Assignment assignment = { frameNumber, index, false };
+    _assignments.push_back( assignment );
+    if( _assignments.size() > _nAssignments )
+        _assignments.pop_front();
+}
+
+void DPlexModel::updateSource( const size_t index, const uint32_t frameNumber,
+                               const uint32_t taskID,
+                               const Statistics& statistics )
+{
+    LBASSERT( index < _sources.size( ));
+    Source& source = _sources[ index ];
+    int64_t startTime = std::numeric_limits< int64_t >::max();
+    int64_t endTime = 0;
+
+    for( size_t i = 0; i < statistics.size(); ++i )
+    {
+        const Statistic& stat = statistics[ i ];
+        if( stat.task != taskID ) // from different compound
+            continue;
+
+        switch( stat.type )
+        {
+        case Statistic::CHANNEL_CLEAR:
+        case Statistic::CHANNEL_DRAW:
+        case Statistic::CHANNEL_READBACK:
+        case Statistic::CHANNEL_ASYNC_READBACK:
+        case Statistic::CHANNEL_FRAME_TRANSMIT:
+            startTime = LB_MIN( startTime, stat.startTime );
+            endTime = LB_MAX( endTime, stat.endTime );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if( startTime == std::numeric_limits< int64_t >::max( ))
+        return;
+
+    size_t nPending = 0;
+    bool found = false;
+    for( std::deque< Assignment >::iterator i = _assignments.begin();
+         i != _assignments.end(); ++i )
+    {
+        Assignment& assignment = *i;
+        if( assignment.source != index || assignment.done )
+            continue;
+        if( assignment.frame == frameNumber )
+        {
+            assignment.done = true;
+            found = true;
+        }
+        else if( assignment.frame > frameNumber )
+            ++nPending;
+    }
+    if( !found )
+        return;
+
+    const float time = float( LB_MAX( endTime - startTime, 1 ));
+    source.time = source.time > 0.f ? .5f * ( source.time + time ) : time;
+
+    // correct the prediction with the measured end of this frame
+    source.ready = endTime + int64_t( source.time * float( nPending ));
+
+    LBLOG( LOG_LB2 ) << "Frame " << frameNumber << " source " << index
+                     << " time " << time << "ms, " << nPending << " pending"
+                     << std::endl;
+}
+
+void DPlexModel::updateDelivery( const uint32_t frameNumber,
+                                 const uint32_t taskID,
+                                 const Statistics& statistics )
+{
+    int64_t endTime = 0;
+
+    for( size_t i = 0; i < statistics.size(); ++i )
+    {
+        const Statistic& stat = statistics[ i ];
+        if( stat.task == taskID && stat.type == Statistic::CHANNEL_ASSEMBLE )
+            endTime = LB_MAX( endTime, stat.endTime );
+    }
+
+    if( endTime == 0 )
+        return;
+
+    _deliveries[ frameNumber ] = endTime;
+    if( _deliveries.size() > _nDeliveries )
+        _deliveries.erase( _deliveries.begin( ));
+    _updateJitter();
+}
+
+void DPlexModel::_updateJitter()
+{
+    std::vector< float > intervals;
+    std::map< uint32_t, int64_t >::const_iterator i = _deliveries.begin();
+    std::map< uint32_t, int64_t >::const_iterator previous = i;
+    for( ++i; i != _deliveries.end(); previous = i, ++i )
+        if( i->first == previous->first + 1 ) // consecutive frames only
+            intervals.push_back( float( i->second - previous->second ));
+
+    if( intervals.size() < 2 )
+        return;
+
+    float sum = 0.f;
+    for( size_t j = 0; j < intervals.size(); ++j )
+        sum += intervals[j];
+    _measured = sum / float( intervals.size( ));
+
+    float variance = 0.f;
+    for( size_t j = 0; j < intervals.size(); ++j )
+        variance += ( intervals[j] - _measured ) * ( intervals[j] - _measured );
+    _jitter = std::sqrt( variance / float( intervals.size( )));
+}
+
+}
+}
@@ -0,0 +1,116 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_DPLEXMODEL_H
+#define EQSERVER_DPLEXMODEL_H
+
+#include "../api.h"
+#include "../types.h"
+
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+    /**
+     * Schedules the frames of a time-multiplex over its sources.
+     *
+     * Predicts when each source finishes its assigned frames from the
+     * measured frame time of the source, and selects the source finishing
+     * closest before the next evenly spaced delivery time. Measures the
+     * jitter of the frames assembled on the destination.
+     */
+    class DPlexModel
+    {
+    public:
+        EQSERVER_API DPlexModel();
+
+        /** Reset the model for the given number of sources. */
+        EQSERVER_API void reset( const size_t nSources );
+
+        /** @return the number of sources. */
+        size_t getNumSources() const { return _sources.size(); }
+
+        /**
+         * @return the source to render the given frame, started at the given
+         *         time. Until all sources are measured, the static
+         *         time-multiplex is used.
+         */
+        EQSERVER_API size_t select( const uint32_t frameNumber,
+                                    const int64_t now );
+
+        /** Assign the given frame, started at the given time, to a source. */
+        EQSERVER_API void assign( const size_t source,
+                                  const uint32_t frameNumber,
+                                  const int64_t now );
+
+        /** Update a source from the load data of one of its frames. */
+        EQSERVER_API void updateSource( const size_t source,
+                                        const uint32_t frameNumber,
+                                        const uint32_t taskID,
+                                        const Statistics& statistics );
+
+        /** Update the jitter from the load data of the destination. */
+        EQSERVER_API void updateDelivery( const uint32_t frameNumber,
+                                          const uint32_t taskID,
+                                          const Statistics& statistics );
+
+        /** @return the targeted time between two output frames in ms. */
+        float getFrameInterval() const { return _interval; }
+
+        /** @return the mean measured output frame interval in ms. */
+        float getMeasuredInterval() const { return _measured; }
+
+        /** @return the deviation of the recent output frame intervals in ms.*/
+        float getJitter() const { return _jitter; }
+
+    private:
+        struct Source
+        {
+            Source() : time( 0.f ), ready( 0 ) {}
+            float time; //!< smoothed frame time in ms, 0 if unknown
+            int64_t ready; //!< predicted end of the last assigned frame
+        };
+        typedef std::vector< Source > Sources;
+        typedef Sources::const_iterator SourcesCIter;
+        Sources _sources;
+
+        struct Assignment
+        {
+            uint32_t frame;
+            size_t source;
+            bool done; //!< load data received
+        };
+        std::deque< Assignment > _assignments; //!< youngest last
+
+        /** Assembly end time on the destination channel per frame. */
+        std::map< uint32_t, int64_t > _deliveries;
+
+        int64_t _delivery; //!< predicted delivery of the last assigned frame
+        float _interval; //!< targeted output frame interval
+        float _measured; //!< mean measured output frame interval
+        float _jitter; //!< standard deviation of the measured intervals
+
+        void _updateJitter();
+    };
+}
+}
+
+#endif // EQSERVER_DPLEXMODEL_H
@@ -0,0 +1,128 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "frameTimeModel.h"
+
+#include "../log.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+static const size_t _nSamples = 32; // frames used to fit the model
+
+/** @return the given percentile [0..100) of the values. */
+float _getPercentile( std::vector< float >& values, const float percentile )
+{
+    LBASSERT( !values.empty( ));
+    size_t index = size_t( LB_MAX( percentile, 0.f ) * .01f *
+                           float( values.size( )));
+    index = LB_MIN( index, values.size() - 1 );
+    std::nth_element( values.begin(), values.begin() + index, values.end( ));
+    return values[ index ];
+}
+}
+
+FrameTimeModel::FrameTimeModel()
+{}
+
+void FrameTimeModel::add( const float pixels, const float time )
+{
+    const Sample sample = { pixels, time };
+    _samples.push_back( sample );
+    if( _samples.size() > _nSamples )
+        _samples.pop_front();
+}
+
+float FrameTimeModel::getTime( const float percentile ) const
+{
+    LBASSERT( !_samples.empty( ));
+    if( percentile <= 0.f )
+        return _samples.back().time;
+
+    std::vector< float > times;
+    times.reserve( _samples.size( ));
+    for( std::deque< Sample >::const_iterator i = _samples.begin();
+         i != _samples.end(); ++i )
+    {
+        times.push_back( i->time );
+    }
+    return _getPercentile( times, percentile );
+}
+
+float FrameTimeModel::predictPixels( const float time,
+                                     const float percentile ) const
+{
+    LBASSERT( !_samples.empty( ));
+
+    // least-squares fit of time = a + b * pixels
+    double sumX = 0., sumY = 0., sumXX = 0., sumXY = 0.;
+    for( std::deque< Sample >::const_iterator i = _samples.begin();
+         i != _samples.end(); ++i )
+    {
+        sumX += i->pixels;
+        sumY += i->time;
+        sumXX += double( i->pixels ) * double( i->pixels );
+        sumXY += double( i->pixels ) * double( i->time );
+    }
+
+    const double n = double( _samples.size( ));
+    const double det = n * sumXX - sumX * sumX;
+    double a = 0.;
+    double b = 0.;
+    if( det > 1e-6 * n * sumXX )
+    {
+        b = ( n * sumXY - sumX * sumY ) / det;
+        a = ( sumY - b * sumX ) / n;
+    }
+    if( b <= 0. ) // constant zoom or noise: time proportional to pixels
+    {
+        b = sumY / LB_MAX( sumX, 1. );
+        a = 0.;
+    }
+
+    // The model predicts the mean time. Correct it by the ratio of the
+    // measured to the modelled time of the last frame or the percentile.
+    std::vector< float > ratios;
+    ratios.reserve( _samples.size( ));
+    for( std::deque< Sample >::const_iterator i = _samples.begin();
+         i != _samples.end(); ++i )
+    {
+        const double model = LB_MAX( a + b * i->pixels, 1e-3 );
+        ratios.push_back( float( i->time / model ));
+    }
+
+    float ratio = ratios.back();
+    if( percentile > 0.f )
+        ratio = _getPercentile( ratios, percentile );
+
+    const double target = time / LB_MAX( ratio, .01f );
+    const float pixels = float(( target - a ) / b );
+    LBLOG( LOG_LB2 ) << "time = " << a << " + " << b << " * pixels, ratio "
+                     << ratio << ": " << pixels << " pixels" << std::endl;
+    return LB_MAX( pixels, 1.f );
+}
+
+}
+}
@@ -0,0 +1,73 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_FRAMETIMEMODEL_H
+#define EQSERVER_FRAMETIMEMODEL_H
+
+#include "../api.h"
+#include "../types.h"
+
+#include <deque>
+
+namespace eq
+{
+namespace server
+{
+    /**
+     * Predicts the frame time of a channel from the rendered pixels.
+     *
+     * The time is fitted as a linear function of the pixels over the recent
+     * frames. The model predicts the mean time, which is corrected by the
+     * ratio of the measured to the modelled time of the last frame or of the
+     * given percentile of the frames.
+     */
+    class FrameTimeModel
+    {
+    public:
+        EQSERVER_API FrameTimeModel();
+
+        /** Add the rendered pixels and the time in ms of one frame. */
+        EQSERVER_API void add( const float pixels, const float time );
+
+        /** @return the number of frames used by the model. */
+        size_t getSize() const { return _samples.size(); }
+
+        /**
+         * @return the time of the last frame, or the given percentile [0..100)
+         *         of the frame times if it is positive.
+         */
+        EQSERVER_API float getTime( const float percentile ) const;
+
+        /**
+         * @return the pixels predicted to render in the given time, keeping
+         *         the last frame or the given percentile of the frames at it.
+         */
+        EQSERVER_API float predictPixels( const float time,
+                                          const float percentile ) const;
+
+    private:
+        struct Sample
+        {
+            float pixels; //!< rendered pixels
+            float time;   //!< channel frame time in ms
+        };
+        std::deque< Sample > _samples; //!< recent frames, youngest last
+    };
+}
+}
+
+#endif // EQSERVER_FRAMETIMEMODEL_H
@@ -0,0 +1,103 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "hybridModel.h"
+
+#include "../log.h"
+
+#include <lunchbox/debug.h>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// The other mode has to be predicted faster by this ratio to switch
+static const float _hysteresis = .2f;
+// Frames after which the other mode is measured again
+static const uint32_t _probeInterval = 500;
+}
+
+HybridModel::HybridModel()
+    : _mode( fabric::Equalizer::MODE_2D )
+    , _time( 0.f )
+    , _ratio( 1.f )
+{}
+
+bool HybridModel::update( const Mode measured, const float render,
+                          const float assemble, const float transfer,
+                          const uint32_t frame,
+                          const uint32_t current, const float damping )
+{
+    LBASSERT( measured == fabric::Equalizer::MODE_2D ||
+              measured == fabric::Equalizer::MODE_DB );
+
+    // update the cost of the mode used to render the measured frame
+    Cost& cost = _costs[ measured == fabric::Equalizer::MODE_DB ];
+    if( cost.base == 0.f ) // first measurement since switching to the mode
+    {
+        cost.render = render;
+        cost.assemble = assemble;
+        cost.base = LB_MAX( render, 1.f );
+    }
+    else
+    {
+        cost.render = damping * cost.render + ( 1.f - damping ) * render;
+        cost.assemble = damping * cost.assemble + ( 1.f - damping ) * assemble;
+    }
+    cost.frame = frame;
+
+    if( measured != _mode ) // rendered before the last switch
+        return false;
+
+    // The other mode was measured before switching to the current mode.
+    // Scale its render time by the load change measured since then.
+    const Mode otherMode = ( _mode == fabric::Equalizer::MODE_DB ) ?
+        fabric::Equalizer::MODE_2D : fabric::Equalizer::MODE_DB;
+    // The transfer time is predicted for the current frame in both modes.
+    const Cost& other = _costs[ otherMode == fabric::Equalizer::MODE_DB ];
+    const bool isDB = _mode == fabric::Equalizer::MODE_DB;
+    const float currentTime = cost.render + cost.assemble +
+                              ( isDB ? transfer : 0.f );
+    const float otherTime = other.render * cost.render / cost.base +
+                            other.assemble + ( isDB ? 0.f : transfer );
+    const bool known = other.base != 0.f;
+    const bool probe = !known || current - other.frame > _probeInterval;
+
+    _time = currentTime;
+    _ratio = known ? currentTime / otherTime : 1.f;
+
+    if( !probe && otherTime >= currentTime * ( 1.f - _hysteresis ))
+        return true;
+
+    LBLOG( LOG_LB1 ) << ( probe ? "Probing " : "Switching to " ) << otherMode
+                     << ", predicted " << otherTime << " ms instead of "
+                     << currentTime << " ms" << std::endl;
+
+    _mode = otherMode;
+    _costs[ _mode == fabric::Equalizer::MODE_DB ].base = 0.f;
+    if( known )
+    {
+        _time = otherTime;
+        _ratio = otherTime / currentTime;
+    }
+    return true;
+}
+
+}
+}
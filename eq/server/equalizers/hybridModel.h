@@ -0,0 +1,99 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_HYBRIDMODEL_H
+#define EQSERVER_HYBRIDMODEL_H
+
+#include "../api.h"
+#include "../types.h"
+
+#include <eq/fabric/equalizer.h> // Mode enum
+
+namespace eq
+{
+namespace server
+{
+    /**
+     * Selects 2D or DB decomposition for the MODE_HYBRID load equalizer.
+     *
+     * The frame time of each mode is the balanced render time per resource
+     * plus the assembly time of the destination channel. DB additionally
+     * sends a full-size output frame from each child, which adds the
+     * predicted transfer time of all children. The cost of the
+     * inactive mode was measured before the last switch, and its render time
+     * is scaled by the load change measured since then. The model switches
+     * when the inactive mode is predicted to be faster by more than the
+     * hysteresis, and probes the inactive mode periodically.
+     */
+    class HybridModel
+    {
+    public:
+        typedef fabric::Equalizer::Mode Mode;
+
+        EQSERVER_API HybridModel();
+
+        /**
+         * Update the model with the times measured for one frame.
+         *
+         * @param measured the mode used to render the measured frame.
+         * @param render the balanced render time per resource in ms.
+         * @param assemble the assembly time of the destination channel in ms.
+         * @param transfer the predicted time to send the output frames of all
+         *                 children in DB mode in ms.
+         * @param frame the number of the measured frame.
+         * @param current the number of the frame to be rendered next.
+         * @param damping the weight of the previous measurements, 0..1.
+         * @return true if a decision was made, false if the frame was rendered
+         *         before the last switch.
+         */
+        EQSERVER_API bool update( const Mode measured, const float render,
+                                  const float assemble, const float transfer,
+                                  const uint32_t frame,
+                                  const uint32_t current, const float damping );
+
+        /** @return the mode to use for the next frame. */
+        Mode getMode() const { return _mode; }
+
+        /** @return the predicted time of the selected mode in ms. */
+        float getTime() const { return _time; }
+
+        /**
+         * @return the predicted time of the selected mode relative to the
+         *         other mode, or 1 if the other mode was not measured yet.
+         */
+        float getRatio() const { return _ratio; }
+
+    private:
+        struct Cost
+        {
+            Cost() : render( 0.f ), assemble( 0.f ), base( 0.f ), frame( 0 )
+                {}
+            float    render;   //!< balanced render time per resource
+            float    assemble; //!< assembly time of the destination channel
+            float    base;     //!< first render time after switching to mode
+            uint32_t frame;    //!< last frame measured in this mode
+        };
+
+        Cost  _costs[2]; //!< Cost of 2D [0] and DB [1]
+        Mode  _mode;     //!< The selected mode
+        float _time;
+        float _ratio;
+    };
+}
+}
+
+#endif // EQSERVER_HYBRIDMODEL_H
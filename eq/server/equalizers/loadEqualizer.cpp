@@ -2,6 +2,7 @@
 /* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Cedric Stalder <cedric.stalder@gmail.com>
  *                    2012, Daniel Nachbaur <danielnachbaur@gmail.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -20,7 +21,9 @@
 #include "loadEqualizer.h"
 
 #include "../compound.h"
+#include "../config.h"
 #include "../log.h"
+#include "../server.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
@@ -38,6 +41,8 @@ std::ostream& operator << ( std::ostream& os, const LoadEqualizer::Node* );
 
 LoadEqualizer::LoadEqualizer()
         : _tree( 0 )
+        , _otherTree( 0 )
+        , _lastMeasured( 0 )
 {
     LBVERB << "New LoadEqualizer @" << (void*)this << std::endl;
 }
@@ -45,6 +50,8 @@ LoadEqualizer::LoadEqualizer()
 LoadEqualizer::LoadEqualizer( const fabric::Equalizer& from )
         : Equalizer( from )
         , _tree( 0 )
+        , _otherTree( 0 )
+        , _lastMeasured( 0 )
 {}
 
 LoadEqualizer::~LoadEqualizer()
@@ -52,6 +59,8 @@ LoadEqualizer::~LoadEqualizer()
     _clearTree( _tree );
     delete _tree;
     _tree = 0;
+    delete _otherTree; // separate nodes, listeners are shared with _tree
+    _otherTree = 0;
 
     _history.clear();
 }
@@ -79,10 +88,15 @@ void LoadEqualizer::notifyUpdatePre( Compound* compound,
 
           default:
               _tree = _buildTree( children );
+              if( getMode() == MODE_HYBRID )
+                  _otherTree = _buildTree( children, false );
               break;
         }
     }
 
+    _updateHybridMode( frameNumber );
+    _updateTransferFactors();
+
     // compute new data
     if( getDamping() < 1.f )
     {
@@ -94,7 +108,8 @@ void LoadEqualizer::notifyUpdatePre( Compound* compound,
     _computeSplit();
 }
 
-LoadEqualizer::Node* LoadEqualizer::_buildTree( const Compounds& compounds )
+LoadEqualizer::Node* LoadEqualizer::_buildTree( const Compounds& compounds,
+                                                const bool listen )
 {
     Node* node = new Node;
 
@@ -107,7 +122,8 @@ LoadEqualizer::Node* LoadEqualizer::_buildTree( const Compounds& compounds )
 
         Channel* channel = compound->getChannel();
         LBASSERT( channel );
-        channel->addListener( this );
+        if( listen )
+            channel->addListener( this );
         return node;
     }
 
@@ -121,8 +137,8 @@ LoadEqualizer::Node* LoadEqualizer::_buildTree( const Compounds& compounds )
     for( size_t i = middle; i < size; ++i )
         right.push_back( compounds[i] );
 
-    node->left  = _buildTree( left );
-    node->right = _buildTree( right );
+    node->left  = _buildTree( left, listen );
+    node->right = _buildTree( right, listen );
 
     return node;
 }
@@ -176,7 +192,6 @@ void LoadEqualizer::notifyLoadData( Channel* channel,
             int64_t startTime = std::numeric_limits< int64_t >::max();
             int64_t endTime   = 0;
             bool    loadSet   = false;
-            int64_t transmitTime = 0;
             for( size_t k = 0; k < statistics.size(); ++k )
             {
                 const Statistic& stat = statistics[k];
@@ -196,14 +211,6 @@ void LoadEqualizer::notifyLoadData( Channel* channel,
                     endTime   = LB_MAX( endTime, stat.endTime );
                     break;
 
-                case Statistic::CHANNEL_ASYNC_READBACK:
-                case Statistic::CHANNEL_FRAME_TRANSMIT:
-                    transmitTime += stat.endTime - stat.startTime;
-                    break;
-                case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
-                    transmitTime -= stat.endTime - stat.startTime;
-                    break;
-
                 // assemble blocks on input frames, stop using subsequent data
                 case Statistic::CHANNEL_ASSEMBLE:
                     loadSet = true;
@@ -220,8 +227,12 @@ void LoadEqualizer::notifyLoadData( Channel* channel,
             data.vp.apply( region ); // Update ROI
             data.time = endTime - startTime;
             data.time = LB_MAX( data.time, 1 );
-            data.time = LB_MAX( data.time, transmitTime );
             data.assembleTime = LB_MAX( data.assembleTime, 0 );
+
+            // output frame transfer is modelled separately per node
+            const PixelViewport& pvp = getCompound()->getInheritPixelViewport();
+            _transfer.update( channel, taskID, statistics,
+                              data.vp.getArea() * float( pvp.getArea( )));
             LBLOG( LOG_LB2 ) << "Added time " << data.time << " (+"
                              << data.assembleTime << ") for "
                              << channel->getName() << " " << data.vp << ", "
@@ -296,6 +307,122 @@ void LoadEqualizer::_checkHistory()
     }
 }
 
+void LoadEqualizer::_updateHybridMode( const uint32_t frameNumber )
+{
+    if( getMode() != MODE_HYBRID || getDamping() >= 1.f )
+        return;
+
+    const LBFrameData& frameData = _history.front();
+    if( frameData.first <= _lastMeasured ) // fake or already used data set
+        return;
+    _lastMeasured = frameData.first;
+
+    LBDatas items( frameData.second );
+    _removeEmpty( items );
+    const float nResources = _getTotalResources();
+    if( items.empty() || nResources <= 0.f )
+        return;
+
+    const Mode mode = _hybrid.getMode();
+    const float render = float( _getTotalTime( )) / nResources;
+    const float assemble = float( _getAssembleTime( ));
+    const float transfer = _getDBTransferTime();
+    if( !_hybrid.update( items.front().mode, render, assemble, transfer,
+                         frameData.first, frameNumber, getDamping( )))
+    {
+        return;
+    }
+    if( _hybrid.getMode() != mode )
+        std::swap( _tree, _otherTree );
+
+    Compound* compound = getCompound();
+    Config* config = compound->getConfig();
+    const int64_t now = config->getServer()->getTime();
+    const Statistic::Type type = _hybrid.getMode() == MODE_DB ?
+        Statistic::CONFIG_LOAD_DB : Statistic::CONFIG_LOAD_2D;
+    config->sendStatistic( type, now - int64_t( _hybrid.getTime( )),
+                           _hybrid.getRatio(),
+                           compound->getChannel()->getName( ));
+}
+
+float LoadEqualizer::_getDBTransferTime() const
+{
+    // each active child sends a full-size output frame in DB
+    const Compound* compound = getCompound();
+    const float area = float( compound->getInheritPixelViewport().getArea( ));
+    const Compounds& children = compound->getChildren();
+    float time = 0.f;
+
+    for( CompoundsCIter i = children.begin(); i != children.end(); ++i )
+    {
+        const Compound* child = *i;
+        if( child->isActive() && child->getUsage() > 0.f &&
+            !child->getOutputFrames().empty( ))
+        {
+            time += _transfer.predict( child->getChannel(), area );
+        }
+    }
+    return time;
+}
+
+void LoadEqualizer::_updateTransferFactors()
+{
+    _transferFactors.clear();
+
+    // Child i renders its share a_i of the work in a_i * T / r_i, with T the
+    // total render time and r_i its usage. Sending the output frames takes
+    // f_i + a_i * k_i, with the transfer time k_i of the full area in 2D, or
+    // the time f_i for a full-size image in DB. Equal finish times tau for all
+    // children give a_i = w_i * ( tau - f_i ), with w_i = r_i / (T + k_i * r_i)
+    const Compound* compound = getCompound();
+    const float time = float( _getTotalTime( ));
+    const float area = float( compound->getInheritPixelViewport().getArea( ));
+    const bool isDB = _getMode() == MODE_DB;
+    const Compounds& children = compound->getChildren();
+
+    std::vector< float > weights( children.size( ));
+    std::vector< float > fixed( children.size( ));
+    float sumWeights = 0.f;
+    float sumFixed = 0.f;
+    float resources = 0.f;
+    bool hasTransfer = false;
+
+    for( size_t i = 0; i < children.size(); ++i )
+    {
+        const Compound* child = children[i];
+        const float usage = child->isActive() ? child->getUsage() : 0.f;
+        const float transfer = child->getOutputFrames().empty() ? 0.f :
+                               _transfer.predict( child->getChannel(), area );
+        const float k = isDB ? 0.f : transfer;
+
+        fixed[i] = isDB ? transfer : 0.f;
+        weights[i] = usage > 0.f ? usage / ( time + k * usage ) : 0.f;
+        sumWeights += weights[i];
+        sumFixed += weights[i] * fixed[i];
+        resources += usage;
+        hasTransfer = hasTransfer || transfer > 0.f;
+    }
+
+    if( !hasTransfer || sumWeights <= 0.f || time <= 0.f )
+        return;
+
+    const float tau = ( 1.f + sumFixed ) / sumWeights;
+    for( size_t i = 0; i < children.size(); ++i )
+    {
+        const Compound* child = children[i];
+        if( weights[i] <= 0.f )
+            continue;
+
+        // keep a minimum share to continue measuring slow children
+        const float share = weights[i] * ( tau - fixed[i] );
+        const float factor = share * resources / child->getUsage();
+        _transferFactors[ child ] = LB_MAX( factor, .1f );
+        LBLOG( LOG_LB2 ) << child->getChannel()->getName() << " share "
+                         << share << ", resource factor " << factor
+                         << std::endl;
+    }
+}
+
 float LoadEqualizer::_getTotalResources( ) const
 {
     const Compounds& children = getCompound()->getChildren();
@@ -317,7 +444,7 @@ void LoadEqualizer::_update( Node* node, const Viewport& vp,
     if( !node )
         return;
 
-    node->mode = getMode();
+    node->mode = _getMode();
     if( node->mode == MODE_2D )
     {
         PixelViewport pvp = getCompound()->getChannel()->getPixelViewport();
@@ -342,6 +469,11 @@ void LoadEqualizer::_updateLeaf( Node* node )
     LBASSERT( channel );
     const PixelViewport& pvp = channel->getPixelViewport();
     node->resources = compound->isActive() ? compound->getUsage() : 0.f;
+
+    std::map< const Compound*, float >::const_iterator i =
+        _transferFactors.find( compound );
+    if( i != _transferFactors.end( ))
+        node->resources *= i->second;
     LBLOG( LOG_LB2 ) << channel->getName() << " active " << compound->isActive()
                      << " using " << node->resources << std::endl;
     LBASSERT( node->resources >= 0.f );
@@ -535,7 +667,7 @@ void LoadEqualizer::_computeSplit()
 
     LBDatas sortedData[3] = { items, items, items };
 
-    if( getMode() == MODE_DB )
+    if( _getMode() == MODE_DB )
     {
         LBDatas& rangeData = sortedData[ MODE_DB ];
         sort( rangeData.begin(), rangeData.end(), _compareRange );
@@ -1075,6 +1207,7 @@ void LoadEqualizer::_assign( Compound* compound, const Viewport& vp,
     data.range   = range;
     data.channel = compound->getChannel();
     data.taskID  = compound->getTaskID();
+    data.mode    = _getMode();
 
     const Compound* destCompound = getCompound();
     if( destCompound->getChannel() == compound->getChannel( ))
@@ -1,6 +1,7 @@
 
 /* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -21,11 +22,14 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"          // base class
+#include "hybridModel.h"        // member
+#include "transferModel.h"      // member
 
 #include <eq/fabric/range.h>    // member
 #include <eq/fabric/viewport.h> // member
 
 #include <deque>
+#include <map>
 #include <vector>
 
 namespace eq
@@ -34,7 +38,20 @@ namespace server
 {
     std::ostream& operator << ( std::ostream& os, const LoadEqualizer* );
 
-    /** Adapts the 2D tiling or DB range of the attached compound's children. */
+    /**
+     * Adapts the 2D tiling or DB range of the attached compound's children.
+     *
+     * In MODE_HYBRID, the equalizer keeps a split tree for 2D and for DB. It
+     * predicts the frame time of both modes from the measured render and
+     * assembly times, and switches to the other mode when it is predicted to
+     * be clearly faster. The compound's frames have to be set up for DB
+     * compositing. Each decision is reported as a CONFIG_LOAD_2D or
+     * CONFIG_LOAD_DB statistic.
+     *
+     * The time to read back, compress and send the output frames of each
+     * child is predicted from its node's measured bandwidth. Children with a
+     * slower link get a correspondingly smaller share of the work.
+     */
     class LoadEqualizer : public Equalizer, protected ChannelListener
     {
     public:
@@ -85,11 +102,15 @@ namespace server
         typedef std::vector< Node* > LBNodes;
 
         Node* _tree; // <! The binary split tree of all children
+        Node* _otherTree; //!< The split tree of the inactive hybrid mode
+
+        HybridModel _hybrid;    //!< Selects 2D or DB in MODE_HYBRID
+        uint32_t _lastMeasured; //!< Last frame used to update the costs
 
         struct Data
         {
             Data() : channel( 0 ), taskID( 0 ), destTaskID( 0 )
-                   , time( -1 ), assembleTime( 0 ) {}
+                   , time( -1 ), assembleTime( 0 ), mode( MODE_2D ) {}
             Channel* channel;
             uint32_t taskID;
             uint32_t destTaskID;
@@ -97,6 +118,7 @@ namespace server
             Range    range;
             int64_t  time;
             int64_t  assembleTime;
+            Mode     mode; //!< The mode used for rendering
         };
 
         typedef std::vector< Data > LBDatas;
@@ -104,9 +126,20 @@ namespace server
 
         std::deque< LBFrameData > _history;
 
+        TransferModel _transfer;
+        /** Share of each child relative to its usage due to transfer costs */
+        std::map< const Compound*, float > _transferFactors;
+
         //-------------------- Methods --------------------
         /** @return true if we have a valid LB tree */
-        Node* _buildTree( const Compounds& children );
+        Node* _buildTree( const Compounds& children, const bool listen = true );
+
+        /** @return the mode of the next frame, resolving MODE_HYBRID. */
+        Mode _getMode() const
+            { return getMode() == MODE_HYBRID ? _hybrid.getMode() : getMode(); }
+
+        /** Update the cost of the last measured mode and select the mode. */
+        void _updateHybridMode( const uint32_t frameNumber );
 
         /** Setup assembly with the compound dest value */
         void _updateAssembleTime( Data& data, const Statistic& stat );
@@ -138,6 +171,12 @@ namespace server
         void _assign( Compound* compound, const Viewport& vp,
                       const Range& range );
 
+        /** Update the _transferFactors from the predicted transfer costs. */
+        void _updateTransferFactors();
+
+        /** @return the predicted time to send all DB output frames in ms. */
+        float _getDBTransferTime() const;
+
         /** Get the resource for all children compound. */
         float _getTotalResources( ) const;
 
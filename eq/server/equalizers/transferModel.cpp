@@ -0,0 +1,125 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "transferModel.h"
+
+#include "../channel.h"
+#include "../log.h"
+
+#include <eq/fabric/statistic.h>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// weight of the previous measurements
+static const float _smoothing = .5f;
+
+float _smooth( const float oldValue, const float newValue )
+{
+    if( oldValue == 0.f )
+        return newValue;
+    return _smoothing * oldValue + ( 1.f - _smoothing ) * newValue;
+}
+}
+
+void TransferModel::update( const Channel* channel, const uint32_t taskID,
+                            const Statistics& statistics, const float pixels )
+{
+    if( pixels <= 0.f )
+        return;
+
+    int64_t cpuTime = 0;
+    int64_t compressTime = 0;
+    int64_t transmitTime = 0;
+    uint64_t sentSize = 0;
+    float ratio = 0.f;
+    size_t nImages = 0;
+    size_t nTransmits = 0;
+    for( size_t i = 0; i < statistics.size(); ++i )
+    {
+        const Statistic& stat = statistics[i];
+        if( stat.task != taskID )
+            continue;
+
+        const int64_t time = stat.endTime - stat.startTime;
+        switch( stat.type )
+        {
+          case Statistic::CHANNEL_ASYNC_READBACK:
+              cpuTime += time;
+              break;
+          case Statistic::CHANNEL_FRAME_COMPRESS:
+              cpuTime += time;
+              compressTime += time;
+              ratio += stat.ratio;
+              ++nImages;
+              break;
+          case Statistic::CHANNEL_FRAME_TRANSMIT:
+              transmitTime += time;
+              sentSize += stat.bytes;
+              ++nTransmits;
+              break;
+          case Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN:
+              transmitTime -= time;
+              break;
+          default:
+              break;
+        }
+    }
+
+    if( nTransmits == 0 || sentSize == 0 ) // nothing sent
+        return;
+
+    // Compression is sampled within the transmission. Without compression
+    // samples, the images were sent uncompressed.
+    ratio = nImages == 0 ? 1.f : LB_MAX( ratio / float( nImages ), 1e-3f );
+    const float rawSize = float( sentSize ) / ratio;
+    const int64_t sendTime = LB_MAX( transmitTime - compressTime, 0 );
+
+    Link& link = _links[ channel->getNode() ];
+    link.cpuTime = _smooth( link.cpuTime, float( cpuTime ) / rawSize );
+    link.sendTime = _smooth( link.sendTime,
+                             float( sendTime ) / float( sentSize ));
+
+    Output& output = _outputs[ channel ];
+    output.pixelSize = _smooth( output.pixelSize, rawSize / pixels );
+    output.ratio = _smooth( output.ratio, ratio );
+
+    LBLOG( LOG_LB2 ) << channel->getName() << " sent " << sentSize
+                     << " bytes in " << sendTime << " ms, "
+                     << 1.f / LB_MAX( link.sendTime, 1e-9f )
+                     << " bytes/ms" << std::endl;
+}
+
+float TransferModel::predict( const Channel* channel,
+                              const float pixels ) const
+{
+    const LinksCIter i = _links.find( channel->getNode( ));
+    const OutputsCIter j = _outputs.find( channel );
+    if( i == _links.end() || j == _outputs.end( ))
+        return 0.f;
+
+    const Link& link = i->second;
+    const Output& output = j->second;
+    const float rawSize = pixels * output.pixelSize;
+    return rawSize * ( link.cpuTime + output.ratio * link.sendTime );
+}
+
+}
+}
@@ -0,0 +1,91 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_TRANSFERMODEL_H
+#define EQSERVER_TRANSFERMODEL_H
+
+#include "../api.h"
+#include "../types.h"
+
+#include <map>
+
+namespace eq
+{
+namespace server
+{
+    /**
+     * Predicts the time to send the output frames of a channel.
+     *
+     * The cost of the asynchronous readback and compression per raw byte and
+     * the output bandwidth are measured for each node from the channel
+     * statistics. The raw bytes per pixel and the compression ratio are
+     * measured for each channel, since they depend on the pixel format of
+     * the output frames. Channels without output frames, e.g., the
+     * destination channel, have no transfer cost.
+     */
+    class TransferModel
+    {
+    public:
+        TransferModel() {}
+
+        /**
+         * Update the model with the statistics of one channel task.
+         *
+         * @param channel the channel sending the output frames.
+         * @param taskID the task of the compound sending the output frames.
+         * @param statistics the statistics of the channel's frame.
+         * @param pixels the number of pixels of the output frames.
+         */
+        EQSERVER_API void update( const Channel* channel, const uint32_t taskID,
+                                  const Statistics& statistics,
+                                  const float pixels );
+
+        /**
+         * @return the predicted time in milliseconds to read back, compress
+         *         and send the given number of pixels from the channel, or 0
+         *         if nothing was measured yet.
+         */
+        EQSERVER_API float predict( const Channel* channel,
+                                    const float pixels ) const;
+
+    private:
+        struct Link
+        {
+            Link() : cpuTime( 0.f ), sendTime( 0.f ) {}
+            float cpuTime;  //!< readback and compression ms per raw byte
+            float sendTime; //!< ms per sent byte, the inverse bandwidth
+        };
+
+        struct Output
+        {
+            Output() : pixelSize( 0.f ), ratio( 0.f ) {}
+            float pixelSize; //!< raw bytes per output pixel
+            float ratio;     //!< sent bytes per raw byte
+        };
+
+        typedef std::map< const Node*, Link > Links;
+        typedef Links::const_iterator LinksCIter;
+        typedef std::map< const Channel*, Output > Outputs;
+        typedef Outputs::const_iterator OutputsCIter;
+
+        Links _links;     //!< per node
+        Outputs _outputs; //!< per channel
+    };
+}
+}
+
+#endif // EQSERVER_TRANSFERMODEL_H
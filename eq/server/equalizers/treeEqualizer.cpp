@@ -1,6 +1,7 @@
 
 /* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -138,19 +139,20 @@ void TreeEqualizer::_clearTree( Node* node )
 void TreeEqualizer::notifyLoadData( Channel* channel,
                                     const uint32_t /*frame*/,
                                     const Statistics& statistics,
-                                    const Viewport& /*region*/ )
+                                    const Viewport& region )
 {
-    _notifyLoadData( _tree, channel, statistics );
+    _notifyLoadData( _tree, channel, statistics, region );
 }
 
 void TreeEqualizer::_notifyLoadData( Node* node, Channel* channel,
-                                     const Statistics& statistics )
+                                     const Statistics& statistics,
+                                     const Viewport& region )
 {
     if( !node )
         return;
 
-    _notifyLoadData( node->left, channel, statistics );
-    _notifyLoadData( node->right, channel, statistics );
+    _notifyLoadData( node->left, channel, statistics, region );
+    _notifyLoadData( node->right, channel, statistics, region );
 
     if( !node->compound || node->compound->getChannel() != channel )
         return;
@@ -160,7 +162,6 @@ void TreeEqualizer::_notifyLoadData( Node* node, Channel* channel,
     int64_t startTime = std::numeric_limits< int64_t >::max();
     int64_t endTime   = 0;
     bool    loadSet   = false;
-    int64_t timeTransmit = 0;
     for( size_t i = 0; i < statistics.size() && !loadSet; ++i )
     {
         const Statistic& stat = statistics[ i ];
@@ -176,11 +177,6 @@ void TreeEqualizer::_notifyLoadData( Node* node, Channel* channel,
             endTime   = LB_MAX( endTime, stat.endTime );
             break;
 
-        case Statistic::CHANNEL_ASYNC_READBACK:
-        case Statistic::CHANNEL_FRAME_TRANSMIT:
-            timeTransmit += stat.endTime - stat.startTime;
-            break;
-
         // assemble blocks on input frames, stop using subsequent data
         case Statistic::CHANNEL_ASSEMBLE:
             loadSet = true;
@@ -194,9 +190,15 @@ void TreeEqualizer::_notifyLoadData( Node* node, Channel* channel,
     if( startTime == std::numeric_limits< int64_t >::max( ))
         return;
 
-    node->time = endTime - startTime;
+    // add the predicted time to send the output frames from this node
+    const Compound* compound = node->compound;
+    const float pixels = region.getArea() *
+                  float( compound->getInheritPixelViewport().getArea( ));
+    _transfer.update( channel, taskID, statistics, pixels );
+    const float transferTime = _transfer.predict( channel, pixels );
+
+    node->time = endTime - startTime + int64_t( transferTime );
     node->time = LB_MAX( node->time, 1 );
-    node->time = LB_MAX( node->time, timeTransmit );
 }
 
 void TreeEqualizer::_update( Node* node )
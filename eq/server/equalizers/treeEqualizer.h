@@ -1,6 +1,7 @@
 
 /* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -21,6 +22,7 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"          // base class
+#include "transferModel.h"      // member
 
 #include <eq/fabric/range.h>    // member
 #include <eq/fabric/viewport.h> // member
@@ -87,6 +89,7 @@ namespace server
         typedef std::vector< Node* > LBNodes;
 
         Node* _tree; // <! The binary split tree of all children
+        TransferModel _transfer; //!< Predicts the output frame transfer time
 
         //-------------------- Methods --------------------
         /** @return true if we have a valid LB tree */
@@ -96,7 +99,8 @@ namespace server
         void _clearTree( Node* node );
 
         void _notifyLoadData( Node* node, Channel* channel,
-                              const Statistics& statistics );
+                              const Statistics& statistics,
+                              const Viewport& region );
 
         /** Update all node fields influencing the split */
         void _update( Node* node );
@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -22,9 +23,11 @@
 #include "../config.h"
 #include "../log.h"
 #include "../pipe.h"
+#include "../server.h"
 
 #include <eq/fabric/statistic.h>
 
+#include <algorithm>
 #include <set>
 
 #define MIN_USAGE .1f // 10%
@@ -36,6 +39,7 @@ namespace server
 
 ViewEqualizer::ViewEqualizer()
         : _nPipes( 0 )
+        , _stealing( false )
 {
     LBINFO << "New view equalizer @" << (void*)this << std::endl;
 }
@@ -43,6 +47,7 @@ ViewEqualizer::ViewEqualizer()
 ViewEqualizer::ViewEqualizer( const ViewEqualizer& from )
         : Equalizer( from )
         , _nPipes( 0 )
+        , _stealing( from._stealing )
 {}
 
 ViewEqualizer::~ViewEqualizer()
@@ -52,6 +57,7 @@ ViewEqualizer::~ViewEqualizer()
 }
 
 ViewEqualizer::Listener::Listener()
+        : _parent( 0 )
 {
 }
 
@@ -291,6 +297,35 @@ private:
     Compound* _fallback;
 };
 
+
+class StealMarker : public CompoundVisitor
+{
+public:
+    StealMarker( const bool stealing, std::vector< const Channel* >& stealers )
+            : _stealing( stealing ), _stealers( stealers ) {}
+
+    virtual VisitorResult visitLeaf( Compound* compound )
+        {
+            // tile leaves not assigned to the view steal after their own work
+            const bool deferred = _stealing && compound->isActive() &&
+                                  compound->hasTiles() &&
+                                  compound->getUsage() == 0.0f;
+            compound->setDeferred( deferred );
+            if( deferred )
+            {
+                _stealers.push_back( compound->getChannel( ));
+                LBLOG( LOG_LB1 ) << "  Steal using "
+                                 << compound->getPipe()->getName() << " task "
+                                 << compound->getTaskID() << std::endl;
+            }
+            return TRAVERSE_CONTINUE;
+        }
+
+private:
+    const bool _stealing;
+    std::vector< const Channel* >& _stealers;
+};
+
 }
 
 void ViewEqualizer::_update( const uint32_t frameNumber )
@@ -307,10 +342,12 @@ void ViewEqualizer::_update( const uint32_t frameNumber )
         Listener& listener = *i;
         const Listener::Load& load = listener.useLoad( frame );
 
-        totalTime += load.time;
+        totalTime += load.time + load.stolenTime;
         loads.push_back( load );
     }
 
+    _updateStealing( frame, loads );
+
     const Compound* compound = getCompound();
 
     if( isFrozen() || !compound->isActive() || _nPipes == 0 )
@@ -341,7 +378,9 @@ void ViewEqualizer::_update( const uint32_t frameNumber )
         if( !child->isActive( ))
             continue;
 
-        float segmentResources( load.time / resourceTime );
+        // the time of stolen tiles counts towards the view
+        float segmentResources( ( load.time + load.stolenTime ) /
+                                resourceTime );
 
         LBLOG( LOG_LB1 ) << "----- balance step 1 for view " << i << " ("
                          << child->getChannel()->getName() << " "
@@ -413,7 +452,11 @@ void ViewEqualizer::_update( const uint32_t frameNumber )
             }
         }
 
-        listener.newLoad( frameNumber, load.missing );
+        std::vector< const Channel* > stealers;
+        StealMarker marker( _stealing, stealers );
+        child->accept( marker );
+
+        listener.newLoad( frameNumber, load.missing, stealers );
     }
 }
 
@@ -450,6 +493,93 @@ uint32_t ViewEqualizer::_findInputFrameNumber() const
     return frame;
 }
 
+void ViewEqualizer::_addPipeLoad( const uint32_t frameNumber,
+                                  const Pipe* pipe, const int64_t startTime,
+                                  const int64_t endTime )
+{
+    PipeLoads& pipeLoads = _pipeLoads[ frameNumber ];
+    PipeLoads::iterator i = pipeLoads.find( pipe );
+    if( i == pipeLoads.end( ))
+    {
+        const PipeLoad pipeLoad = { startTime, endTime, endTime - startTime };
+        pipeLoads[ pipe ] = pipeLoad;
+        return;
+    }
+
+    PipeLoad& pipeLoad = i->second;
+    pipeLoad.start = LB_MIN( pipeLoad.start, startTime );
+    pipeLoad.end = LB_MAX( pipeLoad.end, endTime );
+    pipeLoad.busy += endTime - startTime;
+}
+
+void ViewEqualizer::_updateStealing( const uint32_t frame, const Loads& loads )
+{
+    _steals.resize( loads.size( ));
+    for( size_t i = 0; i < loads.size(); ++i )
+        _steals[i] = loads[i].steals;
+
+    // idle time: render time span of all pipes minus the busy time of a pipe
+    std::map< uint32_t, PipeLoads >::const_iterator used =
+        _pipeLoads.find( frame );
+    const bool hasPipeLoads = used != _pipeLoads.end();
+    int64_t frameTime = 0;
+    if( hasPipeLoads )
+    {
+        const PipeLoads& pipeLoads = used->second;
+        int64_t startTime = std::numeric_limits< int64_t >::max();
+        int64_t endTime = 0;
+        for( PipeLoads::const_iterator i = pipeLoads.begin();
+             i != pipeLoads.end(); ++i )
+        {
+            startTime = LB_MIN( startTime, i->second.start );
+            endTime = LB_MAX( endTime, i->second.end );
+        }
+        frameTime = LB_MAX( endTime - startTime, 1 );
+
+        _idleTimes.clear();
+        for( PipeLoads::const_iterator i = pipeLoads.begin();
+             i != pipeLoads.end(); ++i )
+        {
+            const int64_t idle = frameTime - i->second.busy;
+            _idleTimes[ i->first ] = LB_MAX( idle, 0 );
+        }
+    }
+    // always erase used and older frames to not leak memory
+    _pipeLoads.erase( _pipeLoads.begin(), _pipeLoads.upper_bound( frame ));
+
+    if( !_stealing || !hasPipeLoads )
+        return;
+
+    Compound* compound = getCompound();
+    Config* config = compound->getConfig();
+    const int64_t now = config->getServer()->getTime();
+    const Compounds& children = compound->getChildren();
+
+    for( size_t i = 0; i < loads.size() && i < children.size(); ++i )
+    {
+        const Listener::Load& load = loads[i];
+        const Channel* channel = children[i]->getChannel();
+        if( load.steals > 0 )
+            config->sendStatistic( Statistic::CONFIG_VIEW_STEAL,
+                                   now - load.stolenTime, float( load.steals ),
+                                   channel ? channel->getName() : "view" );
+        LBLOG( LOG_LB1 ) << "Frame " << frame << " view " << i << " "
+                         << load.steals << " tiles stolen in "
+                         << load.stolenTime << "ms" << std::endl;
+    }
+
+    for( PipeTimes::const_iterator i = _idleTimes.begin();
+         i != _idleTimes.end(); ++i )
+    {
+        config->sendStatistic( Statistic::CONFIG_VIEW_IDLE, now - i->second,
+                               float( i->second ) / float( frameTime ),
+                               i->first->getName( ));
+        LBLOG( LOG_LB1 ) << "Frame " << frame << " pipe "
+                         << i->first->getName() << " idle " << i->second
+                         << "ms of " << frameTime << "ms" << std::endl;
+    }
+}
+
 
 void ViewEqualizer::_updateListeners()
 {
@@ -469,7 +599,7 @@ void ViewEqualizer::_updateListeners()
         LBLOG( LOG_LB1 ) << lunchbox::disableFlush << "Tasks for view " << i
                          << ": ";
         Listener& listener = _listeners[ i ];
-        listener.update( children[i] );
+        listener.update( children[i], this );
         LBLOG(LOG_LB1) << std::endl << lunchbox::enableFlush;
     }
 }
@@ -548,9 +678,11 @@ private:
 };
 }
 
-void ViewEqualizer::Listener::update( Compound* compound )
+void ViewEqualizer::Listener::update( Compound* compound,
+                                      ViewEqualizer* parent )
 {
     LBASSERT( _taskIDs.empty( ));
+    _parent = parent;
     LoadSubscriber subscriber( this, _taskIDs );
     compound->accept( subscriber );
 }
@@ -570,7 +702,7 @@ ViewEqualizer::Listener::Load::Load( const uint32_t frame_,
                                      const uint32_t missing_,
                                      const int64_t time_ )
         : frame( frame_ ), missing( missing_ ), nResources( missing_ )
-        , time( time_ ) {}
+        , time( time_ ), steals( 0 ), stolenTime( 0 ) {}
 
 bool ViewEqualizer::Listener::Load::operator == ( const Load& rhs ) const
 {
@@ -630,6 +762,29 @@ void ViewEqualizer::Listener::notifyLoadData( Channel* channel,
     if( startTime == std::numeric_limits< int64_t >::max( ))
         return;
 
+    if( _parent->isStealing( ))
+        _parent->_addPipeLoad( frameNumber, channel->getPipe(), startTime,
+                               endTime );
+
+    if( std::find( load.stealers.begin(), load.stealers.end(), channel ) !=
+        load.stealers.end( ))
+    {
+        // draw statistics of tile tasks carry the number of drawn tiles
+        uint32_t nTiles = 0;
+        for( size_t i = 0; i < statistics.size(); ++i )
+        {
+            const Statistic& data = statistics[i];
+            if( data.task == taskID && data.type == Statistic::CHANNEL_DRAW )
+                nTiles += uint32_t( data.ratio );
+        }
+
+        load.steals += nTiles;
+        load.stolenTime += endTime - startTime;
+        LBLOG( LOG_LB1 ) << "Task " << taskID << " stole " << nTiles
+                         << " tiles from " << load << std::endl;
+        return;
+    }
+
     LBASSERTINFO( load.missing > 0, load << " for " << channel->getName() <<
                                     " " << channel->getSerial( ));
 
@@ -695,15 +850,24 @@ ViewEqualizer::Listener::_getLoad( const uint32_t frame )
 }
 
 void ViewEqualizer::Listener::newLoad( const uint32_t frameNumber,
-                                       const uint32_t nChannels )
+                                       const uint32_t nChannels,
+                                 const std::vector< const Channel* >& stealers )
 {
     LBASSERT( nChannels > 0 );
     _loads.push_front( Load( frameNumber, nChannels, 0 ));
+    _loads.front().stealers = stealers;
 }
 
 std::ostream& operator << ( std::ostream& os, const ViewEqualizer* equalizer )
 {
-    if( equalizer )
+    if( !equalizer )
+        return os;
+
+    if( equalizer->isStealing( ))
+        os << lunchbox::disableFlush << "view_equalizer" << std::endl
+           << '{' << std::endl << "    steal ON" << std::endl
+           << '}' << std::endl << lunchbox::enableFlush;
+    else
         os << "view_equalizer {}" << std::endl;
     return os;
 }
@@ -1,5 +1,6 @@
 
 /* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+ *                    2014, The Equalizer Authors
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -34,6 +35,12 @@ namespace server
     /**
      * An Equalizer allocating resources to multiple destination channels of a
      * single view.
+     *
+     * With stealing enabled, the leaves of a tiled view (using a
+     * tile_equalizer) which are not assigned to the view steal its remaining
+     * tiles once their channel has finished its own work in the same frame.
+     * The stolen tiles per view and the idle time per pipe are reported as
+     * CONFIG_VIEW_STEAL and CONFIG_VIEW_IDLE statistics.
      */
     class ViewEqualizer : public Equalizer
     {
@@ -52,6 +59,20 @@ namespace server
 
         virtual uint32_t getType() const { return fabric::VIEW_EQUALIZER; }
 
+        /** Enable stealing of tiles across views within a frame. */
+        void setStealing( const bool onOff ) { _stealing = onOff; }
+
+        /** @return true if tiles are stolen across views. */
+        bool isStealing() const { return _stealing; }
+
+        /** @return the tiles stolen from each view in the last used frame. */
+        const std::vector< uint32_t >& getSteals() const { return _steals; }
+
+        typedef std::map< const Pipe*, int64_t > PipeTimes;
+
+        /** @return the idle time of each pipe in the last used frame, in ms. */
+        const PipeTimes& getIdleTimes() const { return _idleTimes; }
+
     protected:
         void notifyChildAdded( Compound*, Compound* ) override
             { LBASSERT( _listeners.empty( )); }
@@ -65,7 +86,7 @@ namespace server
             Listener();
             virtual ~Listener();
 
-            void update( Compound* compound );
+            void update( Compound* compound, ViewEqualizer* parent );
             void clear();
 
             virtual void notifyLoadData( Channel* channel,
@@ -84,6 +105,11 @@ namespace server
                 uint32_t missing;
                 uint32_t nResources;
                 int64_t time;
+
+                /** Channels stealing tiles from this view. */
+                std::vector< const Channel* > stealers;
+                uint32_t steals; //!< tiles drawn by the stealers
+                int64_t stolenTime; //!< render time of the stealers
             };
 
             /** @return the frame number of the youngest complete load. */
@@ -91,13 +117,15 @@ namespace server
             /** Delete older loads and return the load belonging to the frame.*/
             const Load& useLoad( const uint32_t frameNumber );
             /** Insert a new, empty load for the given frame. */
-            void newLoad( const uint32_t frameNumber, const uint32_t nChannels);
+            void newLoad( const uint32_t frameNumber, const uint32_t nChannels,
+                          const std::vector< const Channel* >& stealers );
             /** @return the size of the history stash. */
             size_t getNLoads() const { return _loads.size(); }
 
         private:
             typedef lunchbox::PtrHash< Channel*, uint32_t > TaskIDHash;
             TaskIDHash _taskIDs;
+            ViewEqualizer* _parent;
 
             typedef std::deque< Load > LoadDeque;
             LoadDeque _loads;
@@ -119,6 +147,20 @@ namespace server
         /** The total number of available resources. */
         size_t _nPipes;
 
+        bool _stealing;
+        std::vector< uint32_t > _steals;
+        PipeTimes _idleTimes;
+
+        /** Render time span and busy time of a pipe. */
+        struct PipeLoad
+        {
+            int64_t start;
+            int64_t end;
+            int64_t busy;
+        };
+        typedef std::map< const Pipe*, PipeLoad > PipeLoads;
+        std::map< uint32_t, PipeLoads > _pipeLoads; //!< per frame
+
         /** Update channel load subscription. */
         void _updateListeners();
         /** Update resource count. */
@@ -127,6 +169,12 @@ namespace server
         void _update( const uint32_t frameNumber );
         /** Find the frame number to use for update. */
         uint32_t _findInputFrameNumber() const;
+
+        /** Add the render time of a task to the frame's pipe loads. */
+        void _addPipeLoad( const uint32_t frameNumber, const Pipe* pipe,
+                           const int64_t startTime, const int64_t endTime );
+        /** Update and report the steals and idle times of the used frame. */
+        void _updateStealing( const uint32_t frame, const Loads& loads );
     };
     std::ostream& operator << ( std::ostream& os,
                                 const ViewEqualizer::Listener& listener );
@@ -67,6 +67,7 @@ void Global::_setupDefaults()
 
     _configFAttributes[Config::FATTR_EYE_BASE]         = 0.05f;
     _configIAttributes[Config::IATTR_ROBUSTNESS]       = fabric::AUTO;
+    _configIAttributes[Config::IATTR_TASK_CACHE]       = fabric::OFF;
 
     // node
     for( uint32_t i=0; i < Node::CATTR_ALL; ++i )
@@ -122,6 +123,8 @@ void Global::_setupDefaults()
     _channelIAttributes[Channel::IATTR_HINT_STATISTICS] = fabric::NICEST;
 #endif
     _channelIAttributes[Channel::IATTR_HINT_SENDTOKEN] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_ACTIVE_PIXELS] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_PROGRESSIVE] = fabric::OFF;
 
     // compound
     for( uint32_t i=0; i<Compound::IATTR_ALL; ++i )
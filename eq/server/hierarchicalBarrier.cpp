@@ -0,0 +1,86 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "hierarchicalBarrier.h"
+
+#include "node.h"
+#include "pipe.h"
+#include "window.h"
+
+#include <co/node.h>
+#include <lunchbox/uint128_t.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+
+HierarchicalBarrier::HierarchicalBarrier()
+    : _id( lunchbox::make_UUID( ))
+{}
+
+void HierarchicalBarrier::join( Window* window )
+{
+    if( std::find( _windows.begin(), _windows.end(), window ) ==
+        _windows.end( ))
+        _windows.push_back( window );
+}
+
+void HierarchicalBarrier::commit()
+{
+    _entering.clear();
+    _nodes.clear();
+    _heights.clear();
+
+    for( WindowsCIter i = _windows.begin(); i != _windows.end(); ++i )
+    {
+        Window* window = *i;
+        const Windows& pipeWindows = window->getPipe()->getWindows();
+
+        bool first = true;
+        for( WindowsCIter j = pipeWindows.begin();
+             first && j != pipeWindows.end() && *j != window; ++j )
+        {
+            first = std::find( _windows.begin(), _windows.end(), *j ) ==
+                    _windows.end();
+        }
+        if( !first ) // an earlier window of the pipe enters for us
+            continue;
+
+        _entering.push_back( window );
+        const Node* node = window->getNode();
+        if( _heights[ node ]++ == 0 )
+            _nodes.push_back( node->getNode()->getNodeID( ));
+    }
+}
+
+bool HierarchicalBarrier::isEntering( const Window* window ) const
+{
+    return std::find( _entering.begin(), _entering.end(), window ) !=
+           _entering.end();
+}
+
+uint32_t HierarchicalBarrier::getHeight( const Node* node ) const
+{
+    Heights::const_iterator i = _heights.find( node );
+    return i == _heights.end() ? 0 : i->second;
+}
+
+}
+}
@@ -0,0 +1,84 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_HIERARCHICALBARRIER_H
+#define EQSERVER_HIERARCHICALBARRIER_H
+
+#include "types.h"
+
+#include <co/types.h>
+#include <lunchbox/referenced.h> // base class
+#include <map>
+
+namespace eq
+{
+namespace server
+{
+    /**
+     * One frame of a hierarchical swap barrier.
+     *
+     * Collects the windows joining the barrier during the compound update and
+     * derives the participants of the eq::HierarchicalBarrier: the windows
+     * entering, the number of entering windows per node and the participating
+     * nodes.
+     */
+    class HierarchicalBarrier : public lunchbox::Referenced
+    {
+    public:
+        /** Construct a new barrier with a unique identifier. */
+        HierarchicalBarrier();
+
+        /** @return the unique identifier of this barrier. */
+        const uint128_t& getID() const { return _id; }
+
+        /** Add a window to the barrier. */
+        void join( Window* window );
+
+        /**
+         * Compute the participants after all windows joined.
+         *
+         * Only the first joined window of each pipe enters the barrier, since
+         * the windows of a pipe are executed sequentially.
+         */
+        void commit();
+
+        /** @return true if the given window enters the barrier. */
+        bool isEntering( const Window* window ) const;
+
+        /** @return the total number of entering windows. */
+        uint32_t getHeight() const { return uint32_t( _entering.size( )); }
+
+        /** @return the number of entering windows of the given node. */
+        uint32_t getHeight( const Node* node ) const;
+
+        /** @return the participating nodes, in a consistent order. */
+        const co::NodeIDs& getNodes() const { return _nodes; }
+
+    private:
+        virtual ~HierarchicalBarrier() {}
+
+        const uint128_t _id;
+        Windows _windows;
+        Windows _entering;
+        co::NodeIDs _nodes;
+
+        typedef std::map< const Node*, uint32_t > Heights;
+        Heights _heights;
+    };
+}
+}
+#endif // EQSERVER_HIERARCHICALBARRIER_H
@@ -24,6 +24,7 @@
 #include "channel.h"
 #include "compound.h"
 #include "equalizers/dfrEqualizer.h"
+#include "equalizers/dplexEqualizer.h"
 #include "equalizers/framerateEqualizer.h"
 #include "equalizers/loadEqualizer.h"
 #include "equalizers/treeEqualizer.h"
@@ -73,6 +74,7 @@
         static eq::server::DFREqualizer* dfrEqualizer = 0;
         static eq::server::LoadEqualizer* loadEqualizer = 0;
         static eq::server::TreeEqualizer* treeEqualizer = 0;
+        static eq::server::ViewEqualizer* viewEqualizer = 0;
         static eq::server::TileEqualizer* tileEqualizer = 0;
         static eq::server::SwapBarrierPtr swapBarrier;
         static eq::server::Frame*       frame = 0;
@@ -102,6 +104,8 @@
 %token EQTOKEN_GLOBAL
 %token EQTOKEN_CHANNEL_IATTR_HINT_STATISTICS
 %token EQTOKEN_CHANNEL_IATTR_HINT_SENDTOKEN
+%token EQTOKEN_CHANNEL_IATTR_HINT_ACTIVE_PIXELS
+%token EQTOKEN_CHANNEL_IATTR_HINT_PROGRESSIVE
 %token EQTOKEN_CHANNEL_SATTR_DUMP_IMAGE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_MODE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_LEFT_MASK
@@ -113,7 +117,9 @@
 %token EQTOKEN_CONNECTION_IATTR_TYPE
 %token EQTOKEN_CONNECTION_IATTR_PORT
 %token EQTOKEN_CONFIG_FATTR_EYE_BASE
+%token EQTOKEN_CONFIG_FATTR_DEADLINE
 %token EQTOKEN_CONFIG_IATTR_ROBUSTNESS
+%token EQTOKEN_CONFIG_IATTR_TASK_CACHE
 %token EQTOKEN_NODE_SATTR_LAUNCH_COMMAND
 %token EQTOKEN_NODE_CATTR_LAUNCH_COMMAND_QUOTE
 %token EQTOKEN_NODE_IATTR_THREAD_MODEL
@@ -153,6 +159,8 @@
 %token EQTOKEN_HINT_DECORATION
 %token EQTOKEN_HINT_STATISTICS
 %token EQTOKEN_HINT_SENDTOKEN
+%token EQTOKEN_HINT_ACTIVE_PIXELS
+%token EQTOKEN_HINT_PROGRESSIVE
 %token EQTOKEN_HINT_SWAPSYNC
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
@@ -193,7 +201,11 @@
 %token EQTOKEN_COMPOUND
 %token EQTOKEN_LOADBALANCER
 %token EQTOKEN_DFREQUALIZER
+%token EQTOKEN_PREDICTIVE
+%token EQTOKEN_PERCENTILE
+%token EQTOKEN_STEAL
 %token EQTOKEN_FRAMERATEEQUALIZER
+%token EQTOKEN_DPLEXEQUALIZER
 %token EQTOKEN_LOADEQUALIZER
 %token EQTOKEN_TREEEQUALIZER
 %token EQTOKEN_MONITOREQUALIZER
@@ -232,7 +244,10 @@
 %token EQTOKEN_FOCUS_MODE
 %token EQTOKEN_OPENCV_CAMERA
 %token EQTOKEN_VRPN_TRACKER
+%token EQTOKEN_LATE_LATCH
 %token EQTOKEN_ROBUSTNESS
+%token EQTOKEN_TASK_CACHE
+%token EQTOKEN_DEADLINE
 %token EQTOKEN_THREAD_MODEL
 %token EQTOKEN_ASYNC
 %token EQTOKEN_DRAW_SYNC
@@ -272,6 +287,7 @@
 %token EQTOKEN_SWAPBARRIER
 %token EQTOKEN_NVGROUP
 %token EQTOKEN_NVBARRIER
+%token EQTOKEN_HIERARCHICAL
 %token EQTOKEN_OUTPUTFRAME
 %token EQTOKEN_INPUTFRAME
 %token EQTOKEN_OUTPUTTILES
@@ -288,6 +304,7 @@
 %token EQTOKEN_2D
 %token EQTOKEN_ASSEMBLE_ONLY_LIMIT
 %token EQTOKEN_DB
+%token EQTOKEN_HYBRID
 %token EQTOKEN_BOUNDARY
 %token EQTOKEN_RESISTANCE
 %token EQTOKEN_ZOOM
@@ -373,11 +390,21 @@ global:
          eq::server::Global::instance()->setConfigFAttribute(
              eq::server::Config::FATTR_EYE_BASE, $2 );
      }
+     | EQTOKEN_CONFIG_FATTR_DEADLINE FLOAT
+     {
+         eq::server::Global::instance()->setConfigFAttribute(
+             eq::server::Config::FATTR_DEADLINE, $2 );
+     }
      | EQTOKEN_CONFIG_IATTR_ROBUSTNESS IATTR
      {
          eq::server::Global::instance()->setConfigIAttribute(
              eq::server::Config::IATTR_ROBUSTNESS, $2 );
      }
+     | EQTOKEN_CONFIG_IATTR_TASK_CACHE IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_TASK_CACHE, $2 );
+     }
      | EQTOKEN_NODE_SATTR_LAUNCH_COMMAND STRING
      {
          eq::server::Global::instance()->setNodeSAttribute(
@@ -513,6 +540,16 @@ global:
          eq::server::Global::instance()->setChannelIAttribute(
              eq::server::Channel::IATTR_HINT_SENDTOKEN, $2 );
      }
+     | EQTOKEN_CHANNEL_IATTR_HINT_ACTIVE_PIXELS IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_ACTIVE_PIXELS, $2 );
+     }
+     | EQTOKEN_CHANNEL_IATTR_HINT_PROGRESSIVE IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_PROGRESSIVE, $2 );
+     }
      | EQTOKEN_COMPOUND_IATTR_STEREO_MODE IATTR
      {
          eq::server::Global::instance()->setCompoundIAttribute(
@@ -594,6 +631,10 @@ configAttribute:
                              eq::server::Config::FATTR_EYE_BASE, $2 ); }
     | EQTOKEN_ROBUSTNESS IATTR { config->setIAttribute(
                                  eq::server::Config::IATTR_ROBUSTNESS, $2 ); }
+    | EQTOKEN_TASK_CACHE IATTR { config->setIAttribute(
+                                 eq::server::Config::IATTR_TASK_CACHE, $2 ); }
+    | EQTOKEN_DEADLINE FLOAT { config->setFAttribute(
+                               eq::server::Config::FATTR_DEADLINE, $2 ); }
 
 node: appNode | renderNode
 renderNode: EQTOKEN_NODE '{' {
@@ -767,6 +808,12 @@ channelAttribute:
     | EQTOKEN_HINT_SENDTOKEN IATTR
         { channel->setIAttribute( eq::server::Channel::IATTR_HINT_SENDTOKEN,
                                   $2 ); }
+    | EQTOKEN_HINT_ACTIVE_PIXELS IATTR
+        { channel->setIAttribute( eq::server::Channel::IATTR_HINT_ACTIVE_PIXELS,
+                                  $2 ); }
+    | EQTOKEN_HINT_PROGRESSIVE IATTR
+        { channel->setIAttribute( eq::server::Channel::IATTR_HINT_PROGRESSIVE,
+                                  $2 ); }
     | EQTOKEN_DUMP_IMAGE STRING
         { channel->setSAttribute( eq::server::Channel::SATTR_DUMP_IMAGE,
                                   $2 ); }
@@ -805,6 +852,8 @@ observerField:
         { observer->setFocusMode( eq::fabric::FocusMode( $2 )); }
     | EQTOKEN_OPENCV_CAMERA IATTR { observer->setOpenCVCamera( $2 ); }
     | EQTOKEN_VRPN_TRACKER STRING { observer->setVRPNTracker( $2 ); }
+    | EQTOKEN_LATE_LATCH IATTR
+        { observer->setLateLatch( $2 == eq::fabric::ON ); }
 
 layout: EQTOKEN_LAYOUT '{' { layout = new eq::server::Layout( config ); }
             layoutFields '}' { layout = 0; }
@@ -1214,8 +1263,8 @@ loadBalancerMode:
         eqCompound->addEqualizer( new eq::server::MonitorEqualizer );
     }
 
-equalizer: dfrEqualizer | framerateEqualizer | loadEqualizer | treeEqualizer |
-           monitorEqualizer | viewEqualizer | tileEqualizer
+equalizer: dfrEqualizer | framerateEqualizer | dplexEqualizer | loadEqualizer |
+           treeEqualizer | monitorEqualizer | viewEqualizer | tileEqualizer
 
 dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
     { dfrEqualizer = new eq::server::DFREqualizer; }
@@ -1228,6 +1277,10 @@ framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{' '}'
     {
         eqCompound->addEqualizer( new eq::server::FramerateEqualizer );
     }
+dplexEqualizer: EQTOKEN_DPLEXEQUALIZER '{' '}'
+    {
+        eqCompound->addEqualizer( new eq::server::DPlexEqualizer );
+    }
 loadEqualizer: EQTOKEN_LOADEQUALIZER '{'
     { loadEqualizer = new eq::server::LoadEqualizer; }
     loadEqualizerFields '}'
@@ -1246,9 +1299,12 @@ monitorEqualizer: EQTOKEN_MONITOREQUALIZER '{' '}'
     {
         eqCompound->addEqualizer( new eq::server::MonitorEqualizer );
     }
-viewEqualizer: EQTOKEN_VIEWEQUALIZER '{' '}'
+viewEqualizer: EQTOKEN_VIEWEQUALIZER '{'
+    { viewEqualizer = new eq::server::ViewEqualizer; }
+    viewEqualizerFields '}'
     {
-        eqCompound->addEqualizer( new eq::server::ViewEqualizer );
+        eqCompound->addEqualizer( viewEqualizer );
+        viewEqualizer = 0;
     }
 tileEqualizer: EQTOKEN_TILEEQUALIZER
     '{' { tileEqualizer = new eq::server::TileEqualizer; }
@@ -1262,6 +1318,17 @@ dfrEqualizerFields: /* null */ | dfrEqualizerFields dfrEqualizerField
 dfrEqualizerField:
     EQTOKEN_DAMPING FLOAT      { dfrEqualizer->setDamping( $2 ); }
     | EQTOKEN_FRAMERATE FLOAT  { dfrEqualizer->setFrameRate( $2 ); }
+    | EQTOKEN_PREDICTIVE IATTR
+        { dfrEqualizer->setPredictive( $2 == eq::fabric::ON ); }
+    | EQTOKEN_PERCENTILE FLOAT
+        {
+            if( $2 < 0.f || $2 >= 100.f )
+            {
+                yyerror( "DFR equalizer percentile not in [0, 100)" );
+                YYERROR;
+            }
+            dfrEqualizer->setPercentile( $2 );
+        }
 
 loadEqualizerFields: /* null */ | loadEqualizerFields loadEqualizerField
 loadEqualizerField:
@@ -1281,6 +1348,7 @@ loadEqualizerMode:
     | EQTOKEN_DB         { $$ = eq::server::LoadEqualizer::MODE_DB; }
     | EQTOKEN_HORIZONTAL { $$ = eq::server::LoadEqualizer::MODE_HORIZONTAL; }
     | EQTOKEN_VERTICAL   { $$ = eq::server::LoadEqualizer::MODE_VERTICAL; }
+    | EQTOKEN_HYBRID     { $$ = eq::server::LoadEqualizer::MODE_HYBRID; }
 
 treeEqualizerFields: /* null */ | treeEqualizerFields treeEqualizerField
 treeEqualizerField:
@@ -1299,6 +1367,10 @@ treeEqualizerMode:
     | EQTOKEN_HORIZONTAL { $$ = eq::server::TreeEqualizer::MODE_HORIZONTAL; }
     | EQTOKEN_VERTICAL   { $$ = eq::server::TreeEqualizer::MODE_VERTICAL; }
 
+viewEqualizerFields: /* null */ | viewEqualizerFields viewEqualizerField
+viewEqualizerField:
+    EQTOKEN_STEAL IATTR { viewEqualizer->setStealing( $2 == eq::fabric::ON ); }
+
 tileEqualizerFields: /* null */ | tileEqualizerFields tileEqualizerField
 tileEqualizerField:
     EQTOKEN_NAME STRING                   { tileEqualizer->setName( $2 ); }
@@ -1313,6 +1385,8 @@ swapBarrierFields: /*null*/ | swapBarrierFields swapBarrierField
 swapBarrierField: EQTOKEN_NAME STRING { swapBarrier->setName( $2 ); }
     | EQTOKEN_NVGROUP IATTR { swapBarrier->setNVSwapGroup( $2 ); }
     | EQTOKEN_NVBARRIER IATTR { swapBarrier->setNVSwapBarrier( $2 ); }
+    | EQTOKEN_HIERARCHICAL IATTR
+        { swapBarrier->setHierarchical( $2 == eq::fabric::ON ); }
 
 
 
@@ -40,7 +40,8 @@
 #include <lunchbox/clock.h>
 #include <lunchbox/launcher.h>
 #include <lunchbox/os.h>
-#include <lunchbox/sleep.h>
+
+#include <algorithm>
 
 namespace eq
 {
@@ -75,6 +76,8 @@ Node::Node( Config* parent )
     , _bufferedTasks( new co::BufferConnection )
     , _lastDrawPipe( 0 )
 {
+    std::fill( _startupTimes, _startupTimes + STARTUP_ALL, -1 );
+
     const Global* global = Global::instance();
     for( int i=0; i < Node::SATTR_LAST; ++i )
     {
@@ -220,6 +223,9 @@ bool Node::connect()
 {
     LBASSERT( isActive( ));
 
+    if( isStopped( ))
+        std::fill( _startupTimes, _startupTimes + STARTUP_ALL, -1 );
+
     if( _node.isValid( ))
         return _node->isConnected();
 
@@ -243,7 +249,13 @@ bool Node::connect()
     }
 
     LBLOG( LOG_INIT ) << "Connecting node" << std::endl;
-    if( !localNode->connect( _node ) && !launch( ))
+    const bool connected = localNode->connect( _node );
+    setStartupTime( STARTUP_CONNECT );
+    if( connected )
+        setStartupTime( STARTUP_CONNECTED );
+    else if( launch( ))
+        setStartupTime( STARTUP_LAUNCH );
+    else
     {
         LBWARN << "Connection to " << _node->getNodeID() << " failed"
                << std::endl;
@@ -296,20 +308,27 @@ bool Node::syncLaunch( const lunchbox::Clock& clock )
     LBASSERT( localNode.isValid( ));
 
     const int32_t timeOut = getIAttribute( IATTR_LAUNCH_TIMEOUT );
+    ServerPtr server = getServer();
 
     while( true )
     {
+        // read before the check to not miss a connect in between
+        const uint32_t changes = server->getConnectionChanges();
         co::NodePtr node = localNode->getNode( _node->getNodeID( ));
         if( node && node->isConnected( ))
         {
             LBASSERT( _node->getRefCount() == 1 );
             _node = node; // Use co::Node already connected
+            setStartupTime( STARTUP_CONNECTED );
             return true;
         }
 
-        lunchbox::sleep( 100 /*ms*/ );
-        if( timeOut != static_cast<int32_t>(LB_TIMEOUT_INDEFINITE) &&
-            clock.getTime64() > timeOut )
+        uint32_t wait = LB_TIMEOUT_INDEFINITE;
+        if( timeOut != static_cast<int32_t>(LB_TIMEOUT_INDEFINITE) )
+            wait = uint32_t( std::max( int64_t( timeOut ) - clock.getTime64(),
+                                       int64_t( 0 )));
+
+        if( !server->waitConnectionChange( changes, wait ))
         {
             LBASSERT( _node->getRefCount() == 1 );
             _node = 0;
@@ -484,6 +503,7 @@ void Node::configInit( const uint128_t& initID, const uint32_t frameNumber )
 
     LBLOG( LOG_INIT ) << "Init node" << std::endl;
     send( fabric::CMD_NODE_CONFIG_INIT ) << initID << frameNumber;
+    setStartupTime( STARTUP_INIT );
 }
 
 bool Node::syncConfigInit()
@@ -687,6 +707,11 @@ void Node::releaseBarrier( co::Barrier* barrier )
     _barriers.push_back( barrier );
 }
 
+void Node::setStartupTime( const StartupPhase phase )
+{
+    _startupTimes[ phase ] = getServer()->getTime();
+}
+
 void Node::_flushBarriers()
 {
     for( co::BarriersCIter i =_barriers.begin(); i != _barriers.end(); ++i )
@@ -738,6 +763,7 @@ bool Node::_cmdConfigInitReply( co::ICommand& cmd )
     co::ObjectICommand command( cmd );
     LBVERB << "handle configInit reply " << command << std::endl;
     LBASSERT( _state == STATE_INITIALIZING );
+    setStartupTime( STARTUP_RUNNING );
     _state = command.read< uint64_t >() ? STATE_INIT_SUCCESS : STATE_INIT_FAILED;
 
     return true;
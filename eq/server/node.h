@@ -111,6 +111,28 @@ public:
     /** Synchronize the connection of a render slave launch. */
     bool syncLaunch( const lunchbox::Clock& time );
 
+    /** The phases of starting a node. */
+    enum StartupPhase
+    {
+        STARTUP_CONNECT,   //!< Connection attempt finished
+        STARTUP_LAUNCH,    //!< Launch command executed
+        STARTUP_CONNECTED, //!< Node process connected
+        STARTUP_CONFIG,    //!< Config created on the node
+        STARTUP_INIT,      //!< Initialization sent
+        STARTUP_RUNNING,   //!< Initialization finished
+        STARTUP_ALL
+    };
+
+    /**
+     * @return the server time when the given phase of the last start was
+     *         reached, or -1 if it was not reached.
+     */
+    int64_t getStartupTime( const StartupPhase phase ) const
+        { return _startupTimes[ phase ]; }
+
+    /** Record the current server time for the given startup phase. */
+    void setStartupTime( const StartupPhase phase );
+
     /** Start initializing this entity. */
     void configInit( const uint128_t& initID, const uint32_t frameNumber );
 
@@ -278,6 +300,9 @@ private:
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
+    /** The server time of each startup phase. */
+    int64_t _startupTimes[ STARTUP_ALL ];
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -253,7 +253,8 @@ void Pipe::update( const uint128_t& frameID, const uint32_t frameNumber )
     send( fabric::CMD_PIPE_FRAME_START_CLOCK );
 
     send( fabric::CMD_PIPE_FRAME_START )
-            << getVersion() << frameID << frameNumber;
+            << getVersion() << frameID << frameNumber
+            << getConfig()->getFrameDeadline();
     LBLOG( LOG_TASKS ) << "TASK pipe start frame " << frameNumber << " id "
                        << frameID << std::endl;
 
@@ -64,6 +64,7 @@ typedef fabric::Server< co::Node, Server, Config, NodeFactory, co::LocalNode,
 Server::Server()
         : Super( &_nf )
         , _mainThreadQueue( co::Global::getCommandQueueLimit( ))
+        , _connectionChanges( 0 )
         , _running( false )
 {
     lunchbox::Log::setClock( &_clock );
@@ -94,6 +95,18 @@ Server::~Server()
     lunchbox::Log::setClock( 0 );
 }
 
+void Server::notifyConnect( co::NodePtr node )
+{
+    Super::notifyConnect( node );
+    ++_connectionChanges;
+}
+
+void Server::notifyDisconnect( co::NodePtr node )
+{
+    Super::notifyDisconnect( node );
+    ++_connectionChanges;
+}
+
 void Server::init()
 {
     lunchbox::Thread::setName( "Server" );
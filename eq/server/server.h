@@ -27,6 +27,7 @@
 #include <co/commandQueue.h>  // member
 #include <co/localNode.h>     // base class
 #include <lunchbox/clock.h>   // member
+#include <lunchbox/monitor.h> // member
 
 namespace eq
 {
@@ -65,9 +66,29 @@ public:
     /** @return the global time in milliseconds. */
     int64_t getTime() const { return _clock.getTime64(); }
 
+    /** @return the number of node connects and disconnects so far. */
+    uint32_t getConnectionChanges() const { return _connectionChanges.get(); }
+
+    /**
+     * Wait for a node to connect or disconnect.
+     *
+     * @param changes the number of changes already seen.
+     * @param timeout the maximum time to wait in milliseconds.
+     * @return true if a node (dis)connected, false on timeout.
+     */
+    bool waitConnectionChange( const uint32_t changes,
+                               const uint32_t timeout ) const
+        { return _connectionChanges.timedWaitNE( changes, timeout ); }
+
 protected:
     virtual ~Server();
 
+    /** @sa co::LocalNode::notifyConnect() */
+    void notifyConnect( co::NodePtr node ) override;
+
+    /** @sa co::LocalNode::notifyDisconnect() */
+    void notifyDisconnect( co::NodePtr node ) override;
+
 private:
     /** The receiver->main command queue. */
     co::CommandQueue _mainThreadQueue;
@@ -75,6 +96,9 @@ private:
     /** The global clock. */
     lunchbox::Clock _clock;
 
+    /** Incremented on each node connect and disconnect. */
+    lunchbox::Monitor< uint32_t > _connectionChanges;
+
     co::Nodes _admins; //!< connected admin clients
 
     /** The current state. */
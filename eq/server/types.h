@@ -38,10 +38,12 @@ class CompoundVisitor;
 class Config;
 class ConfigVisitor;
 class DFREqualizer;
+class DPlexEqualizer;
 class Equalizer;
 class Frame;
 class FrameData;
 class FramerateEqualizer;
+class HierarchicalBarrier;
 class Layout;
 class LoadEqualizer;
 class MonitorEqualizer;
@@ -108,6 +110,8 @@ typedef Windows::iterator WindowsIter;
 
 typedef lunchbox::RefPtr< Server > ServerPtr;
 typedef lunchbox::RefPtr< const Server > ConstServerPtr;
+typedef lunchbox::RefPtr< HierarchicalBarrier > HierarchicalBarrierPtr;
+typedef std::vector< HierarchicalBarrierPtr > HierarchicalBarriers;
 
 using fabric::DrawableConfig;
 using fabric::Error;
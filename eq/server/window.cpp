@@ -19,6 +19,7 @@
 #include "window.h"
 
 #include "global.h"
+#include "hierarchicalBarrier.h"
 #include "channel.h"
 #include "config.h"
 #include "compound.h"
@@ -207,6 +208,7 @@ void Window::_resetSwapBarriers()
     _nvNetBarrier = 0;
     _masterBarriers.clear();
     _barriers.clear();
+    _hierarchicalBarriers.clear();
 }
 
 co::Barrier* Window::joinSwapBarrier( co::Barrier* barrier )
@@ -262,6 +264,18 @@ co::Barrier* Window::joinSwapBarrier( co::Barrier* barrier )
     return barrier;
 }
 
+void Window::joinHierarchicalSwapBarrier( HierarchicalBarrierPtr barrier )
+{
+    _swapFinish = true;
+    barrier->join( this );
+
+    if( lunchbox::find( _hierarchicalBarriers, barrier ) ==
+        _hierarchicalBarriers.end( ))
+    {
+        _hierarchicalBarriers.push_back( barrier );
+    }
+}
+
 co::Barrier* Window::joinNVSwapBarrier( SwapBarrierConstPtr swapBarrier,
                                         co::Barrier* netBarrier )
 {
@@ -449,6 +463,18 @@ void Window::_updateSwap( const uint32_t frameNumber )
                            << co::ObjectVersion( barrier ) << std::endl;
     }
 
+    BOOST_FOREACH( HierarchicalBarrierPtr barrier, _hierarchicalBarriers )
+    {
+        if( barrier->getHeight() <= 1 || !barrier->isEntering( this ))
+            continue;
+
+        send( fabric::CMD_WINDOW_HIERARCHICAL_BARRIER )
+            << barrier->getID() << barrier->getHeight( getNode( ))
+            << barrier->getNodes();
+        LBLOG( LOG_TASKS ) << "TASK hierarchical barrier " << barrier->getID()
+                           << std::endl;
+    }
+
     if( _nvNetBarrier )
     {
         if( _nvNetBarrier->getHeight() <= 1 )
@@ -119,6 +119,13 @@ namespace server
         co::Barrier* joinNVSwapBarrier( SwapBarrierConstPtr swapBarrier,
                                         co::Barrier* netBarrier );
 
+        /**
+         * Join a hierarchical swap barrier for the next update.
+         *
+         * @param barrier the barrier for the swap barrier group.
+         */
+        void joinHierarchicalSwapBarrier( HierarchicalBarrierPtr barrier );
+
         /** @return true if this window has entered a NV_swap_group. */
         bool hasNVSwapBarrier() const { return (_nvSwapBarrier != 0); }
 
@@ -194,6 +201,9 @@ namespace server
         /** The list of slave swap barriers for the current frame. */
         co::Barriers _barriers;
 
+        /** The list of hierarchical swap barriers for the current frame. */
+        HierarchicalBarriers _hierarchicalBarriers;
+
         /** The hardware swap barrier to use. */
         SwapBarrierConstPtr _nvSwapBarrier;
 
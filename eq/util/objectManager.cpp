@@ -31,6 +31,10 @@
 #include <pression/uploader.h>
 #include <string.h>
 
+#include <list>
+#include <map>
+#include <set>
+
 //#define EQ_OM_TRACE_ALLOCATIONS
 
 namespace eq
@@ -55,6 +59,18 @@ typedef stde::hash_map< const void*, pression::Uploader* > UploaderHash;
 #ifdef EQ_OM_TRACE_ALLOCATIONS
 typedef stde::hash_map< const void*, std::string > UploaderAllocs;
 #endif
+
+typedef ObjectManager::ObjectType ObjectType;
+typedef std::pair< ObjectType, const void* > ObjectKey;
+typedef std::set< ObjectKey > ObjectKeys;
+
+struct SizedObject
+{
+    ObjectKey key;
+    uint64_t size;
+};
+typedef std::list< SizedObject > LRUList; //!< most recently used first
+typedef std::map< ObjectKey, LRUList::iterator > LRUMap;
 }
 
 namespace detail
@@ -63,6 +79,7 @@ class ObjectManager : public lunchbox::Referenced
 {
 public:
     ObjectManager( const GLEWContext* gl )
+        : budget( 0 )
     {
         if( gl )
             memcpy( &glewContext, gl, sizeof( GLEWContext ));
@@ -159,9 +176,105 @@ public:
 #ifdef EQ_OM_TRACE_ALLOCATIONS
     UploaderAllocs eqUploaderAllocs;
 #endif
+
+    /** Mark a sized object as most recently used. */
+    void touch( const ObjectType type, const void* key ) const
+    {
+        if( sized.empty( ))
+            return;
+
+        LRUMap::const_iterator i = sized.find( ObjectKey( type, key ));
+        if( i != sized.end( ))
+            lru.splice( lru.begin(), lru, i->second );
+    }
+
+    /** Count the recreation of an evicted object. */
+    void create( const ObjectType type, const void* key )
+    {
+        if( !evicted.empty() && evicted.erase( ObjectKey( type, key )) > 0 )
+            ++statistics.nRecreations;
+    }
+
+    /** Remove a deleted object from the accounting. */
+    void remove( const ObjectType type, const void* key )
+    {
+        if( sized.empty( ))
+            return;
+
+        LRUMap::iterator i = sized.find( ObjectKey( type, key ));
+        if( i == sized.end( ))
+            return;
+
+        statistics.residentBytes -= i->second->size;
+        lru.erase( i->second );
+        sized.erase( i );
+    }
+
+    void clearAccounting()
+    {
+        lru.clear();
+        sized.clear();
+        evicted.clear();
+        statistics.residentBytes = 0;
+    }
+
+    uint64_t budget;
+    eq::util::ObjectManager::EvictionFunc evictionFunc;
+    eq::util::ObjectManager::MemoryStatistics statistics;
+    mutable LRUList lru;
+    LRUMap sized;
+    ObjectKeys evicted;
 };
 }
 
+namespace
+{
+void _delete( ObjectManager& objectManager, const ObjectKey& key )
+{
+    switch( key.first )
+    {
+      case ObjectManager::OBJECT_LIST:
+          objectManager.deleteList( key.second );
+          break;
+      case ObjectManager::OBJECT_TEXTURE:
+          objectManager.deleteTexture( key.second );
+          break;
+      case ObjectManager::OBJECT_BUFFER:
+          objectManager.deleteBuffer( key.second );
+          break;
+      case ObjectManager::OBJECT_EQ_TEXTURE:
+          objectManager.deleteEqTexture( key.second );
+          break;
+      case ObjectManager::OBJECT_EQ_FRAMEBUFFEROBJECT:
+          objectManager.deleteEqFrameBufferObject( key.second );
+          break;
+      case ObjectManager::OBJECT_EQ_PIXELBUFFEROBJECT:
+          objectManager.deleteEqPixelBufferObject( key.second );
+          break;
+    }
+}
+
+/** Evict least recently used objects until within budget. */
+void _evict( ObjectManager& objectManager, detail::ObjectManager& impl )
+{
+    while( impl.budget > 0 && impl.statistics.residentBytes > impl.budget &&
+           !impl.lru.empty( ))
+    {
+        const ObjectKey key = impl.lru.back().key;
+        LBVERB << "Evict object " << key.second << " of type " << key.first
+               << ", " << impl.statistics.residentBytes << " bytes resident"
+               << std::endl;
+        _delete( objectManager, key );
+        impl.remove( key.first, key.second );
+        impl.evicted.insert( key );
+        ++impl.statistics.nEvictions;
+
+        if( impl.evictionFunc )
+            impl.evictionFunc( key.first, key.second );
+    }
+}
+}
+
 ObjectManager::ObjectManager( const GLEWContext* const glewContext )
     : _impl( new detail::ObjectManager( glewContext ))
 {
@@ -292,6 +405,54 @@ void ObjectManager::deleteAll()
         delete uploader;
     }
     _impl->eqUploaders.clear();
+    _impl->clearAccounting();
+}
+
+void ObjectManager::setObjectSize( const ObjectType type, const void* key,
+                                   const uint64_t bytes )
+{
+    const ObjectKey objectKey( type, key );
+    LRUMap::iterator i = _impl->sized.find( objectKey );
+    if( i == _impl->sized.end( ))
+    {
+        const SizedObject object = { objectKey, 0 };
+        _impl->lru.push_front( object );
+        i = _impl->sized.insert( std::make_pair( objectKey,
+                                                 _impl->lru.begin( ))).first;
+    }
+    else
+        _impl->lru.splice( _impl->lru.begin(), _impl->lru, i->second );
+
+    _impl->statistics.residentBytes += bytes;
+    _impl->statistics.residentBytes -= i->second->size;
+    i->second->size = bytes;
+}
+
+void ObjectManager::setMemoryBudget( const uint64_t bytes )
+{
+    _impl->budget = bytes;
+    _evict( *this, *_impl );
+}
+
+void ObjectManager::evict()
+{
+    _evict( *this, *_impl );
+}
+
+uint64_t ObjectManager::getMemoryBudget() const
+{
+    return _impl->budget;
+}
+
+void ObjectManager::setEvictionFunc( const EvictionFunc& func )
+{
+    _impl->evictionFunc = func;
+}
+
+const ObjectManager::MemoryStatistics&
+ObjectManager::getMemoryStatistics() const
+{
+    return _impl->statistics;
 }
 
 // display list functions
@@ -302,6 +463,7 @@ GLuint ObjectManager::getList( const void* key ) const
     if( i == _impl->lists.end( ))
         return INVALID;
 
+    _impl->touch( OBJECT_LIST, key );
     const Object& object = i->second;
     return object.id;
 }
@@ -321,6 +483,7 @@ GLuint ObjectManager::newList( const void* key, const GLsizei num )
         return INVALID;
     }
 
+    _impl->create( OBJECT_LIST, key );
     Object& object   = _impl->lists[ key ];
     object.id        = id;
     object.num       = num;
@@ -345,6 +508,7 @@ void ObjectManager::deleteList( const void* key )
     const Object& object = i->second;
     glDeleteLists( object.id, object.num );
     _impl->lists.erase( i );
+    _impl->remove( OBJECT_LIST, key );
 }
 
 // texture object functions
@@ -355,6 +519,7 @@ GLuint ObjectManager::getTexture( const void* key ) const
     if( i == _impl->textures.end( ))
         return INVALID;
 
+    _impl->touch( OBJECT_TEXTURE, key );
     const Object& object = i->second;
     return object.id;
 }
@@ -375,6 +540,7 @@ GLuint ObjectManager::newTexture( const void* key )
         return INVALID;
     }
 
+    _impl->create( OBJECT_TEXTURE, key );
     Object& object   = _impl->textures[ key ];
     object.id        = id;
     return id;
@@ -397,6 +563,7 @@ void ObjectManager::deleteTexture( const void* key )
     const Object& object = i->second;
     glDeleteTextures( 1, &object.id );
     _impl->textures.erase( i );
+    _impl->remove( OBJECT_TEXTURE, key );
 }
 
 // buffer object functions
@@ -412,6 +579,7 @@ GLuint ObjectManager::getBuffer( const void* key ) const
     if( i == _impl->buffers.end() )
         return INVALID;
 
+    _impl->touch( OBJECT_BUFFER, key );
     const Object& object = i->second;
     return object.id;
 }
@@ -439,6 +607,7 @@ GLuint ObjectManager::newBuffer( const void* key )
         return INVALID;
     }
 
+    _impl->create( OBJECT_BUFFER, key );
     Object& object     = _impl->buffers[ key ];
     object.id          = id;
     return id;
@@ -461,6 +630,7 @@ void ObjectManager::deleteBuffer( const void* key )
     const Object& object = i->second;
     glDeleteBuffers( 1, &object.id );
     _impl->buffers.erase( i );
+    _impl->remove( OBJECT_BUFFER, key );
 }
 
 // program object functions
@@ -695,6 +865,7 @@ Texture* ObjectManager::getEqTexture( const void* key ) const
     if( i == _impl->eqTextures.end( ))
         return 0;
 
+    _impl->touch( OBJECT_EQ_TEXTURE, key );
     return i->second;
 }
 
@@ -707,6 +878,7 @@ Texture* ObjectManager::newEqTexture( const void* key, const GLenum target )
     }
 
     Texture* texture = new Texture( target, &_impl->glewContext );
+    _impl->create( OBJECT_EQ_TEXTURE, key );
     _impl->eqTextures[ key ] = texture;
     return texture;
 }
@@ -727,6 +899,7 @@ void   ObjectManager::deleteEqTexture( const void* key )
 
     Texture* texture = i->second;
     _impl->eqTextures.erase( i );
+    _impl->remove( OBJECT_EQ_TEXTURE, key );
 
     texture->flush();
     delete texture;
@@ -789,6 +962,7 @@ FrameBufferObject* ObjectManager::getEqFrameBufferObject( const void* key )
     if( i == _impl->eqFrameBufferObjects.end( ))
         return 0;
 
+    _impl->touch( OBJECT_EQ_FRAMEBUFFEROBJECT, key );
     return i->second;
 }
 
@@ -804,6 +978,7 @@ FrameBufferObject* ObjectManager::newEqFrameBufferObject( const void* key )
 
     FrameBufferObject* frameBufferObject =
                                     new FrameBufferObject( &_impl->glewContext );
+    _impl->create( OBJECT_EQ_FRAMEBUFFEROBJECT, key );
     _impl->eqFrameBufferObjects[ key ] = frameBufferObject;
     return frameBufferObject;
 }
@@ -824,6 +999,7 @@ void ObjectManager::deleteEqFrameBufferObject( const void* key )
 
     FrameBufferObject* frameBufferObject = i->second;
     _impl->eqFrameBufferObjects.erase( i );
+    _impl->remove( OBJECT_EQ_FRAMEBUFFEROBJECT, key );
 
     frameBufferObject->exit();
     delete frameBufferObject;
@@ -842,6 +1018,7 @@ PixelBufferObject* ObjectManager::getEqPixelBufferObject( const void* key )
     if( i == _impl->eqPixelBufferObjects.end( ))
         return 0;
 
+    _impl->touch( OBJECT_EQ_PIXELBUFFEROBJECT, key );
     return i->second;
 }
 
@@ -858,6 +1035,7 @@ PixelBufferObject* ObjectManager::newEqPixelBufferObject( const void* key,
 
     PixelBufferObject* pixelBufferObject =
         new PixelBufferObject( &_impl->glewContext, threadSafe );
+    _impl->create( OBJECT_EQ_PIXELBUFFEROBJECT, key );
     _impl->eqPixelBufferObjects[ key ] = pixelBufferObject;
     return pixelBufferObject;
 }
@@ -886,6 +1064,7 @@ void ObjectManager::deleteEqPixelBufferObject( const void* key )
 
     PixelBufferObject* pixelBufferObject = i->second;
     _impl->eqPixelBufferObjects.erase( i );
+    _impl->remove( OBJECT_EQ_PIXELBUFFEROBJECT, key );
 
     pixelBufferObject->destroy();
     delete pixelBufferObject;
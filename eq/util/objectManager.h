@@ -21,6 +21,8 @@
 #include <eq/util/types.h>
 #include <eq/client/api.h>
 
+#include <boost/function.hpp>
+
 namespace eq
 {
 namespace util
@@ -46,6 +48,11 @@ namespace detail { class ObjectManager; }
  * - deleteObject: Delete the object of the given key and all associated
  *   OpenGL data
  *
+ * Optionally, the size of objects can be declared using setObjectSize(). If a
+ * memory budget is set, evict() deletes the least recently used sized objects
+ * when the budget is exceeded. Applications recreate evicted objects on the
+ * next lookup failure, and may be notified using an eviction callback.
+ *
  * @sa http://www.equalizergraphics.com/documents/design/objectManager.html
  */
 class ObjectManager
@@ -79,6 +86,71 @@ public:
      */
     EQ_API void deleteAll();
 
+    /** The object types supporting memory accounting. @version 1.8 */
+    enum ObjectType
+    {
+        OBJECT_LIST,
+        OBJECT_TEXTURE,
+        OBJECT_BUFFER,
+        OBJECT_EQ_TEXTURE,
+        OBJECT_EQ_FRAMEBUFFEROBJECT,
+        OBJECT_EQ_PIXELBUFFEROBJECT
+    };
+
+    /** Called after an object was evicted. @version 1.8 */
+    typedef boost::function< void( ObjectType, const void* ) > EvictionFunc;
+
+    /** The counters of the memory accounting. @version 1.8 */
+    struct MemoryStatistics
+    {
+        MemoryStatistics() : residentBytes( 0 ), nEvictions( 0 )
+                           , nRecreations( 0 ) {}
+
+        uint64_t residentBytes; //!< The size of all sized objects
+        uint64_t nEvictions; //!< Objects deleted to stay within the budget
+        uint64_t nRecreations; //!< Evicted objects which were created again
+    };
+
+    /**
+     * Declare the memory used by an object.
+     *
+     * Only sized objects are accounted and evicted. Lookups of sized objects
+     * mark them as recently used. Does not evict any objects, since objects
+     * set up together may still be in use.
+     * @sa evict()
+     * @version 1.8
+     */
+    EQ_API void setObjectSize( const ObjectType type, const void* key,
+                               const uint64_t bytes );
+
+    /**
+     * Set the memory budget for all sized objects, 0 for unlimited.
+     *
+     * Evicts objects if the new budget is exceeded, which requires a current
+     * GL context.
+     * @version 1.8
+     */
+    EQ_API void setMemoryBudget( const uint64_t bytes );
+
+    /**
+     * Evict the least recently used sized objects until the memory budget is
+     * met.
+     *
+     * Call when no sized object is in use, e.g., at the start of a frame.
+     * Requires a current GL context.
+     * @version 1.8
+     */
+    EQ_API void evict();
+
+    /** @return the memory budget, 0 for unlimited. @version 1.8 */
+    EQ_API uint64_t getMemoryBudget() const;
+
+    /** Set the function called after an object was evicted. @version 1.8 */
+    EQ_API void setEvictionFunc( const EvictionFunc& func );
+
+    /** @return the counters of the memory accounting. @version 1.8 */
+    EQ_API const MemoryStatistics& getMemoryStatistics() const;
+
     EQ_API unsigned getList( const void* key ) const;
     EQ_API unsigned newList( const void* key, const int num = 1 );
     EQ_API unsigned obtainList( const void* key, const int num = 1 );
@@ -0,0 +1,228 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "brickCache.h"
+
+#include <lunchbox/mtQueue.h>
+#include <lunchbox/scopedMutex.h>
+
+#include <fstream>
+
+namespace eVolve
+{
+
+/** Reads queued bricks into the cache. */
+class BrickCache::Prefetcher : public lunchbox::Thread
+{
+public:
+    explicit Prefetcher( BrickCache& cache ) : _cache( cache ) {}
+
+    virtual ~Prefetcher()
+    {
+        _requests.push( LB_UNDEFINED_UINT32 );
+        join();
+    }
+
+    void push( const uint32_t brick ) { _requests.push( brick ); }
+
+protected:
+    virtual void run()
+    {
+        for( ;; )
+        {
+            const uint32_t brick = _requests.pop();
+            if( brick == LB_UNDEFINED_UINT32 )
+                return;
+            _cache._load( brick );
+        }
+    }
+
+private:
+    BrickCache& _cache;
+    lunchbox::MTQueue< uint32_t > _requests;
+};
+
+
+BrickCache::BrickCache( const uint64_t maxSize )
+        : _maxSize( maxSize )
+        , _size( 0 )
+        , _sliceSize( 0 )
+        , _depth( 0 )
+        , _prefetcher( 0 )
+{}
+
+BrickCache::~BrickCache()
+{
+    delete _prefetcher;
+    _prefetcher = 0;
+}
+
+void BrickCache::setVolume( const std::string& filename,
+                            const uint64_t sliceSize, const uint32_t depth )
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    if( filename == _filename && sliceSize == _sliceSize && depth == _depth )
+        return;
+
+    _filename = filename;
+    _sliceSize = sliceSize;
+    _depth = depth;
+
+    _entries.clear();
+    _lru.clear();
+    _size = 0;
+}
+
+uint32_t BrickCache::getNBricks() const
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    return ( _depth + BRICK_DEPTH - 1 ) / BRICK_DEPTH;
+}
+
+BrickCache::BrickPtr BrickCache::get( const uint32_t brick )
+{
+    {
+        lunchbox::ScopedWrite mutex( _lock );
+        Entries::iterator i = _entries.find( brick );
+        if( i != _entries.end( ))
+        {
+            _lru.splice( _lru.begin(), _lru, i->second.lru );
+            return i->second.brick;
+        }
+    }
+
+    // read outside of the lock to not block the other pipes
+    return _insert( brick, _read( brick ));
+}
+
+void BrickCache::prefetch( const uint32_t brick )
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    if( brick >= ( _depth + BRICK_DEPTH - 1 ) / BRICK_DEPTH ||
+        _entries.find( brick ) != _entries.end() ||
+        !_pending.insert( brick ).second )
+    {
+        return;
+    }
+
+    if( !_prefetcher )
+    {
+        _prefetcher = new Prefetcher( *this );
+        _prefetcher->start();
+    }
+    _prefetcher->push( brick );
+}
+
+BrickCache::BrickPtr BrickCache::_read( const uint32_t brick ) const
+{
+    std::string filename;
+    uint64_t sliceSize;
+    uint32_t depth;
+    {
+        lunchbox::ScopedWrite mutex( _lock );
+        filename = _filename;
+        sliceSize = _sliceSize;
+        depth = _depth;
+    }
+
+    const uint32_t start = brick * BRICK_DEPTH;
+    if( start >= depth )
+        return BrickPtr();
+
+    const uint32_t nSlices = LB_MIN( BRICK_DEPTH, depth - start );
+    std::ifstream file( filename.c_str(), std::ifstream::in |
+                        std::ifstream::binary );
+    if( !file.is_open( ))
+    {
+        LBERROR << "Can't open model data file " << filename << std::endl;
+        return BrickPtr();
+    }
+
+    boost::shared_ptr< Brick > data( new Brick( sliceSize * nSlices ));
+    file.seekg( sliceSize * start, std::ios::beg );
+    file.read( reinterpret_cast< char* >( &(*data)[0] ), data->size( ));
+    if( !file )
+    {
+        LBERROR << "Can't read brick " << brick << " from " << filename
+                << std::endl;
+        return BrickPtr();
+    }
+
+    LBLOG( eq::LOG_CUSTOM ) << "read brick " << brick << ", slices " << start
+                            << ".." << start + nSlices - 1 << std::endl;
+    return data;
+}
+
+BrickCache::BrickPtr BrickCache::_insert( const uint32_t brick, BrickPtr data )
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    _pending.erase( brick );
+    if( !data )
+        return data;
+
+    Entries::iterator i = _entries.find( brick );
+    if( i != _entries.end( )) // loaded concurrently by another thread
+    {
+        _lru.splice( _lru.begin(), _lru, i->second.lru );
+        return i->second.brick;
+    }
+
+    // Evict least recently used bricks. Pipes still using an evicted brick
+    // keep their reference until they have uploaded it.
+    while( !_lru.empty() && _size + data->size() > _maxSize )
+    {
+        const uint32_t last = _lru.back();
+        i = _entries.find( last );
+        LBASSERT( i != _entries.end( ));
+        _size -= i->second.brick->size();
+        _entries.erase( i );
+        _lru.pop_back();
+    }
+
+    _lru.push_front( brick );
+    Entry& entry = _entries[ brick ];
+    entry.brick = data;
+    entry.lru = _lru.begin();
+    _size += data->size();
+    return data;
+}
+
+void BrickCache::_load( const uint32_t brick )
+{
+    {
+        lunchbox::ScopedWrite mutex( _lock );
+        if( _entries.find( brick ) != _entries.end( )) // loaded by a pipe
+        {
+            _pending.erase( brick );
+            return;
+        }
+    }
+    _insert( brick, _read( brick ));
+}
+
+}
@@ -0,0 +1,124 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EVOLVE_BRICK_CACHE_H
+#define EVOLVE_BRICK_CACHE_H
+
+#include <eq/eq.h>
+
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <map>
+#include <set>
+
+namespace eVolve
+{
+    /**
+     * Host memory cache of volume bricks, shared by all pipes of a node.
+     *
+     * The volume is split along the depth axis into bricks of BRICK_DEPTH
+     * slices. Bricks are read from the raw data file on demand and kept in an
+     * LRU list up to a maximum size. Bricks adjacent to the range of a pipe
+     * can be prefetched by a background thread, so that small changes of the
+     * DB range only read the new slices from disk.
+     */
+    class BrickCache
+    {
+    public:
+        typedef std::vector< uint8_t > Brick;
+        typedef boost::shared_ptr< const Brick > BrickPtr;
+
+        /** Number of slices per brick. */
+        static const uint32_t BRICK_DEPTH = 16;
+
+        /** Construct a new cache using at most maxSize bytes. */
+        explicit BrickCache( const uint64_t maxSize = 512ull * 1024 * 1024 );
+
+        /** Stop the prefetch thread and free all bricks. */
+        ~BrickCache();
+
+        /**
+         * Set the volume file and its layout.
+         *
+         * All pipes of a node load the same volume, repeated calls with the
+         * same parameters keep the cached bricks.
+         *
+         * @param filename the raw volume data file.
+         * @param sliceSize the size of one slice in bytes.
+         * @param depth the number of slices of the volume.
+         */
+        void setVolume( const std::string& filename, const uint64_t sliceSize,
+                        const uint32_t depth );
+
+        /** @return the number of bricks of the volume. */
+        uint32_t getNBricks() const;
+
+        /** @return the size of one slice in bytes. */
+        uint64_t getSliceSize() const { return _sliceSize; }
+
+        /**
+         * Get the given brick, reading it from disk if it is not cached.
+         *
+         * @return the brick data, or an empty pointer on read errors.
+         */
+        BrickPtr get( const uint32_t brick );
+
+        /** Queue the given brick for asynchronous loading, if needed. */
+        void prefetch( const uint32_t brick );
+
+    private:
+        class Prefetcher;
+
+        struct Entry
+        {
+            BrickPtr brick;
+            std::list< uint32_t >::iterator lru;
+        };
+        typedef std::map< uint32_t, Entry > Entries;
+
+        BrickPtr _read( const uint32_t brick ) const;
+        BrickPtr _insert( const uint32_t brick, BrickPtr data );
+        void _load( const uint32_t brick );
+
+        const uint64_t _maxSize;
+        uint64_t _size;         //!< bytes of all cached bricks
+
+        std::string _filename;
+        uint64_t _sliceSize;
+        uint32_t _depth;
+
+        Entries _entries;
+        std::list< uint32_t > _lru;     //!< cached bricks, most recent first
+        std::set< uint32_t > _pending;  //!< bricks queued for prefetching
+
+        Prefetcher* _prefetcher;
+        mutable lunchbox::Lock _lock;
+    };
+}
+
+#endif // EVOLVE_BRICK_CACHE_H
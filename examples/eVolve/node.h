@@ -29,6 +29,7 @@
 #ifndef EVOLVE_NODE_H
 #define EVOLVE_NODE_H
 
+#include "brickCache.h"
 #include "eVolve.h"
 #include "initData.h"
 
@@ -41,10 +42,16 @@ namespace eVolve
     public:
         Node( eq::Config* parent ) : eq::Node( parent ) {}
 
+        /** @return the volume brick cache shared by all pipes. */
+        BrickCache& getBrickCache() { return _bricks; }
+
     protected:
         virtual ~Node(){}
 
         virtual bool configInit( const eq::uint128_t& initID );
+
+    private:
+        BrickCache _bricks;
     };
 }
 
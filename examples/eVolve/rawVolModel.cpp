@@ -29,6 +29,8 @@
 #include "rawVolModel.h"
 #include "hlp.h"
 
+#include <cstring>
+
 namespace eVolve
 {
 
@@ -50,8 +52,11 @@ static bool readDimensionsAndScaling
 
 
 // Read volume dimensions, scaling and transfer function
-RawVolumeModel::RawVolumeModel( const std::string& filename  )
-        : _headerLoaded( false )
+RawVolumeModel::RawVolumeModel( const std::string& filename,
+                                BrickCache& bricks )
+        : _nUsed( 0 )
+        , _bricks( bricks )
+        , _headerLoaded( false )
         , _filename( filename )
         , _preintName  ( 0 )
         , _w( 0 )
@@ -90,6 +95,8 @@ bool RawVolumeModel::loadHeader( const float brightness, const float alpha )
         return false;
 
     _resolution = LB_MAX( _w, LB_MAX( _h, _d ) );
+    const uint64_t sliceSize = uint64_t( _w ) * _h * ( _hasDerivatives ? 4:1 );
+    _bricks.setVolume( _filename, sliceSize, _d );
 
     if( !readTransferFunction( header.f, _TF ))
         return false;
@@ -119,6 +126,9 @@ static int32_t calcHashKey( const eq::Range& range )
     return static_cast<int32_t>(( range.start*10000.f + range.end )*10000.f );
 }
 
+// Textures of recently used ranges, e.g., while the load equalizer converges
+static const size_t maxTextures = 4;
+
 
 bool RawVolumeModel::getVolumeInfo( VolumeInfo& info, const eq::Range& range )
 {
@@ -137,14 +147,20 @@ bool RawVolumeModel::getVolumeInfo( VolumeInfo& info, const eq::Range& range )
     if( _volumeHash.find( key ) == _volumeHash.end( ) )
     {
         // new key
-        volumePart = &_volumeHash[ key ];
-        if( !_createVolumeTexture( volumePart->volume, volumePart->TD, range ))
+        if( _volumeHash.size() >= maxTextures )
+            _releaseOldestTexture();
+
+        VolumePart part;
+        if( !_createVolumeTexture( part.volume, part.TD, range ))
             return false;
+        volumePart = &_volumeHash[ key ];
+        *volumePart = part;
     }
     else
     {   // old key
         volumePart = &_volumeHash[ key ];
     }
+    volumePart->used = ++_nUsed;
 
     info.volume     = volumePart->volume;
     info.TD         = volumePart->TD;
@@ -171,10 +187,30 @@ void RawVolumeModel::releaseVolumeInfo( const eq::Range& range )
     if( _volumeHash.find( key ) == _volumeHash.end() )
         return;
 
+    glDeleteTextures( 1, &_volumeHash[ key ].volume );
     _volumeHash.erase( key );
 }
 
 
+void RawVolumeModel::_releaseOldestTexture()
+{
+    typedef stde::hash_map< int32_t, VolumePart >::iterator VolumeHashIter;
+
+    VolumeHashIter oldest = _volumeHash.begin();
+    for( VolumeHashIter i = _volumeHash.begin(); i != _volumeHash.end(); ++i )
+        if( i->second.used < oldest->second.used )
+            oldest = i;
+
+    if( oldest == _volumeHash.end( ))
+        return;
+
+    LBLOG( eq::LOG_CUSTOM ) << "deleting texture: " << oldest->second.volume
+                            << std::endl;
+    glDeleteTextures( 1, &oldest->second.volume );
+    _volumeHash.erase( oldest );
+}
+
+
 /** Calculates minimal power of 2 which is greater than given number
 */
 static uint32_t calcMinPow2( uint32_t size )
@@ -248,40 +284,8 @@ bool RawVolumeModel::_createVolumeTexture(        GLuint&    volume,
 
     // Reading of requested part of a volume
     std::vector<uint8_t> data( _tW*_tH*_tD*bytes, 0 );
-    const uint32_t  wh4 =   w *   h * bytes;
-    const uint32_t tWH4 = _tW * _tH * bytes;
-
-    std::ifstream file ( _filename.c_str(), std::ifstream::in |
-                         std::ifstream::binary | std::ifstream::ate );
-
-    if( !file.is_open() )
-    {
-        LBERROR << "Can't open model data file";
+    if( !_readVolume( data, start, end ))
         return false;
-    }
-
-    file.seekg( wh4*start, std::ios::beg );
-
-    if( w==_tW && h==_tH ) // width and height are power of 2
-    {
-        file.read( (char*)( &data[0] ), wh4*depth );
-    }
-    else if( w==_tW )     // only width is power of 2
-    {
-        for( uint32_t i=0; i<depth; i++ )
-            file.read( (char*)( &data[i*tWH4] ), wh4 );
-    }
-    else
-    {               // nor width nor heigh is power of 2
-        const uint32_t   w4 =   w * bytes;
-        const uint32_t  tW4 = _tW * bytes;
-
-        for( uint32_t i=0; i<depth; i++ )
-            for( uint32_t j=0; j<h; j++ )
-                file.read( (char*)( &data[ i*tWH4 + j*tW4] ), w4 );
-    }
-
-    file.close();
 
     LBASSERT( _glewContext );
     // create 3D texture
@@ -311,6 +315,54 @@ bool RawVolumeModel::_createVolumeTexture(        GLuint&    volume,
 }
 
 
+/** Copy slices [start,end] from the brick cache into the padded texture data
+    and prefetch the bricks next to them.
+*/
+bool RawVolumeModel::_readVolume(       std::vector<uint8_t>& data,
+                                  const uint32_t              start,
+                                  const uint32_t              end    )
+{
+    const uint32_t bytes = _hasDerivatives ? 4 : 1;
+    const uint32_t  wh4 =   _w *  _h * bytes;
+    const uint32_t tWH4 =  _tW * _tH * bytes;
+    const uint32_t   w4 =   _w * bytes;
+    const uint32_t  tW4 =  _tW * bytes;
+
+    const uint32_t firstBrick = start / BrickCache::BRICK_DEPTH;
+    const uint32_t lastBrick  = end   / BrickCache::BRICK_DEPTH;
+
+    for( uint32_t i = firstBrick; i <= lastBrick; ++i )
+    {
+        const BrickCache::BrickPtr brick = _bricks.get( i );
+        if( !brick )
+            return false;
+
+        const uint32_t brickStart = i * BrickCache::BRICK_DEPTH;
+        const uint32_t first = LB_MAX( start, brickStart );
+        const uint32_t last  = LB_MIN( end, brickStart +
+                                            BrickCache::BRICK_DEPTH - 1 );
+
+        for( uint32_t s = first; s <= last; ++s )
+        {
+            const uint8_t* src = &(*brick)[ (s - brickStart) * wh4 ];
+                  uint8_t* dst = &data[ (s - start) * tWH4 ];
+
+            if( _w == _tW ) // width is power of 2, rows are contiguous
+                memcpy( dst, src, wh4 );
+            else
+                for( uint32_t j = 0; j < _h; ++j )
+                    memcpy( dst + j*tW4, src + j*w4, w4 );
+        }
+    }
+
+    // small range changes of the load equalizer will need these next
+    if( firstBrick > 0 )
+        _bricks.prefetch( firstBrick - 1 );
+    _bricks.prefetch( lastBrick + 1 );
+    return true;
+}
+
+
 /** Volume always represented as cube [-1,-1,-1]..[1,1,1], so if the model
     is not cube it's proportions should be modified. This function makes
     maximum proportion equal to 1.0 to prevent unnecessary rescaling.
@@ -29,6 +29,8 @@
 #ifndef EVOLVE_RAW_VOL_MODEL_H
 #define EVOLVE_RAW_VOL_MODEL_H
 
+#include "brickCache.h"
+
 #include <eq/eq.h>
 
 namespace eVolve
@@ -79,11 +81,17 @@ namespace eVolve
         DataInTextureDimensions TD; //!< Data dimensions within volume texture
     };
 
-    /** Load model to texture */
+    /**
+     * Load model to texture.
+     *
+     * The 3D textures of the most recently used ranges are kept on the GPU.
+     * The data is assembled from the bricks of the node's brick cache, which
+     * prefetches the bricks adjacent to each new range.
+     */
     class RawVolumeModel
     {
     public:
-        RawVolumeModel( const std::string& filename );
+        RawVolumeModel( const std::string& filename, BrickCache& bricks );
 
         bool loadHeader( const float brightness, const float alpha );
 
@@ -110,13 +118,21 @@ namespace eVolve
         bool _lFailed( char* msg )
             { LBERROR << msg << std::endl; return false; }
 
+        bool _readVolume( std::vector< uint8_t >& data, const uint32_t start,
+                          const uint32_t end );
+        void _releaseOldestTexture();
+
         struct VolumePart
         {
             GLuint                  volume; //!< 3D texture ID
             DataInTextureDimensions TD;     //!< Data dimensions within volume
+            uint32_t                used;   //!< last use, for LRU eviction
         };
 
         stde::hash_map< int32_t, VolumePart > _volumeHash; //!< 3D textures info
+        uint32_t     _nUsed;            //!< number of getVolumeInfo calls
+
+        BrickCache&  _bricks;           //!< node-wide volume data cache
 
         bool         _headerLoaded;     //!< header is loaded successfully
         std::string  _filename;         //!< name of volume data file
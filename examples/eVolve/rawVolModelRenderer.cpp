@@ -37,8 +37,9 @@ namespace eVolve
 
 
 RawVolumeModelRenderer::RawVolumeModelRenderer( const std::string& filename,
+                                                BrickCache&        bricks,
                                                 const uint32_t     precision )
-        : _rawModel(  filename  )
+        : _rawModel(  filename, bricks )
         , _precision( precision )
         , _glewContext( 0 )
         , _ortho( false )
@@ -41,6 +41,7 @@ namespace eVolve
     {
     public:
         RawVolumeModelRenderer( const std::string& filename,
+                                BrickCache&        bricks,
                                 const uint32_t     precision   = 1 );
 
         bool loadHeader( const float brightness, const float alpha )
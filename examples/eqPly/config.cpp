@@ -35,6 +35,7 @@
 
 #include <admin/addWindow.h>
 #include <admin/removeWindow.h>
+#include <lunchbox/omp.h>
 
 namespace eqPly
 {
@@ -127,6 +128,100 @@ static bool _isPlyfile( const std::string& filename )
     }
     return true;
 }
+
+/** Loads a set of models, shared by a bounded number of worker threads. */
+class ModelLoader
+{
+public:
+    ModelLoader( const eq::Strings& filenames, const bool invertFaces )
+        : _filenames( filenames )
+        , _models( filenames.size(), 0 )
+        , _invertFaces( invertFaces )
+        , _next( 0 )
+        , _nDone( 0 )
+    {}
+
+    ~ModelLoader()
+    {
+        for( ModelsCIter i = _models.begin(); i != _models.end(); ++i )
+            delete *i;
+    }
+
+    /** Load models until all files are processed. */
+    void run()
+    {
+        size_t index = 0;
+        while( _nextFile( index ))
+        {
+            const std::string& filename = _filenames[ index ];
+            const lunchbox::Clock clock;
+            Model* model = new Model;
+
+            if( _invertFaces )
+                model->useInvertedFaces();
+
+            // reads the .bin cache or parses the PLY file, builds the kd-tree
+            // and writes the cache for this architecture
+            const bool loaded = model->readFromFile( filename.c_str( ));
+            const float time = clock.getTimef();
+
+            lunchbox::ScopedMutex<> mutex( _lock );
+            ++_nDone;
+            if( loaded )
+            {
+                _models[ index ] = model;
+                LBINFO << "[" << _nDone << "/" << _filenames.size()
+                       << "] Loaded " << filename << " in " << time << " ms"
+                       << std::endl;
+            }
+            else
+            {
+                LBWARN << "[" << _nDone << "/" << _filenames.size()
+                       << "] Can't load model: " << filename << std::endl;
+                delete model;
+            }
+        }
+    }
+
+    /** Move the loaded models, in file order, to the given vector. */
+    void getModels( Models& models )
+    {
+        for( size_t i = 0; i < _models.size(); ++i )
+        {
+            if( _models[i] )
+                models.push_back( _models[i] );
+            _models[i] = 0;
+        }
+    }
+
+    class Worker : public lunchbox::Thread
+    {
+    public:
+        explicit Worker( ModelLoader& loader ) : _loader( loader ) {}
+        virtual void run() { _loader.run(); }
+
+    private:
+        ModelLoader& _loader;
+    };
+
+private:
+    const eq::Strings& _filenames;
+    Models _models;
+    const bool _invertFaces;
+
+    lunchbox::Lock _lock;
+    size_t _next;
+    size_t _nDone;
+
+    bool _nextFile( size_t& index )
+    {
+        lunchbox::ScopedMutex<> mutex( _lock );
+        if( _next >= _filenames.size( ))
+            return false;
+        index = _next++;
+        return true;
+    }
+};
 }
 
 void Config::_loadModels()
@@ -134,6 +229,8 @@ void Config::_loadModels()
     if( !_models.empty( )) // only load on the first config run
         return;
 
+    // collect all model files, recursively searching directories
+    eq::Strings plyFiles;
     eq::Strings filenames = _initData.getFilenames();
     while( !filenames.empty( ))
     {
@@ -141,33 +238,51 @@ void Config::_loadModels()
         filenames.pop_back();
 
         if( _isPlyfile( filename ))
-        {
-            Model* model = new Model;
-
-            if( _initData.useInvertedFaces() )
-                model->useInvertedFaces();
-
-            if( !model->readFromFile( filename.c_str( )))
-            {
-                LBWARN << "Can't load model: " << filename << std::endl;
-                delete model;
-            }
-            else
-                _models.push_back( model );
-        }
+            plyFiles.push_back( filename );
         else
         {
             const std::string basename = lunchbox::getFilename( filename );
             if( basename == "." || basename == ".." )
                 continue;
 
-            // recursively search directories
             const eq::Strings subFiles = lunchbox::searchDirectory( filename,
                                                                     ".*" );
             for(eq::StringsCIter i = subFiles.begin(); i != subFiles.end(); ++i)
                 filenames.push_back( filename + '/' + *i );
         }
     }
+    if( plyFiles.empty( ))
+        return;
+
+    // load models concurrently, the result order matches the file order
+    ModelLoader loader( plyFiles, _initData.useInvertedFaces( ));
+    size_t nThreads = _initData.getNumLoaderThreads();
+    if( nThreads == 0 )
+        nThreads = lunchbox::OMP::getNThreads();
+    nThreads = LB_MAX( size_t( 1 ), LB_MIN( nThreads, plyFiles.size( )));
+
+    const lunchbox::Clock clock;
+    std::vector< ModelLoader::Worker* > workers;
+    for( size_t i = 1; i < nThreads; ++i )
+    {
+        ModelLoader::Worker* worker = new ModelLoader::Worker( loader );
+        if( worker->start( ))
+            workers.push_back( worker );
+        else
+            delete worker;
+    }
+    loader.run(); // use the application thread as well
+
+    for( size_t i = 0; i < workers.size(); ++i )
+    {
+        workers[i]->join();
+        delete workers[i];
+    }
+
+    loader.getModels( _models );
+    LBINFO << "Loaded " << _models.size() << " of " << plyFiles.size()
+           << " models using " << workers.size() + 1 << " threads in "
+           << clock.getTimef() << " ms" << std::endl;
 }
 
 void Config::_registerModels()
@@ -46,6 +46,7 @@ namespace eqPly
 LocalInitData::LocalInitData()
     : _pathFilename("")
     , _maxFrames( 0xffffffffu )
+    , _nLoaderThreads( 0 )
     , _color( true )
     , _isResident( false )
 {
@@ -56,6 +57,7 @@ LocalInitData::LocalInitData()
 const LocalInitData& LocalInitData::operator = ( const LocalInitData& from )
 {
     _maxFrames   = from._maxFrames;
+    _nLoaderThreads = from._nLoaderThreads;
     _color       = from._color;
     _isResident  = from._isResident;
     _filenames    = from._filenames;
@@ -119,6 +121,9 @@ void LocalInitData::parseArguments( const int argc, char** argv )
         ( "numFrames,n",
           po::value<uint32_t>(&_maxFrames)->default_value(0xffffffffu),
           "Maximum number of rendered frames")
+        ( "loaderThreads,l",
+          po::value<uint32_t>(&_nLoaderThreads)->default_value( 0 ),
+          "Number of threads loading models, 0 for one per core" )
         ( "windowSystem,w", po::value<std::string>( &userDefinedWindowSystem ),
           wsHelp.c_str() )
         ( "renderMode,c", po::value<std::string>( &userDefinedRenderMode ),
@@ -51,6 +51,9 @@ namespace eqPly
         bool               useColor()        const { return _color; }
         bool               isResident()      const { return _isResident; }
 
+        /** @return the number of model loading threads, 0 for automatic. */
+        uint32_t getNumLoaderThreads() const { return _nLoaderThreads; }
+
         const std::vector< std::string >& getFilenames() const
             { return _filenames; }
 
@@ -60,6 +63,7 @@ namespace eqPly
         eq::Strings _filenames;
         std::string _pathFilename;
         uint32_t    _maxFrames;
+        uint32_t    _nLoaderThreads;
         bool        _color;
         bool        _isResident;
     };
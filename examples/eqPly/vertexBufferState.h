@@ -67,6 +67,10 @@ public:
     virtual GLuint newBufferObject( const void* key )
         { return _objectManager.newBuffer( key ); }
 
+    virtual void setBufferObjectSize( const void* key, const size_t size )
+        { _objectManager.setObjectSize( eq::util::ObjectManager::OBJECT_BUFFER,
+                                        key, size ); }
+
     virtual GLuint getProgram( const void* key )
         { return _objectManager.getProgram( key ); }
 
@@ -211,6 +211,7 @@ void Window::frameStart( const eq::uint128_t& frameID, const uint32_t frameNumbe
     const FrameData& frameData = pipe->getFrameData();
 
     _state->setRenderMode( frameData.getRenderMode( ));
+    getObjectManager().evict(); // no buffer object is in use between frames
     eq::Window::frameStart( frameID, frameNumber );
 }
 
@@ -49,6 +49,8 @@ extern "C" {
 #define PLY_OKAY    0           /* ply routine worked okay */
 #define PLY_ERROR  -1           /* error in ply routine */
 
+#define PLY_LINE_LENGTH 4096    /* maximum length of a header/ascii line */
+
 /* scalar data types supported by PLY format */
 
 #define PLY_START_TYPE 0
@@ -129,6 +131,8 @@ typedef struct PlyFile {        /* description of PLY file */
   char **obj_info;              /* list of object info items */
   PlyElement *which_elem;       /* which element we're currently writing */
   PlyOtherElems *other_elems;   /* "other" elements from a PLY file */
+  char line[PLY_LINE_LENGTH];      /* current line, split into words */
+  char line_copy[PLY_LINE_LENGTH]; /* unmodified copy of current line */
 } PlyFile;
 
 /* memory allocation */
@@ -139,7 +139,7 @@ PlyProperty *find_property(PlyElement *, const char *, int *);
 void write_scalar_type (FILE *, int);
 
 /* read a line from a file and break it up into separate words */
-char **get_words(FILE *, int *, char **);
+char **get_words(PlyFile *, int *, char **);
 
 /* write an item to a file */
 void write_binary_item(PlyFile *, int, unsigned int, double, int);
@@ -920,7 +920,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
   /* read and parse the file's header */
 
-  words = get_words (plyfile->fp, &nwords, &orig_line);
+  words = get_words (plyfile, &nwords, &orig_line);
   if (!words || !equal_strings (words[0], "ply"))
   {
     free( plyfile );
@@ -968,7 +968,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
     /* free up words space */
     free (words);
 
-    words = get_words (plyfile->fp, &nwords, &orig_line);
+    words = get_words (plyfile, &nwords, &orig_line);
   }
 
 
@@ -1753,7 +1753,7 @@ void ascii_get_element(PlyFile *plyfile, char *elem_ptr)
 
   /* read in the element */
 
-  words = get_words (plyfile->fp, &nwords, &orig_line);
+  words = get_words (plyfile, &nwords, &orig_line);
   if (words == NULL) {
     fprintf (stderr, "ply_get_element: unexpected end of file\n");
     exit (-1);
@@ -1968,8 +1968,11 @@ Get a text line from a file and break it up into words.
 IMPORTANT: The calling routine call "free" on the returned pointer once
 finished with it.
 
+The line buffers are kept in the PlyFile, so that different files can be read
+concurrently from multiple threads.
+
 Entry:
-  fp - file to read from
+  plyfile - file to read from
 
 Exit:
   nwords    - number of words returned
@@ -1977,11 +1980,10 @@ Exit:
   returns a list of words from the line, or NULL if end-of-file
 ******************************************************************************/
 
-char **get_words(FILE *fp, int *nwords, char **orig_line)
+char **get_words(PlyFile *plyfile, int *nwords, char **orig_line)
 {
-#define BIG_STRING 4096
-  static char str[BIG_STRING];
-  static char str_copy[BIG_STRING];
+  char *str = plyfile->line;
+  char *str_copy = plyfile->line_copy;
   char **words;
   int max_words = 10;
   int num_words = 0;
@@ -1989,7 +1991,7 @@ char **get_words(FILE *fp, int *nwords, char **orig_line)
   char *result;
 
   /* read in a line */
-  result = fgets (str, BIG_STRING, fp);
+  result = fgets (str, PLY_LINE_LENGTH, plyfile->fp);
   if (result == NULL) {
     *nwords = 0;
     *orig_line = NULL;
@@ -2002,8 +2004,8 @@ char **get_words(FILE *fp, int *nwords, char **orig_line)
   /* (this guarentees that there will be a space before the */
   /*  null character at the end of the string) */
 
-  str[BIG_STRING-2] = ' ';
-  str[BIG_STRING-1] = '\0';
+  str[PLY_LINE_LENGTH-2] = ' ';
+  str[PLY_LINE_LENGTH-1] = '\0';
 
   for (ptr = str, ptr2 = str_copy; *ptr != '\0'; ptr++, ptr2++) {
     *ptr2 = *ptr;
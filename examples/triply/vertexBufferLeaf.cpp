@@ -240,6 +240,16 @@ void VertexBufferLeaf::setupRendering( VertexBufferState& state,
                         _indexLength * sizeof( ShortIndex ),
                         &_globalData.indices[_indexStart], GL_STATIC_DRAW );
 
+        // declare the sizes once all buffers of this leaf are set up
+        state.setBufferObjectSize( charThis + 0,
+                                   _vertexLength * sizeof( Vertex ));
+        state.setBufferObjectSize( charThis + 1,
+                                   _vertexLength * sizeof( Normal ));
+        if( state.useColors( ))
+            state.setBufferObjectSize( charThis + 2,
+                                       _vertexLength * sizeof( Color ));
+        state.setBufferObjectSize( charThis + 3,
+                                   _indexLength * sizeof( ShortIndex ));
         break;
     }
     case RENDER_MODE_DISPLAY_LIST:
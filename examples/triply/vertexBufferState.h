@@ -72,6 +72,7 @@ public:
     PLYLIB_API virtual GLuint newDisplayList( const void* key ) = 0;
     PLYLIB_API virtual GLuint getBufferObject( const void* key ) = 0;
     PLYLIB_API virtual GLuint newBufferObject( const void* key ) = 0;
+    PLYLIB_API virtual void setBufferObjectSize( const void*, const size_t ) {}
     PLYLIB_API virtual void deleteAll() = 0;
 
     PLYLIB_API const GLEWContext* glewGetContext() const
@@ -0,0 +1,127 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <vector>
+
+// Tests the run-length encoding, packing, serialization and validation of
+// active pixels
+
+int main( int, char** )
+{
+    const eq::PixelViewport pvp( 0, 0, 64, 32 );
+    const size_t area = pvp.getArea();
+
+    // a disc of active pixels on the far plane
+    std::vector< uint32_t > depth( area, 0xffffffffu );
+    std::vector< uint32_t > color( area, 0 );
+    size_t nActive = 0;
+    for( int32_t y = 0; y < pvp.h; ++y )
+        for( int32_t x = 0; x < pvp.w; ++x )
+        {
+            const int32_t dx = x - 32;
+            const int32_t dy = y - 16;
+            if( dx * dx + dy * dy > 100 && x != 5 )
+                continue;
+            depth[ y * pvp.w + x ] = y * pvp.w + x;
+            color[ y * pvp.w + x ] = 0xff000000u | ( y * pvp.w + x );
+            ++nActive;
+        }
+
+    eq::ActivePixels activePixels;
+    TEST( activePixels.isEmpty( ));
+    activePixels.computeDepth( &depth[0], pvp );
+    TEST( !activePixels.isEmpty( ));
+    TEST( activePixels.getWidth() == 64 );
+    TEST( activePixels.getHeight() == 32 );
+    TESTINFO( activePixels.getNumPixels() == nActive,
+              activePixels.getNumPixels() << " != " << nActive );
+    TEST( activePixels.getActiveRatio() < .5f );
+
+    // pack and unpack
+    std::vector< uint32_t > packed( activePixels.getNumPixels( ));
+    activePixels.pack( reinterpret_cast< const uint8_t* >( &color[0] ), 4,
+                       reinterpret_cast< uint8_t* >( &packed[0] ));
+
+    std::vector< uint32_t > unpacked( area, 42 );
+    activePixels.unpack( reinterpret_cast< const uint8_t* >( &packed[0] ), 4,
+                         0, reinterpret_cast< uint8_t* >( &unpacked[0] ));
+    TEST( unpacked == color );
+
+    // color runs match depth runs
+    eq::ActivePixels colorPixels;
+    colorPixels.computeColor( &color[0], pvp );
+    TEST( colorPixels.getNumRuns() == activePixels.getNumRuns( ));
+    TEST( colorPixels.getNumPixels() == activePixels.getNumPixels( ));
+
+    // serialize round trip
+    std::vector< uint8_t > data( activePixels.getSerializedSize( ));
+    activePixels.serialize( &data[0] );
+
+    eq::ActivePixels copy;
+    TEST( copy.deserialize( &data[0], data.size() - 1 ) == 0 );
+    TEST( copy.deserialize( &data[0], data.size( )) == data.size( ));
+    TEST( copy.getWidth() == activePixels.getWidth( ));
+    TEST( copy.getHeight() == activePixels.getHeight( ));
+    TEST( copy.getNumRuns() == activePixels.getNumRuns( ));
+    TEST( copy.getNumPixels() == activePixels.getNumPixels( ));
+    for( uint32_t y = 0; y < copy.getHeight(); ++y )
+    {
+        TEST( copy.getPackedOffset( y ) == activePixels.getPackedOffset( y ));
+        const eq::ActivePixels::Run* i = copy.getRunsBegin( y );
+        const eq::ActivePixels::Run* j = activePixels.getRunsBegin( y );
+        for( ; i != copy.getRunsEnd( y ); ++i, ++j )
+            TEST( i->start == j->start && i->length == j->length );
+    }
+
+    // corrupt runs are rejected: outside of the row, empty, overlapping
+    const size_t runsOffset = data.size() - activePixels.getNumRuns() *
+                                            sizeof( eq::ActivePixels::Run );
+    uint32_t* runs = reinterpret_cast< uint32_t* >( &data[ runsOffset ]);
+    const uint32_t start = runs[0];
+    const uint32_t length = runs[1];
+
+    runs[0] = 60;
+    runs[1] = 5;
+    TEST( copy.deserialize( &data[0], data.size( )) == 0 );
+    TEST( copy.isEmpty( ));
+
+    runs[0] = start;
+    runs[1] = 0;
+    TEST( copy.deserialize( &data[0], data.size( )) == 0 );
+
+    runs[1] = length;
+    TEST( copy.deserialize( &data[0], data.size( )) == data.size( ));
+
+    uint32_t y = 0; // a row with two runs
+    while( activePixels.getRunsEnd( y ) - activePixels.getRunsBegin( y ) < 2 )
+        ++y;
+    const size_t second = activePixels.getRunsBegin( y ) -
+                          activePixels.getRunsBegin( 0 ) + 1;
+    runs[ second * 2 ] = runs[ second * 2 - 2 ];
+    TEST( copy.deserialize( &data[0], data.size( )) == 0 );
+
+    // empty image
+    std::vector< uint32_t > far( area, 0xffffffffu );
+    activePixels.computeDepth( &far[0], pvp );
+    TEST( !activePixels.isEmpty( ));
+    TEST( activePixels.getNumPixels() == 0 );
+    TEST( activePixels.getNumRuns() == 0 );
+    return EXIT_SUCCESS;
+}
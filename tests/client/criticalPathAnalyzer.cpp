@@ -0,0 +1,110 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <sstream>
+
+// Tests the critical path of a synthetic two-source sort-last frame, with an
+// unrelated output finishing last
+
+namespace
+{
+void _add( std::ostream& trace, const uint32_t entity,
+           const eq::Statistic::Type type, const int64_t start,
+           const int64_t end, const char* name, const uint32_t frameData = 0 )
+{
+    eq::CriticalPathAnalyzer::Task task;
+    task.frame = 1;
+    task.entity = entity;
+    task.type = type;
+    task.start = start;
+    task.end = end;
+    task.frameData = frameData;
+    task.name = name;
+    trace << task << std::endl;
+}
+}
+
+int main( int, char** )
+{
+    // source 'fast' draws for 10 ms, source 'slow' for 30 ms, the destination
+    // waits for the output of 'slow' and assembles. 'other' sends a frame to
+    // another destination, which must not release the wait.
+    std::stringstream trace;
+    _add( trace, 1, eq::Statistic::CHANNEL_DRAW, 0, 10, "fast" );
+    _add( trace, 1, eq::Statistic::CHANNEL_READBACK, 10, 12, "fast", 6 );
+    _add( trace, 1, eq::Statistic::CHANNEL_FRAME_TRANSMIT, 12, 15, "fast", 6 );
+    _add( trace, 2, eq::Statistic::CHANNEL_DRAW, 0, 30, "slow" );
+    _add( trace, 2, eq::Statistic::CHANNEL_READBACK, 30, 32, "slow", 7 );
+    _add( trace, 2, eq::Statistic::CHANNEL_FRAME_TRANSMIT, 32, 35, "slow", 7 );
+    _add( trace, 5, eq::Statistic::CHANNEL_DRAW, 0, 33, "other" );
+    _add( trace, 5, eq::Statistic::CHANNEL_FRAME_TRANSMIT, 33, 36, "other", 9 );
+    _add( trace, 3, eq::Statistic::CHANNEL_DRAW, 0, 8, "dest" );
+    _add( trace, 3, eq::Statistic::CHANNEL_ASSEMBLE, 8, 40, "dest" );
+    _add( trace, 3, eq::Statistic::CHANNEL_FRAME_WAIT_READY, 8, 36, "dest",
+          7 );
+    _add( trace, 4, eq::Statistic::WINDOW_SWAP, 40, 41, "window" );
+    trace << "garbage" << std::endl;
+
+    eq::CriticalPathAnalyzer analyzer;
+    TEST( analyzer.read( trace ) == 12 );
+    TEST( analyzer.getFrames().size() == 1 );
+
+    eq::CriticalPathAnalyzer::Analysis analysis;
+    TEST( !analyzer.analyze( 2, analysis ));
+    TEST( analyzer.analyze( 1, analysis ));
+    TESTINFO( analysis.end - analysis.start == 41, analysis );
+
+    // swap <- assemble <- wait <- slow transmit <- slow readback <- slow draw
+    const eq::CriticalPathAnalyzer::Tasks& path = analysis.path;
+    TESTINFO( path.size() == 6, analysis );
+    TESTINFO( path[0].name == "slow" &&
+              path[0].type == eq::Statistic::CHANNEL_DRAW, analysis );
+    TESTINFO( path[2].name == "slow" &&
+              path[2].type == eq::Statistic::CHANNEL_FRAME_TRANSMIT, analysis );
+    TESTINFO( path[3].type == eq::Statistic::CHANNEL_FRAME_WAIT_READY,
+              analysis );
+    TESTINFO( path[5].type == eq::Statistic::WINDOW_SWAP, analysis );
+
+    // destination is busy drawing and assembling, but not while waiting
+    for( size_t i = 0; i < analysis.slacks.size(); ++i )
+    {
+        const eq::CriticalPathAnalyzer::Slack& slack = analysis.slacks[i];
+        if( slack.name == "dest" )
+            TESTINFO( slack.busy == 12 && slack.slack == 29, analysis );
+        if( slack.name == "fast" )
+            TESTINFO( slack.busy == 15, analysis );
+    }
+
+    // live statistics are only collected once enabled
+    eq::Statistic stat = eq::Statistic();
+    stat.type = eq::Statistic::CHANNEL_DRAW;
+    stat.frameNumber = 2;
+    stat.endTime = 10;
+
+    eq::CriticalPathAnalyzer live;
+    TEST( live.getWindow() == 0 );
+    live.add( 1, stat );
+    TEST( live.getFrames().empty( ));
+
+    live.setWindow( 10 );
+    live.add( 1, stat );
+    TEST( live.getFrames().size() == 1 );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the OpenCV head tracker replaying a recorded face video, given by
+// EQ_OPENCV_VIDEO or as cvTracker.avi in the working directory. The tracker
+// has to move the observer, and may not update it more often than the video
+// has frames, i.e., the replay is paced by the frame rate of the video. Skips
+// without a video.
+
+#define EQ_TEST_RUNTIME 300 // seconds
+#include <test.h>
+#include <eq/eq.h>
+#include <lunchbox/clock.h>
+
+#if defined( EQUALIZER_USE_OPENCV ) && defined( EQUALIZER_USE_HWSD )
+#include <opencv2/opencv.hpp>
+#include <fstream>
+
+#ifdef _WIN32
+#  define setenv( name, value, overwrite ) \
+    SetEnvironmentVariable( name, value )
+#endif
+
+namespace
+{
+static const std::string _filename = "cvTracker.eqc";
+static const float _maxRuntime = 10000.f; // ms
+
+static const char* const _config =
+"#Equalizer 1.2 ascii\n"
+"server\n"
+"{\n"
+"    connection { hostname \"127.0.0.1\" }\n"
+"    config\n"
+"    {\n"
+"        appNode\n"
+"        {\n"
+"            pipe { window { viewport [ 0 0 200 200 ]\n"
+"                            attributes { hint_drawable FBO }\n"
+"                            channel { name \"channel\" }}}\n"
+"        }\n"
+"        observer { opencv_camera ON }\n"
+"        layout { view { observer 0 }}\n"
+"        canvas\n"
+"        {\n"
+"            layout 0\n"
+"            wall {}\n"
+"            segment { channel \"channel\" }\n"
+"        }\n"
+"    }\n"
+"}\n";
+
+class Config : public eq::Config
+{
+public:
+    Config( eq::ServerPtr parent ) : eq::Config( parent ), nUpdates( 0 ) {}
+
+    size_t nUpdates;
+
+protected:
+    virtual bool handleEvent( eq::EventICommand command )
+    {
+        if( command.getEventType() == eq::Event::OBSERVER_MOTION )
+            ++nUpdates;
+        return eq::Config::handleEvent( command );
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    virtual eq::Config* createConfig( eq::ServerPtr parent )
+        { return new Config( parent ); }
+};
+}
+
+int main( const int argc, char** argv )
+{
+    const char* env = getenv( "EQ_OPENCV_VIDEO" );
+    const std::string video = env ? env : "cvTracker.avi";
+
+    CvCapture* capture = cvCaptureFromFile( video.c_str( ));
+    if( !capture )
+    {
+        std::cerr << "No tracking video " << video << ", skipping test"
+                  << std::endl;
+        return EXIT_SUCCESS;
+    }
+    const double fps = cvGetCaptureProperty( capture, CV_CAP_PROP_FPS );
+    const double nFrames = cvGetCaptureProperty( capture,
+                                                 CV_CAP_PROP_FRAME_COUNT );
+    cvReleaseCapture( &capture );
+    TESTINFO( fps > 0., video << ": " << fps << " fps" );
+    TESTINFO( nFrames > 0., video << ": " << nFrames << " frames" );
+
+    ::setenv( "EQ_OPENCV_VIDEO", video.c_str(), 1 /*overwrite*/ );
+    {
+        std::ofstream out( _filename.c_str( ));
+        out << _config;
+    }
+    eq::Global::setConfigFile( _filename );
+
+    NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST( client->initLocal( argc, argv ));
+
+    eq::ServerPtr server = new eq::Server;
+    TEST( client->connectServer( server ));
+
+    eq::fabric::ConfigParams configParams;
+    Config* config = static_cast< Config* >(
+        server->chooseConfig( configParams ));
+    TEST( config );
+
+    if( config->init( eq::uint128_t( )))
+    {
+        // replay the whole video, or for the maximum runtime
+        const float duration = LB_MIN( float( nFrames * 1000. / fps ),
+                                       _maxRuntime );
+        lunchbox::Clock clock;
+        while( clock.getTimef() < duration )
+        {
+            config->startFrame( eq::uint128_t( ));
+            config->finishFrame();
+            config->handleEvents();
+        }
+        const float elapsed = clock.getTimef();
+        config->finishAllFrames();
+        config->handleEvents();
+
+        TEST( !config->getObservers().empty( ));
+        const eq::Observer* observer = config->getObservers().front();
+        TESTINFO( config->nUpdates > 0, "no face found in " << video );
+        TEST( observer->getHeadMatrix() != eq::Matrix4f::IDENTITY );
+
+        // at most one update per video frame, plus the one in flight
+        const size_t maxUpdates = size_t( elapsed * fps / 1000.f ) + 2;
+        TESTINFO( config->nUpdates <= maxUpdates,
+                  config->nUpdates << " updates for " << maxUpdates - 2 <<
+                  " frames" );
+        config->exit();
+    }
+    else
+        std::cerr << "Can't run configuration - no GPU available?" << std::endl;
+
+    server->releaseConfig( config );
+    client->disconnectServer( server );
+    client->exitLocal();
+    TESTINFO( client->getRefCount() == 1, client->getRefCount( ));
+    TESTINFO( server->getRefCount() == 1, server->getRefCount( ));
+
+    ::remove( _filename.c_str( ));
+    eq::exit();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main( const int, char** )
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,141 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <lunchbox/sleep.h>
+#include <fstream>
+
+// Tests reading, decoding, priority ordering and upload budget of the
+// DataStreamer
+
+namespace
+{
+static const std::string _filename = "dataStreamer.bin";
+static const size_t _chunkSize = 1024;
+static const size_t _nChunks = 8;
+
+class Streamer : public eq::DataStreamer
+{
+public:
+    Streamer() : eq::DataStreamer( 3 ) {}
+    ~Streamer() { stop(); }
+
+    std::vector< eq::uint128_t > uploaded;
+
+protected:
+    bool decode( const Request& request, lunchbox::Bufferb& data ) override
+    {
+        // chunk i contains the byte value i; decode to one byte per chunk
+        TEST( data.getSize() == _chunkSize );
+        TEST( data[0] == request.id.low( ));
+        TEST( data[ _chunkSize - 1 ] == request.id.low( ));
+        data.resize( 1 );
+        return true;
+    }
+
+    void uploadData( const Request& request,
+                     const lunchbox::Bufferb& data ) override
+    {
+        TEST( data.getSize() == 1 );
+        TEST( data[0] == request.id.low( ));
+        uploaded.push_back( request.id );
+    }
+};
+
+void _waitDecoded( const Streamer& streamer, const size_t nDecoded )
+{
+    for( size_t i = 0; i < 1000; ++i )
+    {
+        if( streamer.getStatistics().nDecoded == nDecoded )
+            return;
+        lunchbox::sleep( 10 );
+    }
+    TESTINFO( false, "Timeout waiting for " << nDecoded << " requests" );
+}
+}
+
+int main( int, char** )
+{
+    {
+        std::ofstream file( _filename.c_str(), std::ios::binary );
+        for( size_t i = 0; i < _nChunks; ++i )
+            for( size_t j = 0; j < _chunkSize; ++j )
+                file.put( char( i ));
+    }
+
+    Streamer streamer;
+    for( size_t i = 0; i < _nChunks; ++i )
+    {
+        eq::DataStreamer::Request request;
+        request.id = eq::uint128_t( 0, i );
+        request.filename = _filename;
+        request.offset = i * _chunkSize;
+        request.size = _chunkSize;
+        request.priority = float( i % 4 ) + float( i ) * .1f;
+        streamer.request( request );
+    }
+
+    _waitDecoded( streamer, _nChunks );
+    TEST( streamer.cancel( eq::uint128_t( 0, 0 )));
+    TEST( !streamer.cancel( eq::uint128_t( 0, 0 )));
+
+    eq::DataStreamer::Statistics stats = streamer.getStatistics();
+    TESTINFO( stats.queueDepth == 0, stats.queueDepth );
+    TESTINFO( stats.nDecoded == _nChunks - 1, stats.nDecoded );
+    TESTINFO( stats.bytesRead == _nChunks * _chunkSize, stats.bytesRead );
+
+    // re-prioritize a decoded request before all others
+    eq::DataStreamer::Request urgent;
+    urgent.id = eq::uint128_t( 0, 4 );
+    urgent.priority = 100.f;
+    streamer.request( urgent );
+    TEST( streamer.getStatistics().nDecoded == _nChunks - 1 );
+
+    // one decoded byte per request: budget of two requests per frame
+    streamer.setUploadBudget( 2, 0.f );
+    const size_t nDecoded = stats.nDecoded;
+    size_t nUploaded = 0;
+    while( nUploaded < nDecoded )
+    {
+        const size_t n = streamer.upload();
+        TESTINFO( n == std::min( size_t( 2 ), nDecoded - nUploaded ), n );
+        nUploaded += n;
+    }
+    TEST( streamer.upload() == 0 );
+    TEST( streamer.uploaded.size() == nDecoded );
+
+    // uploaded in order of priority: 4, 7, 3, 6, 2, 5, 1
+    TEST( streamer.uploaded.front() == urgent.id );
+    for( size_t i = 2; i < streamer.uploaded.size(); ++i )
+    {
+        const size_t prev = streamer.uploaded[ i - 1 ].low();
+        const size_t next = streamer.uploaded[ i ].low();
+        TESTINFO( prev % 4 > next % 4 ||
+                  ( prev % 4 == next % 4 && prev > next ),
+                  prev << " uploaded before " << next );
+    }
+
+    stats = streamer.getStatistics();
+    TEST( stats.nDecoded == 0 );
+    TEST( stats.bytesUploaded == nDecoded );
+    TEST( stats.overruns == 0 );
+
+    ::remove( _filename.c_str( ));
+    return EXIT_SUCCESS;
+}
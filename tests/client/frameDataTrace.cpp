@@ -0,0 +1,138 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+#include <eq/eq.h>
+#include <eq/fabric/frameData.h>
+#include <co/objectVersion.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+// Tests capturing and replaying the frame data of two uncompressed 2D tiles
+
+namespace
+{
+static const std::string _filename = "frameDataTrace.eqft";
+
+std::vector< uint8_t > _newImageData( const eq::PixelViewport& pvp,
+                                      const uint8_t value )
+{
+    const eq::FrameData::ImageHeader header =
+        { EQ_COMPRESSOR_DATATYPE_RGBA, EQ_COMPRESSOR_DATATYPE_RGBA, 4, pvp,
+          EQ_COMPRESSOR_NONE, 0, 1, 1.f };
+    const uint64_t size = pvp.getArea() * 4;
+
+    std::vector< uint8_t > data( sizeof( header ) + sizeof( size ), value );
+    memcpy( &data[0], &header, sizeof( header ));
+    memcpy( &data[ sizeof( header ) ], &size, sizeof( size ));
+    data.resize( data.size() + size, value );
+    return data;
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    const eq::PixelViewport left( 0, 0, 64, 32 );
+    const eq::PixelViewport right( 64, 0, 64, 32 );
+    const std::vector< uint8_t > leftData = _newImageData( left, 1 );
+    const std::vector< uint8_t > rightData = _newImageData( right, 2 );
+    const co::ObjectVersion leftVersion( lunchbox::make_UUID(), 1 );
+    const co::ObjectVersion rightVersion( lunchbox::make_UUID(), 1 );
+
+    eq::fabric::FrameData data;
+    data.buffers = eq::Frame::BUFFER_COLOR;
+    data.range = eq::Range( .25f, .75f );
+    data.period = 2;
+    data.phase = 1;
+    {
+        eq::FrameDataTrace trace;
+        TEST( trace.open( _filename ));
+        for( uint32_t frame = 1; frame < 3; ++frame )
+        {
+            trace.writeImage( rightVersion, frame, right, eq::Zoom::NONE,
+                              eq::Frame::BUFFER_COLOR, false, false,
+                              &rightData[0], rightData.size( ));
+            trace.writeImage( leftVersion, frame, left, eq::Zoom::NONE,
+                              eq::Frame::BUFFER_COLOR, false, false,
+                              &leftData[0], leftData.size( ));
+            trace.writeReady( leftVersion, data );
+            trace.writeReady( rightVersion, data );
+        }
+    }
+
+    eq::FrameDataTrace trace;
+    TESTINFO( trace.read( _filename ) == 4, trace.getFrames().size( ));
+    TEST( trace.getFrames().size() == 2 );
+    TEST( trace.getSize( 1 ) == leftData.size() + rightData.size( ));
+    TEST( trace.getSize( 3 ) == 0 );
+    TEST( trace.receive( 3 ).empty( ));
+
+    for( size_t i = 0; i < 3; ++i ) // replay repeatedly
+    {
+        const eq::Frames& frames = trace.receive( 1 + i % 2 );
+        TEST( frames.size() == 2 );
+        TEST( frames[0]->isReady( ));
+        TEST( frames[1]->isReady( ));
+
+        // frame datas are replayed in the captured order
+        TEST( frames[0]->getImages().size() == 1 );
+        TEST( frames[0]->getImages()[0]->getPixelViewport() == right );
+        TEST( frames[1]->getImages()[0]->getPixelViewport() == left );
+
+        // the ready parameters are restored field by field
+        const eq::FrameDataPtr frameData = frames[0]->getFrameData();
+        TEST( frameData->getRange() == data.range );
+        TEST( frameData->getPeriod() == 2 );
+        TEST( frameData->getPhase() == 1 );
+        TEST( !frameData->isDropped( ));
+
+        const eq::Image* result = eq::Compositor::mergeFramesCPU( frames );
+        TEST( result );
+        TEST( result->getPixelViewport() == eq::PixelViewport( 0, 0, 128, 32 ));
+
+        const uint8_t* pixels =
+            result->getPixelPointer( eq::Frame::BUFFER_COLOR );
+        TEST( pixels[0] == 1 );
+        TEST( pixels[ 128 * 4 - 1 ] == 2 );
+    }
+
+    // traces of another format version are rejected
+    {
+        std::vector< uint8_t > file;
+        {
+            std::ifstream in( _filename.c_str(), std::ios::binary );
+            file.assign( std::istreambuf_iterator< char >( in ),
+                         std::istreambuf_iterator< char >( ));
+        }
+        TEST( file.size() > 8 );
+        ++file[4]; // version
+        std::ofstream out( _filename.c_str(), std::ios::binary );
+        out.write( reinterpret_cast< const char* >( &file[0] ), file.size( ));
+    }
+    TEST( trace.read( _filename ) == 0 );
+    TEST( trace.getFrames().empty( ));
+
+    ::remove( _filename.c_str( ));
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
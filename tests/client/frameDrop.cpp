@@ -0,0 +1,226 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the frame dropping of the deadline mode: a slow source channel misses
+// the deadline, its stale readbacks are dropped and the dropped flag is reset
+// by the next complete readback. Both windows of the swap group skip the swap
+// of exactly the dropped frames, and the newest frame is never dropped.
+
+#define EQ_TEST_RUNTIME 300 // seconds
+#include <test.h>
+#include <eq/eq.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/sleep.h>
+
+#include <fstream>
+
+#ifdef EQUALIZER_USE_HWSD
+#define NFRAMES 10
+
+namespace
+{
+static const std::string _filename = "frameDrop.eqc";
+static const uint32_t _drawTime = 100; // ms, five times the deadline period
+
+// channel1 assembles the output of the slow source channel, channel2 shares
+// the swap barrier without any input
+static const char* const _config =
+"#Equalizer 1.2 ascii\n"
+"server\n"
+"{\n"
+"    connection { hostname \"127.0.0.1\" }\n"
+"    config\n"
+"    {\n"
+"        latency 2\n"
+"        attributes { deadline 20 }\n"
+"        appNode\n"
+"        {\n"
+"            pipe { window { viewport [ 0 0 200 200 ]\n"
+"                            channel { name \"channel1\" }}}\n"
+"            pipe { window { viewport [ 200 0 200 200 ]\n"
+"                            channel { name \"channel2\" }}}\n"
+"            pipe { window { viewport [ 400 0 200 200 ]\n"
+"                            attributes { hint_drawable FBO }\n"
+"                            channel { name \"source\" }}}\n"
+"        }\n"
+"        observer {}\n"
+"        layout { view { observer 0 }}\n"
+"        canvas\n"
+"        {\n"
+"            layout 0\n"
+"            wall {}\n"
+"            segment { channel \"channel1\" viewport [ 0 0 .5 1 ] }\n"
+"            segment { channel \"channel2\" viewport [ .5 0 .5 1 ] }\n"
+"        }\n"
+"        compound\n"
+"        {\n"
+"            compound\n"
+"            {\n"
+"                channel ( segment 0 view 0 )\n"
+"                swapbarrier {}\n"
+"                compound { viewport [ 0 0 1 .5 ] }\n"
+"                compound\n"
+"                {\n"
+"                    channel \"source\"\n"
+"                    viewport [ 0 .5 1 .5 ]\n"
+"                    outputframe { name \"frame.source\" }\n"
+"                }\n"
+"                inputframe { name \"frame.source\" }\n"
+"            }\n"
+"            compound\n"
+"            {\n"
+"                channel ( segment 1 view 0 )\n"
+"                swapbarrier {}\n"
+"            }\n"
+"        }\n"
+"    }\n"
+"}\n";
+
+typedef std::map< uint32_t, bool > Frames; // per frame number
+
+lunchbox::Lock _lock;
+Frames _dropped; // input of channel1 dropped
+std::map< std::string, Frames > _swapped; // per channel name
+
+class Channel : public eq::Channel
+{
+public:
+    Channel( eq::Window* parent ) : eq::Channel( parent ) {}
+
+protected:
+    virtual void frameDraw( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameDraw( frameID );
+        if( getName() == "source" )
+            lunchbox::sleep( _drawTime );
+    }
+
+    virtual void frameAssemble( const eq::uint128_t& frameID,
+                                const eq::Frames& frames )
+    {
+        eq::Channel::frameAssemble( frameID, frames );
+
+        bool dropped = false;
+        for( eq::FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        {
+            TEST( (*i)->isReady( ));
+            dropped |= (*i)->getFrameData()->isDropped();
+        }
+
+        lunchbox::ScopedWrite mutex( _lock );
+        _dropped[ getCurrentFrame() ] = dropped;
+    }
+};
+
+class Window : public eq::Window
+{
+public:
+    Window( eq::Pipe* parent ) : eq::Window( parent ) {}
+
+protected:
+    virtual void swapBuffers()
+    {
+        eq::Window::swapBuffers();
+
+        const eq::Channels& channels = getChannels();
+        lunchbox::ScopedWrite mutex( _lock );
+        _swapped[ channels.front()->getName() ][ getPipe()->getCurrentFrame() ]
+            = true;
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    virtual eq::Window* createWindow( eq::Pipe* parent )
+        { return new Window( parent ); }
+    virtual eq::Channel* createChannel( eq::Window* parent )
+        { return new Channel( parent ); }
+};
+}
+
+int main( const int argc, char** argv )
+{
+    {
+        std::ofstream out( _filename.c_str( ));
+        out << _config;
+    }
+    eq::Global::setConfigFile( _filename );
+
+    NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST( client->initLocal( argc, argv ));
+
+    eq::ServerPtr server = new eq::Server;
+    TEST( client->connectServer( server ));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig( configParams );
+    TEST( config );
+
+    if( config->init( eq::uint128_t( )))
+    {
+        for( uint32_t i = 1; i <= NFRAMES; ++i )
+        {
+            config->startFrame( eq::uint128_t( 0, i ));
+            config->finishFrame();
+        }
+        config->finishAllFrames();
+        config->exit();
+
+        lunchbox::ScopedWrite mutex( _lock );
+        TESTINFO( _dropped.size() == NFRAMES, _dropped.size( ));
+        TESTINFO( !_dropped[ NFRAMES ], "newest frame dropped" );
+
+        size_t nDropped = 0;
+        for( uint32_t i = 1; i <= NFRAMES; ++i )
+        {
+            if( _dropped[ i ] )
+                ++nDropped;
+
+            // the whole swap group skips the dropped frames only
+            TESTINFO( _swapped[ "channel1" ][ i ] == !_dropped[ i ],
+                      "frame " << i );
+            TESTINFO( _swapped[ "channel2" ][ i ] == !_dropped[ i ],
+                      "frame " << i );
+        }
+        TESTINFO( nDropped > 0, "no stale frame in " << NFRAMES << " frames" );
+    }
+    else
+        std::cerr << "Can't run configuration - no GPU available?" << std::endl;
+
+    server->releaseConfig( config );
+    client->disconnectServer( server );
+    client->exitLocal();
+    TESTINFO( client->getRefCount() == 1, client->getRefCount( ));
+    TESTINFO( server->getRefCount() == 1, server->getRefCount( ));
+
+    ::remove( _filename.c_str( ));
+    eq::exit();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main( const int, char** )
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
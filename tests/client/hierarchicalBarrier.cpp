@@ -0,0 +1,160 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the HierarchicalBarrier with multiple local threads on multiple nodes
+// in one process, including late entering nodes and timeouts.
+
+#include <test.h>
+#include <eq/client/hierarchicalBarrier.h>
+
+#include <co/co.h>
+#include <lunchbox/sleep.h>
+#include <lunchbox/thread.h>
+
+namespace
+{
+static const size_t _nNodes = 3; // not a power of two
+static const uint32_t _height = 2;
+static const uint32_t _nBarriers = 20;
+static const uint32_t _timeout = 10000; // ms
+
+struct Node
+{
+    co::LocalNodePtr localNode;
+    eq::HierarchicalBarrier* barrier;
+};
+typedef std::vector< Node > Nodes;
+
+class Thread : public lunchbox::Thread
+{
+public:
+    Thread() : barrier( 0 ), height( _height ), first( 0 ), delay( 0 )
+             , timeout( _timeout ), nSuccess( 0 ) {}
+
+    eq::HierarchicalBarrier* barrier;
+    co::NodeIDs nodes;
+    uint32_t height;
+    uint32_t first;
+    uint32_t delay; //!< ms before the first barrier
+    uint32_t timeout;
+    uint32_t nSuccess;
+
+protected:
+    void run() override
+    {
+        lunchbox::sleep( delay );
+        for( uint32_t i = first; i < first + _nBarriers; ++i )
+            if( barrier->enter( eq::uint128_t( 42, i ), height, nodes,
+                                timeout ))
+            {
+                ++nSuccess;
+            }
+    }
+};
+typedef std::vector< Thread* > Threads;
+
+/** Run _height threads per node, the ones of the last node late. */
+void _run( const Nodes& nodes, const co::NodeIDs& ids, const uint32_t first,
+           const uint32_t delay )
+{
+    Threads threads;
+    for( size_t i = 0; i < nodes.size(); ++i )
+    {
+        for( uint32_t j = 0; j < _height; ++j )
+        {
+            Thread* thread = new Thread;
+            thread->barrier = nodes[i].barrier;
+            thread->nodes = ids;
+            thread->first = first;
+            thread->delay = ( i == nodes.size() - 1 ) ? delay : 0;
+            TEST( thread->start( ));
+            threads.push_back( thread );
+        }
+    }
+
+    for( Threads::const_iterator i = threads.begin(); i != threads.end(); ++i)
+    {
+        TEST( (*i)->join( ));
+        TESTINFO( (*i)->nSuccess == _nBarriers, (*i)->nSuccess );
+        delete *i;
+    }
+}
+}
+
+int main( int argc, char** argv )
+{
+    TEST( co::init( argc, argv ));
+
+    Nodes nodes( _nNodes );
+    co::NodeIDs ids;
+    for( Nodes::iterator i = nodes.begin(); i != nodes.end(); ++i )
+    {
+        co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+        desc->type = co::CONNECTIONTYPE_TCPIP;
+        desc->setHostname( "127.0.0.1" );
+
+        i->localNode = new co::LocalNode;
+        i->localNode->addConnectionDescription( desc );
+        TEST( i->localNode->listen( ));
+        i->barrier = new eq::HierarchicalBarrier( *i->localNode );
+        ids.push_back( i->localNode->getNodeID( ));
+    }
+
+    // connect all peers, the barrier looks them up by identifier
+    for( size_t i = 0; i < _nNodes; ++i )
+    {
+        for( size_t j = i + 1; j < _nNodes; ++j )
+        {
+            co::NodePtr peer = new co::Node;
+            const co::ConnectionDescriptions& descs =
+                nodes[j].localNode->getConnectionDescriptions();
+            for( co::ConnectionDescriptionsCIter k = descs.begin();
+                 k != descs.end(); ++k )
+            {
+                peer->addConnectionDescription( *k );
+            }
+            TEST( nodes[i].localNode->connect( peer ));
+        }
+    }
+
+    _run( nodes, ids, 0, 0 );
+    _run( nodes, ids, _nBarriers, 500 ); // notifications arrive before enter
+
+    // the other nodes are missing, the remaining nodes continue afterwards
+    {
+        Thread thread;
+        thread.barrier = nodes[0].barrier;
+        thread.height = 1;
+        thread.nodes = ids;
+        thread.first = 2 * _nBarriers;
+        thread.timeout = 100;
+        TEST( thread.start( ));
+        TEST( thread.join( ));
+        TEST( thread.nSuccess == 0 );
+    }
+    _run( nodes, ids, 3 * _nBarriers, 0 );
+
+    for( Nodes::iterator i = nodes.begin(); i != nodes.end(); ++i )
+    {
+        delete i->barrier;
+        TEST( i->localNode->close( ));
+        i->localNode = 0;
+    }
+
+    TEST( co::exit( ));
+    return EXIT_SUCCESS;
+}
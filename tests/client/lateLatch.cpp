@@ -0,0 +1,131 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the head prediction of the late latch: linear extrapolation of the
+// position and rotation of the last two samples, the prediction horizon and
+// the degenerate cases without rotation or motion.
+
+#include <test.h>
+#include <eq/eq.h>
+#include <eq/client/detail/lateLatch.h>
+
+#include <cmath>
+
+using eq::detail::LateLatch;
+
+namespace
+{
+static const float _epsilon = 1e-4f;
+
+/** @return a rotation around the Y axis, translated to the given position. */
+eq::Matrix4f _newHead( const float angle, const eq::Vector3f& position )
+{
+    eq::Matrix4f head( eq::Matrix4f::IDENTITY );
+    head.array[0] = std::cos( angle );
+    head.array[2] = -std::sin( angle );
+    head.array[8] = std::sin( angle );
+    head.array[10] = std::cos( angle );
+    head.set_translation( position );
+    return head;
+}
+
+bool _equals( const eq::Matrix4f& a, const eq::Matrix4f& b )
+{
+    for( size_t i = 0; i < 16; ++i )
+        if( std::fabs( a.array[i] - b.array[i] ) > _epsilon )
+            return false;
+    return true;
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    const eq::Vector3f origin( 0.f, 0.f, 0.f );
+    const eq::Vector3f xAxis( 1.f, 0.f, 0.f );
+    {
+        // no sample: no prediction, head unchanged
+        LateLatch latch;
+        eq::Matrix4f head( eq::Matrix4f::IDENTITY );
+        TEST( latch.predict( head, 1000 ) == 0 );
+        TEST( head == eq::Matrix4f::IDENTITY );
+
+        // one sample: no velocity
+        const eq::Matrix4f sample = _newHead( .2f, xAxis );
+        latch.add( sample, 100 );
+        TEST( latch.predict( head, 150 ) == 100 );
+        TESTINFO( _equals( head, sample ), head );
+    }
+    {
+        // translation: .1 per 10 ms
+        LateLatch latch;
+        latch.add( _newHead( 0.f, origin ), 100 );
+        latch.add( _newHead( 0.f, xAxis * .1f ), 110 );
+
+        eq::Matrix4f head;
+        TEST( latch.predict( head, 130 ) == 110 );
+        TESTINFO( _equals( head, _newHead( 0.f, xAxis * .3f )), head );
+
+        // at or before the newest sample
+        TEST( latch.predict( head, 110 ) == 110 );
+        TESTINFO( _equals( head, _newHead( 0.f, xAxis * .1f )), head );
+        TEST( latch.predict( head, 50 ) == 110 );
+        TESTINFO( _equals( head, _newHead( 0.f, xAxis * .1f )), head );
+
+        // clamped to the prediction horizon of 100 ms
+        TEST( latch.predict( head, 5000 ) == 110 );
+        TESTINFO( _equals( head, _newHead( 0.f, xAxis * 1.1f )), head );
+    }
+    {
+        // rotation: .1 radians per 10 ms around Y, with translation
+        LateLatch latch;
+        latch.add( _newHead( .1f, origin ), 100 );
+        latch.add( _newHead( .2f, xAxis * .1f ), 110 );
+
+        eq::Matrix4f head;
+        TEST( latch.predict( head, 130 ) == 110 );
+        TESTINFO( _equals( head, _newHead( .4f, xAxis * .3f )), head );
+
+        TEST( latch.predict( head, 115 ) == 110 );
+        TESTINFO( _equals( head, _newHead( .25f, xAxis * .15f )), head );
+    }
+    {
+        // rotation below the minimum angle: keep the newest rotation
+        LateLatch latch;
+        latch.add( _newHead( .2f, origin ), 100 );
+        latch.add( _newHead( .2f + 5e-5f, origin ), 110 );
+
+        eq::Matrix4f head;
+        TEST( latch.predict( head, 200 ) == 110 );
+        TESTINFO( _equals( head, _newHead( .2f + 5e-5f, origin )), head );
+    }
+    {
+        // samples of the same time: no velocity
+        LateLatch latch;
+        latch.add( _newHead( .1f, origin ), 100 );
+        latch.add( _newHead( .3f, xAxis ), 100 );
+
+        eq::Matrix4f head;
+        TEST( latch.predict( head, 150 ) == 100 );
+        TESTINFO( _equals( head, _newHead( .3f, xAxis )), head );
+    }
+
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
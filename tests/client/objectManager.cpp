@@ -0,0 +1,110 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the memory accounting and LRU eviction of the util::ObjectManager.
+// Uses eq textures, which are created and deleted without a GL context as
+// long as they are not initialized.
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <boost/bind.hpp>
+
+using eq::util::ObjectManager;
+
+namespace
+{
+typedef std::vector< const void* > Keys;
+
+void _onEvict( Keys& evicted, const ObjectManager::ObjectType type,
+               const void* key )
+{
+    TEST( type == ObjectManager::OBJECT_EQ_TEXTURE );
+    evicted.push_back( key );
+}
+}
+
+int main( int, char** )
+{
+    const char keys[4] = { 0 };
+    const void* a = &keys[0];
+    const void* b = &keys[1];
+    const void* c = &keys[2];
+    const void* d = &keys[3];
+
+    ObjectManager om( 0 );
+    Keys evicted;
+    om.setEvictionFunc( boost::bind( &_onEvict, boost::ref( evicted ),
+                                     _1, _2 ));
+    const ObjectManager::MemoryStatistics& stats = om.getMemoryStatistics();
+
+    const void* const initial[] = { a, b, c };
+    for( size_t i = 0; i < 3; ++i )
+    {
+        TEST( om.newEqTexture( initial[i], GL_TEXTURE_2D ));
+        om.setObjectSize( ObjectManager::OBJECT_EQ_TEXTURE, initial[i], 100 );
+    }
+    TESTINFO( stats.residentBytes == 300, stats.residentBytes );
+    TEST( om.getMemoryBudget() == 0 );
+
+    // a new budget evicts the least recently used object immediately
+    om.setMemoryBudget( 250 );
+    TEST( om.getMemoryBudget() == 250 );
+    TESTINFO( stats.residentBytes == 200, stats.residentBytes );
+    TEST( stats.nEvictions == 1 );
+    TEST( evicted.size() == 1 && evicted[0] == a );
+    TEST( !om.getEqTexture( a ));
+
+    // lookups mark as used, sizing does not evict until evict()
+    TEST( om.getEqTexture( b ));
+    TEST( om.newEqTexture( d, GL_TEXTURE_2D ));
+    om.setObjectSize( ObjectManager::OBJECT_EQ_TEXTURE, d, 100 );
+    TESTINFO( stats.residentBytes == 300, stats.residentBytes );
+    TEST( stats.nEvictions == 1 );
+
+    om.evict();
+    TESTINFO( stats.residentBytes == 200, stats.residentBytes );
+    TEST( stats.nEvictions == 2 );
+    TEST( evicted.size() == 2 && evicted[1] == c );
+    TEST( om.getEqTexture( b ));
+    TEST( om.getEqTexture( d ));
+
+    // within budget: nothing to evict
+    om.evict();
+    TEST( stats.nEvictions == 2 );
+
+    // recreation of an evicted object, resizing and unsized objects
+    TEST( om.newEqTexture( a, GL_TEXTURE_2D ));
+    TEST( stats.nRecreations == 1 );
+    TESTINFO( stats.residentBytes == 200, stats.residentBytes );
+
+    om.setObjectSize( ObjectManager::OBJECT_EQ_TEXTURE, b, 50 );
+    TESTINFO( stats.residentBytes == 150, stats.residentBytes );
+
+    // deleted objects leave the accounting
+    om.deleteEqTexture( b );
+    TESTINFO( stats.residentBytes == 100, stats.residentBytes );
+    om.setMemoryBudget( 50 );
+    TEST( stats.nEvictions == 3 );
+    TEST( evicted.size() == 3 && evicted[2] == d );
+    TEST( om.getEqTexture( a )); // unsized objects are never evicted
+    TESTINFO( stats.residentBytes == 0, stats.residentBytes );
+
+    om.deleteAll();
+    TEST( stats.residentBytes == 0 );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the image zoom of progressive output frames: reduced readbacks carry
+// the upscale zoom for the destination, and the full-resolution readbacks of
+// the following frames reuse the cached images without any zoom.
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <algorithm>
+
+namespace
+{
+// What Channel::_finishProgressive does with the images of a reduced readback
+void _readbackProgressive( eq::FrameData& frameData, const float scale )
+{
+    eq::Image* image = frameData.newImage( eq::Frame::TYPE_MEMORY,
+                                           eq::DrawableConfig( ));
+    image->setZoom( eq::Zoom( 1.f / scale, 1.f / scale ));
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+    {
+        eq::FrameData frameData;
+        frameData.setBuffers( eq::Frame::BUFFER_COLOR );
+
+        // interaction: two reduced images
+        _readbackProgressive( frameData, .5f );
+        _readbackProgressive( frameData, .25f );
+        const eq::Images progressive = frameData.getImages();
+        TEST( progressive.size() == 2 );
+        TESTINFO( progressive[0]->getZoom() == eq::Zoom( 2.f, 2.f ),
+                  progressive[0]->getZoom( ));
+        TESTINFO( progressive[1]->getZoom() == eq::Zoom( 4.f, 4.f ),
+                  progressive[1]->getZoom( ));
+
+        // still: the next frame reads back at full resolution into the
+        // recycled images
+        frameData.clear();
+        for( size_t i = 0; i < progressive.size(); ++i )
+        {
+            const eq::Image* image =
+                frameData.newImage( eq::Frame::TYPE_MEMORY,
+                                    eq::DrawableConfig( ));
+            TEST( std::find( progressive.begin(), progressive.end(),
+                             image ) != progressive.end( ));
+            TESTINFO( image->getZoom() == eq::Zoom::NONE, image->getZoom( ));
+        }
+
+        // interaction resumes after the full-resolution frame
+        frameData.clear();
+        _readbackProgressive( frameData, .5f );
+        TEST( frameData.getImages().size() == 1 );
+        TEST( frameData.getImages().front()->getZoom() ==
+              eq::Zoom( 2.f, 2.f ));
+
+        frameData.clear();
+        const eq::Image* image = frameData.newImage( eq::Frame::TYPE_MEMORY,
+                                                     eq::DrawableConfig( ));
+        TESTINFO( image->getZoom() == eq::Zoom::NONE, image->getZoom( ));
+    }
+    {
+        // reset restores the default zoom of a standalone image
+        eq::Image image;
+        image.setZoom( eq::Zoom( 2.f, 2.f ));
+        image.reset();
+        TEST( image.getZoom() == eq::Zoom::NONE );
+    }
+
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
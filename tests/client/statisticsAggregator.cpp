@@ -0,0 +1,130 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+#include <eq/eq.h>
+
+#include <sstream>
+
+// Tests the rolling window and the histogram percentiles of the
+// StatisticsAggregator
+
+namespace
+{
+void _addFrames( eq::StatisticsAggregator& aggregator, eq::Statistic& stat )
+{
+    // frames 1..100, draw time equals frame number
+    for( uint32_t i = 1; i <= 100; ++i )
+    {
+        stat.frameNumber = i;
+        stat.startTime = 1000 * i;
+        stat.endTime = stat.startTime + i;
+        aggregator.add( 42, stat );
+    }
+}
+}
+
+int main( int, char** )
+{
+    eq::Statistic stat;
+    stat.type = eq::Statistic::CHANNEL_DRAW;
+    strcpy( stat.resourceName, "channel" );
+
+    eq::StatisticsAggregator::Summary summary;
+    {
+        eq::StatisticsAggregator aggregator( 100 );
+        _addFrames( aggregator, stat );
+
+        TEST( aggregator.getSummary( 42, eq::Statistic::CHANNEL_DRAW,
+                                     summary ));
+        TESTINFO( summary.count == 100, summary );
+        TESTINFO( summary.min == 1.f && summary.max == 100.f, summary );
+        TESTINFO( summary.mean == 50.5f, summary );
+        TESTINFO( summary.p50 > 49.f && summary.p50 < 52.f, summary );
+        TESTINFO( summary.p95 > 94.f && summary.p95 < 97.f, summary );
+        TESTINFO( summary.p99 >= 98.f && summary.p99 <= 100.f, summary );
+        TEST( !aggregator.getSummary( 42, eq::Statistic::CHANNEL_READBACK,
+                                      summary ));
+    }
+
+    eq::StatisticsAggregator aggregator( 10 );
+    _addFrames( aggregator, stat );
+
+    // only keep frames 91..100
+    aggregator.obsolete( 100 );
+    TEST( aggregator.getSummary( 42, eq::Statistic::CHANNEL_DRAW, summary ));
+    TESTINFO( summary.count == 10, summary );
+    TESTINFO( summary.min == 91.f && summary.max == 100.f, summary );
+    TESTINFO( summary.mean == 95.5f, summary );
+    TESTINFO( summary.p50 >= 91.f && summary.p50 <= 100.f, summary );
+    TEST( summary.name == "channel" );
+
+    // samples of frames before the window are ignored
+    stat.frameNumber = 50;
+    aggregator.add( 42, stat );
+    TEST( aggregator.getSummary( 42, eq::Statistic::CHANNEL_DRAW, summary ));
+    TESTINFO( summary.count == 10, summary );
+
+    const eq::StatisticsAggregator::Summaries summaries =
+        aggregator.getSummaries();
+    TEST( summaries.size() == 1 );
+
+    std::ostringstream csv;
+    eq::StatisticsAggregator::writeCSV( csv, summaries );
+    TEST( csv.str().find( "42,channel," ) != std::string::npos );
+
+    std::ostringstream json;
+    eq::StatisticsAggregator::writeJSON( json, summaries );
+    TEST( json.str().find( "\"p95\": " ) != std::string::npos );
+
+    // names are escaped in CSV and JSON
+    stat.frameNumber = 100;
+    strcpy( stat.resourceName, "a \"b\", c" );
+    aggregator.add( 43, stat );
+    const eq::StatisticsAggregator::Summaries named =
+        aggregator.getSummaries();
+    TEST( named.size() == 2 );
+
+    csv.str( "" );
+    eq::StatisticsAggregator::writeCSV( csv, named );
+    TESTINFO( csv.str().find( "43,\"a \"\"b\"\", c\"," ) != std::string::npos,
+              csv.str( ));
+    json.str( "" );
+    eq::StatisticsAggregator::writeJSON( json, named );
+    TESTINFO( json.str().find( "\"a \\\"b\\\", c\"" ) != std::string::npos,
+              json.str( ));
+
+    // setting the window clears all series, which count any number of
+    // samples in constant memory
+    aggregator.setWindow( 1 );
+    TEST( aggregator.getSummaries().empty( ));
+    strcpy( stat.resourceName, "channel" );
+    stat.startTime = 0;
+    for( uint32_t i = 0; i < 10000; ++i )
+    {
+        stat.endTime = i % 100;
+        aggregator.add( 44, stat );
+    }
+    TEST( aggregator.getSummary( 44, eq::Statistic::CHANNEL_DRAW, summary ));
+    TESTINFO( summary.count == 10000, summary );
+    TESTINFO( summary.min == 0.f && summary.max == 99.f, summary );
+    TESTINFO( summary.p50 > 48.f && summary.p50 < 52.f, summary );
+
+    aggregator.setWindow( 0 );
+    TEST( aggregator.getSummaries().empty( ));
+    return EXIT_SUCCESS;
+}
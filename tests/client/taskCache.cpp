@@ -0,0 +1,256 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that the task cache replays the same channel tasks in the same order,
+// with the current frame identifier, as the uncached task stream. The observer
+// moves in the middle of the run, which invalidates the cache.
+
+#define EQ_TEST_RUNTIME 300 // seconds
+#include <test.h>
+#include <eq/eq.h>
+#include <eq/server/global.h>
+#include <lunchbox/scopedMutex.h>
+
+#ifdef _WIN32
+#  define setenv( name, value, overwrite ) \
+    SetEnvironmentVariable( name, value )
+#endif
+
+#ifdef EQUALIZER_USE_HWSD
+#define NFRAMES 10
+#define MOVEFRAME 5
+
+namespace
+{
+typedef std::vector< std::string > Tasks;
+struct Frame
+{
+    Tasks tasks;
+    std::vector< eq::Matrix4f > heads;
+};
+typedef std::map< uint32_t, Frame > Log; // per frame number
+typedef std::map< const eq::Channel*, Log > Logs;
+typedef std::vector< Log > ChannelLogs; // in config order
+
+lunchbox::Lock _lock;
+Logs _logs;
+std::map< uint32_t, eq::uint128_t > _frameIDs;
+lunchbox::a_int32_t _wrongFrameIDs;
+
+void _log( const eq::Channel* channel, const std::string& task,
+           const eq::uint128_t& frameID, const uint32_t frameNumber )
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    if( _frameIDs[ frameNumber ] != frameID )
+        ++_wrongFrameIDs;
+    _logs[ channel ][ frameNumber ].tasks.push_back( task );
+}
+
+class Channel : public eq::Channel
+{
+public:
+    Channel( eq::Window* parent ) : eq::Channel( parent ) {}
+
+protected:
+    virtual void frameClear( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameClear( frameID );
+        _log( this, "clear", frameID, getCurrentFrame( ));
+    }
+
+    virtual void frameDraw( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameDraw( frameID );
+        _log( this, "draw", frameID, getCurrentFrame( ));
+
+        lunchbox::ScopedWrite mutex( _lock );
+        _logs[ this ][ getCurrentFrame() ].heads.push_back(
+            getHeadTransform( ));
+    }
+
+    virtual void frameDrawFinish( const eq::uint128_t& frameID,
+                                  const uint32_t frameNumber )
+    {
+        eq::Channel::frameDrawFinish( frameID, frameNumber );
+        _log( this, "draw finish", frameID, frameNumber );
+    }
+
+    virtual void frameViewStart( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameViewStart( frameID );
+        _log( this, "view start", frameID, getCurrentFrame( ));
+    }
+
+    virtual void frameViewFinish( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameViewFinish( frameID );
+        _log( this, "view finish", frameID, getCurrentFrame( ));
+    }
+};
+
+class Window : public eq::Window
+{
+public:
+    Window( eq::Pipe* parent ) : eq::Window( parent ) {}
+
+protected:
+    virtual void frameDrawFinish( const eq::uint128_t& frameID,
+                                  const uint32_t frameNumber )
+    {
+        eq::Window::frameDrawFinish( frameID, frameNumber );
+
+        const eq::Channels& channels = getChannels();
+        for( eq::ChannelsCIter i = channels.begin(); i != channels.end(); ++i )
+            _log( *i, "window draw finish", frameID, frameNumber );
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    virtual eq::Window* createWindow( eq::Pipe* parent )
+        { return new Window( parent ); }
+    virtual eq::Channel* createChannel( eq::Window* parent )
+        { return new Channel( parent ); }
+};
+
+/** @return the logs of all local channels in config order. */
+ChannelLogs _getLogs( const eq::Config* config )
+{
+    ChannelLogs logs;
+    lunchbox::ScopedWrite mutex( _lock );
+
+    const eq::Nodes& nodes = config->getNodes();
+    for( eq::NodesCIter i = nodes.begin(); i != nodes.end(); ++i )
+    {
+        const eq::Pipes& pipes = (*i)->getPipes();
+        for( eq::PipesCIter j = pipes.begin(); j != pipes.end(); ++j )
+        {
+            const eq::Windows& windows = (*j)->getWindows();
+            for( eq::WindowsCIter k = windows.begin(); k != windows.end(); ++k)
+            {
+                const eq::Channels& channels = (*k)->getChannels();
+                for( eq::ChannelsCIter l = channels.begin();
+                     l != channels.end(); ++l )
+                {
+                    logs.push_back( _logs[ *l ] );
+                }
+            }
+        }
+    }
+    _logs.clear();
+    return logs;
+}
+
+/** Run a config, moving the observer after MOVEFRAME frames. */
+bool _run( eq::ServerPtr server, const bool taskCache, ChannelLogs& logs )
+{
+    eq::server::Global::instance()->setConfigIAttribute(
+        eq::server::Config::IATTR_TASK_CACHE, taskCache ? eq::ON : eq::OFF );
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig( configParams );
+    if( !config ) // Autoconfig failed, likely because there are no GPUs
+        return false;
+
+    TEST( config->init( co::uint128_t( )));
+    for( uint32_t i = 1; i <= NFRAMES; ++i )
+    {
+        if( i == MOVEFRAME && !config->getObservers().empty( ))
+        {
+            eq::Matrix4f head( eq::Matrix4f::IDENTITY );
+            head.set_translation( eq::Vector3f( .1f, 0.f, .5f ));
+            config->getObservers().front()->setHeadMatrix( head );
+        }
+
+        // unique identifiers across both runs
+        const eq::uint128_t frameID( taskCache ? 1 : 2, i );
+        {
+            lunchbox::ScopedWrite mutex( _lock );
+            _frameIDs[ config->getCurrentFrame() + 1 ] = frameID;
+        }
+        config->startFrame( frameID );
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+    logs = _getLogs( config );
+
+    config->exit();
+    server->releaseConfig( config );
+    return true;
+}
+}
+
+int main( const int argc, char** argv )
+{
+#ifndef Darwin
+    ::setenv( "EQ_WINDOW_IATTR_HINT_DRAWABLE", "-12" /*FBO*/, 1 /*overwrite*/ );
+#endif
+    NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST( client->initLocal( argc, argv ));
+
+    eq::ServerPtr server = new eq::Server;
+    TEST( client->connectServer( server ));
+
+    ChannelLogs uncached;
+    ChannelLogs cached;
+    if( _run( server, false, uncached ) && _run( server, true, cached ))
+    {
+        TESTINFO( _wrongFrameIDs == 0, _wrongFrameIDs );
+        TEST( !cached.empty( ));
+        TEST( cached.size() == uncached.size( ));
+
+        for( size_t i = 0; i < cached.size(); ++i )
+        {
+            const Log& expected = uncached[i];
+            const Log& log = cached[i];
+            TESTINFO( log.size() == expected.size(), "channel " << i );
+
+            for( Log::const_iterator j = log.begin(); j != log.end(); ++j )
+            {
+                const Log::const_iterator k = expected.find( j->first );
+                TESTINFO( k != expected.end(), "frame " << j->first );
+
+                const Frame& frame = j->second;
+                TESTINFO( frame.tasks == k->second.tasks,
+                          "channel " << i << " frame " << j->first );
+                TESTINFO( frame.heads == k->second.heads,
+                          "channel " << i << " frame " << j->first );
+            }
+        }
+    }
+
+    client->disconnectServer( server );
+    client->exitLocal();
+    TESTINFO( client->getRefCount() == 1, client->getRefCount( ));
+    TESTINFO( server->getRefCount() == 1, server->getRefCount( ));
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main( const int, char** )
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,248 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the task order of cross-view tile stealing: the tiles a channel steals
+// for the other view are issued after its own tasks, and draw finish follows
+// the last tile task of the channel. Without stealing, the tree order is kept.
+
+#define EQ_TEST_RUNTIME 300 // seconds
+#include <test.h>
+#include <eq/eq.h>
+#include <lunchbox/scopedMutex.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#  define setenv( name, value, overwrite ) \
+    SetEnvironmentVariable( name, value )
+#endif
+
+#ifdef EQUALIZER_USE_HWSD
+#define NFRAMES 20
+
+namespace
+{
+static const std::string _stealConfig = "configs/2-window.wall.steal.eqc";
+static const std::string _noStealConfig = "tileSteal.off.eqc";
+
+typedef std::vector< std::string > Tasks;
+typedef std::map< uint32_t, Tasks > Log; // per frame number
+typedef std::map< std::string, Log > Logs; // per channel name
+
+lunchbox::Lock _lock;
+Logs _logs;
+
+void _log( const eq::Channel* channel, const std::string& task,
+           const uint32_t frameNumber )
+{
+    lunchbox::ScopedWrite mutex( _lock );
+    _logs[ channel->getName() ][ frameNumber ].push_back( task );
+}
+
+class Channel : public eq::Channel
+{
+public:
+    Channel( eq::Window* parent ) : eq::Channel( parent ) {}
+
+protected:
+    virtual void frameDraw( const eq::uint128_t& frameID )
+    {
+        eq::Channel::frameDraw( frameID );
+        _log( this, "draw", getCurrentFrame( ));
+    }
+
+    virtual void frameDrawFinish( const eq::uint128_t& frameID,
+                                  const uint32_t frameNumber )
+    {
+        eq::Channel::frameDrawFinish( frameID, frameNumber );
+        _log( this, "draw finish", frameNumber );
+    }
+
+    virtual void frameAssemble( const eq::uint128_t& frameID,
+                                const eq::Frames& frames )
+    {
+        eq::Channel::frameAssemble( frameID, frames );
+        _log( this, "assemble", getCurrentFrame( ));
+    }
+
+    virtual void frameReadback( const eq::uint128_t& frameID,
+                                const eq::Frames& frames )
+    {
+        eq::Channel::frameReadback( frameID, frames );
+        _log( this, "readback", getCurrentFrame( ));
+    }
+
+    virtual void frameTilesStart( const eq::uint128_t& )
+        { _log( this, "tiles start", getCurrentFrame( )); }
+
+    virtual void frameTilesFinish( const eq::uint128_t& )
+        { _log( this, "tiles finish", getCurrentFrame( )); }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    virtual eq::Channel* createChannel( eq::Window* parent )
+        { return new Channel( parent ); }
+};
+
+/** Write the steal config with stealing turned off. */
+void _writeNoStealConfig()
+{
+    std::ifstream in( _stealConfig.c_str( ));
+    TESTINFO( in.is_open(), _stealConfig );
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string config = buffer.str();
+
+    const std::string steal = "steal ON";
+    const size_t pos = config.find( steal );
+    TEST( pos != std::string::npos );
+    config.replace( pos, steal.length(), "steal OFF" );
+
+    std::ofstream out( _noStealConfig.c_str( ));
+    out << config;
+}
+
+/** @return false if the config can't be initialized, e.g., without GPUs. */
+bool _run( eq::ClientPtr client, const std::string& filename, Logs& logs )
+{
+    eq::Global::setConfigFile( filename );
+    eq::ServerPtr server = new eq::Server;
+    TEST( client->connectServer( server ));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig( configParams );
+    if( !config )
+    {
+        client->disconnectServer( server );
+        return false;
+    }
+
+    if( !config->init( eq::uint128_t( )))
+    {
+        server->releaseConfig( config );
+        client->disconnectServer( server );
+        return false;
+    }
+
+    for( uint32_t i = 1; i <= NFRAMES; ++i )
+    {
+        config->startFrame( eq::uint128_t( 0, i ));
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+    {
+        lunchbox::ScopedWrite mutex( _lock );
+        logs.swap( _logs );
+        _logs.clear();
+    }
+
+    config->exit();
+    server->releaseConfig( config );
+    client->disconnectServer( server );
+    return true;
+}
+
+/**
+ * Check the draw finish placement of all frames.
+ * @return the number of frames of the given channel with tiles read back for
+ *         the other view after its own assembly.
+ */
+size_t _check( const Logs& logs, const std::string& channel )
+{
+    TESTINFO( logs.size() == 2, logs.size( ));
+    size_t nStolen = 0;
+
+    for( Logs::const_iterator i = logs.begin(); i != logs.end(); ++i )
+    {
+        const Log& log = i->second;
+        TESTINFO( log.size() >= NFRAMES, i->first << ": " << log.size( ));
+
+        for( Log::const_iterator j = log.begin(); j != log.end(); ++j )
+        {
+            const Tasks& tasks = j->second;
+            std::ostringstream where;
+            where << i->first << " frame " << j->first;
+            TESTINFO( std::count( tasks.begin(), tasks.end(),
+                                  "draw finish" ) == 1, where.str( ));
+
+            const Tasks::const_iterator drawFinish =
+                std::find( tasks.begin(), tasks.end(), "draw finish" );
+            TESTINFO( std::find( drawFinish, tasks.end(), "tiles start" ) ==
+                      tasks.end(), where.str( ));
+            TESTINFO( std::find( drawFinish, tasks.end(), "draw" ) ==
+                      tasks.end(), where.str( ));
+
+            if( i->first != channel )
+                continue;
+
+            const Tasks::const_iterator assemble =
+                std::find( tasks.begin(), tasks.end(), "assemble" );
+            if( std::find( assemble, tasks.end(), "readback" ) != tasks.end( ))
+                ++nStolen;
+        }
+    }
+    return nStolen;
+}
+}
+
+int main( const int argc, char** argv )
+{
+#ifndef Darwin
+    ::setenv( "EQ_WINDOW_IATTR_HINT_DRAWABLE", "-12" /*FBO*/, 1 /*overwrite*/ );
+#endif
+    NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST( client->initLocal( argc, argv ));
+    _writeNoStealConfig();
+
+    // channel2 renders the tiles of the first view before its own view in tree
+    // order, unless they are deferred by stealing
+    Logs logs;
+    if( _run( client, _noStealConfig, logs ))
+    {
+        TESTINFO( _check( logs, "channel2" ) == 0, "tree order without steal" );
+
+        TEST( _run( client, _stealConfig, logs ));
+        const size_t nStolen = _check( logs, "channel2" );
+        TESTINFO( nStolen > 0, "no stolen tiles in " << NFRAMES << " frames" );
+    }
+    else
+        std::cerr << "Can't run configuration - no GPU available?" << std::endl;
+
+    ::remove( _noStealConfig.c_str( ));
+    client->exitLocal();
+    TESTINFO( client->getRefCount() == 1, client->getRefCount( ));
+
+    eq::exit();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main( const int, char** )
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,197 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+
+#include <eq/client/compositor.h>
+#include <eq/client/frame.h>
+#include <eq/client/frameData.h>
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/pixelData.h>
+#include <eq/fabric/drawableConfig.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+// Tests the CPU compositing of pixel and sub-pixel decompositions. The input
+// images are sampled from a reference image the same way as the readback of
+// the source channels, so de-interleaving them has to reproduce the reference.
+
+namespace
+{
+eq::Frame* _newFrame( const eq::Image& reference, const eq::Pixel& pixel,
+                      const eq::SubPixel& subpixel, const uint8_t* pixels )
+{
+    const eq::PixelViewport& refPVP = reference.getPixelViewport();
+    const size_t pixelSize = reference.getPixelSize( eq::Frame::BUFFER_COLOR );
+
+    eq::PixelViewport pvp = refPVP;
+    pvp.apply( pixel );
+
+    std::vector< uint8_t > samples( pvp.getArea() * pixelSize, 0 );
+    for( int32_t y = 0; y < pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < pvp.w; ++x )
+        {
+            const int32_t refX = x * pixel.w + pixel.x;
+            const int32_t refY = y * pixel.h + pixel.y;
+            if( refX >= refPVP.w || refY >= refPVP.h )
+                continue;
+
+            memcpy( &samples[ ( y * pvp.w + x ) * pixelSize ],
+                    pixels + ( refY * refPVP.w + refX ) * pixelSize,
+                    pixelSize );
+        }
+    }
+
+    eq::FrameDataPtr frameData = new eq::FrameData;
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR );
+    frameData->setPixel( pixel );
+    frameData->setSubPixel( subpixel );
+
+    eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                            eq::DrawableConfig( ));
+    image->setPixelViewport( pvp );
+    image->setAlphaUsage( reference.getAlphaUsage( ));
+
+    eq::PixelData data;
+    data.internalFormat = reference.getInternalFormat( eq::Frame::BUFFER_COLOR);
+    data.externalFormat = reference.getExternalFormat( eq::Frame::BUFFER_COLOR);
+    data.pixelSize = uint32_t( pixelSize );
+    data.pvp = pvp;
+    data.pixels = &samples[0];
+    image->setPixelData( eq::Frame::BUFFER_COLOR, data );
+
+    eq::Frame* frame = new eq::Frame;
+    frame->setFrameData( frameData );
+    return frame;
+}
+
+void _clear( eq::Frames& frames )
+{
+    for( eq::FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        delete *i;
+    frames.clear();
+}
+
+void _compare( const eq::Image* result, const eq::Image& reference,
+               const uint8_t* expected, const std::string& name )
+{
+    TESTINFO( result, name );
+    const eq::PixelViewport& refPVP = reference.getPixelViewport();
+    const eq::PixelViewport& pvp = result->getPixelViewport();
+    const size_t pixelSize = reference.getPixelSize( eq::Frame::BUFFER_COLOR );
+    TESTINFO( pvp.x == refPVP.x && pvp.y == refPVP.y &&
+              pvp.w >= refPVP.w && pvp.h >= refPVP.h, name << " " << pvp );
+
+    const uint8_t* pixels = result->getPixelPointer( eq::Frame::BUFFER_COLOR );
+    for( int32_t y = 0; y < refPVP.h; ++y )
+        TESTINFO( memcmp( pixels + y * pvp.w * pixelSize,
+                          expected + y * refPVP.w * pixelSize,
+                          refPVP.w * pixelSize ) == 0, name << " row " << y );
+
+    result->writeImages( "Result_" + name );
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    eq::Image reference;
+    TEST( reference.readImage( "images/teapot.rgb", eq::Frame::BUFFER_COLOR ));
+    const uint8_t* pixels =
+        reference.getPixelPointer( eq::Frame::BUFFER_COLOR );
+    const eq::PixelViewport& pvp = reference.getPixelViewport();
+    const size_t pixelSize = reference.getPixelSize( eq::Frame::BUFFER_COLOR );
+    const size_t size = pvp.getArea() * pixelSize;
+
+    // 1) pixel decompositions, including sizes which don't divide the image
+    const eq::Pixel kernels[] = { eq::Pixel( 0, 0, 2, 1 ),
+                                  eq::Pixel( 0, 0, 1, 3 ),
+                                  eq::Pixel( 0, 0, 2, 2 ),
+                                  eq::Pixel( 0, 0, 3, 5 ) };
+    eq::Frames frames;
+    for( size_t i = 0; i < sizeof( kernels ) / sizeof( eq::Pixel ); ++i )
+    {
+        const eq::Pixel& kernel = kernels[i];
+        for( uint32_t y = 0; y < kernel.h; ++y )
+            for( uint32_t x = 0; x < kernel.w; ++x )
+                frames.push_back( _newFrame( reference,
+                                             eq::Pixel( x, y, kernel.w,
+                                                        kernel.h ),
+                                             eq::SubPixel::ALL, pixels ));
+
+        std::ostringstream name;
+        name << "Pixel" << kernel.w << "x" << kernel.h;
+        _compare( eq::Compositor::mergeFramesCPU( frames ), reference, pixels,
+                  name.str( ));
+        _clear( frames );
+    }
+
+    // 2) sub-pixel decomposition, using images shifted by one pixel as jitter
+    const uint32_t nSteps = 4;
+    std::vector< uint8_t > sum( size, 0 );
+    std::vector< std::vector< uint8_t > > steps( nSteps );
+    for( uint32_t i = 0; i < nSteps; ++i )
+    {
+        std::vector< uint8_t >& step = steps[i];
+        step.resize( size );
+        for( int32_t y = 0; y < pvp.h; ++y )
+        {
+            for( int32_t x = 0; x < pvp.w; ++x )
+            {
+                const int32_t fromX = std::min( x + int32_t( i % 2 ), pvp.w-1 );
+                const int32_t fromY = std::min( y + int32_t( i / 2 ), pvp.h-1 );
+                memcpy( &step[ ( y * pvp.w + x ) * pixelSize ],
+                        pixels + ( fromY * pvp.w + fromX ) * pixelSize,
+                        pixelSize );
+            }
+        }
+        frames.push_back( _newFrame( reference, eq::Pixel::ALL,
+                                     eq::SubPixel( i, nSteps ), &step[0] ));
+    }
+
+    std::vector< uint8_t > expected( size );
+    for( size_t i = 0; i < size; ++i )
+    {
+        float value = 0.f;
+        for( uint32_t j = 0; j < nSteps; ++j )
+            value += steps[j][i];
+        expected[i] = uint8_t( value * ( 1.f / float( nSteps )) + .5f );
+    }
+    _compare( eq::Compositor::mergeFramesCPU( frames ), reference,
+              &expected[0], "SubPixel" );
+    _clear( frames );
+
+    // 3) sub-pixel steps of pixel decompositions
+    for( uint32_t i = 0; i < nSteps; ++i )
+        for( uint32_t x = 0; x < 2; ++x )
+            frames.push_back( _newFrame( reference, eq::Pixel( x, 0, 2, 1 ),
+                                         eq::SubPixel( i, nSteps ),
+                                         &steps[i][0] ));
+    _compare( eq::Compositor::mergeFramesCPU( frames ), reference,
+              &expected[0], "PixelSubPixel" );
+    _clear( frames );
+
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
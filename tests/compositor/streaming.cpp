@@ -0,0 +1,201 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+
+#include <eq/client/compositor.h>
+#include <eq/client/frame.h>
+#include <eq/client/frameData.h>
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/pixelData.h>
+#include <eq/fabric/drawableConfig.h>
+#include <lunchbox/rng.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+
+// Compares the streaming CPU compositing, which merges one frame after another
+// as they become ready, against the CPU compositing of all frames at once.
+
+namespace
+{
+static const eq::PixelViewport _destPVP( 0, 0, 640, 400 );
+static const size_t _nFrames = 4;
+
+// the clear values of the streaming merge buffers
+static const uint32_t _opaqueBlack = 0xff000000u; // RGBA bytes 0, 0, 0, 255
+static const uint32_t _far = 0xffffffffu;
+
+class Frames
+{
+public:
+    Frames( const uint32_t buffers )
+    {
+        for( size_t i = 0; i < _nFrames; ++i )
+        {
+            eq::Frame* frame = new eq::Frame;
+            eq::FrameDataPtr frameData = new eq::FrameData;
+            frameData->setBuffers( buffers );
+            frame->setFrameData( frameData );
+            frames.push_back( frame );
+        }
+    }
+
+    ~Frames()
+    {
+        for( eq::FramesCIter i = frames.begin(); i != frames.end(); ++i )
+        {
+            (*i)->getFrameData()->clear();
+            delete *i;
+        }
+    }
+
+    void addImage( const size_t index, const eq::PixelViewport& pvp,
+                   const bool depth, const bool alpha, lunchbox::RNG& rng )
+    {
+        std::vector< uint32_t > color( pvp.getArea( ));
+        std::vector< uint32_t > depthValues( pvp.getArea( ));
+        for( size_t i = 0; i < color.size(); ++i )
+        {
+            color[i] = rng.get< uint32_t >();
+            if( !alpha )
+                color[i] |= 0xff000000u;
+            // a quarter of the pixels on the far plane
+            depthValues[i] = ( i % 4 ) == 0 ? _far : rng.get< uint32_t >();
+        }
+
+        eq::FrameDataPtr frameData = frames[ index ]->getFrameData();
+        eq::Image* image = frameData->newImage( eq::Frame::TYPE_MEMORY,
+                                                eq::DrawableConfig( ));
+        image->setPixelViewport( pvp );
+        image->setAlphaUsage( alpha );
+
+        eq::PixelData data;
+        data.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        data.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        data.pixelSize = 4;
+        data.pvp = pvp;
+        data.pixels = &color[0];
+        image->setPixelData( eq::Frame::BUFFER_COLOR, data );
+
+        if( !depth )
+            return;
+
+        data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+        data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+        data.pixels = &depthValues[0];
+        image->setPixelData( eq::Frame::BUFFER_DEPTH, data );
+    }
+
+    eq::Frames frames;
+};
+
+/** Merge with the streaming compositor and compare against mergeFramesCPU */
+void _compare( const std::string& name, const eq::Frames& frames,
+               const bool blendAlpha, const bool depth )
+{
+    const size_t area = _destPVP.getArea();
+    std::vector< uint32_t > color( area, blendAlpha ? _opaqueBlack : 0 );
+    std::vector< uint32_t > depthValues( area, _far );
+    eq::PixelViewport pvp;
+    TESTINFO( eq::Compositor::mergeFramesCPU( frames, blendAlpha, &color[0],
+                                              area * 4, &depthValues[0],
+                                              area * 4, pvp ), name );
+
+    const eq::Image* result =
+        eq::Compositor::mergeFramesCPUStreaming( frames, _destPVP,
+                                                 blendAlpha );
+    TESTINFO( result, name );
+    TESTINFO( result->getPixelViewport() == pvp,
+              name << ": " << result->getPixelViewport() << " != " << pvp );
+
+    const uint32_t* resultColor = reinterpret_cast< const uint32_t* >(
+        result->getPixelPointer( eq::Frame::BUFFER_COLOR ));
+    TESTINFO( std::equal( resultColor, resultColor + pvp.getArea(),
+                          color.begin( )), name );
+    if( !depth )
+        return;
+
+    TESTINFO( result->hasPixelData( eq::Frame::BUFFER_DEPTH ), name );
+    const uint32_t* resultDepth = reinterpret_cast< const uint32_t* >(
+        result->getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+    TESTINFO( std::equal( resultDepth, resultDepth + pvp.getArea(),
+                          depthValues.begin( )), name );
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+    lunchbox::RNG rng;
+
+    // DB: full-size images with depth, merged in any order
+    {
+        Frames frames( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+        for( size_t i = 0; i < _nFrames; ++i )
+            frames.addImage( i, _destPVP, true, false, rng );
+        _compare( "DB", frames.frames, false, true );
+
+        eq::Frames reversed( frames.frames.rbegin(), frames.frames.rend( ));
+        _compare( "DB reversed", reversed, false, true );
+    }
+
+    // DB: regions of interest of different sizes, some frames empty
+    {
+        Frames frames( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+        for( int32_t i = 0; i < 6; ++i )
+            frames.addImage( i % 3, eq::PixelViewport( 20 + i * 67, 10 + i * 41,
+                                                       200, 150 ),
+                             true, false, rng );
+        _compare( "DB ROI", frames.frames, false, true );
+    }
+
+    // 2D: depth-sorted tiles distributed over the frames
+    {
+        Frames frames( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+        size_t index = 0;
+        for( int32_t y = 0; y < _destPVP.h; y += 100 )
+            for( int32_t x = 0; x < _destPVP.w; x += 160 )
+                frames.addImage( index++ % _nFrames,
+                                 eq::PixelViewport( x, y, 160, 100 ), true,
+                                 false, rng );
+        _compare( "2D", frames.frames, false, true );
+    }
+
+    // blending: full-size images with alpha, merged in order
+    {
+        Frames frames( eq::Frame::BUFFER_COLOR );
+        for( size_t i = 0; i < _nFrames; ++i )
+            frames.addImage( i, _destPVP, false, true, rng );
+        _compare( "blend", frames.frames, true, false );
+    }
+
+    // color-only images without blending are not merged on the CPU
+    {
+        Frames frames( eq::Frame::BUFFER_COLOR );
+        for( size_t i = 0; i < _nFrames; ++i )
+            frames.addImage( i, _destPVP, false, false, rng );
+        TEST( !eq::Compositor::mergeFramesCPUStreaming( frames.frames,
+                                                        _destPVP ));
+    }
+
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <test.h>
+
+#include <eq/client/compositor.h>
+#include <eq/client/frame.h>
+#include <eq/client/frameData.h>
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/pixelData.h>
+#include <eq/fabric/drawableConfig.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/rng.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstdlib>
+
+// Compares the tiled CPU compositing against the per-image compositing for
+// synthetic 2D tiles, DB images and blended images.
+
+namespace
+{
+static const eq::PixelViewport _destPVP( 0, 0, 1920, 1200 );
+static const size_t _nLoops = 10;
+
+void _addImage( eq::FrameData& frameData, const eq::PixelViewport& pvp,
+                const bool depth, const bool alpha, lunchbox::RNG& rng )
+{
+    std::vector< uint32_t > color( pvp.getArea( ));
+    std::vector< uint32_t > depthValues( pvp.getArea( ));
+    for( size_t i = 0; i < color.size(); ++i )
+    {
+        color[i] = rng.get< uint32_t >();
+        if( !alpha )
+            color[i] |= 0xff000000u;
+        // a quarter of the pixels on the far plane
+        depthValues[i] = ( i % 4 ) == 0 ? 0xffffffffu : rng.get< uint32_t >();
+    }
+
+    eq::Image* image = frameData.newImage( eq::Frame::TYPE_MEMORY,
+                                           eq::DrawableConfig( ));
+    image->setPixelViewport( pvp );
+    image->setAlphaUsage( alpha );
+
+    eq::PixelData data;
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    data.pixelSize = 4;
+    data.pvp = pvp;
+    data.pixels = &color[0];
+    image->setPixelData( eq::Frame::BUFFER_COLOR, data );
+
+    if( !depth )
+        return;
+
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    data.pixels = &depthValues[0];
+    image->setPixelData( eq::Frame::BUFFER_DEPTH, data );
+}
+
+struct Result
+{
+    std::vector< uint32_t > color;
+    std::vector< uint32_t > depth;
+    float time;
+};
+
+Result _merge( const eq::Frames& frames, const bool blendAlpha,
+               const bool tiled )
+{
+    if( tiled )
+        unsetenv( "EQ_COMPOSITOR_UNTILED" );
+    else
+        setenv( "EQ_COMPOSITOR_UNTILED", "1", 1 );
+
+    Result result;
+    result.time = 0.f;
+    const size_t area = _destPVP.getArea();
+    lunchbox::Clock clock;
+
+    for( size_t i = 0; i < _nLoops; ++i )
+    {
+        result.color.assign( area, 0 );
+        result.depth.assign( area, 0xffffffffu );
+
+        eq::PixelViewport pvp;
+        clock.reset();
+        TEST( eq::Compositor::mergeFramesCPU( frames, blendAlpha,
+                                              &result.color[0], area * 4,
+                                              &result.depth[0], area * 4,
+                                              pvp ));
+        result.time += clock.getTimef();
+        TESTINFO( pvp == _destPVP, pvp );
+    }
+    result.time /= float( _nLoops );
+    return result;
+}
+
+void _compare( const std::string& name, const eq::Frames& frames,
+               const bool blendAlpha, const bool depth )
+{
+    const Result perImage = _merge( frames, blendAlpha, false );
+    const Result tiled = _merge( frames, blendAlpha, true );
+
+    TESTINFO( perImage.color == tiled.color, name );
+    if( depth )
+        TESTINFO( perImage.depth == tiled.depth, name );
+
+    std::cout << std::setw( 10 ) << name << ", " << std::setw( 9 )
+              << perImage.time << ", " << std::setw( 9 ) << tiled.time
+              << ", " << std::setw( 7 ) << perImage.time / tiled.time
+              << std::endl;
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    lunchbox::RNG rng;
+    eq::Frame frame;
+    eq::FrameDataPtr frameData = new eq::FrameData;
+    frame.setFrameData( frameData );
+    eq::Frames frames( 1, &frame );
+
+    std::cout << "     INPUT, IMAGE (ms), TILED (ms), SPEEDUP" << std::endl;
+
+    // 2D: many small tiles covering the destination
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR );
+    for( int32_t y = 0; y < _destPVP.h; y += 75 )
+        for( int32_t x = 0; x < _destPVP.w; x += 120 )
+            _addImage( *frameData, eq::PixelViewport( x, y, 120, 75 ), false,
+                       false, rng );
+    _compare( "2D tiles", frames, false, false );
+
+    // DB: full-size images with depth
+    frameData->clear();
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR | eq::Frame::BUFFER_DEPTH );
+    for( size_t i = 0; i < 4; ++i )
+        _addImage( *frameData, _destPVP, true, false, rng );
+    _compare( "DB", frames, false, true );
+
+    // DB: regions of interest of different sizes
+    frameData->clear();
+    for( int32_t i = 0; i < 16; ++i )
+        _addImage( *frameData, eq::PixelViewport( i * 97, i * 53, 400, 300 ),
+                   true, false, rng );
+    _compare( "DB ROI", frames, false, true );
+
+    // blending: full-size images with alpha
+    frameData->clear();
+    frameData->setBuffers( eq::Frame::BUFFER_COLOR );
+    for( size_t i = 0; i < 4; ++i )
+        _addImage( *frameData, _destPVP, false, true, rng );
+    _compare( "blend", frames, true, false );
+
+    frameData->clear();
+    TEST( eq::exit( ));
+    return EXIT_SUCCESS;
+}
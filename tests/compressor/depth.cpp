@@ -0,0 +1,173 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that the built-in depth compressor is lossless and that the
+// decompressor survives truncated and corrupted input. The benchmark of all
+// depth compressors is in tests/perf/depthCompressor.cpp.
+
+#include <test.h>
+
+#include <eq/client/compressor/compressorDepth.h>
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/pixelData.h>
+
+#include <lunchbox/rng.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// odd size for partial blocks and rows
+static const eq::PixelViewport _pvp( 0, 0, 333, 97 );
+static const size_t _headerSize = 24; // band header of the compressor
+
+typedef std::vector< uint32_t > Depth;
+typedef std::vector< uint8_t > Bytes;
+typedef std::vector< Bytes > Chunks;
+
+/** A slanted plane with a far-plane hole and a random-noise patch. */
+Depth _createDepth()
+{
+    lunchbox::RNG rng;
+    Depth depth( _pvp.getArea( ));
+    for( int32_t y = 0; y < _pvp.h; ++y )
+    {
+        for( int32_t x = 0; x < _pvp.w; ++x )
+        {
+            uint32_t& z = depth[ y * _pvp.w + x ];
+            if( x > 100 && x < 200 && y > 20 && y < 60 )
+                z = 0xffffffffu;
+            else if( x > 250 && y > 70 )
+                z = rng.get< uint32_t >();
+            else
+                z = 0x40000000u + uint32_t( x ) * 1021u + uint32_t( y ) * 77u;
+        }
+    }
+    return depth;
+}
+
+eq::PixelData _createPixelData( const Depth& depth )
+{
+    eq::PixelData data;
+    data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+    data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    data.pixelSize = 4;
+    data.pvp = _pvp;
+    data.pixels = const_cast< uint32_t* >( &depth[0] );
+    return data;
+}
+
+/** Decompress the given chunks, which must not crash or overrun. */
+void _decompress( const eq::PixelData& compressed, Chunks& chunks )
+{
+    pression::CompressorChunks results;
+    for( Chunks::iterator i = chunks.begin(); i != chunks.end(); ++i )
+        results.push_back( pression::CompressorChunk( i->empty() ? 0 :
+                                                      &(*i)[0], i->size( )));
+
+    eq::PixelData data = compressed;
+    data.compressedData = pression::CompressorResult(
+        EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT, results );
+
+    eq::Image image;
+    image.setPixelViewport( _pvp );
+    image.setPixelData( eq::Frame::BUFFER_DEPTH, data );
+    image.flush();
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    const Depth depth = _createDepth();
+    eq::Image image;
+    image.setPixelViewport( _pvp );
+    image.setPixelData( eq::Frame::BUFFER_DEPTH, _createPixelData( depth ));
+    TEST( image.allocCompressor( eq::Frame::BUFFER_DEPTH,
+                                 EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT ));
+
+    const eq::PixelData& compressed =
+        image.compressPixelData( eq::Frame::BUFFER_DEPTH );
+    TEST( compressed.compressedData.isCompressed( ));
+    TEST( compressed.compressedData.compressor ==
+          EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT );
+    TESTINFO( compressed.compressedData.getSize() <
+              depth.size() * sizeof( uint32_t ),
+              compressed.compressedData.getSize( ));
+
+    // lossless round trip
+    eq::Image destImage;
+    destImage.setPixelViewport( _pvp );
+    destImage.setPixelData( eq::Frame::BUFFER_DEPTH, compressed );
+    const uint32_t* result = reinterpret_cast< const uint32_t* >(
+        destImage.getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+    TEST( std::equal( depth.begin(), depth.end(), result ));
+    destImage.flush();
+
+    Chunks original;
+    const pression::CompressorChunks& chunks = compressed.compressedData.chunks;
+    for( size_t i = 0; i < chunks.size(); ++i )
+    {
+        const uint8_t* data = reinterpret_cast< const uint8_t* >(
+            chunks[i].data );
+        original.push_back( Bytes( data, data + chunks[i].getNumBytes( )));
+    }
+
+    // truncated input, down to less than a header
+    for( size_t size = 1; size < 1024; size *= 2 )
+    {
+        Chunks truncated = original;
+        for( Chunks::iterator i = truncated.begin(); i != truncated.end(); ++i )
+            i->resize( i->size() > size ? i->size() - size : 0 );
+        _decompress( compressed, truncated );
+    }
+    Chunks empty( original.size( ));
+    _decompress( compressed, empty );
+
+    // corrupted band header and payload
+    lunchbox::RNG rng;
+    for( size_t i = 0; i < 100; ++i )
+    {
+        Chunks corrupt = original;
+        for( Chunks::iterator j = corrupt.begin(); j != corrupt.end(); ++j )
+        {
+            for( size_t k = 0; k < 8 && !j->empty(); ++k )
+            {
+                const size_t index = rng.get< uint32_t >() % j->size();
+                (*j)[ index ] = rng.get< uint8_t >();
+            }
+        }
+        _decompress( compressed, corrupt );
+    }
+
+    // far-plane runs beyond the band
+    Chunks farRun = original;
+    for( Chunks::iterator i = farRun.begin(); i != farRun.end(); ++i )
+        std::fill( i->begin() + std::min( i->size(), _headerSize ), i->end(),
+                   0xff );
+    _decompress( compressed, farRun );
+
+    image.flush();
+    eq::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests that RenderContext::operator == compares all members
+
+#include <test.h>
+#include <eq/fabric/renderContext.h>
+
+using eq::fabric::RenderContext;
+
+#define TEST_MEMBER( member, value )                    \
+    {                                                   \
+        RenderContext changed;                          \
+        changed.member = value;                         \
+        TESTINFO( changed != context, #member );        \
+        TESTINFO( !( changed == context ), #member );   \
+    }
+
+int main( int, char** )
+{
+    // A new member changes the size: compare it in operator ==, swap it in
+    // byteswap() and add it here.
+    const size_t size = 2 * sizeof( eq::fabric::Frustumf ) +
+                        3 * sizeof( eq::fabric::Matrix4f ) +
+                        2 * sizeof( eq::fabric::uint128_t ) +
+                        2 * sizeof( eq::fabric::Vector3f ) +
+                        sizeof( float ) + sizeof( uint32_t ) +
+                        sizeof( co::ObjectVersion ) +
+                        sizeof( eq::fabric::PixelViewport ) +
+                        sizeof( eq::fabric::Pixel ) +
+                        sizeof( eq::fabric::Vector4i ) +
+                        sizeof( eq::fabric::Viewport ) +
+                        sizeof( eq::fabric::Vector2i ) +
+                        sizeof( eq::fabric::Range ) +
+                        sizeof( eq::fabric::SubPixel ) +
+                        sizeof( eq::fabric::Zoom ) +
+                        5 * sizeof( uint32_t ) + sizeof( eq::fabric::Eye ) +
+                        sizeof( eq::fabric::ColorMask ) + 28 * sizeof( bool );
+    TESTINFO( sizeof( RenderContext ) == size,
+              sizeof( RenderContext ) << " != " << size );
+
+    const RenderContext context;
+    TEST( context == RenderContext( ));
+    TEST( !( context != RenderContext( )));
+
+    TEST_MEMBER( frustum.left(), -2.f );
+    TEST_MEMBER( ortho.far_plane(), 42.f );
+    TEST_MEMBER( headTransform.array[12], 1.f );
+    TEST_MEMBER( orthoTransform.array[13], 1.f );
+    TEST_MEMBER( latchID, eq::fabric::uint128_t( 42 ));
+    TEST_MEMBER( headMatrix.array[14], 1.f );
+    TEST_MEMBER( eyeHead.x(), .03f );
+    TEST_MEMBER( modelUnit, .5f );
+    TEST_MEMBER( eyeWall.y(), 1.f );
+    TEST_MEMBER( wallType, 1 );
+    TEST_MEMBER( view.version, eq::fabric::uint128_t( 2 ));
+    TEST_MEMBER( frameID, eq::fabric::uint128_t( 1 ));
+    TEST_MEMBER( pvp.w, 640 );
+    TEST_MEMBER( pixel.w, 2 );
+    TEST_MEMBER( overdraw.x(), 1 );
+    TEST_MEMBER( vp.h, .5f );
+    TEST_MEMBER( offset.y(), 10 );
+    TEST_MEMBER( range.end, .5f );
+    TEST_MEMBER( subpixel.size, 2 );
+    TEST_MEMBER( zoom.x(), 2.f );
+    TEST_MEMBER( buffer, 0x0404 ); // GL_FRONT
+    TEST_MEMBER( taskID, 7 );
+    TEST_MEMBER( period, 2 );
+    TEST_MEMBER( phase, 1 );
+    TEST_MEMBER( eye, eq::fabric::EYE_LEFT );
+    TEST_MEMBER( bufferMask.red, false );
+    TEST_MEMBER( bufferMask.green, false );
+    TEST_MEMBER( bufferMask.blue, false );
+    TEST_MEMBER( bufferMask.alpha, false );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define TEST_RUNTIME 600 // seconds
+#include <test.h>
+
+#include <eq/client/compressor/compressorDepth.h>
+#include <eq/client/image.h>
+#include <eq/client/init.h>
+#include <eq/client/nodeFactory.h>
+#include <eq/client/pixelData.h>
+
+#include <lunchbox/clock.h>
+#include <lunchbox/file.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// Benchmarks the depth buffer compressors: compression ratio and throughput of
+// all engines able to compress unsigned int depth, for sparse and dense
+// synthetic depth buffers and the depth images found in the working directory.
+
+namespace
+{
+static const size_t _nLoops = 10;
+
+struct Input
+{
+    std::string name;
+    eq::PixelViewport pvp;
+    std::vector< uint32_t > depth;
+};
+typedef std::vector< Input > Inputs;
+
+/**
+ * Spheres in front of a slanted plane or the far plane. The spheres cover
+ * the given fraction of the width.
+ */
+Input _createDepth( const std::string& name, const float coverage,
+                    const bool background )
+{
+    Input input;
+    input.name = name;
+    input.pvp = eq::PixelViewport( 0, 0, 1920, 1200 );
+    input.depth.resize( input.pvp.getArea( ));
+
+    const int32_t w = input.pvp.w;
+    const int32_t h = input.pvp.h;
+    const float radius = coverage * float( w ) / 8.f;
+
+#pragma omp parallel for
+    for( int32_t y = 0; y < h; ++y )
+    {
+        for( int32_t x = 0; x < w; ++x )
+        {
+            float z = background ? .9f - .1f * float( x + y ) / float( w + h ) :
+                                   1.f;
+            for( int32_t i = 0; i < 4; ++i )
+            {
+                const float cx = float( w ) * ( .5f + float( i ) ) / 4.f;
+                const float cy = float( h ) * .5f;
+                const float dx = ( float( x ) - cx ) / radius;
+                const float dy = ( float( y ) - cy ) / radius;
+                const float d2 = dx * dx + dy * dy;
+                if( d2 < 1.f )
+                    z = std::min( z, .5f - .2f * std::sqrt( 1.f - d2 ));
+            }
+            input.depth[ y * w + x ] = z >= 1.f ? 0xffffffffu :
+                                       uint32_t( double( z ) * 4294967295. );
+        }
+    }
+    return input;
+}
+
+bool _readDepth( const std::string& filename, Input& input )
+{
+    eq::Image image;
+    if( !image.readImage( filename, eq::Frame::BUFFER_DEPTH ))
+        return false;
+
+    input.name = filename;
+    input.pvp = image.getPixelViewport();
+    const uint32_t* depth = reinterpret_cast< const uint32_t* >(
+        image.getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+    input.depth.assign( depth, depth + input.pvp.getArea( ));
+    image.flush();
+    return true;
+}
+}
+
+int main( int argc, char **argv )
+{
+    eq::NodeFactory nodeFactory;
+    TEST( eq::init( argc, argv, &nodeFactory ));
+
+    Inputs inputs;
+    inputs.push_back( _createDepth( "sparse", .25f, false ));
+    inputs.push_back( _createDepth( "medium", 1.f, false ));
+    inputs.push_back( _createDepth( "dense", 1.f, true ));
+
+    const eq::Strings candidates =
+        lunchbox::searchDirectory( ".", "Result.*depth.*\\.rgb" );
+    for( eq::StringsCIter i = candidates.begin(); i != candidates.end(); ++i )
+    {
+        Input input;
+        if( _readDepth( *i, input ))
+            inputs.push_back( input );
+    }
+
+    eq::Image image;
+    eq::Image destImage;
+    const std::vector< uint32_t > names =
+        image.findCompressors( eq::Frame::BUFFER_DEPTH );
+    TEST( std::find( names.begin(), names.end(),
+                     EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT ) != names.end( ));
+
+    std::cout.setf( std::ios::right, std::ios::adjustfield );
+    std::cout.precision( 4 );
+    std::cout << "COMPRESSOR,      IMAGE,      SIZE, COMPRESSED,  RATIO,"
+              << "  COMP GB/s, DECOMP GB/s" << std::endl;
+
+    lunchbox::Clock clock;
+    for( std::vector< uint32_t >::const_iterator i = names.begin();
+         i != names.end(); ++i )
+    {
+        const uint32_t name = *i;
+        for( Inputs::const_iterator j = inputs.begin(); j != inputs.end(); ++j )
+        {
+            const Input& input = *j;
+            eq::PixelData data;
+            data.internalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH;
+            data.externalFormat = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+            data.pixelSize = 4;
+            data.pvp = input.pvp;
+            data.pixels = const_cast< uint32_t* >( &input.depth[0] );
+
+            image.setPixelViewport( input.pvp );
+            image.setPixelData( eq::Frame::BUFFER_DEPTH, data );
+            TEST( image.allocCompressor( eq::Frame::BUFFER_DEPTH, name ));
+            destImage.setPixelViewport( input.pvp );
+
+            float compressTime = 0.f;
+            float decompressTime = 0.f;
+            uint64_t compressedSize = 0;
+            for( size_t k = 0; k < _nLoops; ++k )
+            {
+                // force recompression
+                image.setAlphaUsage( !image.getAlphaUsage( ));
+                image.setAlphaUsage( !image.getAlphaUsage( ));
+
+                clock.reset();
+                const eq::PixelData& pixels =
+                    image.compressPixelData( eq::Frame::BUFFER_DEPTH );
+                compressTime += clock.getTimef();
+
+                compressedSize = pixels.compressedData.isCompressed() ?
+                                 pixels.compressedData.getSize() :
+                                 image.getPixelDataSize(
+                                     eq::Frame::BUFFER_DEPTH );
+
+                clock.reset();
+                destImage.setPixelData( eq::Frame::BUFFER_DEPTH, pixels );
+                decompressTime += clock.getTimef();
+            }
+
+            const uint64_t size = input.depth.size() * sizeof( uint32_t );
+            const float bytes = float( size * _nLoops );
+            std::cout << "0x" << std::setw(8) << std::setfill( '0' )
+                      << std::hex << name << std::dec << std::setfill( ' ' )
+                      << ", " << std::setw(10) << input.name.substr( 0, 10 )
+                      << ", " << std::setw(9) << size << ", " << std::setw(10)
+                      << compressedSize << ", " << std::setw(6)
+                      << float( compressedSize ) / float( size ) << ", "
+                      << std::setw(10) << bytes / compressTime / 1e6f << ", "
+                      << std::setw(11) << bytes / decompressTime / 1e6f
+                      << std::endl;
+
+            if( name == EQ_COMPRESSOR_DIFF_DEPTH_UNSIGNED_INT )
+            {
+                const uint32_t* result = reinterpret_cast< const uint32_t* >(
+                    destImage.getPixelPointer( eq::Frame::BUFFER_DEPTH ));
+                TESTINFO( std::equal( input.depth.begin(), input.depth.end(),
+                                      result ),
+                          "Lossless depth compression failed for " <<
+                          input.name );
+            }
+        }
+    }
+
+    image.flush();
+    destImage.flush();
+    eq::exit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the source selection and the jitter measurement of the dplex_equalizer
+// with synthetic load data of two fast and one slow source.
+
+#include <test.h>
+#include <eq/server/equalizers/dplexModel.h>
+#include <eq/fabric/statistic.h>
+
+#include <cmath>
+
+using eq::fabric::Statistic;
+using eq::fabric::Statistics;
+
+namespace
+{
+static const uint32_t _sourceTask = 2;
+static const uint32_t _destTask = 1;
+
+bool _equals( const float a, const float b )
+{
+    return std::abs( a - b ) <= .001f * std::abs( b );
+}
+
+Statistics _newStatistics( const Statistic::Type type, const uint32_t task,
+                           const int64_t startTime, const int64_t endTime )
+{
+    Statistic statistic = Statistic();
+    statistic.type = type;
+    statistic.task = task;
+    statistic.startTime = startTime;
+    statistic.endTime = endTime;
+    return Statistics( 1, statistic );
+}
+
+/** Report the draw time of a frame rendered by a source. */
+void _draw( eq::server::DPlexModel& model, const size_t source,
+            const uint32_t frame, const int64_t time )
+{
+    model.updateSource( source, frame, _sourceTask,
+                        _newStatistics( Statistic::CHANNEL_DRAW, _sourceTask,
+                                        0, time ));
+}
+
+/** Report the assembly of a frame on the destination. */
+void _deliver( eq::server::DPlexModel& model, const uint32_t frame,
+               const int64_t time )
+{
+    model.updateDelivery( frame, _destTask,
+                          _newStatistics( Statistic::CHANNEL_ASSEMBLE,
+                                          _destTask, time - 1, time ));
+}
+}
+
+int main( int, char** )
+{
+    // source selection
+    {
+        eq::server::DPlexModel model;
+        model.reset( 3 );
+
+        // static time-multiplex until all sources are measured
+        for( uint32_t frame = 1; frame <= 3; ++frame )
+        {
+            const size_t source = model.select( frame, 0 );
+            TESTINFO( source == frame % 3, frame << ": " << source );
+            model.assign( source, frame, 0 );
+        }
+        TEST( model.getFrameInterval() == 0.f );
+
+        _draw( model, 1, 1, 30 );
+        _draw( model, 1, 5, 90 ); // not assigned to the source
+        _draw( model, 2, 2, 60 );
+        model.updateSource( 0, 3, _sourceTask + 1, // other task
+                            _newStatistics( Statistic::CHANNEL_DRAW,
+                                            _sourceTask + 1, 0, 90 ));
+        TEST( model.select( 4, 0 ) == 1 );
+
+        _draw( model, 0, 3, 30 );
+
+        // combined rate of 1/30 + 1/30 + 1/60 frames per ms
+        const size_t expected[] = { 0, 1, 0, 1, 2 };
+        for( uint32_t i = 0; i < 5; ++i )
+        {
+            const size_t source = model.select( i + 4, 1000 );
+            TESTINFO( source == expected[i], i << ": " << source );
+            TESTINFO( _equals( model.getFrameInterval(), 12.f ),
+                      model.getFrameInterval( ));
+            model.assign( source, i + 4, 1000 );
+        }
+    }
+
+    // jitter of consecutive delivered frames
+    {
+        eq::server::DPlexModel model;
+        model.reset( 2 );
+        _deliver( model, 10, 100 );
+        _deliver( model, 11, 112 );
+        TEST( model.getMeasuredInterval() == 0.f ); // one interval only
+
+        _deliver( model, 12, 124 );
+        _deliver( model, 13, 136 );
+        TESTINFO( _equals( model.getMeasuredInterval(), 12.f ),
+                  model.getMeasuredInterval( ));
+        TEST( model.getJitter() == 0.f );
+
+        _deliver( model, 14, 160 );
+        _deliver( model, 20, 300 ); // not consecutive
+        TESTINFO( _equals( model.getMeasuredInterval(), 15.f ),
+                  model.getMeasuredInterval( ));
+        TESTINFO( _equals( model.getJitter(), std::sqrt( 27.f )),
+                  model.getJitter( ));
+    }
+    return EXIT_SUCCESS;
+}
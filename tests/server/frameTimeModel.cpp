@@ -0,0 +1,84 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the least-squares fit and the percentile correction of the frame time
+// model used by the predictive DFR equalizer.
+
+#include <test.h>
+#include <eq/server/equalizers/frameTimeModel.h>
+
+#include <cmath>
+
+using eq::server::FrameTimeModel;
+
+namespace
+{
+static const size_t _nSamples = 32;
+
+bool _equals( const float a, const float b )
+{
+    return std::abs( a - b ) <= .01f * std::abs( b );
+}
+}
+
+int main( int, char** )
+{
+    // time = 2 ms + 1 ms per 100k pixels with varying zoom
+    {
+        FrameTimeModel model;
+        for( size_t i = 0; i < 2 * _nSamples; ++i )
+        {
+            const float pixels = 100000.f + float( i % _nSamples ) * 10000.f;
+            model.add( pixels, 2.f + pixels * 1e-5f );
+        }
+        TESTINFO( model.getSize() == _nSamples, model.getSize( ));
+
+        // the offset is fitted, not scaled with the pixels
+        float pixels = model.predictPixels( 5.f, 0.f );
+        TESTINFO( _equals( pixels, 300000.f ), pixels );
+        pixels = model.predictPixels( 5.f, 95.f );
+        TESTINFO( _equals( pixels, 300000.f ), pixels );
+        pixels = model.predictPixels( 12.f, 0.f );
+        TESTINFO( _equals( pixels, 1000000.f ), pixels );
+    }
+
+    // constant zoom with one slow frame: time proportional to the pixels
+    {
+        FrameTimeModel model;
+        model.add( 100000.f, 20.f );
+        for( size_t i = 1; i < _nSamples; ++i )
+            model.add( 100000.f, 10.f );
+
+        TEST( model.getTime( 0.f ) == 10.f );
+        TEST( model.getTime( 50.f ) == 10.f );
+        TEST( model.getTime( 99.f ) == 20.f );
+        TEST( model.getTime( 100.f ) == 20.f ); // clamped to the slowest
+
+        // the last frame and the 95th percentile render at the mean speed
+        float pixels = model.predictPixels( 10.f, 0.f );
+        TESTINFO( _equals( pixels, 100000.f ), pixels );
+        pixels = model.predictPixels( 10.f, 95.f );
+        TESTINFO( _equals( pixels, 100000.f ), pixels );
+
+        // the 99th percentile keeps the slow frame at the target
+        pixels = model.predictPixels( 10.f, 99.f );
+        TESTINFO( _equals( pixels, 50000.f ), pixels );
+        pixels = model.predictPixels( 10.f, 100.f );
+        TESTINFO( _equals( pixels, 50000.f ), pixels );
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the mode selection of the hybrid load equalizer with synthetic frame
+// times: the initial probe, frames in flight during a switch, the hysteresis,
+// the scaling of the inactive mode by the load change, periodic probing and
+// the transfer cost of the DB output frames.
+
+#include <test.h>
+#include <eq/server/equalizers/hybridModel.h>
+
+#include <cmath>
+
+using eq::server::HybridModel;
+using eq::fabric::Equalizer;
+
+namespace
+{
+static const float _damping = 0.f; // use the last measurement only
+static const uint32_t _latency = 1;
+
+bool _equals( const float a, const float b )
+{
+    return std::abs( a - b ) < 0.0001f;
+}
+
+/** Feed the times of the given frame, rendered with the given mode. */
+bool _update( HybridModel& model, const Equalizer::Mode mode,
+              const float render, const float assemble, const uint32_t frame,
+              const float transfer = 0.f )
+{
+    return model.update( mode, render, assemble, transfer, frame,
+                         frame + _latency, _damping );
+}
+}
+
+int main( int, char** )
+{
+    {
+        HybridModel model;
+        TEST( model.getMode() == Equalizer::MODE_2D );
+
+        // the unknown DB mode is probed after the first measurement
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, 1 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getTime(), 12.f ), model.getTime( ));
+        TESTINFO( _equals( model.getRatio(), 1.f ), model.getRatio( ));
+
+        // frames in flight rendered in 2D do not switch back
+        TEST( !_update( model, Equalizer::MODE_2D, 10.f, 2.f, 2 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+
+        // DB at 10 ms is faster than 2D at 12 ms
+        TEST( _update( model, Equalizer::MODE_DB, 6.f, 4.f, 3 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getTime(), 10.f ), model.getTime( ));
+        TESTINFO( _equals( model.getRatio(), 10.f / 12.f ), model.getRatio( ));
+
+        // 2D at 12 ms is faster than DB at 14 ms, but within the hysteresis
+        TEST( _update( model, Equalizer::MODE_DB, 6.f, 8.f, 4 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getRatio(), 14.f / 12.f ), model.getRatio( ));
+
+        // 2D at 12 ms is clearly faster than DB at 20 ms
+        TEST( _update( model, Equalizer::MODE_DB, 6.f, 14.f, 5 ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+        TESTINFO( _equals( model.getTime(), 12.f ), model.getTime( ));
+        TESTINFO( _equals( model.getRatio(), .6f ), model.getRatio( ));
+
+        // the render load doubles: DB is predicted at 2 * 6 + 14 ms
+        TEST( _update( model, Equalizer::MODE_2D, 20.f, 2.f, 6 ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+        TEST( _update( model, Equalizer::MODE_2D, 40.f, 2.f, 7 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getTime(), 26.f ), model.getTime( ));
+        TESTINFO( _equals( model.getRatio(), 26.f / 42.f ),
+                  model.getRatio( ));
+    }
+    {
+        HybridModel model;
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, 1 ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TEST( _update( model, Equalizer::MODE_DB, 20.f, 4.f, 2 ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+
+        // DB was last measured in frame 2 and is probed again after 500 frames
+        uint32_t frame = 3;
+        for( ; frame + _latency <= 502; ++frame )
+        {
+            TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, frame ));
+            TESTINFO( model.getMode() == Equalizer::MODE_2D, frame );
+        }
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, frame ));
+        TESTINFO( model.getMode() == Equalizer::MODE_DB, frame );
+        TESTINFO( _equals( model.getTime(), 24.f ), model.getTime( ));
+    }
+    {
+        // transfer-dominated: DB renders and assembles faster, but sending
+        // the full-size output frames of all children takes 8 ms
+        HybridModel model;
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, 1, 8.f ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getTime(), 12.f ), model.getTime( ));
+
+        // DB at 6 + 4 + 8 ms is slower than 2D at 12 ms
+        TEST( _update( model, Equalizer::MODE_DB, 6.f, 4.f, 2, 8.f ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+        TESTINFO( _equals( model.getTime(), 12.f ), model.getTime( ));
+        TESTINFO( _equals( model.getRatio(), 12.f / 18.f ),
+                  model.getRatio( ));
+
+        // the prediction of the inactive DB mode uses the current transfer
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, 3, 2.f ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+        TESTINFO( _equals( model.getRatio(), 1.f ), model.getRatio( ));
+
+        // a faster network makes DB the better choice
+        TEST( _update( model, Equalizer::MODE_2D, 10.f, 2.f, 4, 0.f ));
+        TEST( model.getMode() == Equalizer::MODE_2D );
+        TEST( _update( model, Equalizer::MODE_2D, 20.f, 2.f, 5, 0.f ));
+        TEST( model.getMode() == Equalizer::MODE_DB );
+        TESTINFO( _equals( model.getTime(), 16.f ), model.getTime( ));
+    }
+    return EXIT_SUCCESS;
+}
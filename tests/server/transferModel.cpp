@@ -0,0 +1,134 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the output frame transfer model of the load and tree equalizers with
+// synthetic readback, compression and transmission statistics.
+
+#include <test.h>
+
+#include <eq/server/channel.h>
+#include <eq/server/config.h>
+#include <eq/server/equalizers/transferModel.h>
+#include <eq/server/node.h>
+#include <eq/server/pipe.h>
+#include <eq/server/server.h>
+#include <eq/server/window.h>
+#include <eq/fabric/statistic.h>
+
+#include <cmath>
+
+using eq::fabric::Statistic;
+using eq::fabric::Statistics;
+
+namespace
+{
+static const uint32_t _task = 1;
+
+bool _equals( const float a, const float b )
+{
+    return std::abs( a - b ) <= .001f * std::abs( b );
+}
+
+eq::server::Channel* _newChannel( eq::server::Node* node )
+{
+    eq::server::Pipe* pipe = new eq::server::Pipe( node );
+    eq::server::Window* window = new eq::server::Window( pipe );
+    return new eq::server::Channel( window );
+}
+
+void _add( Statistics& statistics, const Statistic::Type type,
+           const int64_t time, const uint32_t task = _task,
+           const float ratio = 1.f, const uint32_t bytes = 0 )
+{
+    Statistic statistic = Statistic();
+    statistic.type = type;
+    statistic.task = task;
+    statistic.startTime = 100;
+    statistic.endTime = 100 + time;
+    statistic.ratio = ratio;
+    statistic.bytes = bytes;
+    statistics.push_back( statistic );
+}
+}
+
+int main( int, char** )
+{
+    eq::server::ServerPtr server = new eq::server::Server;
+    eq::server::Config* config = new eq::server::Config( server );
+    eq::server::Node* node = new eq::server::Node( config );
+    eq::server::Node* remote = new eq::server::Node( config );
+    const eq::server::Channel* rgba8 = _newChannel( node );
+    const eq::server::Channel* rgba32f = _newChannel( node );
+    const eq::server::Channel* compressed = _newChannel( remote );
+
+    eq::server::TransferModel model;
+    TEST( model.predict( rgba8, 1e6f ) == 0.f );
+
+    // uncompressed RGBA8: 4 bytes per pixel, 2 ms readback, 10 ms sending
+    {
+        Statistics statistics;
+        _add( statistics, Statistic::CHANNEL_ASYNC_READBACK, 2 );
+        _add( statistics, Statistic::CHANNEL_FRAME_TRANSMIT, 10, _task, 1.f,
+              4000000 );
+        _add( statistics, Statistic::CHANNEL_FRAME_TRANSMIT, 50, _task + 1,
+              1.f, 4000000 ); // other task
+        model.update( rgba8, _task, statistics, 1e6f );
+    }
+    float time = model.predict( rgba8, 1e6f );
+    TESTINFO( _equals( time, 12.f ), time );
+    time = model.predict( rgba8, 5e5f );
+    TESTINFO( _equals( time, 6.f ), time );
+    TEST( model.predict( rgba32f, 1e6f ) == 0.f ); // not measured yet
+
+    // uncompressed RGBA32F over the same link: 16 bytes per pixel
+    {
+        Statistics statistics;
+        _add( statistics, Statistic::CHANNEL_ASYNC_READBACK, 8 );
+        _add( statistics, Statistic::CHANNEL_FRAME_TRANSMIT, 40, _task, 1.f,
+              16000000 );
+        model.update( rgba32f, _task, statistics, 1e6f );
+    }
+    time = model.predict( rgba32f, 1e6f );
+    TESTINFO( _equals( time, 48.f ), time );
+    time = model.predict( rgba8, 1e6f );
+    TESTINFO( _equals( time, 12.f ), time );
+
+    // compressed to a quarter, compression is sampled within the transmission
+    {
+        Statistics statistics;
+        _add( statistics, Statistic::CHANNEL_ASYNC_READBACK, 2 );
+        _add( statistics, Statistic::CHANNEL_FRAME_COMPRESS, 4, _task, .25f );
+        _add( statistics, Statistic::CHANNEL_FRAME_TRANSMIT, 14, _task, 1.f,
+              1000000 );
+        model.update( compressed, _task, statistics, 1e6f );
+    }
+    time = model.predict( compressed, 1e6f );
+    TESTINFO( _equals( time, 16.f ), time );
+
+    // frames without transmission do not change the model
+    {
+        Statistics statistics;
+        _add( statistics, Statistic::CHANNEL_ASYNC_READBACK, 100 );
+        model.update( rgba8, _task, statistics, 1e6f );
+    }
+    time = model.predict( rgba8, 1e6f );
+    TESTINFO( _equals( time, 12.f ), time );
+
+    server->deleteConfigs(); // break server <-> config ref circle
+    TESTINFO( server->getRefCount() == 1, server->getRefCount( ));
+    return EXIT_SUCCESS;
+}
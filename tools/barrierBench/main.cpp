@@ -0,0 +1,248 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the swap barrier latency of the master-based co::Barrier and the
+// eq::HierarchicalBarrier for an increasing number of processes. The master
+// process launches the worker processes on the local host, each process
+// standing in for one render node of a display wall.
+//
+// Usage: eqBarrierBench [processes [iterations [address]]]
+
+#include <eq/eq.h>
+
+#include <co/barrier.h>
+#include <co/connectionDescription.h>
+#include <co/customICommand.h>
+#include <co/customOCommand.h>
+#include <co/init.h>
+#include <co/localNode.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/launcher.h>
+#include <lunchbox/mtQueue.h>
+
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <iomanip>
+
+namespace
+{
+const eq::uint128_t _cmdHello( 0x4d1c7a0e5f3b2968ull, 0xa3e5c1b7d9f20486ull );
+const eq::uint128_t _cmdRun( 0x4d1c7a0e5f3b2968ull, 0xa3e5c1b7d9f20487ull );
+
+/** One benchmark run with a given set of participants. */
+struct Run
+{
+    Run() : iterations( 0 ) {}
+
+    co::NodeIDs nodes; //!< The participants, empty to terminate
+    co::ObjectVersion barrier; //!< The flat barrier
+    uint32_t iterations;
+};
+
+typedef std::vector< float > Times;
+
+Times _runFlat( co::Barrier& barrier, const uint32_t iterations )
+{
+    Times times;
+    lunchbox::Clock clock;
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+        clock.reset();
+        barrier.enter();
+        times.push_back( clock.getTimef( ));
+    }
+    return times;
+}
+
+Times _runHierarchical( eq::HierarchicalBarrier& barrier, const Run& run )
+{
+    Times times;
+    lunchbox::Clock clock;
+    const uint64_t size = run.nodes.size();
+    for( uint32_t i = 0; i < run.iterations; ++i )
+    {
+        clock.reset();
+        barrier.enter( eq::uint128_t( size, i ), 1, run.nodes );
+        times.push_back( clock.getTimef( ));
+    }
+    return times;
+}
+
+float _getPercentile( const Times& sorted, const float percentile )
+{
+    if( sorted.empty( ))
+        return 0.f;
+    return sorted[ size_t( percentile * float( sorted.size() - 1 ) + .5f )];
+}
+
+void _print( const std::string& name, const size_t nProcesses, Times times )
+{
+    std::sort( times.begin(), times.end( ));
+    std::cout << std::setw( 12 ) << name << ", " << std::setw( 9 )
+              << nProcesses << ", " << std::setw( 8 )
+              << _getPercentile( times, .5f ) << ", " << std::setw( 8 )
+              << _getPercentile( times, .95f ) << ", " << std::setw( 8 )
+              << _getPercentile( times, .99f ) << std::endl;
+}
+
+class Master
+{
+public:
+    bool cmdHello( co::CustomICommand& command )
+    {
+        workers.push( command.getNode()->getNodeID( ));
+        return true;
+    }
+
+    lunchbox::MTQueue< co::NodeID > workers;
+};
+
+class Worker
+{
+public:
+    bool cmdRun( co::CustomICommand& command )
+    {
+        Run run;
+        run.nodes = command.read< co::NodeIDs >();
+        run.barrier = command.read< co::ObjectVersion >();
+        run.iterations = command.read< uint32_t >();
+        runs.push( run );
+        return true;
+    }
+
+    lunchbox::MTQueue< Run > runs;
+};
+
+int _runWorker( co::LocalNodePtr node, const std::string& address )
+{
+    Worker worker;
+    node->registerCommandHandler( _cmdRun,
+                                  boost::bind( &Worker::cmdRun, &worker, _1 ),
+                                  0 );
+    eq::HierarchicalBarrier hierarchicalBarrier( *node );
+
+    co::NodePtr master = new co::Node;
+    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+    desc->fromString( address );
+    master->addConnectionDescription( desc );
+    if( !node->connect( master ))
+    {
+        LBERROR << "Can't connect master at " << address << std::endl;
+        return EXIT_FAILURE;
+    }
+    master->send( _cmdHello );
+
+    for( Run run = worker.runs.pop(); !run.nodes.empty();
+         run = worker.runs.pop( ))
+    {
+        co::Barrier barrier( node, run.barrier );
+        _runFlat( barrier, run.iterations );
+        _runHierarchical( hierarchicalBarrier, run );
+    }
+    return EXIT_SUCCESS;
+}
+
+int _runMaster( co::LocalNodePtr node, const std::string& program,
+                const std::string& address, const uint32_t nProcesses,
+                const uint32_t iterations )
+{
+    Master master;
+    node->registerCommandHandler( _cmdHello,
+                                  boost::bind( &Master::cmdHello, &master, _1 ),
+                                  0 );
+    eq::HierarchicalBarrier hierarchicalBarrier( *node );
+
+    for( uint32_t i = 1; i < nProcesses; ++i )
+    {
+        const std::string command = program + " --worker " + address;
+        if( !lunchbox::Launcher::run( command ))
+        {
+            LBERROR << "Can't launch " << command << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    co::NodeIDs workers;
+    while( workers.size() < nProcesses - 1 )
+        workers.push_back( master.workers.pop( ));
+
+    std::cout.setf( std::ios::right, std::ios::adjustfield );
+    std::cout.precision( 3 );
+    std::cout << std::fixed << "     BARRIER, PROCESSES,  P50 ms,  P95 ms,  "
+              << "P99 ms" << std::endl;
+
+    for( uint32_t size = 2; size <= nProcesses; size <<= 1 )
+    {
+        Run run;
+        run.nodes.push_back( node->getNodeID( ));
+        run.nodes.insert( run.nodes.end(), workers.begin(),
+                          workers.begin() + size - 1 );
+        run.iterations = iterations;
+
+        co::Barrier barrier( node, node->getNodeID(), size );
+        run.barrier = co::ObjectVersion( &barrier );
+
+        for( uint32_t i = 1; i < size; ++i )
+            node->connect( run.nodes[i] )->send( _cmdRun )
+                << run.nodes << run.barrier << run.iterations;
+
+        _print( "flat", size, _runFlat( barrier, iterations ));
+        _print( "hierarchical", size,
+                _runHierarchical( hierarchicalBarrier, run ));
+    }
+
+    for( co::NodeIDs::const_iterator i = workers.begin(); i != workers.end();
+         ++i )
+    {
+        node->connect( *i )->send( _cmdRun )
+            << co::NodeIDs() << co::ObjectVersion() << uint32_t( 0 );
+    }
+    return EXIT_SUCCESS;
+}
+}
+
+int main( const int argc, char** argv )
+{
+    if( !co::init( argc, argv ))
+        return EXIT_FAILURE;
+
+    const bool isWorker = argc > 2 && std::string( argv[1] ) == "--worker";
+    const uint32_t nProcesses = !isWorker && argc > 1 ? atoi( argv[1] ) : 16;
+    const uint32_t iterations = !isWorker && argc > 2 ? atoi( argv[2] ) : 1000;
+    const std::string address = isWorker ? argv[2] :
+                                argc > 3 ? argv[3] : "127.0.0.1:4243";
+
+    co::LocalNodePtr node = new co::LocalNode;
+    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+    if( !isWorker )
+        desc->fromString( address );
+    node->addConnectionDescription( desc );
+    if( !node->listen( ))
+    {
+        LBERROR << "Can't listen on " << desc << std::endl;
+        co::exit();
+        return EXIT_FAILURE;
+    }
+
+    const int result = isWorker ? _runWorker( node, address ) :
+                       _runMaster( node, argv[0], address,
+                                   std::max( nProcesses, 2u ), iterations );
+    node->close();
+    node = 0;
+    co::exit();
+    return result;
+}
@@ -0,0 +1,58 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Prints the critical path and resource slack of all frames of a statistics
+// trace written by eq::CriticalPathAnalyzer::setTrace().
+
+#include <eq/eq.h>
+
+#include <fstream>
+
+int main( const int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [frame]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream trace( argv[1] );
+    if( !trace )
+    {
+        std::cerr << "Can't open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    eq::CriticalPathAnalyzer analyzer;
+    const size_t nTasks = analyzer.read( trace );
+    std::cout << "Read " << nTasks << " tasks from " << argv[1] << std::endl;
+
+    std::vector< uint32_t > frames = analyzer.getFrames();
+    if( argc > 2 )
+        frames = std::vector< uint32_t >( 1, atoi( argv[2] ));
+
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        eq::CriticalPathAnalyzer::Analysis analysis;
+        if( analyzer.analyze( frames[i], analysis ))
+            std::cout << analysis << std::endl;
+        else
+            std::cout << "No tasks for frame " << frames[i] << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
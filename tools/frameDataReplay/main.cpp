@@ -0,0 +1,94 @@
+
+/* Copyright (c) 2014, The Equalizer Authors
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Replays a frame data trace captured with EQ_FRAMEDATA_TRACE through the
+// decompression and the CPU compositing at full speed, and prints the time
+// spent in each stage.
+
+#include <eq/eq.h>
+
+#include <iomanip>
+
+int main( const int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [loops]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    eq::NodeFactory nodeFactory;
+    if( !eq::init( 0, 0, &nodeFactory ))
+    {
+        std::cerr << "Equalizer init failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    eq::FrameDataTrace trace;
+    const size_t nImages = trace.read( argv[1] );
+    const std::vector< uint32_t > frames = trace.getFrames();
+    const size_t nLoops = argc > 2 ? atoi( argv[2] ) : 1;
+    std::cout << "Read " << nImages << " images of " << frames.size()
+              << " frames from " << argv[1] << std::endl
+              << " FRAME, SIZE (KB), RECEIVE (ms), MERGE (ms), MB/s"
+              << std::endl;
+
+    float receiveTime = 0.f;
+    float mergeTime = 0.f;
+    uint64_t size = 0;
+    lunchbox::Clock clock;
+
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        const uint32_t frame = frames[i];
+        const uint64_t frameSize = trace.getSize( frame ) * nLoops;
+        float receive = 0.f;
+        float merge = 0.f;
+
+        for( size_t j = 0; j < nLoops; ++j )
+        {
+            clock.reset();
+            const eq::Frames& inputs = trace.receive( frame );
+            receive += clock.getTimef();
+
+            clock.reset();
+            eq::Compositor::mergeFramesCPU( inputs );
+            merge += clock.getTimef();
+        }
+
+        std::cout << std::setw( 6 ) << frame << ", " << std::setw( 9 )
+                  << frameSize / nLoops / 1024 << ", " << std::setw( 12 )
+                  << receive / nLoops << ", " << std::setw( 10 )
+                  << merge / nLoops << ", " << std::setw( 6 )
+                  << frameSize / 1024.f / 1.024f / ( receive + merge )
+                  << std::endl;
+
+        receiveTime += receive;
+        mergeTime += merge;
+        size += frameSize;
+    }
+
+    if( !frames.empty( ))
+        std::cout << " TOTAL, " << std::setw( 9 ) << size / 1024 << ", "
+                  << std::setw( 12 ) << receiveTime << ", " << std::setw( 10 )
+                  << mergeTime << ", " << std::setw( 6 )
+                  << size / 1024.f / 1.024f / ( receiveTime + mergeTime )
+                  << std::endl;
+
+    return eq::exit() ? EXIT_SUCCESS : EXIT_FAILURE;
+}